@@ -62,6 +62,7 @@
 
 #include "common/messageType.h"
 #include "common/messageParserAndSerializer.h"
+#include "common/messageCache.h"
 
 #include "device/alarmHandling.h"
 #include "webServer/webServer.h"
@@ -190,11 +191,10 @@ static bool SendDeviceStatus(const SettingDevice_t* setting);
  */
 static bool SendDeviceLocation(const Location_t* location);
 
-/** @brief Send device scheduler
- *  @param scheduler [in] pointer to Scheduler_t struct
+/** @brief Send current device scheduler
  *  @return true if success
  */
-static bool SendDeviceScheduler(const Scheduler_t* scheduler);
+static bool SendDeviceScheduler(void);
 
 /** @brief Publish send data to iot hub by direct method
  *  @param scheduler [in] pointer to Scheduler_t struct
@@ -490,7 +490,7 @@ void IotHubClientMainLoop(void *argument)
             if((runFirstTime == true) || (schedulerChange == true) || (TimeDriverHasTimeElapsed(sendMessageDeviceSchedulerTime, SEND_DEVICE_SCHEDULE_UPDATE_REQUEST_INTERVAL_MS))){
                 SchedulerGetAll(&scheduler);
 
-                if(SendDeviceScheduler(&scheduler) == true){
+                if(SendDeviceScheduler() == true){
                     sendMessageDeviceSchedulerTime = TimeDriverGetSystemTickMs();
                     memcpy(&schedulerOld, &scheduler, sizeof(Scheduler_t));
                     ESP_LOGI(TAG, "send device scheduler");
@@ -721,30 +721,22 @@ static bool SendDeviceLocation(const Location_t* location)
     return true;
 }
 
-static bool SendDeviceScheduler(const Scheduler_t* scheduler)
+static bool SendDeviceScheduler(void)
 {
-    messageTypeScheduler_t messageScheduler = {};
     char jsonStr[MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH] = {};
+    size_t jsonLen = 0;
 
-    cJSON *jsonRoot = cJSON_CreateObject();
-
-    MessageTypeCreateMessageTypeScheduler(&messageScheduler, scheduler);
-    MessageParserAndSerializerCreateSchedulerJson(jsonRoot, &messageScheduler);
-
-    if (cJSON_PrintPreallocated(jsonRoot, jsonStr, MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH, false) == false) {
-        jsonStr[0] = 0;
-        ESP_LOGE(TAG, "device scheduler json size is too big");
+    // the same json is served by the web server, it is built once per scheduler change
+    if (MessageCacheGetSchedulerJson(jsonStr, sizeof(jsonStr), &jsonLen) == false) {
+        ESP_LOGE(TAG, "device scheduler json not available");
       
         return false;
     }
 
-    cJSON_Delete(jsonRoot);
-
-    int jsonStrLen = strlen(jsonStr);
-    ESP_LOGI(TAG, "device scheduler len %d", jsonStrLen);
+    ESP_LOGI(TAG, "device scheduler len %d", (int)jsonLen);
     ESP_LOGI(TAG, "%s", jsonStr);
 
-    bool sendStatus = PublishDataEvent(jsonStr, jsonStrLen);
+    bool sendStatus = PublishDataEvent(jsonStr, jsonLen);
     if(sendStatus == false){
         ESP_LOGW(TAG, "device scheduler websocket send error");
         
@@ -0,0 +1,213 @@
+/**
+ * @file messageCache.c
+ *
+ * @brief cache of serialized json messages source file
+ *
+ * Building a message json from the device data (cJSON tree and print) takes
+ * much longer than copying it. The last serialized json is kept with the
+ * key of the data it was built from and rebuilt only when the key changes.
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "messageCache.h"
+
+#include <string.h>
+
+#include <esp_log.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "common/messageType.h"
+#include "common/messageParserAndSerializer.h"
+
+#include "timeDriver/timeDriver.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+ *****************************************************************************/
+
+#define MUTEX_TIMEOUT_MS (1U * 1000U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+/** @brief Serialize message json
+ *  @param json [out] json buffer
+ *  @param jsonSize json buffer size
+ *  @return true if success
+ */
+typedef bool (*messageCacheBuild_t)(char *json, size_t jsonSize);
+
+typedef struct {
+    const char *name;
+    messageCacheBuild_t build;
+    char *json;
+    size_t size;
+    size_t len;
+    uint64_t key;
+    bool isValid;
+    SemaphoreHandle_t mutex;
+} messageCacheEntry_t;
+
+static const char *TAG = "messageC";
+
+static char sSchedulerJson[MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH];
+static char sDeviceInfoJson[MESSAGE_TYPE_MAX_DEVICE_INFO_JSON_LENGTH];
+
+// used only with the entry mutex taken
+static SettingDevice_t sSetting;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Build scheduler json
+ *  @param json [out] json buffer
+ *  @param jsonSize json buffer size
+ *  @return true if success
+ */
+static bool BuildSchedulerJson(char *json, size_t jsonSize);
+
+/** @brief Build device info json
+ *  @param json [out] json buffer
+ *  @param jsonSize json buffer size
+ *  @return true if success
+ */
+static bool BuildDeviceInfoJson(char *json, size_t jsonSize);
+
+/** @brief Copy cached json, rebuild it first if the key changed
+ *  @param entry cache entry
+ *  @param key key of the current data
+ *  @param json [out] json buffer
+ *  @param jsonSize json buffer size
+ *  @param len [out] json length without null
+ *  @return true if success
+ */
+static bool GetJson(messageCacheEntry_t *entry, uint64_t key, char *json, size_t jsonSize, size_t *len);
+
+static messageCacheEntry_t sSchedulerCache = {
+    .name = "scheduler",
+    .build = BuildSchedulerJson,
+    .json = sSchedulerJson,
+    .size = sizeof(sSchedulerJson),
+};
+
+static messageCacheEntry_t sDeviceInfoCache = {
+    .name = "device info",
+    .build = BuildDeviceInfoJson,
+    .json = sDeviceInfoJson,
+    .size = sizeof(sDeviceInfoJson),
+};
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool MessageCacheInit(void)
+{
+    sSchedulerCache.mutex = xSemaphoreCreateMutex();
+    sDeviceInfoCache.mutex = xSemaphoreCreateMutex();
+
+    return (sSchedulerCache.mutex != NULL) && (sDeviceInfoCache.mutex != NULL);
+}
+
+bool MessageCacheGetSchedulerJson(char *json, size_t jsonSize, size_t *len)
+{
+    return GetJson(&sSchedulerCache, SchedulerGetGeneration(), json, jsonSize, len);
+}
+
+bool MessageCacheGetDeviceInfoJson(char *json, size_t jsonSize, size_t *len)
+{
+    // device info carries the current timestamp, it is valid for one second at most
+    uint64_t key = ((uint64_t)TimeDriverGetUTCUnixTime() << 32) | SettingGetGeneration();
+
+    return GetJson(&sDeviceInfoCache, key, json, jsonSize, len);
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static bool BuildSchedulerJson(char *json, size_t jsonSize)
+{
+    Scheduler_t scheduler = {};
+    messageTypeScheduler_t messageScheduler = {};
+
+    if (SchedulerGetAll(&scheduler) == false) {
+        return false;
+    }
+
+    MessageTypeCreateMessageTypeScheduler(&messageScheduler, &scheduler);
+
+    cJSON *jsonRoot = cJSON_CreateObject();
+    MessageParserAndSerializerCreateSchedulerJson(jsonRoot, &messageScheduler);
+
+    bool res = cJSON_PrintPreallocated(jsonRoot, json, jsonSize, false);
+    cJSON_Delete(jsonRoot);
+
+    return res;
+}
+
+static bool BuildDeviceInfoJson(char *json, size_t jsonSize)
+{
+    messageTypeDeviceInfo_t info = {};
+
+    if (SettingGet(&sSetting) == false) {
+        return false;
+    }
+
+    MessageTypeCreateDeviceInfo(&info, &sSetting);
+
+    cJSON *jsonRoot = cJSON_CreateObject();
+    MessageParserAndSerializerCreateDeviceInfoJson(jsonRoot, &info);
+
+    bool res = cJSON_PrintPreallocated(jsonRoot, json, jsonSize, false);
+    cJSON_Delete(jsonRoot);
+
+    return res;
+}
+
+static bool GetJson(messageCacheEntry_t *entry, uint64_t key, char *json, size_t jsonSize, size_t *len)
+{
+    *len = 0;
+
+    if (entry->mutex == NULL) {
+        if (entry->build(json, jsonSize) == false) {
+            return false;
+        }
+        *len = strlen(json);
+        return true;
+    }
+
+    if (xSemaphoreTake(entry->mutex, MUTEX_TIMEOUT_MS / portTICK_RATE_MS) != pdTRUE) {
+        return false;
+    }
+
+    // key is read before the build, a change during the build causes a rebuild next time
+    if ((entry->isValid == false) || (entry->key != key)) {
+        entry->isValid = entry->build(entry->json, entry->size);
+        entry->len = entry->isValid ? strlen(entry->json) : 0;
+        entry->key = key;
+
+        if (entry->isValid == false) {
+            ESP_LOGE(TAG, "%s json size is too big", entry->name);
+        }
+    }
+
+    bool res = entry->isValid && (entry->len < jsonSize);
+    if (res) {
+        memcpy(json, entry->json, entry->len + 1);
+        *len = entry->len;
+    }
+
+    xSemaphoreGive(entry->mutex);
+
+    return res;
+}
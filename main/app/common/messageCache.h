@@ -0,0 +1,41 @@
+/**
+ * @file messageCache.h
+ *
+ * @brief cache of serialized json messages header file
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Initialize message cache, without it messages are built on every get
+ *  @return true if success
+ */
+bool MessageCacheInit(void);
+
+/** @brief Get scheduler json, rebuilt only when the scheduler generation changed
+ *  @param json [out] json buffer, MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH bytes
+ *  @param jsonSize json buffer size
+ *  @param len [out] json length without null
+ *  @return true if success
+ */
+bool MessageCacheGetSchedulerJson(char *json, size_t jsonSize, size_t *len);
+
+/** @brief Get device info json, rebuilt only when the settings generation or the timestamp second changed
+ *  @param json [out] json buffer, MESSAGE_TYPE_MAX_DEVICE_INFO_JSON_LENGTH bytes
+ *  @param jsonSize json buffer size
+ *  @param len [out] json length without null
+ *  @return true if success
+ */
+bool MessageCacheGetDeviceInfoJson(char *json, size_t jsonSize, size_t *len);
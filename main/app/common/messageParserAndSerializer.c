@@ -22,6 +22,7 @@
 #include "factorySettingsDriver/factorySettingsDriver.h"
 
 #include <string.h>
+#include <stdlib.h>
 
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
@@ -77,6 +78,45 @@ static const char *TAG = "m_parser_seria";
  */
 static bool IsDeviceIdCorrect(const char* id);
 
+/** @brief Wifi setting Json value callback
+ *  @param ctx [in] pointer to messageParserWifiSettingStream_t
+ *  @param key [in] top level key
+ *  @param type [in] value type
+ *  @param data [in] piece of the value
+ *  @param len [in] piece length
+ *  @param isEnd [in] last piece of the value
+ *  @return false when value is too long
+ */
+static bool WifiSettingStreamCallback(void *ctx, const char *key, jsonStreamType_t type, const char *data, uint32_t len, bool isEnd);
+
+/** @brief Append piece of string value to fixed size buffer and terminate it
+ *  @param dst [out] destination buffer
+ *  @param dstSize [in] destination buffer size
+ *  @param offset [in] length of already copied value
+ *  @param data [in] piece of the value
+ *  @param len [in] piece length
+ *  @return true when value with null fits in the buffer
+ */
+static bool AppendString(char *dst, uint32_t dstSize, uint32_t offset, const char *data, uint32_t len);
+
+/** @brief Append piece of certificate to heap buffer
+ *  @param blob [in/out] pointer to heap buffer, reallocated
+ *  @param blobLen [in/out] buffer length
+ *  @param data [in] piece of the value
+ *  @param len [in] piece length
+ *  @return true if success
+ */
+static bool AppendBlob(char **blob, uint32_t *blobLen, const char *data, uint32_t len);
+
+/** @brief Add array of numbers to json object
+ *  @param root [out] json object
+ *  @param name [in] array name
+ *  @param values [in] numbers
+ *  @param count [in] numbers count
+ *  @return true if success
+ */
+static bool AddNumberArrayToObject(cJSON *root, const char *name, const uint32_t *values, uint16_t count);
+
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
 *****************************************************************************/
@@ -427,174 +467,101 @@ bool MessageParserAndSerializerCreateSchedulerJson(cJSON *root, const messageTyp
     return true;
 }
 
-bool MessageParserAndSerializerParseWifiSettingJsonString(const char * const wifiSettingBody, wifiSetting_t* wifiSetting)
+void MessageParserAndSerializerWifiSettingStreamBegin(messageParserWifiSettingStream_t* parser, wifiSetting_t* wifiSetting)
+{
+    memset(parser, 0, sizeof(messageParserWifiSettingStream_t));
+
+    parser->wifiSetting = wifiSetting;
+    JsonStreamInit(&parser->stream, WifiSettingStreamCallback, parser);
+}
+
+bool MessageParserAndSerializerWifiSettingStreamParse(messageParserWifiSettingStream_t* parser, const char * const data, uint32_t len)
 {
-    cJSON *wifiJson = cJSON_Parse(wifiSettingBody);
-    if (wifiJson == NULL){
-        cJSON_Delete(wifiJson);
+    if(parser->isError){
         return false;
     }
 
-    const cJSON *DeviceId = cJSON_GetObjectItemCaseSensitive(wifiJson, "DeviceId");
-    if (cJSON_IsString(DeviceId))
-    {
-        ESP_LOGI(TAG, "device id %s", DeviceId->valuestring);
+    if(JsonStreamParse(&parser->stream, data, len) == false){
+        ESP_LOGE(TAG, "wifi setting parse error");
+        parser->isError = true;
     }
 
-    const cJSON *ssid = cJSON_GetObjectItemCaseSensitive(wifiJson, "SSID");
-    if (cJSON_IsString(ssid))
-    {
-        int len = strlen(ssid->valuestring);
-        
-        if(len < WIFI_SSID_STRING_NAME_LEN){
-            memcpy(wifiSetting->ssid, ssid->valuestring, len);
-        }
-        else{
-            ESP_LOGE(TAG, "ssid incorrect size");
-            cJSON_Delete(wifiJson);
-    
-            return false;
-        }
-    }
-
-    const cJSON *password = cJSON_GetObjectItemCaseSensitive(wifiJson, "Password");
-    if (cJSON_IsString(password))
-    {
-        int len = strlen(password->valuestring);
+    return (parser->isError == false);
+}
 
-        if(len < WIFI_PASSWORD_STRING_NAME_LEN){
-            memcpy(wifiSetting->password, password->valuestring, len);
-        }
-        else{
-            ESP_LOGE(TAG, "password incorrect size");
-            cJSON_Delete(wifiJson);
-    
-            return false;
-        }
-    }
+bool MessageParserAndSerializerWifiSettingStreamEnd(messageParserWifiSettingStream_t* parser)
+{
+    wifiSetting_t* wifiSetting = parser->wifiSetting;
+    bool res = (parser->isError == false) && JsonStreamIsComplete(&parser->stream);
 
-    wifiSetting->eapMethod = WIFI_EAP_METHOD_NONE;
-    const cJSON *eapMethod = cJSON_GetObjectItemCaseSensitive(wifiJson, "eapMethod");
-    if(cJSON_IsString(eapMethod))
-    {
+    if(res){
+        // values could come in any order, eap dependent fields are resolved when the whole Json is known
+        wifiSetting->eapMethod = WIFI_EAP_METHOD_NONE;
         for(uint16_t idx = WIFI_EAP_METHOD_TLS; idx < WIFI_EAP_METHOD_COUNT; ++idx)
         {
-            int cmpRes = strncmp(eapMethod->valuestring, sEapMethodStr[idx], strlen(sEapMethodStr[idx]));
+            int cmpRes = strncmp(parser->eapMethod, sEapMethodStr[idx], strlen(sEapMethodStr[idx]));
             if(cmpRes == 0){
                 wifiSetting->eapMethod = idx;
                 break;
             }
         }
-    }
+        ESP_LOGI(TAG, "EAP method %d", wifiSetting->eapMethod);
 
-    ESP_LOGI(TAG, "EAP method %d", wifiSetting->eapMethod);
-
-    const cJSON *radius = cJSON_GetObjectItemCaseSensitive(wifiJson, "radius");
-    if (cJSON_IsString(radius))
-    {
-        int len = strlen(radius->valuestring);
-
-        if(len < WIFI_RADIUS_SERVER_ADDRESS_LEN){
-            memcpy(wifiSetting->radiusServerAddress, radius->valuestring, len);
-            ESP_LOGI(TAG, "radius addres len %d", len);
+        bool isPeapOrTtls = (wifiSetting->eapMethod == WIFI_EAP_METHOD_PEAP) || (wifiSetting->eapMethod == WIFI_EAP_METHOD_TTLS);
+        if(isPeapOrTtls && parser->isEapUserTooLong){
+            ESP_LOGE(TAG, "peap user or password incorrect size");
+            res = false;
         }
-        else{
-            ESP_LOGE(TAG, "radius incorrect size");
-            cJSON_Delete(wifiJson);
-    
-            return false;
+        else if(isPeapOrTtls == false){
+            memset(wifiSetting->wpa2PeapEapUser, 0, sizeof(wifiSetting->wpa2PeapEapUser));
+            memset(wifiSetting->wpa2PeapPassword, 0, sizeof(wifiSetting->wpa2PeapPassword));
         }
-    }
 
-    const cJSON *pem = cJSON_GetObjectItemCaseSensitive(wifiJson, "pem");
-    if(cJSON_IsString(pem))
-    {
-        int len = strlen(pem->valuestring);
-        if(len > 0){
-            wifiSetting->validateServer = true;
-            NvsDriverSave(WIFI_WPA2_CA_PEM_FILE_NAME, pem->valuestring, len);
-            ESP_LOGI(TAG, "save %d bytes to %s", len, WIFI_WPA2_CA_PEM_FILE_NAME);
+        if(wifiSetting->eapMethod == WIFI_EAP_METHOD_TTLS){
+            wifiSetting->phase2Method = ESP_EAP_TTLS_PHASE2_EAP;
+            for(uint16_t idx = 0; idx <= ESP_EAP_TTLS_PHASE2_CHAP; ++idx)
+            {
+                int cmpRes = strncmp(parser->phase2Method, sEapPhase2MethodStr[idx], strlen(sEapPhase2MethodStr[idx]));
+                if(cmpRes == 0){
+                    wifiSetting->phase2Method = idx;
+                    break;
+                }
+            }
+            ESP_LOGI(TAG, "phase2Method %d", wifiSetting->phase2Method);
         }
     }
-    ESP_LOGI(TAG, "pem ca enable %d", wifiSetting->validateServer);
 
-    if(wifiSetting->eapMethod == WIFI_EAP_METHOD_TLS){
-        const cJSON *tslCrt = cJSON_GetObjectItemCaseSensitive(wifiJson, "crt");
-        if(cJSON_IsString(tslCrt))
-        {
-            int len = strlen(tslCrt->valuestring);
-            if(len > 0){
-                NvsDriverSave(WIFI_WPA2_CLIENT_CRT_FILE_NAME, tslCrt->valuestring, len);
-                ESP_LOGI(TAG, "save %d bytes to %s", len, WIFI_WPA2_CLIENT_CRT_FILE_NAME);
-            }
+    if(res){
+        if(parser->pemLen > 0){
+            wifiSetting->validateServer = true;
+            NvsDriverSave(WIFI_WPA2_CA_PEM_FILE_NAME, parser->pem, parser->pemLen);
+            ESP_LOGI(TAG, "save %d bytes to %s", (int)parser->pemLen, WIFI_WPA2_CA_PEM_FILE_NAME);
         }
+        ESP_LOGI(TAG, "pem ca enable %d", wifiSetting->validateServer);
 
-        const cJSON *tslKey = cJSON_GetObjectItemCaseSensitive(wifiJson, "key");
-        if(cJSON_IsString(tslKey))
-        {
-            int len = strlen(tslKey->valuestring);
-            if(len > 0){
-                NvsDriverSave(WIFI_WPA2_CLIENT_KEY_FILE_NAME, tslKey->valuestring, len);
-                ESP_LOGI(TAG, "save %d bytes to %s", len, WIFI_WPA2_CLIENT_KEY_FILE_NAME);
-            }
-        }
-    }
-    else if((wifiSetting->eapMethod == WIFI_EAP_METHOD_PEAP) || (wifiSetting->eapMethod == WIFI_EAP_METHOD_TTLS)){
-        const cJSON *eapUser = cJSON_GetObjectItemCaseSensitive(wifiJson, "eapuser");
-        if(cJSON_IsString(eapUser))
-        {
-            int len = strlen(eapUser->valuestring);
-            if(len < WIFI_PEAP_USEN_LEN){
-                memcpy(wifiSetting->wpa2PeapEapUser, eapUser->valuestring, len);
-                ESP_LOGI(TAG, "eap user len %d", len);
-            }
-            else{
-                ESP_LOGE(TAG, "peap user incorrect size");
-                cJSON_Delete(wifiJson);
-    
-                return false;
+        if(wifiSetting->eapMethod == WIFI_EAP_METHOD_TLS){
+            if(parser->crtLen > 0){
+                NvsDriverSave(WIFI_WPA2_CLIENT_CRT_FILE_NAME, parser->crt, parser->crtLen);
+                ESP_LOGI(TAG, "save %d bytes to %s", (int)parser->crtLen, WIFI_WPA2_CLIENT_CRT_FILE_NAME);
             }
-        }
 
-        const cJSON *eapPassword = cJSON_GetObjectItemCaseSensitive(wifiJson, "eappassword");
-        if(cJSON_IsString(eapPassword))
-        {
-            int len = strlen(eapPassword->valuestring);
-            if(len < WIFI_PEAP_USEN_LEN){
-                memcpy(wifiSetting->wpa2PeapPassword, eapPassword->valuestring, len);
-                ESP_LOGI(TAG, "eap password len %d", len);
-            }
-            else{
-                ESP_LOGE(TAG, "peap password incorrect size");
-                cJSON_Delete(wifiJson);
-    
-                return false;
+            if(parser->keyLen > 0){
+                NvsDriverSave(WIFI_WPA2_CLIENT_KEY_FILE_NAME, parser->key, parser->keyLen);
+                ESP_LOGI(TAG, "save %d bytes to %s", (int)parser->keyLen, WIFI_WPA2_CLIENT_KEY_FILE_NAME);
             }
         }
 
-        if(wifiSetting->eapMethod == WIFI_EAP_METHOD_TTLS){
-            wifiSetting->phase2Method = ESP_EAP_TTLS_PHASE2_EAP;
-            const cJSON *phase2Method = cJSON_GetObjectItemCaseSensitive(wifiJson, "phase2Method");
-            if(cJSON_IsString(phase2Method))
-            {
-                for(uint16_t idx = 0; idx <= ESP_EAP_TTLS_PHASE2_CHAP; ++idx)
-                {
-                    int cmpRes = strncmp(phase2Method->valuestring, sEapPhase2MethodStr[idx], strlen(sEapPhase2MethodStr[idx]));
-                    if(cmpRes == 0){
-                        wifiSetting->phase2Method = idx;
-                        break;
-                    }
-                }
-            }
-            ESP_LOGI(TAG, "phase2Method %d", wifiSetting->phase2Method);
-        }
+        ESP_LOGI(TAG, "new ssid and passord save");
     }
 
-    cJSON_Delete(wifiJson);
-    
-    ESP_LOGI(TAG, "new ssid and passord save");
+    free(parser->pem);
+    free(parser->crt);
+    free(parser->key);
+    parser->pem = NULL;
+    parser->crt = NULL;
+    parser->key = NULL;
 
-    return true;
+    return res;
 }
 
 bool MessageParserAndSerializerCreateDeviceInfoHttpClientJson(cJSON *root, const messageTypeDeviceInfoHttpClient_t* deviceInfo)
@@ -645,6 +612,9 @@ bool MessageParserAndSerializerCreateDeviceStatusHttpClientJson(cJSON *root, con
     cJSON_AddBoolToObject(root, "WifiOn", deviceStatus->wifiOn);
     cJSON_AddBoolToObject(root, "DeviceReset", deviceStatus->deviceReset);
     cJSON_AddNumberToObject(root, "ResetReason", deviceStatus->resetReason);
+    if(deviceStatus->hepaLoadIsSet){
+        cJSON_AddNumberToObject(root, "HepaLoad", deviceStatus->hepaLoad);
+    }
 
     return true;
 }
@@ -1081,7 +1051,24 @@ bool MessageParserAndSerializerCreateDeviceDiagnosticJson(cJSON *root, const mes
     cJSON_AddNumberToObject(root, "timerHepa", deviceDiag->timerHepa);
     cJSON_AddNumberToObject(root, "timerTotal", deviceDiag->timerTotal);
 
-    return true;
+    // per button in CfgTouchButtonName_t order: power, fan+, fan-; copied out of the packed struct
+    bool res = true;
+    uint32_t touchValues[CFG_TOUCH_BUTTON_NAME_COUNT] = {};
+
+    memcpy(touchValues, deviceDiag->touchFalseTriggers, sizeof(touchValues));
+    res &= AddNumberArrayToObject(root, "touchFalseTriggers", touchValues, CFG_TOUCH_BUTTON_NAME_COUNT);
+
+    memcpy(touchValues, deviceDiag->touchNoisePeak, sizeof(touchValues));
+    res &= AddNumberArrayToObject(root, "touchNoise", touchValues, CFG_TOUCH_BUTTON_NAME_COUNT);
+
+    memcpy(touchValues, deviceDiag->touchThreshold, sizeof(touchValues));
+    res &= AddNumberArrayToObject(root, "touchThreshold", touchValues, CFG_TOUCH_BUTTON_NAME_COUNT);
+    cJSON_AddNumberToObject(root, "touchSensitivity", deviceDiag->touchSensitivity);
+    cJSON_AddNumberToObject(root, "hepaLoad", deviceDiag->hepaLoad);
+    cJSON_AddNumberToObject(root, "hepaDutyChange", deviceDiag->hepaDutyChange);
+    cJSON_AddNumberToObject(root, "hepaLoadSamples", deviceDiag->hepaLoadSamples);
+
+    return res;
 }
 
 /******************************************************************************
@@ -1092,3 +1079,119 @@ static bool IsDeviceIdCorrect(const char* id)
 {
     return (strncmp(FactorySettingsGetDevceName(), id, strlen(FactorySettingsGetDevceName())) == 0);
 }
+
+static bool WifiSettingStreamCallback(void *ctx, const char *key, jsonStreamType_t type, const char *data, uint32_t len, bool isEnd)
+{
+    messageParserWifiSettingStream_t* parser = (messageParserWifiSettingStream_t*)ctx;
+    wifiSetting_t* wifiSetting = parser->wifiSetting;
+    uint32_t valueLen = parser->valueLen;
+    bool res = true;
+
+    parser->valueLen = isEnd ? 0 : (valueLen + len);
+
+    if(type != JSON_STREAM_TYPE_STRING){
+        return true;
+    }
+
+    if(strcmp(key, "SSID") == 0){
+        res = AppendString(wifiSetting->ssid, WIFI_SSID_STRING_NAME_LEN, valueLen, data, len);
+    }
+    else if(strcmp(key, "Password") == 0){
+        res = AppendString(wifiSetting->password, WIFI_PASSWORD_STRING_NAME_LEN, valueLen, data, len);
+    }
+    else if(strcmp(key, "radius") == 0){
+        res = AppendString(wifiSetting->radiusServerAddress, WIFI_RADIUS_SERVER_ADDRESS_LEN, valueLen, data, len);
+    }
+    else if(strcmp(key, "eapMethod") == 0){
+        // longer strings are cut, prefix comparison is done at the end
+        AppendString(parser->eapMethod, MESSAGE_PARSER_EAP_METHOD_STR_LEN, valueLen, data, len);
+    }
+    else if(strcmp(key, "phase2Method") == 0){
+        AppendString(parser->phase2Method, MESSAGE_PARSER_EAP_METHOD_STR_LEN, valueLen, data, len);
+    }
+    else if(strcmp(key, "eapuser") == 0){
+        // eap method may come later, size is checked at the end
+        if(AppendString(wifiSetting->wpa2PeapEapUser, WIFI_PEAP_USEN_LEN, valueLen, data, len) == false){
+            parser->isEapUserTooLong = true;
+        }
+    }
+    else if(strcmp(key, "eappassword") == 0){
+        if(AppendString(wifiSetting->wpa2PeapPassword, WIFI_PEAP_USEN_LEN, valueLen, data, len) == false){
+            parser->isEapUserTooLong = true;
+        }
+    }
+    else if(strcmp(key, "pem") == 0){
+        res = AppendBlob(&parser->pem, &parser->pemLen, data, len);
+    }
+    else if(strcmp(key, "crt") == 0){
+        res = AppendBlob(&parser->crt, &parser->crtLen, data, len);
+    }
+    else if(strcmp(key, "key") == 0){
+        res = AppendBlob(&parser->key, &parser->keyLen, data, len);
+    }
+    else if((strcmp(key, "DeviceId") == 0) && isEnd){
+        ESP_LOGI(TAG, "device id %.*s", (int)len, data);
+    }
+
+    if(res == false){
+        ESP_LOGE(TAG, "%s incorrect size", key);
+    }
+
+    return res;
+}
+
+static bool AppendString(char *dst, uint32_t dstSize, uint32_t offset, const char *data, uint32_t len)
+{
+    // one place is left for null
+    if((offset + len) >= dstSize){
+        return false;
+    }
+
+    memcpy(&dst[offset], data, len);
+    dst[offset + len] = '\0';
+
+    return true;
+}
+
+static bool AppendBlob(char **blob, uint32_t *blobLen, const char *data, uint32_t len)
+{
+    if(len == 0){
+        return true;
+    }
+
+    if((*blobLen + len) > MESSAGE_TYPE_MAX_WIFI_SETTING_JSON_LENGTH){
+        return false;
+    }
+
+    char *newBlob = realloc(*blob, *blobLen + len);
+    if(newBlob == NULL){
+        return false;
+    }
+
+    memcpy(&newBlob[*blobLen], data, len);
+    *blob = newBlob;
+    *blobLen += len;
+
+    return true;
+}
+
+static bool AddNumberArrayToObject(cJSON *root, const char *name, const uint32_t *values, uint16_t count)
+{
+    cJSON *array = cJSON_CreateArray();
+    if(array == NULL){
+        return false;
+    }
+
+    for(uint16_t idx = 0; idx < count; ++idx){
+        cJSON *value = cJSON_CreateNumber(values[idx]);
+        if(value == NULL){
+            cJSON_Delete(array);
+            return false;
+        }
+        cJSON_AddItemToArray(array, value);
+    }
+
+    cJSON_AddItemToObject(root, name, array);
+
+    return true;
+}
@@ -16,6 +16,7 @@
 #include <time.h>
 
 #include "messageType.h"
+#include "utils/jsonStream/jsonStream.h"
 
 #include "scheduler/scheduler.h"
 #include "location/location.h"
@@ -38,6 +39,24 @@ typedef enum{
     MESSAGE_TYPE_DEVICE_COUNT
 }MessageType_t;
 
+#define MESSAGE_PARSER_EAP_METHOD_STR_LEN (16U)
+
+typedef struct{
+    jsonStream_t stream;
+    wifiSetting_t* wifiSetting;
+    uint32_t valueLen;
+    char eapMethod[MESSAGE_PARSER_EAP_METHOD_STR_LEN];
+    char phase2Method[MESSAGE_PARSER_EAP_METHOD_STR_LEN];
+    char *pem;
+    uint32_t pemLen;
+    char *crt;
+    uint32_t crtLen;
+    char *key;
+    uint32_t keyLen;
+    bool isEapUserTooLong;
+    bool isError;
+}messageParserWifiSettingStream_t;
+
 /*****************************************************************************
                          PUBLIC INTERFACE DECLARATION
 *****************************************************************************/
@@ -76,12 +95,26 @@ bool MessageParserAndSerializerParseDeviceSchedulerJsonString(const char * const
  */
 bool MessageParserAndSerializerCreateSchedulerJson(cJSON *root, const messageTypeScheduler_t* scheduler);
 
-/** @brief Parse Json and write result to wifiSetting_t type
- *  @param wifiSettingBody [in] pointer to json string
- *  @param wifiSetting [out] pointer to  wifiSetting_t result
+/** @brief Start streaming parse of wifi setting Json, the body is fed in pieces as it is received
+ *  @param parser [in] pointer to parser context
+ *  @param wifiSetting [out] pointer to wifiSetting_t result
+ */
+void MessageParserAndSerializerWifiSettingStreamBegin(messageParserWifiSettingStream_t* parser, wifiSetting_t* wifiSetting);
+
+/** @brief Parse next piece of wifi setting Json
+ *  @param parser [in] pointer to parser context
+ *  @param data [in] pointer to json piece
+ *  @param len [in] piece length
+ *  @return return true if success, false on syntax error or too long value
+ */
+bool MessageParserAndSerializerWifiSettingStreamParse(messageParserWifiSettingStream_t* parser, const char * const data, uint32_t len);
+
+/** @brief Finish wifi setting parse, certificates are saved to nvs only if the whole Json was correct.
+ *         Parser buffers are always freed.
+ *  @param parser [in] pointer to parser context
  *  @return return true if success
  */
-bool MessageParserAndSerializerParseWifiSettingJsonString(const char * const wifiSettingBody, wifiSetting_t* wifiSetting);
+bool MessageParserAndSerializerWifiSettingStreamEnd(messageParserWifiSettingStream_t* parser);
 
 /** @brief Create Json from messageTypeDeviceInfoHttpClient_t type
  *  @param root [in] pointer to cJSON structure
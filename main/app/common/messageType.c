@@ -28,6 +28,7 @@
 
 #include "uvLamp/uvLamp.h"
 #include "fan/fan.h"
+#include "touch/touch.h"
 
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
@@ -231,6 +232,11 @@ void MessageTypeCreateDeviceStatusHttpClient(messageTypeDeviceStatusHttpClient_t
 
     deviceStatus->resetReason = esp_reset_reason();
 
+    FanFilterLoad_t filterLoad = {};
+    FanGetFilterLoad(&filterLoad);
+    deviceStatus->hepaLoadIsSet = filterLoad.isEstimated;
+    deviceStatus->hepaLoad = filterLoad.loadPercent;
+
     static bool addOnlyOnce = false;
     if(addOnlyOnce == false){
         deviceStatus->deviceReset = setting->newFirmwareVeryfication;
@@ -533,4 +539,19 @@ void MessageTypeCreateDeviceDiagnostic(messageTypeDiagnostic_t* deviceDiagn, con
     deviceDiagn->timerUv2 = TIMER_DRIVER_RAW_DATA_TO_HOUR(setting->restore.liveTime[TIMER_NAME_UV_LAMP_2]);
     deviceDiagn->timerHepa = TIMER_DRIVER_RAW_DATA_TO_HOUR(setting->restore.liveTime[TIMER_NAME_HEPA]);
     deviceDiagn->timerTotal = TIMER_DRIVER_RAW_DATA_TO_HOUR(setting->restore.liveTime[TIMER_NAME_GLOBAL_ON]);
+
+    TouchStats_t touchStats = {};
+    TouchGetStats(&touchStats);
+    for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        deviceDiagn->touchFalseTriggers[idx] = touchStats.button[idx].falseTriggers;
+        deviceDiagn->touchNoisePeak[idx] = touchStats.button[idx].noisePeak;
+        deviceDiagn->touchThreshold[idx] = touchStats.button[idx].threshold;
+    }
+    deviceDiagn->touchSensitivity = touchStats.sensitivity;
+
+    FanFilterLoad_t filterLoad = {};
+    FanGetFilterLoad(&filterLoad);
+    deviceDiagn->hepaLoad = filterLoad.loadPercent;
+    deviceDiagn->hepaDutyChange = filterLoad.dutyChangePercent;
+    deviceDiagn->hepaLoadSamples = filterLoad.samples;
 } 
\ No newline at end of file
@@ -104,6 +104,8 @@ typedef struct
     uint16_t wifiOn         : 1;
     uint16_t deviceReset    : 1;
     uint16_t resetReason    : 3;
+    uint16_t hepaLoadIsSet  : 1;
+    uint8_t hepaLoad;
 } __attribute__ ((packed)) messageTypeDeviceStatusHttpClient_t;
 
 typedef struct
@@ -160,6 +162,13 @@ typedef struct
     uint32_t timerUv2;
     uint32_t timerHepa;
     uint32_t timerTotal;
+    uint32_t touchFalseTriggers[CFG_TOUCH_BUTTON_NAME_COUNT];
+    uint32_t touchNoisePeak[CFG_TOUCH_BUTTON_NAME_COUNT];
+    uint32_t touchThreshold[CFG_TOUCH_BUTTON_NAME_COUNT];
+    uint8_t touchSensitivity;
+    uint8_t hepaLoad;
+    int16_t hepaDutyChange;
+    uint32_t hepaLoadSamples;
 } __attribute__ ((packed)) messageTypeDiagnostic_t;
 
 
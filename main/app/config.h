@@ -40,11 +40,19 @@
 */
 #define CFG_FACTORY_PARTITION_DISABLE (0U)
 
+#define CFG_WEB_ASSETS_PARTITION_LABEL ("www")
+#define CFG_WEB_ASSETS_OTA_PARTITION_LABEL ("www_ota")     // staging area for web assets uploaded without firmware update
+#define CFG_WEB_ASSETS_PARTITION_SUBTYPE (0x40)             // web assets archive, see partitions.csv
+
 /*** Hepa ************************************************************************/
 
 #define CFG_HEPA_SERVICE_LIFETIME_HOURS (20U * 1000U)
 #define CFG_HEPA_SERVICE_REPLACEMENT_REMINDER (18U * 1000U)
 
+// fan duty per speed change of the clogged hepa filter against the new one, in percent;
+// from the fan curve measured with a clogged filter, negative for fans unloading with the filter load
+#define CFG_HEPA_CLOGGED_FAN_DUTY_CHANGE_PERCENT (40)
+
 /*** UV Lamp ********************************************************************/
 #define CFG_UV_LAMP_BALLAST_1_ON_OFF_GPIO_PIN (22U)     // REL1
 #define CFG_UV_LAMP_BALLAST_2_ON_OFF_GPIO_PIN (19U)     // REL2
@@ -71,13 +79,26 @@
 #define CFG_FAN_PWM_GPIO_PIN (23U)                      // FAN_PWM
 #define CFG_FAN_TACHO_GPIO_PIN (4U)                     // FAN_TACHO
 
+// 1 - speed from the tacho edge periods, 0 - speed from the pulse count in 1 s
+#define CFG_FAN_TACHO_PERIOD_MEASUREMENT (1U)
+
+// pwm duty ramps, a level change takes the part of the full range time of its duty change
+#define CFG_FAN_RAMP_START_MS (3U * 1000U)                  // from off to any level
+#define CFG_FAN_RAMP_UP_FULL_SCALE_MS (8U * 1000U)
+#define CFG_FAN_RAMP_DOWN_FULL_SCALE_MS (6U * 1000U)
+
+// pwm used until the factory sweep stores the fan batch setting, the level pwm values are set with it
+#define CFG_FAN_PWM_DEFAULT_FREQ_HZ (5U * 1000U)
+#define CFG_FAN_PWM_DEFAULT_RESOLUTION_BITS (12U)
+
 /*** Common I2c Communication **************************************************/
 #define CFG_I2C_PORT_NUMBER (0)
 
 #define CFG_I2C_DATA_PIN (26U)                          // I2C_SDA
 #define CFG_I2C_CLK_PIN (27U)                           // I2C_SCL
 
-#define CFG_I2C_FREQ_HZ (100U * 1000U)
+#define CFG_I2C_FREQ_HZ (100U * 1000U)                   // standard mode, only esp32 internal pull-ups
+#define CFG_I2C_BUS_MAX_BURST_TRANSFERS (4U)            // register transfers sent in one command link
 
 /*** Touch *********************************************************************/
 #define CFG_TOUCH_INTERRUPT_PIN (36U)                   // TP_INT
@@ -116,6 +137,21 @@ typedef enum{
 #define CFG_HTTP_CLIENT_PORT_NUMBER (443U)
 #define CFG_HTTP_CLIENT_NO_INTERNET_ACCESS_NUMBER_OF_SAVED_POST (16U)
 
+/*** Web Server **************************************************************/
+#define CFG_WEB_SERVER_MAX_SOCKETS (7U)                 // with 3 httpd internal, captive dns and client sockets all must fit in CONFIG_LWIP_MAX_SOCKETS
+#define CFG_CLIENT_MAX_SOCKETS (3U)                     // iot hub, cloud post and ota http clients
+#define CFG_WEB_SERVER_SEND_TIMEOUT_S (5U)              // slow client blocks the httpd task at most this long per send
+#define CFG_WEB_SERVER_SEND_SLICE_LEN (4U * 1024U)      // keep below per client tcp send buffer CONFIG_LWIP_TCP_SND_BUF_DEFAULT
+#define CFG_WEB_SERVER_KEEP_ALIVE_IDLE_S (15U)          // idle connections are probed, sockets of gone clients freed
+#define CFG_WEB_SERVER_KEEP_ALIVE_INTERVAL_S (5U)
+#define CFG_WEB_SERVER_KEEP_ALIVE_COUNT (3U)
+#define CFG_WEB_SERVER_DEFLATE_MIN_LEN (256U)           // shorter json responses are sent uncompressed
+#define CFG_WEB_WORKER_QUEUE_LEN (8U)
+#define CFG_WEB_CACHE_BUDGET (16U * 1024U)              // ram for small web files, sent without flash reads
+#define CFG_WEB_CACHE_ENTRIES (8U)
+#define CFG_WEB_CACHE_MAX_FILE_LEN (4U * 1024U)         // bigger files are sent from the mapped flash
+#define CFG_WEB_METRICS_MAX_ENDPOINTS (16U)            // registered handlers above are served unmeasured
+
 /*** Wifi **************************************************************/
 #define CFG_WIFI_DEFAULT_AP_SSID (CFG_DEFAULT_DEVICE_NAME)
 #define CFG_WIFI_AP_SSID_STRING_LEN (32U) // idf limitation (do not change)
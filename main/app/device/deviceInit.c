@@ -23,13 +23,11 @@
 #include "esp_spi_flash.h"
 #include "esp_log.h"
 
-#include "driver/i2c.h"
-#include "hal/i2c_types.h"
-
 #include "deviceInit.h"
 #include "deviceManager.h"
 #include "cloud/iotHubClient.h"
 #include "webServer/webServer.h"
+#include "common/messageCache.h"
 
 #include "fan/fan.h"
 #include "led/led.h"
@@ -48,6 +46,7 @@
 #include "rtcDriver/rtcDriver.h"
 #include "ethernetDriver/ethernetDriver.h"
 #include "gpioExpanderDriver/gpioExpanderDriver.h"
+#include "i2cBusDriver/i2cBusDriver.h"
 #include "externalFlashDriver/externalFlashDriver.h"
 
 /*****************************************************************************
@@ -119,6 +118,7 @@ static const taskInit_t sTaskInitList[] = {
     { "Comm I2C", DeviceInitCommonI2cInit, CRITICAL },
     { "Gpio expa", GpioExpanderDriverInit, CRITICAL }, 
     { "NVS Init", DeviceInitReadDataFromNvs, CRITICAL },
+    { "Msg cache", MessageCacheInit, CRITICAL },
     { "IotHub Init", IotHubClientInit, CRITICAL },
     { "Rtc init", RtcDriverInit, CRITICAL },
     { "Webserver Init", WebServerInit, CRITICAL },
@@ -149,27 +149,7 @@ void DeviceInit(void)
 
 bool DeviceInitCommonI2cInit(void)
 {
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = CFG_I2C_DATA_PIN,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_io_num = CFG_I2C_CLK_PIN,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = CFG_I2C_FREQ_HZ,
-        // .clk_flags = 0,          /*!< Optional, you can use I2C_SCLK_SRC_FLAG_* flags to choose i2c source clock here. */
-    };
-
-    esp_err_t err = i2c_param_config(CFG_I2C_PORT_NUMBER, &conf);
-    if (err != ESP_OK) {
-        return false;
-    }
-
-    err = i2c_driver_install(CFG_I2C_PORT_NUMBER, conf.mode, 0, 0, 0);
-    if (err != ESP_OK) {
-        return false;
-    }
-
-    return true;
+    return I2cBusDriverInit();
 }
 
 bool DeviceInitCommonSpiInit(void)
@@ -49,6 +49,7 @@
 #include "rtcDriver/rtcDriver.h"
 #include "ethernetDriver/ethernetDriver.h"
 #include "gpioExpanderDriver/gpioExpanderDriver.h"
+#include "i2cBusDriver/i2cBusDriver.h"
 
 #include <sys/time.h>
 #include "esp_timer.h"
@@ -332,6 +333,9 @@ void DeviceManagerMainLoop(void *argument)
             // when it appears we work normally
         }
 
+        // pwm sweep result is written to flash here, not in the fan timer
+        FanPwmSweepProcess();
+
         // rewriting the contents of the esp32 timers to deviceSetting
         if(TimeDriverHasTimeElapsed(updtateTimerTime, DEVICEMANAGER_UPDATE_TIMERS_MS)){
             updtateTimerTime = TimeDriverGetSystemTickMs();
@@ -340,6 +344,7 @@ void DeviceManagerMainLoop(void *argument)
             AlarmHandlingTimersWornOutCheck(&deviceSetting);
 
             SettingUpdateTimers(&deviceSetting);
+            FanFilterLoadProcess();
             ESP_LOGI(TAG, "setting timers update");
         }
 
@@ -416,7 +421,8 @@ void DeviceManagerMainLoop(void *argument)
         TestRunProcess();
 
         memcpy(&deviceSettingOld, &deviceSetting, sizeof(SettingDevice_t));
-        vTaskDelay(DEVICEMANAGER_TASK_DELAY_MS);
+        // woken early by touch press, release or press time threshold
+        TouchWaitForEvent(DEVICEMANAGER_TASK_DELAY_MS);
     }
 }
 
@@ -506,12 +512,26 @@ static void PrintStatus(void)
     FanTachoState_t status = FanGetTachoRevolutionsPerSecond(&count);
     ESP_LOGI(TAG, "fan status %d, speed %d [RPS]", status, count);
 
+    FanControlStatus_t control = {};
+    FanGetControlStatus(&control);
+    ESP_LOGI(TAG, "fan speed %u.%03u, target %u [RPS], duty %u, control %s%s", (control.tachoMilli / 1000U), (control.tachoMilli % 1000U), control.targetTacho, control.duty,
+        (control.isControlActive) ? "ON" : "OFF", (control.isLimited) ? " limited" : "");
+    ESP_LOGI(TAG, "fan pwm %u Hz, %u bits, sweep %d", control.pwmFreqHz, control.pwmResolutionBits, FanGetPwmSweepState());
+
+    FanFilterLoad_t filterLoad = {};
+    FanGetFilterLoad(&filterLoad);
+    ESP_LOGI(TAG, "hepa load %u%% %s, duty change %d%%, samples %u", filterLoad.loadPercent, (filterLoad.isEstimated) ? "estimated" : "learning",
+        filterLoad.dutyChangePercent, filterLoad.samples);
+
     uint32_t volt = UvLampGetMeanMiliVolt(UV_LAMP_1);
     ESP_LOGI(TAG, "Uv lamp 1 ballast mean %u [mV]", volt);
 
     volt = UvLampGetMeanMiliVolt(UV_LAMP_2);
     ESP_LOGI(TAG, "Uv lamp 2 ballast mean %u [mV]", volt);
 
+    I2cBusDriverPrintStats();
+    TouchPrintStats();
+
     ESP_LOGI(TAG, "");
 }
 
@@ -590,6 +610,9 @@ static void RestoreFactoryDeviceSetting(SettingDevice_t* setting)
     res &= WifiSettingSave(&wifiSetting);
     ESP_LOGI(TAG, "clear wifi setting %d", res);
 
+    res &= OtaWebAssetsInvalidate();
+    ESP_LOGI(TAG, "back to base web assets %d", res);
+
     vTaskDelay(1000U);
 
     McuDriverDeviceSafeRestart();
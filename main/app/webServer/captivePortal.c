@@ -0,0 +1,180 @@
+/**
+ * @file captivePortal.c
+ *
+ * @brief Web Server captive portal source file
+ *
+ * Clients of the access point get the device as dns server (dhcp) and every
+ * name resolves to the device. The phone connectivity check then reaches the
+ * web server, is redirected to the device page and the phone shows it as
+ * the sign-in page right after joining the network.
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "captivePortal.h"
+#include "config.h"
+
+#include <esp_log.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <lwip/sockets.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "utils/captiveDns/captiveDns.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define CAPTIVE_PORTAL_STACK_SIZE (3U * 1024U)
+#define CAPTIVE_PORTAL_TASK_PRIORITY (2U)
+#define CAPTIVE_PORTAL_RETRY_DELAY_MS (1000U)
+
+#define HOST_MAX_LEN (64U)
+#define LOCATION_MAX_LEN (32U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+static const char *TAG = "captive_portal";
+
+static TaskHandle_t sTaskHandle;
+static uint32_t sApIp;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Dns responder task
+ *  @param arg unused
+ */
+static void CaptivePortalDnsTask(void *arg);
+
+/** @brief Answer dns queries until socket error
+ *  @param sock bound udp socket
+ */
+static void ServeDns(int sock);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool CaptivePortalInit(uint32_t apIp)
+{
+  sApIp = apIp;
+
+  if (sTaskHandle == NULL) {
+    BaseType_t res = xTaskCreate(CaptivePortalDnsTask, "CaptiveDnsTask", CAPTIVE_PORTAL_STACK_SIZE, NULL, CAPTIVE_PORTAL_TASK_PRIORITY, &sTaskHandle);
+    if (res != pdPASS) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CaptivePortalRedirect(httpd_req_t *req)
+{
+  struct sockaddr_in localAddr = {};
+  socklen_t addrLen = sizeof(localAddr);
+  char host[HOST_MAX_LEN] = {};
+  char apIpStr[INET_ADDRSTRLEN] = {};
+  char location[LOCATION_MAX_LEN] = {};
+
+  // clients of the station interface use the device address they know
+  int sockfd = httpd_req_to_sockfd(req);
+  if ((getsockname(sockfd, (struct sockaddr *)&localAddr, &addrLen) != 0) ||
+      (localAddr.sin_family != AF_INET) || (localAddr.sin_addr.s_addr != sApIp)) {
+    return false;
+  }
+
+  inet_ntoa_r(localAddr.sin_addr, apIpStr, sizeof(apIpStr));
+
+  // no host header is an old client, the page is served as usual
+  if (httpd_req_get_hdr_value_str(req, "Host", host, sizeof(host)) != ESP_OK) {
+    return false;
+  }
+
+  char *port = strchr(host, ':');
+  if (port != NULL) {
+    *port = '\0';
+  }
+
+  if (strcmp(host, apIpStr) == 0) {
+    return false;
+  }
+
+  ESP_LOGI(TAG, "redirect %s%s", host, req->uri);
+
+  snprintf(location, sizeof(location), "http://%s/", apIpStr);
+  httpd_resp_set_status(req, "302 Found");
+  httpd_resp_set_hdr(req, "Location", location);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+  httpd_resp_send(req, NULL, 0);
+
+  return true;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void CaptivePortalDnsTask(void *arg)
+{
+  (void)arg;
+
+  while (1) {
+    struct sockaddr_in addr = {
+      .sin_family = AF_INET,
+      .sin_port = htons(CAPTIVE_DNS_PORT),
+      .sin_addr.s_addr = sApIp,
+    };
+
+    // bound to the access point address, station network dns is not disturbed
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+      ESP_LOGE(TAG, "socket error %d", errno);
+    } else if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+      ESP_LOGE(TAG, "bind error %d", errno);
+    } else {
+      ESP_LOGI(TAG, "dns responder started");
+      ServeDns(sock);
+    }
+
+    if (sock >= 0) {
+      close(sock);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(CAPTIVE_PORTAL_RETRY_DELAY_MS));
+  }
+}
+
+static void ServeDns(int sock)
+{
+  uint8_t query[CAPTIVE_DNS_MAX_PACKET_LEN];
+  uint8_t response[CAPTIVE_DNS_MAX_PACKET_LEN];
+
+  while (1) {
+    struct sockaddr_in client = {};
+    socklen_t clientLen = sizeof(client);
+    uint32_t responseLen = 0;
+
+    int len = recvfrom(sock, query, sizeof(query), 0, (struct sockaddr *)&client, &clientLen);
+    if (len < 0) {
+      ESP_LOGW(TAG, "recv error %d", errno);
+      return;
+    }
+
+    if (CaptiveDnsBuildResponse(query, len, (const uint8_t *)&sApIp, response, sizeof(response), &responseLen)) {
+      sendto(sock, response, responseLen, 0, (struct sockaddr *)&client, clientLen);
+    }
+  }
+}
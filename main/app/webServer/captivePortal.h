@@ -0,0 +1,35 @@
+/**
+ * @file captivePortal.h
+ *
+ * @brief Web Server captive portal header file
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <esp_http_server.h>
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Start dns responder on the access point interface, task survives web server restart
+ *  @param apIp access point ipv4 address, network order
+ *  @return true if success
+ */
+bool CaptivePortalInit(uint32_t apIp);
+
+/** @brief Redirect request of the access point client to the device page, if it is addressed to other host.
+ *         Phone connectivity checks (e.g. /generate_204, /hotspot-detect.html) end here and open the page.
+ *  @param req HTTP request data structure
+ *  @return true if redirect is sent
+ */
+bool CaptivePortalRedirect(httpd_req_t *req);
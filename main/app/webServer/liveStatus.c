@@ -0,0 +1,442 @@
+/**
+ * @file liveStatus.c
+ *
+ * @brief Web Server live status channel source file
+ *
+ * Clients connected to the websocket get the full status first, then only
+ * the changed fields whenever settings or alarms change. Messages are
+ * throttled, clients never poll.
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "liveStatus.h"
+#include "config.h"
+
+#include <esp_log.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "cJSON.h"
+
+#include "setting.h"
+#include "common/messageParserAndSerializer.h"
+#include "common/messageType.h"
+
+#include "timeDriver/timeDriver.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define LIVE_STATUS_MAX_CLIENTS (3U)
+#define LIVE_STATUS_POLL_PERIOD_MS (100U)
+#define LIVE_STATUS_MIN_SEND_PERIOD_MS (500U)         // throttling, at most 2 messages per second
+#define LIVE_STATUS_MAX_JSON_LENGTH (MESSAGE_TYPE_MAX_DEVICE_INFO_JSON_LENGTH + 64U)
+#define LIVE_STATUS_MAX_RX_LEN (64U)                  // clients don't send anything meaningful
+#define LIVE_STATUS_MUTEX_TIMEOUT_MS (1000U)
+
+#define LIVE_STATUS_STACK_SIZE (4U * 1024U)
+#define LIVE_STATUS_TASK_PRIORITY (2U)
+
+#define NO_CLIENT (-1)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef struct {
+  int fd;
+  bool isNew;                 // waits for the full status
+} liveStatusClient_t;
+
+typedef struct {
+  httpd_handle_t server;
+  int fd;
+  size_t len;
+  char payload[];
+} liveStatusMessage_t;
+
+static const char *TAG = "live_status";
+
+static httpd_handle_t sServer;
+static TaskHandle_t sTaskHandle;
+static SemaphoreHandle_t sClientsMutex;
+static liveStatusClient_t sClients[LIVE_STATUS_MAX_CLIENTS];
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Websocket handler, handshake registers the client, received frames are dropped
+ *  @param req HTTP request data structure
+ *  @return ESP_OK if succes
+ */
+static esp_err_t LiveStatusHandler(httpd_req_t *req);
+
+/** @brief Streaming task
+ *  @param arg unused
+ */
+static void LiveStatusTask(void *arg);
+
+/** @brief Add client, slots of closed sockets are reused. Called from the httpd task
+ *  @param fd client socket
+ *  @return true if client added
+ */
+static bool AddClient(int fd);
+
+/** @brief Remove client
+ *  @param fd client socket
+ */
+static void RemoveClient(int fd);
+
+/** @brief Get clients count
+ *  @param newCount [out] clients waiting for the full status
+ *  @return all clients count
+ */
+static uint8_t GetClientsCount(uint8_t *newCount);
+
+/** @brief Create status json from the current settings
+ *  @return status json, NULL if no memory
+ */
+static cJSON *CreateStatusJson(void);
+
+/** @brief Create json with the fields of current status which differ from previous status
+ *  @param previous previous status
+ *  @param current current status
+ *  @return delta json, NULL if no memory
+ */
+static cJSON *CreateDeltaJson(const cJSON *previous, const cJSON *current);
+
+/** @brief Send json to clients
+ *  @param json json to send
+ *  @param isNew true - send to new clients only, false - send to the rest
+ */
+static void SendToClients(const cJSON *json, bool isNew);
+
+/** @brief Send websocket frame, queued by httpd_queue_work and executed in the httpd task
+ *  @param arg liveStatusMessage_t, freed after sending
+ */
+static void SendFrameWork(void *arg);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool LiveStatusInit(httpd_handle_t server)
+{
+  if (sClientsMutex == NULL) {
+    sClientsMutex = xSemaphoreCreateMutex();
+    if (sClientsMutex == NULL) {
+      return false;
+    }
+  }
+
+  for (uint8_t idx = 0; idx < LIVE_STATUS_MAX_CLIENTS; ++idx) {
+    sClients[idx].fd = NO_CLIENT;
+  }
+
+  httpd_uri_t liveStatusUri =
+  {
+    .uri = LIVE_STATUS_URI,
+    .method = HTTP_GET,
+    .handler = LiveStatusHandler,
+    .is_websocket = true
+  };
+  if (httpd_register_uri_handler(server, &liveStatusUri) != ESP_OK) {
+    ESP_LOGE(TAG, "can't register %s", LIVE_STATUS_URI);
+    return false;
+  }
+
+  sServer = server;
+
+  // task survives web server restart
+  if (sTaskHandle == NULL) {
+    BaseType_t res = xTaskCreate(LiveStatusTask, "LiveStatusTask", LIVE_STATUS_STACK_SIZE, NULL, LIVE_STATUS_TASK_PRIORITY, &sTaskHandle);
+    if (res != pdPASS) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void LiveStatusDeinit(void)
+{
+  if (xSemaphoreTake(sClientsMutex, LIVE_STATUS_MUTEX_TIMEOUT_MS) == pdTRUE) {
+    sServer = NULL;
+
+    for (uint8_t idx = 0; idx < LIVE_STATUS_MAX_CLIENTS; ++idx) {
+      sClients[idx].fd = NO_CLIENT;
+    }
+
+    xSemaphoreGive(sClientsMutex);
+  }
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static esp_err_t LiveStatusHandler(httpd_req_t *req)
+{
+  if (req->method == HTTP_GET) {
+    // handshake done
+    if (AddClient(httpd_req_to_sockfd(req)) == false) {
+      ESP_LOGW(TAG, "too many clients");
+      return ESP_FAIL;
+    }
+
+    return ESP_OK;
+  }
+
+  uint8_t buf[LIVE_STATUS_MAX_RX_LEN] = {};
+  httpd_ws_frame_t frame = {};
+
+  // get frame length first
+  esp_err_t err = httpd_ws_recv_frame(req, &frame, 0);
+  if ((err != ESP_OK) || (frame.len > sizeof(buf))) {
+    return ESP_FAIL;
+  }
+
+  frame.payload = buf;
+  return httpd_ws_recv_frame(req, &frame, frame.len);
+}
+
+static void LiveStatusTask(void *arg)
+{
+  (void)arg;
+
+  cJSON *lastStatus = NULL;
+  uint32_t lastGeneration = 0;
+  int64_t lastSendTime = 0;
+
+  for (;;) {
+    vTaskDelay(LIVE_STATUS_POLL_PERIOD_MS / portTICK_PERIOD_MS);
+
+    uint8_t newCount = 0;
+    if (GetClientsCount(&newCount) == 0) {
+      // nobody listens, next client gets a fresh status
+      cJSON_Delete(lastStatus);
+      lastStatus = NULL;
+      continue;
+    }
+
+    uint32_t generation = SettingGetGeneration();
+    bool isChanged = ((lastStatus == NULL) || (generation != lastGeneration));
+
+    if (((isChanged == false) && (newCount == 0)) ||
+        (TimeDriverHasTimeElapsed(lastSendTime, LIVE_STATUS_MIN_SEND_PERIOD_MS) == false)) {
+      continue;
+    }
+
+    cJSON *status = lastStatus;
+    if (isChanged == true) {
+      status = CreateStatusJson();
+      if (status == NULL) {
+        continue;
+      }
+    }
+
+    if ((lastStatus != NULL) && (status != lastStatus)) {
+      cJSON *delta = CreateDeltaJson(lastStatus, status);
+      if ((delta != NULL) && (delta->child != NULL)) {
+        SendToClients(delta, false);
+      }
+      cJSON_Delete(delta);
+      cJSON_Delete(lastStatus);
+    }
+
+    if (newCount > 0) {
+      SendToClients(status, true);
+    }
+
+    lastStatus = status;
+    lastGeneration = generation;
+    lastSendTime = TimeDriverGetSystemTickMs();
+  }
+}
+
+static bool AddClient(int fd)
+{
+  bool res = false;
+
+  if (xSemaphoreTake(sClientsMutex, LIVE_STATUS_MUTEX_TIMEOUT_MS) == pdTRUE) {
+    liveStatusClient_t *freeSlot = NULL;
+
+    for (uint8_t idx = 0; idx < LIVE_STATUS_MAX_CLIENTS; ++idx) {
+      liveStatusClient_t *client = &sClients[idx];
+
+      // socket number can be reused by a new connection
+      if ((client->fd == fd) || ((client->fd != NO_CLIENT) && (httpd_ws_get_fd_info(sServer, client->fd) != HTTPD_WS_CLIENT_WEBSOCKET))) {
+        client->fd = NO_CLIENT;
+      }
+
+      if ((client->fd == NO_CLIENT) && (freeSlot == NULL)) {
+        freeSlot = client;
+      }
+    }
+
+    if (freeSlot != NULL) {
+      freeSlot->fd = fd;
+      freeSlot->isNew = true;
+      res = true;
+    }
+
+    xSemaphoreGive(sClientsMutex);
+  }
+
+  return res;
+}
+
+static void RemoveClient(int fd)
+{
+  if (xSemaphoreTake(sClientsMutex, LIVE_STATUS_MUTEX_TIMEOUT_MS) == pdTRUE) {
+    for (uint8_t idx = 0; idx < LIVE_STATUS_MAX_CLIENTS; ++idx) {
+      if (sClients[idx].fd == fd) {
+        sClients[idx].fd = NO_CLIENT;
+      }
+    }
+
+    xSemaphoreGive(sClientsMutex);
+  }
+}
+
+static uint8_t GetClientsCount(uint8_t *newCount)
+{
+  uint8_t count = 0;
+  *newCount = 0;
+
+  if (xSemaphoreTake(sClientsMutex, LIVE_STATUS_MUTEX_TIMEOUT_MS) == pdTRUE) {
+    for (uint8_t idx = 0; idx < LIVE_STATUS_MAX_CLIENTS; ++idx) {
+      if (sClients[idx].fd != NO_CLIENT) {
+        count++;
+        *newCount += sClients[idx].isNew;
+      }
+    }
+
+    xSemaphoreGive(sClientsMutex);
+  }
+
+  return count;
+}
+
+static cJSON *CreateStatusJson(void)
+{
+  SettingDevice_t setting = {};
+  messageTypeDeviceInfo_t info = {};
+  uint16_t alarmError = 0;
+  uint8_t alarmWarning = 0;
+  uint8_t timersStatus = 0;
+
+  cJSON *jsonRoot = cJSON_CreateObject();
+  if (jsonRoot == NULL) {
+    return NULL;
+  }
+
+  SettingGet(&setting);
+  MessageTypeCreateDeviceInfo(&info, &setting);
+  MessageParserAndSerializerCreateDeviceInfoJson(jsonRoot, &info);
+
+  // would make every delta non empty
+  cJSON_DeleteItemFromObjectCaseSensitive(jsonRoot, "Timestamp");
+
+  // alarm bit fields in SettingAlarmError_t, SettingAlarmWarning_t, SettingTimersStatus_t order
+  memcpy(&alarmError, &setting.alarmError, sizeof(setting.alarmError));
+  memcpy(&alarmWarning, &setting.alarmWarning, sizeof(setting.alarmWarning));
+  memcpy(&timersStatus, &setting.timersStatus, sizeof(setting.timersStatus));
+
+  cJSON_AddNumberToObject(jsonRoot, "alarmError", alarmError);
+  cJSON_AddNumberToObject(jsonRoot, "alarmWarning", alarmWarning);
+  cJSON_AddNumberToObject(jsonRoot, "timersStatus", timersStatus);
+
+  return jsonRoot;
+}
+
+static cJSON *CreateDeltaJson(const cJSON *previous, const cJSON *current)
+{
+  cJSON *delta = cJSON_CreateObject();
+  if (delta == NULL) {
+    return NULL;
+  }
+
+  const cJSON *item = NULL;
+  cJSON_ArrayForEach(item, current) {
+    const cJSON *previousItem = cJSON_GetObjectItemCaseSensitive(previous, item->string);
+
+    if ((previousItem == NULL) || (cJSON_Compare(item, previousItem, true) == false)) {
+      cJSON_AddItemToObject(delta, item->string, cJSON_Duplicate(item, true));
+    }
+  }
+
+  return delta;
+}
+
+static void SendToClients(const cJSON *json, bool isNew)
+{
+  char jsonStr[LIVE_STATUS_MAX_JSON_LENGTH] = {};
+
+  if (cJSON_PrintPreallocated((cJSON *)json, jsonStr, sizeof(jsonStr), false) == false) {
+    ESP_LOGE(TAG, "Live status Json size is too big");
+    return;
+  }
+
+  size_t len = strlen(jsonStr);
+
+  if (xSemaphoreTake(sClientsMutex, LIVE_STATUS_MUTEX_TIMEOUT_MS) == pdTRUE) {
+    for (uint8_t idx = 0; idx < LIVE_STATUS_MAX_CLIENTS; ++idx) {
+      liveStatusClient_t *client = &sClients[idx];
+
+      if ((client->fd == NO_CLIENT) || (client->isNew != isNew)) {
+        continue;
+      }
+
+      liveStatusMessage_t *message = malloc(sizeof(liveStatusMessage_t) + len);
+      if (message == NULL) {
+        break;
+      }
+
+      message->server = sServer;
+      message->fd = client->fd;
+      message->len = len;
+      memcpy(message->payload, jsonStr, len);
+
+      if (httpd_queue_work(sServer, SendFrameWork, message) != ESP_OK) {
+        free(message);
+        continue;
+      }
+
+      client->isNew = false;
+    }
+
+    xSemaphoreGive(sClientsMutex);
+  }
+}
+
+static void SendFrameWork(void *arg)
+{
+  liveStatusMessage_t *message = (liveStatusMessage_t *)arg;
+
+  httpd_ws_frame_t frame = {
+    .final = true,
+    .type = HTTPD_WS_TYPE_TEXT,
+    .payload = (uint8_t *)message->payload,
+    .len = message->len
+  };
+
+  if ((httpd_ws_get_fd_info(message->server, message->fd) != HTTPD_WS_CLIENT_WEBSOCKET) ||
+      (httpd_ws_send_frame_async(message->server, message->fd, &frame) != ESP_OK)) {
+    ESP_LOGI(TAG, "client %d gone", message->fd);
+    RemoveClient(message->fd);
+  }
+
+  free(message);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file liveStatus.h
+ *
+ * @brief Web Server live status channel header file
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <esp_http_server.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define LIVE_STATUS_URI "/ws/status"
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Register live status websocket on the web server and start streaming task
+ *  @param server web server handle
+ *  @return true if success
+ */
+bool LiveStatusInit(httpd_handle_t server);
+
+/** @brief Stop streaming, must be called before the web server is stopped
+ */
+void LiveStatusDeinit(void);
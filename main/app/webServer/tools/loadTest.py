@@ -0,0 +1,154 @@
+#!/usr/bin/env python
+#
+# @file loadTest.py
+#
+# @brief Load test of the device web server run from a host connected to the
+#        device access point. Pollers request /deviceInfo like the UI does while
+#        downloaders fetch big static files, latency of the polling is reported.
+#        First a file and /deviceInfo are requested pipelined on one keep-alive
+#        socket, both responses must come whole and in order.
+#
+# Usage: loadTest.py <host[:port]> [seconds] [pollers] [downloaders] [file uri]
+#
+# @copyright 2021 Fideltronik R&D - all rights reserved.
+
+import http.client
+import socket
+import sys
+import threading
+import time
+
+DEFAULT_PORT = 3500
+POLL_URI = '/deviceInfo'
+POLL_PERIOD_S = 0.5
+TIMEOUT_S = 10
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.latencies = []
+        self.errors = 0
+        self.bytes = 0
+
+    def add(self, latency, size):
+        with self.lock:
+            self.latencies.append(latency)
+            self.bytes += size
+
+    def error(self):
+        with self.lock:
+            self.errors += 1
+
+
+def request(host, port, uri, stats):
+    start = time.monotonic()
+    try:
+        conn = http.client.HTTPConnection(host, port, timeout=TIMEOUT_S)
+        conn.request('GET', uri, headers={'Accept-Encoding': 'gzip'})
+        response = conn.getresponse()
+        size = len(response.read())
+        conn.close()
+        if response.status not in (200, 304):
+            stats.error()
+            return
+        stats.add(time.monotonic() - start, size)
+    except (OSError, http.client.HTTPException):
+        stats.error()
+
+
+def readResponse(stream):
+    status = int(stream.readline().split()[1])
+    headers = {}
+    while True:
+        line = stream.readline().strip()
+        if not line:
+            break
+        name, _, value = line.decode().partition(':')
+        headers[name.strip().lower()] = value.strip()
+
+    if headers.get('transfer-encoding') != 'chunked':
+        return status, stream.read(int(headers.get('content-length', 0)))
+
+    body = b''
+    while True:
+        size = int(stream.readline().strip(), 16)
+        if size == 0:
+            stream.readline()
+            return status, body
+        body += stream.read(size)
+        stream.readline()
+
+
+def pipelined(host, port, uri):
+    template = 'GET {} HTTP/1.1\r\nHost: {}\r\nAccept-Encoding: gzip\r\n\r\n'
+    try:
+        with socket.create_connection((host, port), timeout=TIMEOUT_S) as sock:
+            sock.sendall((template.format(uri, host) + template.format(POLL_URI, host)).encode())
+            stream = sock.makefile('rb')
+            fileStatus, _ = readResponse(stream)
+            pollStatus, body = readResponse(stream)
+    except (OSError, ValueError, IndexError):
+        return False
+
+    return (fileStatus == 200) and (pollStatus == 200) and body.startswith(b'{')
+
+
+def worker(host, port, uri, period, deadline, stats):
+    while time.monotonic() < deadline:
+        started = time.monotonic()
+        request(host, port, uri, stats)
+        time.sleep(max(0.0, period - (time.monotonic() - started)))
+
+
+def percentile(values, pct):
+    if not values:
+        return float('nan')
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+def report(name, stats, seconds):
+    lat = [x * 1000 for x in stats.latencies]
+    print('{:<10} requests {:5d}  errors {:3d}  p50 {:7.1f} ms  p95 {:7.1f} ms  max {:7.1f} ms  {:7.1f} kB/s'.format(
+        name, len(lat), stats.errors, percentile(lat, 50), percentile(lat, 95),
+        max(lat) if lat else float('nan'), stats.bytes / 1024 / seconds))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: loadTest.py <host[:port]> [seconds] [pollers] [downloaders] [file uri]')
+        return 1
+
+    host, _, port = sys.argv[1].partition(':')
+    port = int(port) if port else DEFAULT_PORT
+    seconds = float(sys.argv[2]) if len(sys.argv) > 2 else 30
+    pollers = int(sys.argv[3]) if len(sys.argv) > 3 else 3
+    downloaders = int(sys.argv[4]) if len(sys.argv) > 4 else 2
+    fileUri = sys.argv[5] if len(sys.argv) > 5 else '/'
+
+    isPipelined = pipelined(host, port, fileUri)
+    print('pipelined  {} + {} {}'.format(fileUri, POLL_URI, 'ok' if isPipelined else 'FAILED'))
+
+    pollStats = Stats()
+    fileStats = Stats()
+    deadline = time.monotonic() + seconds
+
+    threads = [threading.Thread(target=worker, args=(host, port, POLL_URI, POLL_PERIOD_S, deadline, pollStats))
+               for _ in range(pollers)]
+    threads += [threading.Thread(target=worker, args=(host, port, fileUri, 0, deadline, fileStats))
+                for _ in range(downloaders)]
+
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    report(POLL_URI, pollStats, seconds)
+    report(fileUri, fileStats, seconds)
+
+    return 1 if (pollStats.errors or fileStats.errors or not isPipelined) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
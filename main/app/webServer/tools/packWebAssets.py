@@ -0,0 +1,120 @@
+#!/usr/bin/env python
+#
+# @file packWebAssets.py
+#
+# @brief Packs web assets into a read-only archive served directly from
+#        memory mapped flash (see middleware/utils/webArchive/webArchive.h).
+#        Compressible files get a gzip variant stored as <name>.gz
+#        A bundle of changed files for the www_ota partition records the crc of
+#        the base archive it is built on, the device ignores it over other ones.
+#
+# Usage: packWebAssets.py <source dir> <output file> [max size] [base archive]
+#
+# @copyright 2021 Fideltronik R&D - all rights reserved.
+
+import gzip
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = 0x41575757  # "WWWA"
+VERSION = 2
+NAME_MAX_LEN = 48  # including terminating zero
+
+HEADER_FORMAT = '<IHHIII'
+ENTRY_FORMAT = '<{}sIIII'.format(NAME_MAX_LEN)
+DATA_ALIGNMENT = 4
+
+# Already compressed formats (woff, woff2, png, ico) are not worth it
+COMPRESSIBLE_EXTENSIONS = ('.html', '.js', '.css', '.svg', '.json', '.txt')
+
+# gzip variant is kept only if it saves at least 10 %
+MAX_COMPRESSION_RATIO = 0.9
+
+
+def collect_files(src_dir):
+    files = {}
+
+    for root, _, names in os.walk(src_dir):
+        for name in names:
+            path = os.path.join(root, name)
+            archive_name = '/' + os.path.relpath(path, src_dir).replace(os.sep, '/')
+
+            with open(path, 'rb') as src:
+                data = src.read()
+            files[archive_name] = data
+
+            if not name.lower().endswith(COMPRESSIBLE_EXTENSIONS):
+                continue
+
+            # mtime = 0 keeps the archive reproducible
+            compressed = gzip.compress(data, compresslevel=9, mtime=0)
+            if len(compressed) <= len(data) * MAX_COMPRESSION_RATIO:
+                files[archive_name + '.gz'] = compressed
+
+    return files
+
+
+def align(size):
+    return (size + DATA_ALIGNMENT - 1) // DATA_ALIGNMENT * DATA_ALIGNMENT
+
+
+def read_crc(archive_path):
+    with open(archive_path, 'rb') as src:
+        magic, version, _, _, crc, _ = struct.unpack(HEADER_FORMAT, src.read(struct.calcsize(HEADER_FORMAT)))
+
+    if magic != MAGIC or version != VERSION:
+        raise ValueError('not a web assets archive: {}'.format(archive_path))
+
+    return crc
+
+
+def pack(files, base_crc):
+    # the device looks files up by binary search, strcmp order
+    names = sorted(files.keys(), key=lambda name: name.encode('utf-8'))
+
+    offset = struct.calcsize(HEADER_FORMAT) + len(names) * struct.calcsize(ENTRY_FORMAT)
+    table = b''
+    data = b''
+
+    for name in names:
+        encoded_name = name.encode('utf-8')
+        if len(encoded_name) >= NAME_MAX_LEN:
+            raise ValueError('file name too long: {}'.format(name))
+
+        content = files[name]
+        padding = align(len(content)) - len(content)
+
+        table += struct.pack(ENTRY_FORMAT, encoded_name, offset + len(data), len(content),
+                             zlib.crc32(content) & 0xFFFFFFFF, 0)
+        data += content + b'\0' * padding
+
+    body = table + data
+    size = struct.calcsize(HEADER_FORMAT) + len(body)
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(names), size, zlib.crc32(body) & 0xFFFFFFFF, base_crc)
+
+    return header + body
+
+
+def main():
+    if len(sys.argv) not in (3, 4, 5):
+        print('Usage: {} <source dir> <output file> [max size] [base archive]'.format(sys.argv[0]))
+        return 1
+
+    files = collect_files(sys.argv[1])
+    archive = pack(files, read_crc(sys.argv[4]) if len(sys.argv) == 5 else 0)
+
+    if len(sys.argv) >= 4 and len(archive) > int(sys.argv[3], 0):
+        print('archive size {} exceeds {}'.format(len(archive), sys.argv[3]))
+        return 1
+
+    with open(sys.argv[2], 'wb') as out:
+        out.write(archive)
+
+    print('packed {} files, {} bytes'.format(len(files), len(archive)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,269 @@
+/**
+ * @file webMetrics.c
+ *
+ * @brief Web Server per endpoint metrics source file
+ *
+ * Measured handlers are registered with a wrapper taking the handler time.
+ * Sessions send through an override counting the bytes for the endpoint
+ * last requested on the socket, headers included. Latency is the time the httpd task was busy
+ * with the handler, other clients wait for it.
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "webMetrics.h"
+#include "config.h"
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <lwip/sockets.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define ENDPOINT_NAME_MAX_LEN (32U)
+#define METRICS_LINE_MAX_LEN (128U)
+#define METRICS_HEADER "# endpoint count errors bytes mean_us p95_us max_us hist_ms<1,2,4,8,16,32,64,128,256,inf\n"
+#define METRICS_CACHE_FORMAT "# cache hits %u misses %u hit_rate %u%% bytes %u\n"
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef struct {
+  httpd_uri_t uri;                      // original handler
+  char name[ENDPOINT_NAME_MAX_LEN];
+  requestMetrics_t metrics;
+} webMetricsEndpoint_t;
+
+static const char *TAG = "web_metrics";
+
+static webMetricsEndpoint_t sEndpoints[CFG_WEB_METRICS_MAX_ENDPOINTS];
+static uint8_t sEndpointsCount;
+
+// endpoint last requested on the socket, indexed by socket number
+static webMetricsEndpoint_t *sSocketEndpoint[CONFIG_LWIP_MAX_SOCKETS];
+
+// read by the /metrics handler on the httpd task, the same task uses the cache
+static const lruCache_t *sCache;
+
+// metrics are updated by the httpd task and read by other tasks
+static portMUX_TYPE sLock = portMUX_INITIALIZER_UNLOCKED;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Run original handler and record its time and result
+ *  @param req HTTP request data structure, user_ctx points to the endpoint
+ *  @return handler result
+ */
+static esp_err_t MeteredHandler(httpd_req_t *req);
+
+/** @brief Send metrics of all endpoints as text, one line per endpoint
+ *  @param req HTTP request data structure
+ *  @return ESP_OK if sent
+ */
+static esp_err_t MetricsGetHandler(httpd_req_t *req);
+
+/** @brief Session send function counting bytes sent, replaces the httpd default send
+ *  @param hd web server handle
+ *  @param sockfd session socket descriptor
+ *  @param buf data
+ *  @param bufLen data length
+ *  @param flags send flags
+ *  @return bytes sent or HTTPD_SOCK_ERR_x
+ */
+static int MeteredSend(httpd_handle_t hd, int sockfd, const char *buf, size_t bufLen, int flags);
+
+/** @brief Get socket table slot
+ *  @param sockfd socket descriptor
+ *  @return pointer to slot, NULL if socket is out of range
+ */
+static webMetricsEndpoint_t **GetSocketSlot(int sockfd);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool WebMetricsInit(httpd_handle_t server)
+{
+  portENTER_CRITICAL(&sLock);
+  sEndpointsCount = 0;
+  memset(sSocketEndpoint, 0, sizeof(sSocketEndpoint));
+  portEXIT_CRITICAL(&sLock);
+
+  httpd_uri_t metricsGet =
+  {
+    .uri = "/metrics",
+    .method = HTTP_GET,
+    .handler = MetricsGetHandler
+  };
+
+  return (WebMetricsRegisterUri(server, &metricsGet) == ESP_OK);
+}
+
+esp_err_t WebMetricsRegisterUri(httpd_handle_t server, const httpd_uri_t *uri)
+{
+  if (sEndpointsCount >= CFG_WEB_METRICS_MAX_ENDPOINTS) {
+    ESP_LOGW(TAG, "%s not measured, table full", uri->uri);
+    return httpd_register_uri_handler(server, uri);
+  }
+
+  webMetricsEndpoint_t *endpoint = &sEndpoints[sEndpointsCount];
+
+  endpoint->uri = *uri;
+  snprintf(endpoint->name, sizeof(endpoint->name), "%s %s", http_method_str(uri->method), uri->uri);
+  RequestMetricsInit(&endpoint->metrics, endpoint->name);
+
+  httpd_uri_t metered = *uri;
+  metered.handler = MeteredHandler;
+  metered.user_ctx = endpoint;
+
+  esp_err_t err = httpd_register_uri_handler(server, &metered);
+  if (err == ESP_OK) {
+    sEndpointsCount += 1;
+  }
+
+  return err;
+}
+
+void WebMetricsOpenSession(httpd_handle_t server, int sockfd)
+{
+  webMetricsEndpoint_t **slot = GetSocketSlot(sockfd);
+  if (slot == NULL) {
+    return;
+  }
+
+  // socket number is reused, nothing is counted until the first request
+  *slot = NULL;
+  httpd_sess_set_send_override(server, sockfd, MeteredSend);
+}
+
+void WebMetricsSetCache(const lruCache_t *cache)
+{
+  sCache = cache;
+}
+
+uint8_t WebMetricsGetEndpointsCount(void)
+{
+  return sEndpointsCount;
+}
+
+bool WebMetricsGet(uint8_t endpoint, requestMetrics_t *metrics)
+{
+  if (endpoint >= sEndpointsCount) {
+    return false;
+  }
+
+  portENTER_CRITICAL(&sLock);
+  *metrics = sEndpoints[endpoint].metrics;
+  portEXIT_CRITICAL(&sLock);
+
+  return true;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static esp_err_t MeteredHandler(httpd_req_t *req)
+{
+  webMetricsEndpoint_t *endpoint = req->user_ctx;
+
+  webMetricsEndpoint_t **slot = GetSocketSlot(httpd_req_to_sockfd(req));
+  if (slot != NULL) {
+    *slot = endpoint;
+  }
+
+  req->user_ctx = endpoint->uri.user_ctx;
+
+  int64_t start = esp_timer_get_time();
+  esp_err_t err = endpoint->uri.handler(req);
+  uint32_t latencyUs = (uint32_t)(esp_timer_get_time() - start);
+
+  portENTER_CRITICAL(&sLock);
+  RequestMetricsRecord(&endpoint->metrics, latencyUs, (err != ESP_OK));
+  portEXIT_CRITICAL(&sLock);
+
+  return err;
+}
+
+static esp_err_t MetricsGetHandler(httpd_req_t *req)
+{
+  char buf[METRICS_LINE_MAX_LEN];
+  size_t len = 0;
+
+  httpd_resp_set_type(req, "text/plain");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+  esp_err_t err = httpd_resp_send_chunk(req, METRICS_HEADER, strlen(METRICS_HEADER));
+
+  for (uint8_t idx = 0; (idx < sEndpointsCount) && (err == ESP_OK); ++idx) {
+    requestMetrics_t metrics;
+    WebMetricsGet(idx, &metrics);
+
+    if (RequestMetricsFormat(&metrics, buf, sizeof(buf), &len) == true) {
+      err = httpd_resp_send_chunk(req, buf, len);
+    }
+  }
+
+  // comment line, endpoint line numbers don't change
+  if ((err == ESP_OK) && (sCache != NULL)) {
+    len = snprintf(buf, sizeof(buf), METRICS_CACHE_FORMAT, (unsigned int)sCache->hits, (unsigned int)sCache->misses,
+                   (unsigned int)LruCacheGetHitRatePercent(sCache), (unsigned int)sCache->usedBytes);
+    err = httpd_resp_send_chunk(req, buf, len);
+  }
+
+  if (err == ESP_OK) {
+    err = httpd_resp_send_chunk(req, NULL, 0);
+  }
+
+  return err;
+}
+
+static int MeteredSend(httpd_handle_t hd, int sockfd, const char *buf, size_t bufLen, int flags)
+{
+  (void)hd;
+
+  if (buf == NULL) {
+    return HTTPD_SOCK_ERR_INVALID;
+  }
+
+  // same as the httpd default send
+  int ret = send(sockfd, buf, bufLen, flags);
+  if (ret < 0) {
+    return ((errno == EAGAIN) || (errno == EINTR)) ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+  }
+
+  webMetricsEndpoint_t **slot = GetSocketSlot(sockfd);
+  if ((slot != NULL) && (*slot != NULL)) {
+    portENTER_CRITICAL(&sLock);
+    RequestMetricsAddBytes(&(*slot)->metrics, (uint32_t)ret);
+    portEXIT_CRITICAL(&sLock);
+  }
+
+  return ret;
+}
+
+static webMetricsEndpoint_t **GetSocketSlot(int sockfd)
+{
+  int idx = sockfd - LWIP_SOCKET_OFFSET;
+
+  if ((idx < 0) || (idx >= CONFIG_LWIP_MAX_SOCKETS)) {
+    return NULL;
+  }
+
+  return &sSocketEndpoint[idx];
+}
@@ -0,0 +1,61 @@
+/**
+ * @file webMetrics.h
+ *
+ * @brief Web Server per endpoint metrics header file
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <esp_http_server.h>
+
+#include "utils/requestMetrics/requestMetrics.h"
+#include "utils/lruCache/lruCache.h"
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Clear metrics and register GET /metrics, must be called before the wildcard GET handler is registered
+ *  @param server web server handle
+ *  @return true if success
+ */
+bool WebMetricsInit(httpd_handle_t server);
+
+/** @brief Register uri handler measured by the metrics: handler time, result and bytes sent
+ *  @param server web server handle
+ *  @param uri uri handler definition, user_ctx is passed to the handler unchanged
+ *  @return ESP_OK if registered; handler is registered unmeasured if the metrics table is full
+ */
+esp_err_t WebMetricsRegisterUri(httpd_handle_t server, const httpd_uri_t *uri);
+
+/** @brief Count bytes sent on the new session socket, called from the session open callback
+ *  @param server web server handle
+ *  @param sockfd session socket descriptor
+ */
+void WebMetricsOpenSession(httpd_handle_t server, int sockfd);
+
+/** @brief Report hits and misses of the web file cache after the endpoints
+ *  @param cache web file cache, used by the httpd task only
+ */
+void WebMetricsSetCache(const lruCache_t *cache);
+
+/** @brief Get number of measured endpoints
+ *  @return endpoints count
+ */
+uint8_t WebMetricsGetEndpointsCount(void);
+
+/** @brief Get copy of endpoint metrics, safe from any task
+ *  @param endpoint endpoint index in registration order
+ *  @param metrics [out] endpoint metrics
+ *  @return true if endpoint exists
+ */
+bool WebMetricsGet(uint8_t endpoint, requestMetrics_t *metrics);
@@ -13,12 +13,18 @@
  * @copyright 2021 Fideltronik R&D - all rights reserved.
  */
 
+#include "config.h"
 #include "webServer.h"
+#include "liveStatus.h"
+#include "webWorker.h"
+#include "captivePortal.h"
+#include "webMetrics.h"
 #include "esp_eth.h"
 #include "esp_netif.h"
-#include "esp_spiffs.h"
+#include "esp_partition.h"
+#include "esp_spi_flash.h"
 #include "esp_tls_crypto.h"
-#include "esp_vfs.h"
+#include "dhcpserver/dhcpserver.h"
 #include "nvs_flash.h"
 #include <esp_event.h>
 #include <esp_http_server.h>
@@ -27,14 +33,19 @@
 #include <esp_wifi.h>
 #include <nvs_flash.h>
 #include <sys/param.h>
+#include <lwip/sockets.h>
 
 #include <esp_err.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 
 #include "common/messageParserAndSerializer.h"
 #include "common/messageType.h"
+#include "common/messageCache.h"
 
 #include "scheduler/scheduler.h"
 #include "wifi/wifi.h"
@@ -46,6 +57,10 @@
 
 #include "device/alarmHandling.h"
 
+#include "utils/webArchive/webArchive.h"
+#include "utils/deflate/deflate.h"
+#include "utils/lruCache/lruCache.h"
+
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
 *****************************************************************************/
@@ -67,7 +82,6 @@
 
 #define SERVER_PORT 3500
 
-#define WEB_MOUNT_POINT "/www"
 static const char *TAG = "web_server";
 #define REST_CHECK(a, str, goto_tag, ...)                                      \
   do {                                                                         \
@@ -80,8 +94,26 @@ static const char *TAG = "web_server";
 #define CHECK_FILE_EXTENSION(filename, ext)                                    \
   (strcasecmp(&filename[strlen(filename) - strlen(ext)], ext) == 0)
 
-#define FILE_PATH_MAX (ESP_VFS_PATH_MAX + 128)
-#define SCRATCH_BUFSIZE (10240)
+#define GZIP_FILE_EXTENSION ".gz"
+#define ACCEPT_ENCODING_MAX_LEN (128U)
+#define ETAG_MAX_LEN (24U)
+#define CACHE_KEY_MAX_LEN (20U)
+#define FILE_NAME_HASH_LEN (8U)         // vue build adds 8 hex digits hash to the file names: app.57c405b1.js
+
+#define HTTPD_304 "304 Not Modified"
+#define HTTPD_413 "413 Payload Too Large"
+#define REQUEST_RECV_CHUNK_LEN (512U)
+#define REQUEST_RECV_TIMEOUT_RETRIES (3U)
+#define CACHE_CONTROL_IMMUTABLE "public, max-age=31536000, immutable"
+#define CACHE_CONTROL_REVALIDATE "no-cache"
+#define ETAG_WEAK_PREFIX "W/"
+
+#define HTTPD_INTERNAL_SOCKETS (3U)
+#define CAPTIVE_DNS_SOCKETS (1U)
+
+#if (CFG_WEB_SERVER_MAX_SOCKETS + HTTPD_INTERNAL_SOCKETS + CAPTIVE_DNS_SOCKETS + CFG_CLIENT_MAX_SOCKETS) > CONFIG_LWIP_MAX_SOCKETS
+#error "web server, captive dns and client sockets don't fit in CONFIG_LWIP_MAX_SOCKETS"
+#endif
 
 #define AUTH_PASS ("{\"authenticate\":true}")
 #define AUTH_FAIL ("{\"authenticate\":false}")
@@ -89,14 +121,27 @@ static const char *TAG = "web_server";
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
 *****************************************************************************/
-typedef struct rest_server_context {
-  char base_path[ESP_VFS_PATH_MAX + 1];
-  char scratch[SCRATCH_BUFSIZE];
-} __attribute__ ((packed)) rest_server_context_t;
+typedef struct {
+  const char *label;
+  webArchive_t archive;
+  spi_flash_mmap_handle_t mmapHandle;
+  bool isMapped;
+} webAssets_t;
 
 static httpd_handle_t webServerInstance = NULL;
 static SettingDevice_t sDeviceSetting;
 
+// uploaded web assets take precedence over base web assets
+static webAssets_t sWebAssetsOta = { .label = CFG_WEB_ASSETS_OTA_PARTITION_LABEL };
+static webAssets_t sWebAssets = { .label = CFG_WEB_ASSETS_PARTITION_LABEL };
+
+// small files copied from the mapped archive, keyed by content crc and size, used by the httpd task only
+static lruCacheEntry_t sWebCacheEntries[CFG_WEB_CACHE_ENTRIES];
+static lruCache_t sWebCache;
+
+// generation counters start from 0 after reboot, ETags of the json api carry boot id to stay unique
+static uint32_t sBootId;
+
 /*****************************************************************************
                          PRIVATE FUNCTION DECLARATION
 *****************************************************************************/
@@ -149,6 +194,12 @@ static esp_err_t ResetCounterPostHandler(httpd_req_t *req);
  */
 static esp_err_t DeviceUplaodPostHandler(httpd_req_t *req);
 
+/** @brief Post web assets update
+ *  @param req HTTP request data structure
+ *  @return ESP_OK if succes
+ */
+static esp_err_t WebAssetsUplaodPostHandler(httpd_req_t *req);
+
 /** @brief Get device diagnostic
  *  @param req HTTP request data structure
  *  @return ESP_OK if succes
@@ -177,17 +228,152 @@ static esp_err_t RestCommonGetHandler(httpd_req_t *req);
 /** @brief Start Web Server
  *  @return ESP_OK if succes
  */
-esp_err_t StartWebserver(const char *base_path);
+esp_err_t StartWebserver(void);
 
 /** @brief Initialize Access Point
  *  @return ESP_OK if succes
  */
 static esp_err_t WifiInitAp(void);
 
-/** @brief  Initialize filesystem
+/** @brief  Map base and uploaded web assets
+ *  @return ESP_OK if succes
+ */
+static esp_err_t InitWebAssets(void);
+
+/** @brief  Map web assets archive from partition
+ *  @param assets web assets to map
+ *  @param checkCrc verify archive crc
+ *  @return ESP_OK if succes
+ */
+static esp_err_t MapWebAssets(webAssets_t *assets, bool checkCrc);
+
+/** @brief  Unmap web assets archive
+ *  @param assets web assets to unmap
+ */
+static void UnmapWebAssets(webAssets_t *assets);
+
+/** @brief  Map uploaded web assets, only a bundle built on the mapped base web assets is used
+ *  @return ESP_OK if mapped
+ */
+static esp_err_t MapWebAssetsBundle(void);
+
+/** @brief  Find requested file, uploaded web assets are checked first.
+ *  Gzip variant of the file is preferred if the client accepts it
+ *  @param fileName requested file name
+ *  @param isGzipAccepted client accepts gzip content encoding
+ *  @param file [out] file data in memory mapped flash
+ *  @param isGzip [out] true if gzip variant is found
+ *  @return true if file found
+ */
+static bool FindWebFile(const char *fileName, bool isGzipAccepted, webArchiveFile_t *file, bool *isGzip);
+
+/** @brief  Get file data from the ram cache, a small file missing in the cache is copied to it
+ *  @param  file file found in the mapped archive
+ *  @return cached copy, mapped file data if the file is big or the cache full
+ */
+static const uint8_t *GetCachedWebFile(const webArchiveFile_t *file);
+
+/** @brief  Check if client accepts content encoding
+ *  @param req HTTP request data structure
+ *  @param encoding content encoding name, e.g. "gzip"
+ *  @return true if encoding is accepted
+ */
+static bool IsEncodingAccepted(httpd_req_t *req, const char *encoding);
+
+/** @brief  Check if file name contains build hash, such file never changes its content
+ *  @param filepath path to file
+ *  @return true if file name is hashed
+ */
+static bool IsHashedFileName(const char *filepath);
+
+/** @brief  Check if client cached version matches the ETag
+ *  @param req HTTP request data structure
+ *  @param etag ETag string
+ *  @return true if client version is up to date
+ */
+static bool IsEtagMatch(httpd_req_t *req, const char *etag);
+
+/** @brief  Set json response ETag derived from the data generation, responds with 304 if client version is up to date.
+ *          ETag is weak, the json can be sent deflated or not and device info timestamp is not a part of it
+ *  @param req HTTP request data structure
+ *  @param etag [out] ETag buffer, must stay valid until the response is sent
+ *  @param etagSize ETag buffer size
+ *  @param generation generation of the data the json is built from, read before the json is built
+ *  @return true if response is already sent
+ */
+static bool SetJsonEtagHeaders(httpd_req_t *req, char *etag, size_t etagSize, uint32_t generation);
+
+/** @brief  Get name of the file served for the uri
+ *  @param uri requested uri
+ *  @return file name
+ */
+static const char *GetWebFileName(const char *uri);
+
+/** @brief  Set static file response headers, responds with 304 if client version is up to date
+ *  @param req HTTP request data structure
+ *  @param filepath path to file
+ *  @param isGzip gzip variant of the file
+ *  @param etag ETag string
+ *  @return true if response is already sent
+ */
+static bool SetWebFileHeaders(httpd_req_t *req, const char *filepath, bool isGzip, const char *etag);
+
+/** @brief  Receive part of the request body, retries on socket timeout
+ *  @param req HTTP request data structure
+ *  @param buf buffer for received data
+ *  @param len number of bytes to receive at most
+ *  @return number of received bytes, 0 or less on error
+ */
+static int ReceiveRequestChunk(httpd_req_t *req, char *buf, size_t len);
+
+/** @brief  Receive whole request body as null terminated string, too long body is rejected with 413
+ *  @param req HTTP request data structure
+ *  @param buf buffer for the body
+ *  @param bufSize buffer size, including null
+ *  @return true if whole body received
+ */
+static bool ReceiveRequestBody(httpd_req_t *req, char *buf, size_t bufSize);
+
+/** @brief  Respond with 413 status
+ *  @param req HTTP request data structure
+ *  @return ESP_FAIL to close the connection with unread body
+ */
+static esp_err_t SendPayloadTooLarge(httpd_req_t *req);
+
+/** @brief  Send json response, compressed with deflate if it is long enough and the client accepts it
+ *  @param req HTTP request data structure
+ *  @param json json string
+ *  @param len json length
  *  @return ESP_OK if succes
  */
-static esp_err_t InitFs(void);
+static esp_err_t SendJsonResponse(httpd_req_t *req, const char *json, size_t len);
+
+/** @brief  Set options of new client socket, called by httpd for every new connection
+ *  @param hd web server handle
+ *  @param sockfd client socket
+ *  @return ESP_OK to keep the connection
+ */
+static esp_err_t OpenSessionSocket(httpd_handle_t hd, int sockfd);
+
+/** @brief  Reconnect with the saved wifi setting, run by the worker
+ *  @param arg unused
+ */
+static void WifiReinitJob(void *arg);
+
+/** @brief  Save device setting, run by the worker
+ *  @param arg unused
+ */
+static void SettingSaveJob(void *arg);
+
+/** @brief  Save scheduler, run by the worker
+ *  @param arg unused
+ */
+static void SchedulerSaveJob(void *arg);
+
+/** @brief  Save location, run by the worker
+ *  @param arg unused
+ */
+static void LocationSaveJob(void *arg);
 
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
@@ -198,6 +384,10 @@ bool WebServerInit(void)
   ESP_ERROR_CHECK(esp_netif_init());
   ESP_ERROR_CHECK(esp_event_loop_create_default());
 
+  sBootId = esp_random();
+
+  LruCacheInit(&sWebCache, sWebCacheEntries, CFG_WEB_CACHE_ENTRIES, CFG_WEB_CACHE_BUDGET);
+
   return true;
 }
 
@@ -205,14 +395,19 @@ void WebServerStart(void)
 {
   ESP_LOGI(TAG, "init softAP");
   ESP_ERROR_CHECK(WifiInitAp());
-  ESP_ERROR_CHECK(InitFs());
 
-  ESP_ERROR_CHECK(StartWebserver(WEB_MOUNT_POINT));
+  // device is still configurable through the json api
+  if (InitWebAssets() != ESP_OK) {
+    ESP_LOGE(TAG, "web assets not available");
+  }
+
+  ESP_ERROR_CHECK(StartWebserver());
 }
 
 void WebServerStop(void) 
 { 
   // Stop the httpd server
+  LiveStatusDeinit();
   httpd_stop(webServerInstance);
 }
 
@@ -221,37 +416,33 @@ void WebServerStop(void)
 ******************************************************************************/
 
 static esp_err_t DeviceInfoHandler(httpd_req_t *req) {
-  messageTypeDeviceInfo_t info = {};
   char jsonStr[MESSAGE_TYPE_MAX_DEVICE_INFO_JSON_LENGTH] = {};
-
-  cJSON *jsonRoot = cJSON_CreateObject();
-
-  SettingGet(&sDeviceSetting);
-  MessageTypeCreateDeviceInfo(&info, &sDeviceSetting);
-  MessageParserAndSerializerCreateDeviceInfoJson(jsonRoot, &info);
+  char etag[ETAG_MAX_LEN] = {};
+  size_t jsonLen = 0;
 
   if( ESP_OK != httpd_resp_set_type( req, "applicatio/json" ) ) {
 	  ESP_LOGW( TAG, "Changing Content-Type in http header to application/json fails" );
   }
 
-  if (cJSON_PrintPreallocated(jsonRoot, jsonStr, MESSAGE_TYPE_MAX_DEVICE_INFO_JSON_LENGTH, false) == false) {
-    jsonStr[0] = 0;
-    ESP_LOGE(TAG, "Device info Json size is too big");
+  // ui polling gets 304 until the settings change
+  if (SetJsonEtagHeaders(req, etag, sizeof(etag), SettingGetGeneration()) == true) {
+    return ESP_OK;
   }
 
-  cJSON_Delete(jsonRoot);
-  httpd_resp_send(req, jsonStr, strlen(jsonStr));
+  if (MessageCacheGetDeviceInfoJson(jsonStr, sizeof(jsonStr), &jsonLen) == false) {
+    ESP_LOGE(TAG, "Device info Json not available");
+  }
+
+  SendJsonResponse(req, jsonStr, jsonLen);
 
   return ESP_OK;
 }
 
 static esp_err_t DeviceModeHandler(httpd_req_t *req) {
   char buf[MESSAGE_TYPE_MAX_DEVICE_MODE_JSON_LENGTH] = {};
-  int ret;
 
   /* Read the data for the request */
-  ret = httpd_req_recv(req, buf, MESSAGE_TYPE_MAX_DEVICE_MODE_JSON_LENGTH);
-  if (ret <= 0) {
+  if (ReceiveRequestBody(req, buf, sizeof(buf)) == false) {
     return ESP_FAIL;
   }
 
@@ -275,11 +466,9 @@ static esp_err_t DeviceModeHandler(httpd_req_t *req) {
 
 static esp_err_t DeviceSchedulerPostHandler(httpd_req_t *req) {
   char buf[MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH] = {};
-  int ret;
 
   /* Read the data for the request */
-  ret = httpd_req_recv(req, buf, MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH);
-  if (ret <= 0) {
+  if (ReceiveRequestBody(req, buf, sizeof(buf)) == false) {
     return ESP_FAIL;
   }
   
@@ -292,7 +481,7 @@ static esp_err_t DeviceSchedulerPostHandler(httpd_req_t *req) {
     MessageTypeCreateScheduler(&messageScheduler, &scheduler);
 
     SchedulerSetAll(&scheduler);
-    SchedulerSave();
+    WebWorkerRun(SchedulerSaveJob, NULL, 0);
     SchedulerPrintf(&scheduler); 
   }
   else{
@@ -306,28 +495,50 @@ static esp_err_t DeviceSchedulerPostHandler(httpd_req_t *req) {
 }
 
 static esp_err_t WifiSettingPostHandler(httpd_req_t *req) {
-  char buf[MESSAGE_TYPE_MAX_WIFI_SETTING_JSON_LENGTH] = {};
-  int ret;
+  // certificates make the body a few kB, it is parsed while received instead of being buffered
+  char buf[REQUEST_RECV_CHUNK_LEN];
+  wifiSetting_t wifiSetting = {};
+  messageParserWifiSettingStream_t parser;
+  size_t remaining = req->content_len;
+  bool res = true;
 
-  /* Read the data for the request */
-  ret = httpd_req_recv(req, buf, MESSAGE_TYPE_MAX_WIFI_SETTING_JSON_LENGTH);
-  if (ret <= 0) {
-    return ESP_FAIL;
+  if (req->content_len > MESSAGE_TYPE_MAX_WIFI_SETTING_JSON_LENGTH) {
+    return SendPayloadTooLarge(req);
   }
-  
-  wifiSetting_t wifiSetting = {};
 
-  if(MessageParserAndSerializerParseWifiSettingJsonString(buf, &wifiSetting)){
+  MessageParserAndSerializerWifiSettingStreamBegin(&parser, &wifiSetting);
+
+  while ((remaining > 0) && res) {
+    int ret = ReceiveRequestChunk(req, buf, MIN(remaining, sizeof(buf)));
+    if (ret <= 0) {
+      MessageParserAndSerializerWifiSettingStreamEnd(&parser);
+      return ESP_FAIL;
+    }
+
+    remaining -= ret;
+    res = MessageParserAndSerializerWifiSettingStreamParse(&parser, buf, ret);
+  }
+
+  // always called to free parser buffers
+  res = MessageParserAndSerializerWifiSettingStreamEnd(&parser) && res;
+
+  if(res){
     ESP_LOGI(TAG, "Set new wifi ssid %s", wifiSetting.ssid);
     wifiSetting.isSet = true;
-    WifiSettingSave(&wifiSetting);
 
-    SettingGet(&sDeviceSetting);
-    sDeviceSetting.tryConnectToNewAp = true;
-    sDeviceSetting.isConnectNewAp = false;
-    SettingSet(&sDeviceSetting);
+    // the response reports the save, the reconnection drops the access point clients so it follows the response
+    if(WifiSettingSave(&wifiSetting) == true){
+      SettingGet(&sDeviceSetting);
+      sDeviceSetting.tryConnectToNewAp = true;
+      sDeviceSetting.isConnectNewAp = false;
+      SettingSet(&sDeviceSetting);
 
-    WifiReinit();
+      WebWorkerRun(WifiReinitJob, NULL, 0);
+    }
+    else{
+      ESP_LOGE(TAG, "wifi setting not saved");
+      httpd_resp_set_status(req, HTTPD_500);
+    }
   }
   else{
     httpd_resp_set_status(req, HTTPD_400);
@@ -358,13 +569,36 @@ static esp_err_t DeviceUplaodPostHandler(httpd_req_t *req) {
   return ESP_OK;
 }
 
+static esp_err_t WebAssetsUplaodPostHandler(httpd_req_t *req) {
+  // staging partition is rewritten, it can't be in use; files are sent within their handlers, none is pending
+  UnmapWebAssets(&sWebAssetsOta);
+  LruCacheClear(&sWebCache);
+
+  esp_err_t err = OtaUploadWebAssetsByWebserver(req);
+  if(err == ESP_OK){
+    err = MapWebAssetsBundle();
+    if(err != ESP_OK){
+      ESP_LOGW(TAG, "uploaded web assets are broken or built on other base web assets");
+      OtaWebAssetsInvalidate();
+    }
+  }
+
+  if(err != ESP_OK){
+    ESP_LOGW(TAG, "something went wrong");
+    httpd_resp_set_status(req, HTTPD_400);
+  }
+
+  // End response
+  httpd_resp_send_chunk(req, NULL, 0);
+
+  return ESP_OK;
+}
+
 static esp_err_t DeviceTimePostHandler(httpd_req_t *req) {
   char buf[MESSAGE_TYPE_MAX_DEVICE_TIME_JSON_LENGTH] = {};
-  int ret;
 
   /* Read the data for the request */
-  ret = httpd_req_recv(req, buf, MESSAGE_TYPE_MAX_DEVICE_TIME_JSON_LENGTH);
-  if (ret <= 0) {
+  if (ReceiveRequestBody(req, buf, sizeof(buf)) == false) {
     return ESP_FAIL;
   }
   
@@ -382,10 +616,10 @@ static esp_err_t DeviceTimePostHandler(httpd_req_t *req) {
     if(actualOffset != newOffset){
       ESP_LOGI(TAG, "utc offset change %.1f", newOffset);
       LocationSetUtcOffset(newOffset);
-      LocationSave();
+      WebWorkerRun(LocationSaveJob, NULL, 0);
     }
 
-    SettingSave();
+    WebWorkerRun(SettingSaveJob, NULL, 0);
   }
   else{
     httpd_resp_set_status(req, HTTPD_400);
@@ -399,11 +633,9 @@ static esp_err_t DeviceTimePostHandler(httpd_req_t *req) {
 
 static esp_err_t ResetCounterPostHandler(httpd_req_t *req) {
   char buf[MESSAGE_TYPE_MAX_CLEAR_COUNTER_JSON_LENGTH] = {};
-  int ret;
 
   /* Read the data for the request */
-  ret = httpd_req_recv(req, buf, MESSAGE_TYPE_MAX_DEVICE_TIME_JSON_LENGTH);
-  if (ret <= 0) {
+  if (ReceiveRequestBody(req, buf, sizeof(buf)) == false) {
     return ESP_FAIL;
   }
 
@@ -419,7 +651,6 @@ static esp_err_t ResetCounterPostHandler(httpd_req_t *req) {
       AlarmHandlingTimersWornOutCheck(&sDeviceSetting);
 
       SettingSet(&sDeviceSetting);
-      SettingSave();
     }
 
     if(messageTypeClearCounter.uvLamp1Counter == true){
@@ -432,7 +663,6 @@ static esp_err_t ResetCounterPostHandler(httpd_req_t *req) {
       AlarmHandlingTimersWornOutCheck(&sDeviceSetting);
 
       SettingSet(&sDeviceSetting);
-      SettingSave();
     }
 
     if(messageTypeClearCounter.uvLamp2Counter == true){
@@ -445,8 +675,9 @@ static esp_err_t ResetCounterPostHandler(httpd_req_t *req) {
       AlarmHandlingTimersWornOutCheck(&sDeviceSetting);
 
       SettingSet(&sDeviceSetting);
-      SettingSave();
     }
+
+    WebWorkerRun(SettingSaveJob, NULL, 0);
   }
   else{
     httpd_resp_set_status(req, HTTPD_400);
@@ -459,27 +690,24 @@ static esp_err_t ResetCounterPostHandler(httpd_req_t *req) {
 }
 
 static esp_err_t DeviceSchedulerGetHandler(httpd_req_t *req) {
-  Scheduler_t scheduler = {};
-  messageTypeScheduler_t messageScheduler = {};
   char jsonStr[MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH] = {};
-  
-  SchedulerGetAll(&scheduler);
-  MessageTypeCreateMessageTypeScheduler(&messageScheduler, &scheduler);
+  char etag[ETAG_MAX_LEN] = {};
+  size_t jsonLen = 0;
 
   if( ESP_OK != httpd_resp_set_type( req, "applicatio/json" ) ) {
 	  ESP_LOGW( TAG, "Changing Content-Type in http header to application/json fails" );
   }
 
-  cJSON *jsonRoot = cJSON_CreateObject();
-  MessageParserAndSerializerCreateSchedulerJson(jsonRoot, &messageScheduler);
+  if (SetJsonEtagHeaders(req, etag, sizeof(etag), SchedulerGetGeneration()) == true) {
+    return ESP_OK;
+  }
 
-  if (cJSON_PrintPreallocated(jsonRoot, jsonStr, MESSAGE_TYPE_MAX_DEVICE_SCHEDULER_JSON_LENGTH, false) == false) {
-    jsonStr[0] = 0;
-    ESP_LOGE(TAG, "Scheduler Json size is too big");
+  // schedule changes rarely, the json is rebuilt only after a change
+  if (MessageCacheGetSchedulerJson(jsonStr, sizeof(jsonStr), &jsonLen) == false) {
+    ESP_LOGE(TAG, "Scheduler Json not available");
   }
 
-  cJSON_Delete(jsonRoot);
-  httpd_resp_send(req, jsonStr, strlen(jsonStr));
+  SendJsonResponse(req, jsonStr, jsonLen);
 
   return ESP_OK;
 }
@@ -504,18 +732,16 @@ static esp_err_t DeviceDiagnosticGetHandler(httpd_req_t *req) {
   }
 
   cJSON_Delete(jsonRoot);
-  httpd_resp_send(req, jsonStr, strlen(jsonStr));
+  SendJsonResponse(req, jsonStr, strlen(jsonStr));
 
   return ESP_OK;
 }
 
 static esp_err_t DeviceAuthPostHandler(httpd_req_t *req) {
   char buf[MESSAGE_TYPE_MAX_DEVICE_AUTH_JSON_LENGTH] = {};
-  int ret;
 
   /* Read the data for the request */
-  ret = httpd_req_recv(req, buf, MESSAGE_TYPE_MAX_DEVICE_AUTH_JSON_LENGTH);
-  if (ret <= 0) {
+  if (ReceiveRequestBody(req, buf, sizeof(buf)) == false) {
     return ESP_FAIL;
   }
 
@@ -538,17 +764,14 @@ static esp_err_t DeviceAuthPostHandler(httpd_req_t *req) {
   return ESP_OK;
 }
 
- esp_err_t StartWebserver(const char *base_path) {
-
-  REST_CHECK(base_path, "wrong base path", err);
-  rest_server_context_t *rest_context =
-      calloc(1, sizeof(rest_server_context_t));
-  REST_CHECK(rest_context, "No memory for rest context", err);
-  strlcpy(rest_context->base_path, base_path, sizeof(rest_context->base_path));
+ esp_err_t StartWebserver(void) {
 
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
-  config.max_uri_handlers = 12;
+  config.max_uri_handlers = 16;
   config.stack_size = (10U * 1024U); // Increase  stack size
+  config.max_open_sockets = CFG_WEB_SERVER_MAX_SOCKETS;
+  config.send_wait_timeout = CFG_WEB_SERVER_SEND_TIMEOUT_S;
+  config.open_fn = OpenSessionSocket;
 
   config.lru_purge_enable = true;
   config.uri_match_fn = httpd_uri_match_wildcard;
@@ -558,120 +781,132 @@ static esp_err_t DeviceAuthPostHandler(httpd_req_t *req) {
   REST_CHECK(httpd_start(&webServerInstance, &config) == ESP_OK, "Start server failed", err_start);
   ESP_LOGI(TAG, "Registering URI handlers");
 
+  // metrics are registered before the wildcard GET handler which would catch them
+  if (WebMetricsInit(webServerInstance) == false) {
+    ESP_LOGW(TAG, "Web metrics not available");
+  }
+  WebMetricsSetCache(&sWebCache);
+
+  /* websocket pushing status changes, also before the wildcard GET handler */
+  if (LiveStatusInit(webServerInstance) == false) {
+    ESP_LOGW(TAG, "Live status not available");
+  }
+
   /* URI handler for getting diagnostic json */
   httpd_uri_t deviceDiagnosticGet = 
   {
     .uri = "/deviceDiag",
     .method = HTTP_GET,
-    .handler = DeviceDiagnosticGetHandler,
-    .user_ctx = rest_context
+    .handler = DeviceDiagnosticGetHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceDiagnosticGet);
+  WebMetricsRegisterUri(webServerInstance, &deviceDiagnosticGet);
 
   /* URI handler for post device auth json */
   httpd_uri_t deviceAuthPost = 
   {
     .uri = "/deviceAuth",
     .method = HTTP_POST,
-    .handler = DeviceAuthPostHandler,
-    .user_ctx = rest_context
+    .handler = DeviceAuthPostHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceAuthPost);
+  WebMetricsRegisterUri(webServerInstance, &deviceAuthPost);
 
   /* URI handler for getting device info json */
   httpd_uri_t deviceInfo = 
   {
     .uri = "/deviceInfo",
     .method = HTTP_GET,
-    .handler = DeviceInfoHandler,
-    .user_ctx = rest_context
+    .handler = DeviceInfoHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceInfo);
+  WebMetricsRegisterUri(webServerInstance, &deviceInfo);
 
   /* URI handler for getting scheduler json */
   httpd_uri_t deviceScheduleGet = 
   {
     .uri = "/deviceSchedule",
     .method = HTTP_GET,
-    .handler = DeviceSchedulerGetHandler,
-    .user_ctx = rest_context
+    .handler = DeviceSchedulerGetHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceScheduleGet);
+  WebMetricsRegisterUri(webServerInstance, &deviceScheduleGet);
 
   /* URI handler for post device mode */
   httpd_uri_t deviceMode = 
   {
     .uri = "/deviceMode",
     .method = HTTP_POST,
-    .handler = DeviceModeHandler,
-    .user_ctx = rest_context
+    .handler = DeviceModeHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceMode);
+  WebMetricsRegisterUri(webServerInstance, &deviceMode);
 
   /* URI handler for getting web server files */
   httpd_uri_t commonGetUri = 
   {
     .uri = "/*",
     .method = HTTP_GET,
-    .handler = RestCommonGetHandler,
-    .user_ctx = rest_context
+    .handler = RestCommonGetHandler
   };
-  httpd_register_uri_handler(webServerInstance, &commonGetUri);
+  WebMetricsRegisterUri(webServerInstance, &commonGetUri);
 
   /* URI handler for post scheduler */
   httpd_uri_t deviceSchedulePost = 
   {
     .uri = "/deviceSchedule",
     .method = HTTP_POST,
-    .handler = DeviceSchedulerPostHandler,
-    .user_ctx = rest_context
+    .handler = DeviceSchedulerPostHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceSchedulePost);
+  WebMetricsRegisterUri(webServerInstance, &deviceSchedulePost);
 
   /* URI handler for post wifiSetting */
   httpd_uri_t deviceWifiSettingPost = 
   {
     .uri = "/wifiSetting",
     .method = HTTP_POST,
-    .handler = WifiSettingPostHandler,
-    .user_ctx = rest_context
+    .handler = WifiSettingPostHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceWifiSettingPost);
+  WebMetricsRegisterUri(webServerInstance, &deviceWifiSettingPost);
 
   /* URI handler for post deviceUpload */
   httpd_uri_t deviceDeviceUplaodPost = 
   {
     .uri = "/upload",
     .method = HTTP_POST,
-    .handler = DeviceUplaodPostHandler,
-    .user_ctx = rest_context
+    .handler = DeviceUplaodPostHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceDeviceUplaodPost);
+  WebMetricsRegisterUri(webServerInstance, &deviceDeviceUplaodPost);
+
+  /* URI handler for post web assets upload */
+  httpd_uri_t webAssetsUplaodPost = 
+  {
+    .uri = "/uploadWww",
+    .method = HTTP_POST,
+    .handler = WebAssetsUplaodPostHandler
+  };
+  WebMetricsRegisterUri(webServerInstance, &webAssetsUplaodPost);
 
   /* URI handler for post time */
   httpd_uri_t deviceDeviceTimePost = 
   {
     .uri = "/time",
     .method = HTTP_POST,
-    .handler = DeviceTimePostHandler,
-    .user_ctx = rest_context
+    .handler = DeviceTimePostHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceDeviceTimePost);
+  WebMetricsRegisterUri(webServerInstance, &deviceDeviceTimePost);
 
   /* URI handler for post resetcounter */
   httpd_uri_t deviceResetCounterPost = 
   {
     .uri = "/resetcounter",
     .method = HTTP_POST,
-    .handler = ResetCounterPostHandler,
-    .user_ctx = rest_context
+    .handler = ResetCounterPostHandler
   };
-  httpd_register_uri_handler(webServerInstance, &deviceResetCounterPost);
+  WebMetricsRegisterUri(webServerInstance, &deviceResetCounterPost);
+
+  // without workers long jobs are run on the httpd task
+  if (WebWorkerInit() == false) {
+    ESP_LOGW(TAG, "Web workers not available");
+  }
 
   return ESP_OK;
 err_start:
-  free(rest_context);
-err:
   return ESP_FAIL;
 }
 
@@ -685,43 +920,212 @@ static esp_err_t WifiInitAp(void) {
   IP4_ADDR(&ipAddressInfo.netmask, SOFT_AP_NM_ADDRESS_1, SOFT_AP_NM_ADDRESS_2, SOFT_AP_NM_ADDRESS_3, SOFT_AP_NM_ADDRESS_4);
 
   ESP_ERROR_CHECK(tcpip_adapter_set_ip_info(TCPIP_ADAPTER_IF_AP, &ipAddressInfo));
+
+  // clients get the device as dns server, the captive portal resolves every name to it
+  tcpip_adapter_dns_info_t dnsInfo = {};
+  dhcps_offer_t dhcpsDnsOffer = OFFER_DNS;
+  dnsInfo.ip.type = ESP_IPADDR_TYPE_V4;
+  dnsInfo.ip.u_addr.ip4 = ipAddressInfo.ip;
+  ESP_ERROR_CHECK(tcpip_adapter_set_dns_info(TCPIP_ADAPTER_IF_AP, TCPIP_ADAPTER_DNS_MAIN, &dnsInfo));
+  ESP_ERROR_CHECK(tcpip_adapter_dhcps_option(TCPIP_ADAPTER_OP_SET, TCPIP_ADAPTER_DOMAIN_NAME_SERVER, &dhcpsDnsOffer, sizeof(dhcpsDnsOffer)));
+
   ESP_ERROR_CHECK(tcpip_adapter_dhcps_start(TCPIP_ADAPTER_IF_AP));
 
+  if (CaptivePortalInit(ipAddressInfo.ip.addr) == false) {
+    ESP_LOGW(TAG, "Captive portal not available");
+  }
+
   return ESP_OK;
 }
 
-static esp_err_t InitFs(void) {
-  esp_vfs_spiffs_conf_t conf = 
-  {
-    .base_path = WEB_MOUNT_POINT,
-    .partition_label = NULL,
-    .max_files = 5,
-    .format_if_mount_failed = false
-  };
-  esp_err_t ret = esp_vfs_spiffs_register(&conf);
+static esp_err_t InitWebAssets(void) {
+  // base web assets are flashed and verified by esptool, crc check is skipped for faster startup
+  if (MapWebAssets(&sWebAssets, false) != ESP_OK) {
+    return ESP_FAIL;
+  }
 
-  if (ret != ESP_OK) {
-    if (ret == ESP_FAIL) {
-      ESP_LOGE(TAG, "Failed to mount or format filesystem");
-    } else if (ret == ESP_ERR_NOT_FOUND) {
-      ESP_LOGE(TAG, "Failed to find SPIFFS partition");
-    } else {
-      ESP_LOGE(TAG, "Failed to initialize SPIFFS (%s)", esp_err_to_name(ret));
-    }
+  // base web assets are enough to work
+  if ((OtaIsWebAssetsValid() == true) && (MapWebAssetsBundle() != ESP_OK)) {
+    ESP_LOGW(TAG, "Uploaded web assets skipped");
+  }
+
+  return ESP_OK;
+}
+
+static esp_err_t MapWebAssets(webAssets_t *assets, bool checkCrc) {
+  webArchiveHeader_t header = {};
+
+  const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, CFG_WEB_ASSETS_PARTITION_SUBTYPE, assets->label);
+  if (partition == NULL) {
+    ESP_LOGE(TAG, "Failed to find %s partition", assets->label);
     return ESP_FAIL;
   }
 
-  size_t total = 0, used = 0;
-  ret = esp_spiffs_info(NULL, &total, &used);
+  esp_err_t ret = esp_partition_read(partition, 0, &header, sizeof(header));
+  if ((ret != ESP_OK) || (WebArchiveCheckHeader(&header, partition->size) == false)) {
+    ESP_LOGE(TAG, "No web assets in %s partition", assets->label);
+    return ESP_FAIL;
+  }
+
+  // only the archive is mapped, data address space is shared with the application rodata
+  const void *data = NULL;
+  ret = esp_partition_mmap(partition, 0, header.size, SPI_FLASH_MMAP_DATA, &data, &assets->mmapHandle);
   if (ret != ESP_OK) {
-    ESP_LOGE(TAG, "Failed to get SPIFFS partition information (%s)",
-             esp_err_to_name(ret));
-  } else {
-    ESP_LOGI(TAG, "Partition size: total: %d, used: %d", total, used);
+    ESP_LOGE(TAG, "Failed to map %s partition (%s)", assets->label, esp_err_to_name(ret));
+    return ESP_FAIL;
+  }
+
+  if (WebArchiveOpen(&assets->archive, data, header.size, checkCrc) == false) {
+    ESP_LOGE(TAG, "Broken web assets in %s partition", assets->label);
+    spi_flash_munmap(assets->mmapHandle);
+    return ESP_FAIL;
   }
+
+  assets->isMapped = true;
+  ESP_LOGI(TAG, "Web assets %s: %u files, %u bytes", assets->label, assets->archive.entriesCount, assets->archive.size);
+
   return ESP_OK;
 }
 
+static void UnmapWebAssets(webAssets_t *assets) {
+  if (assets->isMapped == false) {
+    return;
+  }
+
+  WebArchiveClose(&assets->archive);
+  spi_flash_munmap(assets->mmapHandle);
+  assets->isMapped = false;
+}
+
+static esp_err_t MapWebAssetsBundle(void) {
+  if (MapWebAssets(&sWebAssetsOta, true) != ESP_OK) {
+    return ESP_FAIL;
+  }
+
+  // the bundle holds changed files only, over other base web assets they would be mixed with files they don't match
+  if (WebArchiveIsBundleOf(&sWebAssetsOta.archive, &sWebAssets.archive) == false) {
+    ESP_LOGW(TAG, "Web assets %s built on base %08x, base is %08x", sWebAssetsOta.label,
+             (unsigned int)sWebAssetsOta.archive.baseCrc, (unsigned int)sWebAssets.archive.crc);
+    UnmapWebAssets(&sWebAssetsOta);
+    return ESP_FAIL;
+  }
+
+  return ESP_OK;
+}
+
+static bool FindWebFile(const char *fileName, bool isGzipAccepted, webArchiveFile_t *file, bool *isGzip) {
+  char name[WEB_ARCHIVE_NAME_MAX_LEN];
+  char gzipName[WEB_ARCHIVE_NAME_MAX_LEN];
+
+  // query string is not a part of the file name
+  size_t nameLen = strcspn(fileName, "?");
+  if ((nameLen + sizeof(GZIP_FILE_EXTENSION)) > sizeof(gzipName)) {
+    return false;
+  }
+
+  strlcpy(name, fileName, nameLen + 1);
+  memcpy(gzipName, name, nameLen);
+  memcpy(&gzipName[nameLen], GZIP_FILE_EXTENSION, sizeof(GZIP_FILE_EXTENSION));
+
+  webAssets_t *searchAssets[] = { &sWebAssetsOta, &sWebAssets };
+
+  for (uint8_t idx = 0; idx < (sizeof(searchAssets) / sizeof(searchAssets[0])); ++idx) {
+    if (searchAssets[idx]->isMapped == false) {
+      continue;
+    }
+
+    if ((isGzipAccepted == true) && (WebArchiveFind(&searchAssets[idx]->archive, gzipName, file) == true)) {
+      *isGzip = true;
+      return true;
+    }
+
+    if (WebArchiveFind(&searchAssets[idx]->archive, name, file) == true) {
+      *isGzip = false;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static const uint8_t *GetCachedWebFile(const webArchiveFile_t *file) {
+  char key[CACHE_KEY_MAX_LEN];
+
+  // flash reads of every small file request evict the code from the flash cache
+  if (file->size > CFG_WEB_CACHE_MAX_FILE_LEN) {
+    return file->data;
+  }
+
+  // the key changes with the content, a file of other web assets is never served from a stale copy
+  snprintf(key, sizeof(key), "%08x-%u", (unsigned int)file->hash, (unsigned int)file->size);
+
+  const uint8_t *data = LruCacheGet(&sWebCache, key, NULL);
+  if (data != NULL) {
+    return data;
+  }
+
+  uint8_t *copy = LruCachePut(&sWebCache, key, file->size);
+  if (copy == NULL) {
+    return file->data;
+  }
+
+  memcpy(copy, file->data, file->size);
+
+  return copy;
+}
+
+static bool IsEncodingAccepted(httpd_req_t *req, const char *encoding) {
+  char acceptEncoding[ACCEPT_ENCODING_MAX_LEN] = {};
+
+  // truncated value is still searched, gzip and deflate are usually listed first
+  esp_err_t err = httpd_req_get_hdr_value_str(req, "Accept-Encoding", acceptEncoding, sizeof(acceptEncoding));
+  if ((err != ESP_OK) && (err != ESP_ERR_HTTPD_RESULT_TRUNC)) {
+    return false;
+  }
+
+  return (strstr(acceptEncoding, encoding) != NULL);
+}
+
+static bool IsHashedFileName(const char *filepath) {
+  // name.<hash>.ext
+  const char *extension = strrchr(filepath, '.');
+  if ((extension == NULL) || ((size_t)(extension - filepath) < (FILE_NAME_HASH_LEN + 1U))) {
+    return false;
+  }
+
+  const char *hash = extension - FILE_NAME_HASH_LEN;
+  if (hash[-1] != '.') {
+    return false;
+  }
+
+  for (uint8_t idx = 0; idx < FILE_NAME_HASH_LEN; ++idx) {
+    if (isxdigit((unsigned char)hash[idx]) == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool IsEtagMatch(httpd_req_t *req, const char *etag) {
+  char ifNoneMatch[ETAG_MAX_LEN] = {};
+
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", ifNoneMatch, sizeof(ifNoneMatch)) != ESP_OK) {
+    return false;
+  }
+
+  // If-None-Match uses weak comparison, W/ prefix is ignored on both sides
+  const char *clientEtag = ifNoneMatch;
+  if (strncmp(clientEtag, ETAG_WEAK_PREFIX, strlen(ETAG_WEAK_PREFIX)) == 0) {
+    clientEtag += strlen(ETAG_WEAK_PREFIX);
+  }
+  if (strncmp(etag, ETAG_WEAK_PREFIX, strlen(ETAG_WEAK_PREFIX)) == 0) {
+    etag += strlen(ETAG_WEAK_PREFIX);
+  }
+
+  return (strcmp(clientEtag, etag) == 0);
+}
+
 static esp_err_t SetContentTypeFromFile(httpd_req_t *req, const char *filepath) {
   const char *type = "text/plain";
   if (CHECK_FILE_EXTENSION(filepath, ".html")) {
@@ -736,56 +1140,196 @@ static esp_err_t SetContentTypeFromFile(httpd_req_t *req, const char *filepath)
     type = "image/x-icon";
   } else if (CHECK_FILE_EXTENSION(filepath, ".svg")) {
     type = "image/svg+xml";
+  } else if (CHECK_FILE_EXTENSION(filepath, ".woff")) {
+    type = "font/woff";
+  } else if (CHECK_FILE_EXTENSION(filepath, ".woff2")) {
+    type = "font/woff2";
   }
   return httpd_resp_set_type(req, type);
 }
 
 static esp_err_t RestCommonGetHandler(httpd_req_t *req) {
-  char filepath[FILE_PATH_MAX];
-
-  rest_server_context_t *rest_context = (rest_server_context_t *)req->user_ctx;
-  strlcpy(filepath, rest_context->base_path, sizeof(filepath));
-  if (req->uri[strlen(req->uri) - 1] == '/') {
-    strlcat(filepath, "/index.html", sizeof(filepath));
-  } else {
-    strlcat(filepath, req->uri, sizeof(filepath));
-  }
-  int fd = open(filepath, O_RDONLY, 0);
-  if (fd == -1) {
-    ESP_LOGE(TAG, "Failed to open file : %s", filepath);
-    /* Respond with 500 Internal Server Error */
-    httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR,
-                        "Failed to read existing file");
+  char etag[ETAG_MAX_LEN] = {};
+  webArchiveFile_t file = {};
+  bool isGzip = false;
+
+  // connectivity checks of phones joining the access point
+  if (CaptivePortalRedirect(req) == true) {
+    return ESP_OK;
+  }
+
+  const char *fileName = GetWebFileName(req->uri);
+  if (FindWebFile(fileName, IsEncodingAccepted(req, "gzip"), &file, &isGzip) == false) {
+    ESP_LOGE(TAG, "File not found : %s", fileName);
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "File does not exist");
     return ESP_FAIL;
   }
 
+  // archive stores crc of each file, gzip variant has its own
+  snprintf(etag, sizeof(etag), "\"%08x\"", file.hash);
+
+  if (SetWebFileHeaders(req, fileName, isGzip, etag) == true) {
+    return ESP_OK;
+  }
+
+  // archive is memory mapped, big files are sent directly from flash
+  return WebWorkerSendFile(req, GetCachedWebFile(&file), file.size);
+}
+
+static const char *GetWebFileName(const char *uri) {
+  if (uri[strlen(uri) - 1] == '/') {
+    return "/index.html";
+  }
+
+  return uri;
+}
+
+static bool SetWebFileHeaders(httpd_req_t *req, const char *filepath, bool isGzip, const char *etag) {
   SetContentTypeFromFile(req, filepath);
 
-  char *chunk = rest_context->scratch;
-  ssize_t read_bytes;
-  do {
-    /* Read file in chunks into the scratch buffer */
-    read_bytes = read(fd, chunk, SCRATCH_BUFSIZE);
-    if (read_bytes == -1) {
-      ESP_LOGE(TAG, "Failed to read file : %s", filepath);
-    } else if (read_bytes > 0) {
-      /* Send the buffer contents as HTTP response chunk */
-      if (httpd_resp_send_chunk(req, chunk, read_bytes) != ESP_OK) {
-        close(fd);
-        ESP_LOGE(TAG, "File sending failed!");
-        /* Abort sending file */
-        httpd_resp_sendstr_chunk(req, NULL);
-        /* Respond with 500 Internal Server Error */
-        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR,
-                            "Failed to send file");
-        return ESP_FAIL;
-      }
+  // header values must stay valid until the response is sent
+  httpd_resp_set_hdr(req, "Cache-Control", (IsHashedFileName(filepath) ? CACHE_CONTROL_IMMUTABLE : CACHE_CONTROL_REVALIDATE));
+  httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+
+  httpd_resp_set_hdr(req, "ETag", etag);
+
+  if (IsEtagMatch(req, etag) == true) {
+    httpd_resp_set_status(req, HTTPD_304);
+    httpd_resp_send(req, NULL, 0);
+    return true;
+  }
+
+  if (isGzip == true) {
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  }
+
+  return false;
+}
+
+static bool SetJsonEtagHeaders(httpd_req_t *req, char *etag, size_t etagSize, uint32_t generation) {
+  snprintf(etag, etagSize, ETAG_WEAK_PREFIX "\"%08x%08x\"", (unsigned int)sBootId, (unsigned int)generation);
+
+  httpd_resp_set_hdr(req, "Cache-Control", CACHE_CONTROL_REVALIDATE);
+  httpd_resp_set_hdr(req, "ETag", etag);
+
+  // the full response sets Vary in SendJsonResponse
+  if (IsEtagMatch(req, etag) == true) {
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+    httpd_resp_set_status(req, HTTPD_304);
+    httpd_resp_send(req, NULL, 0);
+    return true;
+  }
+
+  return false;
+}
+
+static int ReceiveRequestChunk(httpd_req_t *req, char *buf, size_t len) {
+  int ret = HTTPD_SOCK_ERR_TIMEOUT;
+
+  for (uint8_t retry = 0; (retry < REQUEST_RECV_TIMEOUT_RETRIES) && (ret == HTTPD_SOCK_ERR_TIMEOUT); ++retry) {
+    ret = httpd_req_recv(req, buf, len);
+  }
+
+  return ret;
+}
+
+static bool ReceiveRequestBody(httpd_req_t *req, char *buf, size_t bufSize) {
+  size_t received = 0;
+
+  // one place is left for null
+  if (req->content_len >= bufSize) {
+    SendPayloadTooLarge(req);
+    return false;
+  }
+
+  // body can come in several tcp segments
+  while (received < req->content_len) {
+    int ret = ReceiveRequestChunk(req, &buf[received], req->content_len - received);
+    if (ret <= 0) {
+      return false;
     }
-  } while (read_bytes > 0);
-  /* Close file after sending complete */
-  close(fd);
-  ESP_LOGI(TAG, "File sending complete");
-  /* Respond with an empty chunk to signal HTTP response completion */
-  httpd_resp_send_chunk(req, NULL, 0);
+    received += ret;
+  }
+
+  buf[received] = '\0';
+
+  return (received > 0);
+}
+
+static esp_err_t SendPayloadTooLarge(httpd_req_t *req) {
+  ESP_LOGW(TAG, "%s body too long %d", req->uri, (int)req->content_len);
+
+  httpd_resp_set_status(req, HTTPD_413);
+  httpd_resp_send(req, NULL, 0);
+
+  return ESP_FAIL;
+}
+
+static void WifiReinitJob(void *arg) {
+  (void)arg;
+
+  WifiReinit();
+}
+
+static void SettingSaveJob(void *arg) {
+  (void)arg;
+
+  SettingSave();
+}
+
+static void SchedulerSaveJob(void *arg) {
+  (void)arg;
+
+  SchedulerSave();
+}
+
+static void LocationSaveJob(void *arg) {
+  (void)arg;
+
+  LocationSave();
+}
+
+static esp_err_t SendJsonResponse(httpd_req_t *req, const char *json, size_t len) {
+  // every variant of the response depends on the encoding, caches keep them apart
+  httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+
+  if ((len < CFG_WEB_SERVER_DEFLATE_MIN_LEN) || (IsEncodingAccepted(req, "deflate") == false)) {
+    return httpd_resp_send(req, json, len);
+  }
+
+  // compressed response is sent only if it is shorter
+  uint8_t *compressed = malloc(len);
+  uint32_t compressedLen = 0;
+
+  if ((compressed == NULL) || (DeflateCompress((const uint8_t *)json, len, compressed, len, &compressedLen) == false)) {
+    free(compressed);
+    return httpd_resp_send(req, json, len);
+  }
+
+  httpd_resp_set_hdr(req, "Content-Encoding", "deflate");
+  esp_err_t err = httpd_resp_send(req, (const char *)compressed, compressedLen);
+
+  free(compressed);
+
+  return err;
+}
+
+static esp_err_t OpenSessionSocket(httpd_handle_t hd, int sockfd) {
+  int enable = 1;
+  int idle = CFG_WEB_SERVER_KEEP_ALIVE_IDLE_S;
+  int interval = CFG_WEB_SERVER_KEEP_ALIVE_INTERVAL_S;
+  int count = CFG_WEB_SERVER_KEEP_ALIVE_COUNT;
+
+  // small json responses are sent at once, not delayed by nagle waiting for the ack
+  setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+  // connections are kept open between requests, sockets of clients gone from the AP are freed by keep-alive
+  setsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable));
+  setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+  setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+  setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count));
+
+  WebMetricsOpenSession(hd, sockfd);
+
   return ESP_OK;
 }
@@ -0,0 +1,181 @@
+/**
+ * @file webWorker.c
+ *
+ * @brief Web Server worker source file
+ *
+ * The httpd serves all clients on a single task. Jobs blocking for a long
+ * time (nvs saves, wifi reconfiguration) are moved to a worker task. The
+ * jobs read and save shared settings, they run one at a time in order.
+ * Files are sent in slices within the handler: the httpd of IDF v4.3 has no
+ * asynchronous requests, a response finished after the handler returned
+ * would be interleaved with the next request of a keep-alive connection.
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "webWorker.h"
+#include "config.h"
+
+#include <esp_log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define WEB_WORKER_STACK_SIZE (5U * 1024U)
+#define WEB_WORKER_TASK_PRIORITY (3U)                   // below httpd task
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef struct {
+  webWorkerJob_t job;
+  void *arg;
+  bool isArgCopy;
+} webWorkerItem_t;
+
+static const char *TAG = "web_worker";
+
+static QueueHandle_t sQueue;
+
+// a job run in place doesn't overlap the worker
+static SemaphoreHandle_t sJobMutex;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Worker task
+ *  @param arg unused
+ */
+static void WebWorkerTask(void *arg);
+
+/** @brief Run job exclusively and free its argument copy
+ *  @param item job item
+ */
+static void RunJob(const webWorkerItem_t *item);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool WebWorkerInit(void)
+{
+  if (sQueue != NULL) {
+    return true;
+  }
+
+  if (sJobMutex == NULL) {
+    sJobMutex = xSemaphoreCreateMutex();
+  }
+  if (sJobMutex == NULL) {
+    return false;
+  }
+
+  sQueue = xQueueCreate(CFG_WEB_WORKER_QUEUE_LEN, sizeof(webWorkerItem_t));
+  if (sQueue == NULL) {
+    return false;
+  }
+
+  if (xTaskCreate(WebWorkerTask, "WebWorker", WEB_WORKER_STACK_SIZE, NULL, WEB_WORKER_TASK_PRIORITY, NULL) != pdPASS) {
+    ESP_LOGE(TAG, "can't create worker");
+    vQueueDelete(sQueue);
+    sQueue = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+void WebWorkerRun(webWorkerJob_t job, const void *arg, size_t argSize)
+{
+  webWorkerItem_t item = {
+    .job = job,
+    .arg = (void *)arg,
+    .isArgCopy = (argSize > 0),
+  };
+
+  if (item.isArgCopy) {
+    item.arg = malloc(argSize);
+    if (item.arg == NULL) {
+      item.arg = (void *)arg;
+      item.isArgCopy = false;
+      RunJob(&item);
+      return;
+    }
+    memcpy(item.arg, arg, argSize);
+  }
+
+  if ((sQueue == NULL) || (xQueueSend(sQueue, &item, 0) != pdTRUE)) {
+    ESP_LOGW(TAG, "queue full, job run in place");
+    RunJob(&item);
+  }
+}
+
+esp_err_t WebWorkerSendFile(httpd_req_t *req, const uint8_t *data, size_t size)
+{
+  size_t offset = 0;
+
+  // a client not taking a slice within CFG_WEB_SERVER_SEND_TIMEOUT_S aborts the file
+  while (offset < size) {
+    size_t len = MIN(size - offset, CFG_WEB_SERVER_SEND_SLICE_LEN);
+
+    esp_err_t err = httpd_resp_send_chunk(req, (const char *)&data[offset], len);
+    if (err != ESP_OK) {
+      ESP_LOGW(TAG, "file send aborted, fd %d", httpd_req_to_sockfd(req));
+      return err;
+    }
+
+    offset += len;
+  }
+
+  return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void WebWorkerTask(void *arg)
+{
+  (void)arg;
+
+  webWorkerItem_t item;
+
+  while (1) {
+    if (xQueueReceive(sQueue, &item, portMAX_DELAY) == pdTRUE) {
+      RunJob(&item);
+    }
+  }
+}
+
+static void RunJob(const webWorkerItem_t *item)
+{
+  // without the workers there is only the httpd task, nothing to exclude
+  bool isLocked = (sJobMutex != NULL) && (xSemaphoreTake(sJobMutex, portMAX_DELAY) == pdTRUE);
+
+  item->job(item->arg);
+
+  if (isLocked) {
+    xSemaphoreGive(sJobMutex);
+  }
+
+  if (item->isArgCopy) {
+    free(item->arg);
+  }
+}
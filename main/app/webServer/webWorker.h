@@ -0,0 +1,53 @@
+/**
+ * @file webWorker.h
+ *
+ * @brief Web Server worker header file
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <esp_http_server.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+typedef void (*webWorkerJob_t)(void *arg);
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Start worker task, the worker survives web server restart
+ *  @return true if success
+ */
+bool WebWorkerInit(void);
+
+/** @brief Run job on the worker, so the httpd task can serve other clients.
+ *         Jobs run one at a time in order; the job is run in the caller context
+ *         after the running one if the queue is full.
+ *  @param job job function
+ *  @param arg job argument, copied; the job gets the copy which is freed after the job
+ *  @param argSize argument size, 0 if arg is passed as is
+ */
+void WebWorkerRun(webWorkerJob_t job, const void *arg, size_t argSize);
+
+/** @brief Send file in slices and finish the response. The file is sent within the handler,
+ *         so the next request of a keep-alive connection is read only after the whole file.
+ *         Headers must be set before.
+ *  @param req HTTP request data structure
+ *  @param data file data (e.g. mapped flash)
+ *  @param size file size
+ *  @return ESP_OK if the whole file is sent
+ */
+esp_err_t WebWorkerSendFile(httpd_req_t *req, const uint8_t *data, size_t size);
@@ -17,16 +17,57 @@
 
 #include "config.h"
 
+#include <string.h>
+
 #include <esp_log.h>
+#include "esp_idf_version.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 #include "driver/adc.h"
 #include "esp_adc_cal.h"
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(4, 4, 0)
+#include "driver/i2s.h"
+#endif
 
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
  *****************************************************************************/
 
 #define ADC_DEFAULT_VREF (1100U)
+#define ADC_ATTEN (ADC_ATTEN_DB_11)
+#define ADC_WIDTH (ADC_WIDTH_BIT_12)
+
+// at the input there is a voltage divider by 2
+#define ADC_INPUT_DIVIDER (2U)
+
+// the uv lamp task reads every 10 ms, the channel getters reuse its values and read the adc only without it
+#define LAST_SAMPLE_MAX_AGE_US (100 * 1000)
+#define MUTEX_TIMEOUT_MS (100U)
+
+// channels converted in turn into a DMA ring buffer, through the ADC digital controller from IDF v4.4,
+// on older versions through the I2S0 built-in ADC mode
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0)
+#define ADC_DIGI_CONTINUOUS (1)
+#endif
+
+// about 10 k conversions per channel per second
+#define ADC_SAMPLE_FREQ_HZ (20U * 1000U)
+#define ADC_FRAME_SIZE (256U)
+// DMA ring buffer, about 100 ms of conversions
+#define ADC_STORE_BUFFER_SIZE (4U * 1024U)
+#define ADC_CONVERSION_SIZE (sizeof(adc_digi_output_data_t))
+// esp32 digital controller needs the conversion limit
+#define ADC_CONVERSION_LIMIT (250U)
+
+#ifndef ADC_DIGI_CONTINUOUS
+// only I2S0 is wired to the ADC, one DMA buffer per frame, the oldest buffer is dropped on overflow
+#define ADC_I2S_PORT (I2S_NUM_0)
+#define ADC_I2S_DMA_BUF_COUNT (ADC_STORE_BUFFER_SIZE / ADC_FRAME_SIZE)
+#define ADC_I2S_DMA_BUF_LEN (ADC_FRAME_SIZE / ADC_CONVERSION_SIZE)
+#endif
 
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
@@ -36,6 +77,7 @@ typedef struct
 {
     const adc_channel_t channel;
     esp_adc_cal_characteristics_t characteristic;
+    uint32_t lastRaw;
 }AdcDriverSetting_t;
 
 static AdcDriverSetting_t sAdcSetting[ADC_DRIVER_CHANNEL_COUNT] = {
@@ -43,11 +85,44 @@ static AdcDriverSetting_t sAdcSetting[ADC_DRIVER_CHANNEL_COUNT] = {
     [ADC_DRIVER_CHANNEL_UV_2] = {.channel = ADC_CHANNEL_7}, //CFG_UV_LAMP_BALLAST_2_FAULT_ADC_PIN (35U)
 };
 
+static uint8_t sReadBuffer[ADC_FRAME_SIZE];
+
+// read buffer, channel settings and the last sample are shared by the uv lamp task and the production task
+static SemaphoreHandle_t sAdcMutex;
+static AdcDriverSample_t sLastSample;
+static int64_t sLastReadUs;
+
 static const char *TAG = "adc";
 
-/******************************************************************************
-                        PRIVATE FUNCTION IMPLEMENTATION
-******************************************************************************/
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Start conversion of all channels
+ *  @return return true if success
+ */
+static bool StartConversion(void);
+
+/** @brief Read conversions taken since the last read, the mutex must be taken
+ *  @param sample [out] pointer to result
+ *  @return return true if every channel has new conversions
+ */
+static bool ReadSample(AdcDriverSample_t* sample);
+
+/** @brief Get the last sample, read the adc if it is old, the mutex must be taken
+ */
+static void UpdateLastSample(void);
+
+/** @brief Read the next frame of conversions from the DMA buffer, does not wait
+ *  @return return frame length in bytes, 0 if there is none
+ */
+static uint32_t ReadFrame(void);
+
+/** @brief Sum conversions taken since the last read
+ *  @param sum [out] raw sum of each channel
+ *  @param count [out] conversions of each channel
+ */
+static void ReadConversions(uint32_t sum[ADC_DRIVER_CHANNEL_COUNT], uint32_t count[ADC_DRIVER_CHANNEL_COUNT]);
 
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
@@ -55,9 +130,6 @@ static const char *TAG = "adc";
 
 bool AdcDriverInit(void)
 {
-    const adc_atten_t atten = ADC_ATTEN_DB_11;
-    const adc_bits_width_t width = ADC_WIDTH_BIT_12;
-
     //Check if TP is burned into eFuse
     if (esp_adc_cal_check_efuse(ESP_ADC_CAL_VAL_EFUSE_TP) == ESP_OK) {
         ESP_LOGI(TAG, "eFuse Two Point: Supported");
@@ -68,12 +140,8 @@ bool AdcDriverInit(void)
         ESP_LOGI(TAG, "eFuse Vref: Supported");
     }
 
-    adc1_config_width(width);
-
     for(uint16_t idx = 0; idx < ADC_DRIVER_CHANNEL_COUNT; ++idx){
-        adc1_config_channel_atten(sAdcSetting[idx].channel, atten);
-
-        esp_adc_cal_value_t val_type = esp_adc_cal_characterize(ADC_UNIT_1, atten, width, ADC_DEFAULT_VREF, &sAdcSetting[idx].characteristic);
+        esp_adc_cal_value_t val_type = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN, ADC_WIDTH, ADC_DEFAULT_VREF, &sAdcSetting[idx].characteristic);
 
         if(val_type == ESP_ADC_CAL_VAL_EFUSE_TP){
             ESP_LOGI(TAG, "%d characterized using Two Point Value", idx);
@@ -85,7 +153,28 @@ bool AdcDriverInit(void)
     }
     ESP_LOGI(TAG, "");
 
-    return true;
+    if(sAdcMutex == NULL){
+        sAdcMutex = xSemaphoreCreateMutex();
+        if(sAdcMutex == NULL){
+            ESP_LOGE(TAG, "Mutex Fail");
+            return false;
+        }
+    }
+
+    return StartConversion();
+}
+
+bool AdcDriverReadSample(AdcDriverSample_t* sample)
+{
+    if(xSemaphoreTake(sAdcMutex, MUTEX_TIMEOUT_MS / portTICK_RATE_MS) != pdTRUE){
+        return false;
+    }
+
+    bool res = ReadSample(sample);
+
+    xSemaphoreGive(sAdcMutex);
+
+    return res;
 }
 
 uint32_t AdcDriverGetRawData(AdcDriverChannel_t adcChannel)
@@ -95,7 +184,16 @@ uint32_t AdcDriverGetRawData(AdcDriverChannel_t adcChannel)
         return 0;
     }
 
-    return adc1_get_raw(sAdcSetting[adcChannel].channel);
+    if(xSemaphoreTake(sAdcMutex, MUTEX_TIMEOUT_MS / portTICK_RATE_MS) != pdTRUE){
+        return 0;
+    }
+
+    UpdateLastSample();
+    uint32_t raw = sAdcSetting[adcChannel].lastRaw;
+
+    xSemaphoreGive(sAdcMutex);
+
+    return raw;
 }
 
 float AdcDriverGetMilliVoltageData(AdcDriverChannel_t adcChannel)
@@ -105,9 +203,197 @@ float AdcDriverGetMilliVoltageData(AdcDriverChannel_t adcChannel)
         return 0;
     }
 
-    uint32_t adcRaw = adc1_get_raw(sAdcSetting[adcChannel].channel);
-    uint32_t voltage = esp_adc_cal_raw_to_voltage(adcRaw, &sAdcSetting[adcChannel].characteristic);
+    if(xSemaphoreTake(sAdcMutex, MUTEX_TIMEOUT_MS / portTICK_RATE_MS) != pdTRUE){
+        return 0;
+    }
+
+    UpdateLastSample();
+    uint32_t milliVolt = sLastSample.milliVolt[adcChannel];
+
+    xSemaphoreGive(sAdcMutex);
+
+    return (float)milliVolt;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static bool ReadSample(AdcDriverSample_t* sample)
+{
+    uint32_t sum[ADC_DRIVER_CHANNEL_COUNT] = {};
+    bool res = true;
+
+    ReadConversions(sum, sample->conversions);
+
+    for(uint16_t idx = 0; idx < ADC_DRIVER_CHANNEL_COUNT; ++idx){
+        uint32_t count = sample->conversions[idx];
+        if(count == 0){
+            res = false;
+        }else{
+            sAdcSetting[idx].lastRaw = (sum[idx] + (count / 2U)) / count;
+        }
+
+        uint32_t voltage = esp_adc_cal_raw_to_voltage(sAdcSetting[idx].lastRaw, &sAdcSetting[idx].characteristic);
+        sample->milliVolt[idx] = voltage * ADC_INPUT_DIVIDER;
+    }
+
+    sLastSample = *sample;
+    sLastReadUs = esp_timer_get_time();
 
-    float res = voltage * 2.0f; // at the input there is a voltage divider by 2
     return res;
-}
\ No newline at end of file
+}
+
+static void UpdateLastSample(void)
+{
+    // the conversions belong to the periodic reader if there is one
+    if((esp_timer_get_time() - sLastReadUs) <= LAST_SAMPLE_MAX_AGE_US){
+        return;
+    }
+
+    AdcDriverSample_t sample = {};
+    ReadSample(&sample);
+}
+
+static void ReadConversions(uint32_t sum[ADC_DRIVER_CHANNEL_COUNT], uint32_t count[ADC_DRIVER_CHANNEL_COUNT])
+{
+    memset(count, 0, ADC_DRIVER_CHANNEL_COUNT * sizeof(uint32_t));
+
+    // empties the DMA ring buffer, an overflow drops the oldest frames and is not an error
+    for(uint16_t frame = 0; frame <= (ADC_STORE_BUFFER_SIZE / ADC_FRAME_SIZE); ++frame){
+        uint32_t length = ReadFrame();
+        if(length == 0){
+            return;
+        }
+
+        for(uint32_t offset = 0; (offset + ADC_CONVERSION_SIZE) <= length; offset += ADC_CONVERSION_SIZE){
+            const adc_digi_output_data_t* data = (const adc_digi_output_data_t*)&sReadBuffer[offset];
+
+            for(uint16_t idx = 0; idx < ADC_DRIVER_CHANNEL_COUNT; ++idx){
+                if(data->type1.channel == sAdcSetting[idx].channel){
+                    sum[idx] += data->type1.data;
+                    count[idx] += 1;
+                }
+            }
+        }
+    }
+}
+
+#ifdef ADC_DIGI_CONTINUOUS
+
+static bool StartConversion(void)
+{
+    adc_digi_init_config_t initConfig = {
+        .max_store_buf_size = ADC_STORE_BUFFER_SIZE,
+        .conv_num_each_intr = ADC_FRAME_SIZE,
+    };
+    adc_digi_pattern_config_t pattern[ADC_DRIVER_CHANNEL_COUNT] = {};
+
+    for(uint16_t idx = 0; idx < ADC_DRIVER_CHANNEL_COUNT; ++idx){
+        initConfig.adc1_chan_mask |= (1U << sAdcSetting[idx].channel);
+
+        pattern[idx].atten = ADC_ATTEN;
+        pattern[idx].channel = sAdcSetting[idx].channel;
+        pattern[idx].unit = 0;                              // ADC1
+        pattern[idx].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_digi_configuration_t config = {
+        .conv_limit_en = true,
+        .conv_limit_num = ADC_CONVERSION_LIMIT,
+        .pattern_num = ADC_DRIVER_CHANNEL_COUNT,
+        .adc_pattern = pattern,
+        .sample_freq_hz = ADC_SAMPLE_FREQ_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+    };
+
+    if(adc_digi_initialize(&initConfig) != ESP_OK){
+        ESP_LOGE(TAG, "continuous mode init fail");
+        return false;
+    }
+
+    if(adc_digi_controller_configure(&config) != ESP_OK){
+        ESP_LOGE(TAG, "continuous mode config fail");
+        return false;
+    }
+
+    return (adc_digi_start() == ESP_OK);
+}
+
+static uint32_t ReadFrame(void)
+{
+    uint32_t length = 0;
+    esp_err_t res = adc_digi_read_bytes(sReadBuffer, ADC_FRAME_SIZE, &length, 0);
+    if((res != ESP_OK) && (res != ESP_ERR_INVALID_STATE)){
+        return 0;
+    }
+
+    return length;
+}
+
+#else
+
+static bool StartConversion(void)
+{
+    i2s_config_t i2sConfig = {
+        .mode = I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN,
+        .sample_rate = ADC_SAMPLE_FREQ_HZ,
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+        .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
+        .communication_format = I2S_COMM_FORMAT_STAND_I2S,
+        .intr_alloc_flags = 0,
+        .dma_buf_count = ADC_I2S_DMA_BUF_COUNT,
+        .dma_buf_len = ADC_I2S_DMA_BUF_LEN,
+        .use_apll = false,
+    };
+    adc_digi_pattern_table_t pattern[ADC_DRIVER_CHANNEL_COUNT] = {};
+
+    for(uint16_t idx = 0; idx < ADC_DRIVER_CHANNEL_COUNT; ++idx){
+        // routes the pad to the ADC
+        adc1_config_channel_atten((adc1_channel_t)sAdcSetting[idx].channel, ADC_ATTEN);
+
+        pattern[idx].atten = ADC_ATTEN;
+        pattern[idx].bit_width = ADC_WIDTH;
+        pattern[idx].channel = sAdcSetting[idx].channel;
+    }
+
+    adc_digi_config_t config = {
+        .conv_limit_en = true,
+        .conv_limit_num = ADC_CONVERSION_LIMIT,
+        .adc1_pattern_len = ADC_DRIVER_CHANNEL_COUNT,
+        .adc1_pattern = pattern,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_FORMAT_12BIT,
+    };
+
+    if(i2s_driver_install(ADC_I2S_PORT, &i2sConfig, 0, NULL) != ESP_OK){
+        ESP_LOGE(TAG, "i2s adc mode init fail");
+        return false;
+    }
+
+    // the I2S ADC mode takes one channel, the pattern of both channels replaces it once the mode is enabled
+    if((i2s_set_adc_mode(ADC_UNIT_1, (adc1_channel_t)sAdcSetting[0].channel) != ESP_OK) || (i2s_adc_enable(ADC_I2S_PORT) != ESP_OK)){
+        ESP_LOGE(TAG, "i2s adc mode enable fail");
+        return false;
+    }
+
+    if(adc_digi_controller_config(&config) != ESP_OK){
+        ESP_LOGE(TAG, "i2s adc mode config fail");
+        return false;
+    }
+
+    return true;
+}
+
+static uint32_t ReadFrame(void)
+{
+    size_t length = 0;
+    if(i2s_read(ADC_I2S_PORT, sReadBuffer, ADC_FRAME_SIZE, &length, 0) != ESP_OK){
+        return 0;
+    }
+
+    return (uint32_t)length;
+}
+
+#endif
@@ -29,22 +29,34 @@ typedef enum{
                        PUBLIC STRUCTS
 *****************************************************************************/
 
+typedef struct{
+    uint32_t milliVolt[ADC_DRIVER_CHANNEL_COUNT];
+    uint32_t conversions[ADC_DRIVER_CHANNEL_COUNT];     // conversions averaged into the value
+}AdcDriverSample_t;
+
 /*****************************************************************************
                          PUBLIC INTERFACE DECLARATION
 *****************************************************************************/
 
-/** @brief Adc driver initialization
+/** @brief Adc driver initialization, starts continuous conversion of all channels
  *  @return return true if success 
  */
 bool AdcDriverInit(void);
 
-/** @brief Get raw data from ADC
+/** @brief Read conversions taken since the last read, oversampled to one value per channel,
+ *         does not wait for conversions, one periodic reader gets all of them
+ *  @param sample [out] pointer to result
+ *  @return return true if every channel has new conversions
+ */
+bool AdcDriverReadSample(AdcDriverSample_t* sample);
+
+/** @brief Get raw data from ADC, the value of the last periodic read or of a new read if there was none in 100 ms
  *  @param adcChannel channel number
  *  @return return raw data
  */
 uint32_t AdcDriverGetRawData(AdcDriverChannel_t adcChannel);
 
-/** @brief Get milli voltage data from ADC
+/** @brief Get milli voltage data from ADC, the value of the last periodic read or of a new read if there was none in 100 ms
  *  @param adcChannel channel number
  *  @return return milli voltage data
  */
@@ -93,6 +93,24 @@ static const char* sFanPwmKeyName[FAN_LEVEL_COUNT] = {
     [FAN_LEVEL_5] = "fanPwmLevel5",
 };
 
+static const char* sFanTachoKeyName[FAN_LEVEL_COUNT] = {
+    [FAN_LEVEL_1] = "fanTachoLevel1",
+    [FAN_LEVEL_2] = "fanTachoLevel2",
+    [FAN_LEVEL_3] = "fanTachoLevel3",
+    [FAN_LEVEL_4] = "fanTachoLevel4",
+    [FAN_LEVEL_5] = "fanTachoLevel5",
+};
+
+// 0 - level not calibrated
+static uint32_t sFanTachoValue[FAN_LEVEL_COUNT];
+
+static const char* sFanPwmFreqKeyName = "fanPwmFreq";
+static const char* sFanPwmBitsKeyName = "fanPwmBits";
+
+// 0 - fan batch not swept
+static uint32_t sFanPwmFreq;
+static uint32_t sFanPwmBits;
+
 static const char* sServiceSettingKeyName[FACTORY_SETTING_SERVICE_COUNT] = {
         [FACTORY_SETTING_SERVICE_HEPA_LIFETIME_HOURS] =         "hepaLifeTime",
         [FACTORY_SETTING_SERVICE_HEPA_WARNING_HOURS] =          "hepaWarnTime",
@@ -280,6 +298,150 @@ bool FactorySettingsGetPwmFanLevel(SettingFanLevel_t levelNumber, uint32_t* pwmV
     return true;
 }
 
+bool FactorySettingsGetTachoFanLevel(SettingFanLevel_t levelNumber, uint32_t* tachoValue)
+{
+    static bool readAllValues = false;
+
+    if(levelNumber >= FAN_LEVEL_COUNT){
+        return false;
+    }
+
+    #if CFG_FACTORY_PARTITION_DISABLE
+        readAllValues = true;
+    #endif
+
+    if(readAllValues == true){
+        *tachoValue = sFanTachoValue[levelNumber];
+
+        return true;
+    }
+
+    nvs_handle_t nvsHandle;
+
+    esp_err_t res = nvs_open_from_partition(PARTITION_NAME, NVS_STORAGE_NAMESPACE, NVS_READONLY, &nvsHandle);
+    if(res != ESP_OK){
+        return false;
+    }
+
+    for(uint16_t idx = 0; idx < FAN_LEVEL_COUNT; ++idx){
+        res = nvs_get_u32 (nvsHandle, sFanTachoKeyName[idx], &sFanTachoValue[idx]);
+        if(res == ESP_ERR_NVS_NOT_FOUND){
+            // devices produced before the speed control have no target speed
+            sFanTachoValue[idx] = 0;
+        }else if(res != ESP_OK){
+            nvs_close(nvsHandle);
+
+            return false;
+        }
+        ESP_LOGI(TAG, "Fan tacho level %d = %d", (idx + 1), sFanTachoValue[idx]);
+    }
+
+    readAllValues = true;
+    nvs_close(nvsHandle);
+
+    *tachoValue = sFanTachoValue[levelNumber];
+
+    return true;
+}
+
+bool FactorySettingsUpdateTachoFanLevel(SettingFanLevel_t levelNumber, uint32_t tachoValue)
+{
+    if(levelNumber >= FAN_LEVEL_COUNT){
+        return false;
+    }
+
+    #if CFG_FACTORY_PARTITION_DISABLE
+        sFanTachoValue[levelNumber] = tachoValue;
+        return true;
+    #endif
+
+    nvs_handle_t nvsHandle;
+    esp_err_t res = nvs_open_from_partition(PARTITION_NAME, NVS_STORAGE_NAMESPACE, NVS_READWRITE, &nvsHandle);
+    if(res != ESP_OK){
+        return false;
+    }
+
+    res = nvs_set_u32(nvsHandle, sFanTachoKeyName[levelNumber], tachoValue);
+    if(res != ESP_OK){
+        nvs_close(nvsHandle);
+        return false;
+    }
+    nvs_close(nvsHandle);
+
+    sFanTachoValue[levelNumber] = tachoValue;
+    ESP_LOGI(TAG, "Fan tacho level %d = %d", (levelNumber + 1), sFanTachoValue[levelNumber]);
+
+    return true;
+}
+
+bool FactorySettingsGetFanPwmConfig(uint32_t* freqHz, uint32_t* resolutionBits)
+{
+    #if CFG_FACTORY_PARTITION_DISABLE
+        *freqHz = sFanPwmFreq;
+        *resolutionBits = sFanPwmBits;
+        return true;
+    #endif
+
+    nvs_handle_t nvsHandle;
+
+    esp_err_t res = nvs_open_from_partition(PARTITION_NAME, NVS_STORAGE_NAMESPACE, NVS_READONLY, &nvsHandle);
+    if(res != ESP_OK){
+        return false;
+    }
+
+    // devices produced before the sweep run the default pwm
+    res = nvs_get_u32(nvsHandle, sFanPwmFreqKeyName, &sFanPwmFreq);
+    if(res == ESP_OK){
+        res = nvs_get_u32(nvsHandle, sFanPwmBitsKeyName, &sFanPwmBits);
+    }
+    nvs_close(nvsHandle);
+
+    if(res == ESP_ERR_NVS_NOT_FOUND){
+        sFanPwmFreq = 0;
+        sFanPwmBits = 0;
+    }else if(res != ESP_OK){
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Fan pwm %d Hz, %d bits", sFanPwmFreq, sFanPwmBits);
+
+    *freqHz = sFanPwmFreq;
+    *resolutionBits = sFanPwmBits;
+
+    return true;
+}
+
+bool FactorySettingsUpdateFanPwmConfig(uint32_t freqHz, uint32_t resolutionBits)
+{
+    #if CFG_FACTORY_PARTITION_DISABLE
+        sFanPwmFreq = freqHz;
+        sFanPwmBits = resolutionBits;
+        return true;
+    #endif
+
+    nvs_handle_t nvsHandle;
+    esp_err_t res = nvs_open_from_partition(PARTITION_NAME, NVS_STORAGE_NAMESPACE, NVS_READWRITE, &nvsHandle);
+    if(res != ESP_OK){
+        return false;
+    }
+
+    res = nvs_set_u32(nvsHandle, sFanPwmFreqKeyName, freqHz);
+    if(res == ESP_OK){
+        res = nvs_set_u32(nvsHandle, sFanPwmBitsKeyName, resolutionBits);
+    }
+    nvs_close(nvsHandle);
+
+    if(res != ESP_OK){
+        return false;
+    }
+
+    sFanPwmFreq = freqHz;
+    sFanPwmBits = resolutionBits;
+    ESP_LOGI(TAG, "Fan pwm %d Hz, %d bits", sFanPwmFreq, sFanPwmBits);
+
+    return true;
+}
+
 bool FactorySettingsGetScheduler(Scheduler_t* scheduler)
 {
     #if CFG_FACTORY_PARTITION_DISABLE
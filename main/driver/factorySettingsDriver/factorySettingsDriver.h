@@ -82,6 +82,34 @@ char* FactorySettingsGetLocation(void);
  */
 bool FactorySettingsGetPwmFanLevel(SettingFanLevel_t levelNumber, uint32_t* pwmValue);
 
+/** @brief Get target tacho speed of the fan level read from factory partition
+ *  @param levelNumber level number
+ *  @param tachoValue [out] pointer to read data, 0 if the level is not calibrated
+ *  @return true if success
+ */
+bool FactorySettingsGetTachoFanLevel(SettingFanLevel_t levelNumber, uint32_t* tachoValue);
+
+/** @brief Save target tacho speed of the fan level to factory partition
+ *  @param levelNumber level number
+ *  @param tachoValue new value, 0 disables speed control of the level
+ *  @return true if success
+ */
+bool FactorySettingsUpdateTachoFanLevel(SettingFanLevel_t levelNumber, uint32_t tachoValue);
+
+/** @brief Get fan pwm frequency and resolution read from factory partition
+ *  @param freqHz [out] pointer to read data, 0 if the fan batch is not swept
+ *  @param resolutionBits [out] pointer to read data, 0 if the fan batch is not swept
+ *  @return true if success
+ */
+bool FactorySettingsGetFanPwmConfig(uint32_t* freqHz, uint32_t* resolutionBits);
+
+/** @brief Save fan pwm frequency and resolution to factory partition
+ *  @param freqHz new value
+ *  @param resolutionBits new value
+ *  @return true if success
+ */
+bool FactorySettingsUpdateFanPwmConfig(uint32_t freqHz, uint32_t resolutionBits);
+
 /** @brief Get default factory  scheduler
  *  @param scheduler [out] pointer to Scheduler_t
  *  @return true if success
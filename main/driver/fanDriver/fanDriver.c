@@ -15,8 +15,15 @@
 
 #include "config.h"
 
+#include <string.h>
+
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+
+#include "freertos/FreeRTOS.h"
 
+#include "driver/gpio.h"
 #include "driver/ledc.h"
 #include "driver/pcnt.h"
 #include "fanDriver.h"
@@ -31,6 +38,23 @@
 
 #define COUNTER_UNIT_NUMBER PCNT_UNIT_0
 
+// duty of the interface is 12 bits for any timer resolution, the level pwm values keep their meaning
+#define PWM_DUTY_BITS (12U)
+#define PWM_DUTY_MAX (0x0fff)
+#define PWM_MIN_RESOLUTION_BITS (8U)
+#define PWM_MAX_RESOLUTION_BITS (14U)
+// the timer counts the APB clock, frequency x 2**resolution can not exceed it
+#define PWM_SOURCE_CLOCK_HZ (80U * 1000U * 1000U)
+// the fade end is not reported by the IDF v4.3 ledc, the ramp is done by time if the duty is not read back
+#define RAMP_DONE_MARGIN_US (100 * 1000)
+
+// sliding window of the edge periods, power of 2
+#define TACHO_PERIODS_COUNT (8U)
+// shorter periods are glitches, 500 count per second is far above the fan max
+#define TACHO_MIN_PERIOD_US (2000)
+// no edge for longer means the fan stands, below 2 count per second
+#define TACHO_STALL_PERIOD_US (500 * 1000)
+
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
 *****************************************************************************/
@@ -44,24 +68,61 @@ static ledc_channel_config_t sPwmChannel = {
     .timer_sel  = PWM_TIMER_NUMBER
 };
 
+static const char *TAG = "fanD";
+
+static uint32_t sPwmFreqHz = CFG_FAN_PWM_DEFAULT_FREQ_HZ;
+static uint8_t sPwmResolutionBits = CFG_FAN_PWM_DEFAULT_RESOLUTION_BITS;
+
+// timer duty of the ramp end
+static uint32_t sRampDuty;
+static int64_t sRampEndUs;
+
+static portMUX_TYPE sTachoLock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t sTachoLastEdgeUs;
+static uint32_t sTachoPeriodsUs[TACHO_PERIODS_COUNT];
+static uint8_t sTachoPeriodIdx;
+static uint8_t sTachoPeriodsCount;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Configure PWM timer
+ *  @param freqHz frequency of PWM signal
+ *  @param resolutionBits resolution of PWM duty
+ *  @return return true if success
+ */
+static bool ConfigTimer(uint32_t freqHz, uint8_t resolutionBits);
+
+/** @brief Convert 12 bits duty to the timer duty
+ *  @param duty 12 bits duty
+ *  @return timer duty
+ */
+static uint32_t ToTimerDuty(uint32_t duty);
+
+/** @brief End running ramp at the present duty. A running fade holds the channel fade
+ *         semaphore until its end, any next duty set of the ledc would wait for it
+ *  @return return true if success
+ */
+static bool StopRamp(void);
+
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
 *****************************************************************************/
 
 bool FanDriverInit(void)
 {
-     ledc_timer_config_t pwmTimer = {
-        .duty_resolution = LEDC_TIMER_12_BIT,   // resolution of PWM duty
-        .freq_hz = 5U * 1000U,                  // frequency of PWM signal
-        .speed_mode = PWM_SPEED_MODE,           // timer mode
-        .timer_num = PWM_TIMER_NUMBER,          // timer index
-        .clk_cfg = LEDC_AUTO_CLK,               // Auto select the source clock
-    };
-
      /* Initialize LEDC unit */
-    ledc_timer_config(&pwmTimer);
+    if(ConfigTimer(sPwmFreqHz, sPwmResolutionBits) == false){
+        return false;
+    }
     ledc_channel_config(&sPwmChannel);
 
+    /* Hardware fade for the duty ramps, thread safe duty set */
+    if(ledc_fade_func_install(0) != ESP_OK){
+        return false;
+    }
+
     pcnt_config_t counter = {
         // Set PCNT input signal and control GPIOs
         .pulse_gpio_num = CFG_FAN_TACHO_GPIO_PIN,
@@ -81,22 +142,106 @@ bool FanDriverInit(void)
     /* Start counting */
     pcnt_counter_resume(COUNTER_UNIT_NUMBER);
 
+#if CFG_FAN_TACHO_PERIOD_MEASUREMENT
+    /* Edge periods of the same pin, handler added by the gpio isr driver */
+    gpio_set_intr_type(CFG_FAN_TACHO_GPIO_PIN, GPIO_INTR_POSEDGE);
+    gpio_intr_enable(CFG_FAN_TACHO_GPIO_PIN);
+#endif
+
     return true;
 }
 
 bool FanDriverSetDuty(uint32_t duty)
 {
-    if(duty > 0x0fff)
+    return FanDriverSetDutyWithRamp(duty, 0);
+}
+
+bool FanDriverSetDutyWithRamp(uint32_t duty, uint32_t rampMs)
+{
+    if(duty > PWM_DUTY_MAX)
     {
         return false;
     }
 
-    ledc_set_duty(sPwmChannel.speed_mode, sPwmChannel.channel, duty);
-    ledc_update_duty(sPwmChannel.speed_mode, sPwmChannel.channel);
+    uint32_t timerDuty = ToTimerDuty(duty);
+
+    // the new duty, ramped or not, is set without waiting for the running ramp
+    if((FanDriverIsRampDone() == false) && (StopRamp() == false)){
+        return false;
+    }
+
+    esp_err_t res;
+    if((rampMs == 0) || (timerDuty == ledc_get_duty(sPwmChannel.speed_mode, sPwmChannel.channel))){
+        res = ledc_set_duty_and_update(sPwmChannel.speed_mode, sPwmChannel.channel, timerDuty, sPwmChannel.hpoint);
+        rampMs = 0;
+    }else{
+        res = ledc_set_fade_time_and_start(sPwmChannel.speed_mode, sPwmChannel.channel, timerDuty, rampMs, LEDC_FADE_NO_WAIT);
+    }
+
+    if(res != ESP_OK){
+        return false;
+    }
+
+    sRampDuty = timerDuty;
+    sRampEndUs = esp_timer_get_time() + (int64_t)rampMs * 1000LL;
 
     return true;
 }
 
+bool FanDriverIsRampDone(void)
+{
+    if(ledc_get_duty(sPwmChannel.speed_mode, sPwmChannel.channel) == sRampDuty){
+        return true;
+    }
+
+    return esp_timer_get_time() > (sRampEndUs + RAMP_DONE_MARGIN_US);
+}
+
+uint32_t FanDriverGetDuty(void)
+{
+    uint32_t timerDuty = ledc_get_duty(sPwmChannel.speed_mode, sPwmChannel.channel);
+
+    if(sPwmResolutionBits >= PWM_DUTY_BITS){
+        return timerDuty >> (sPwmResolutionBits - PWM_DUTY_BITS);
+    }
+
+    return timerDuty << (PWM_DUTY_BITS - sPwmResolutionBits);
+}
+
+bool FanDriverSetPwmConfig(uint32_t freqHz, uint8_t resolutionBits)
+{
+    if((resolutionBits < PWM_MIN_RESOLUTION_BITS) || (resolutionBits > PWM_MAX_RESOLUTION_BITS) || (freqHz == 0)){
+        return false;
+    }
+
+    if(freqHz > (PWM_SOURCE_CLOCK_HZ >> resolutionBits)){
+        return false;
+    }
+
+    // a running ramp ends at once, the duty is kept in the new resolution
+    if((FanDriverIsRampDone() == false) && (StopRamp() == false)){
+        return false;
+    }
+    uint32_t duty = FanDriverGetDuty();
+
+    if(ConfigTimer(freqHz, resolutionBits) == false){
+        ConfigTimer(sPwmFreqHz, sPwmResolutionBits);
+        FanDriverSetDuty(duty);
+        return false;
+    }
+
+    sPwmFreqHz = freqHz;
+    sPwmResolutionBits = resolutionBits;
+
+    return FanDriverSetDuty(duty);
+}
+
+void FanDriverGetPwmConfig(uint32_t* freqHz, uint8_t* resolutionBits)
+{
+    *freqHz = sPwmFreqHz;
+    *resolutionBits = sPwmResolutionBits;
+}
+
 int16_t FanDriverGetTachoCount(void)
 {
     int16_t count;
@@ -105,4 +250,118 @@ int16_t FanDriverGetTachoCount(void)
     pcnt_counter_clear(COUNTER_UNIT_NUMBER);
 
     return count;
-}
\ No newline at end of file
+}
+
+uint32_t FanDriverGetTachoMilliSpeed(void)
+{
+    uint32_t periodsUs[TACHO_PERIODS_COUNT];
+
+    portENTER_CRITICAL(&sTachoLock);
+    int64_t lastEdgeUs = sTachoLastEdgeUs;
+    uint8_t periodsCount = sTachoPeriodsCount;
+    memcpy(periodsUs, sTachoPeriodsUs, sizeof(periodsUs));
+    portEXIT_CRITICAL(&sTachoLock);
+
+    int64_t sinceEdgeUs = esp_timer_get_time() - lastEdgeUs;
+    if((periodsCount == 0) || (sinceEdgeUs > TACHO_STALL_PERIOD_US)){
+        return 0;
+    }
+
+    uint32_t sumUs = 0;
+    for(uint8_t idx = 0; idx < periodsCount; ++idx){
+        sumUs += periodsUs[idx];
+    }
+
+    // a slowing fan has no new edge yet, the time from the last one bounds the period
+    uint32_t meanUs = sumUs / periodsCount;
+    if(sinceEdgeUs > meanUs){
+        meanUs = (uint32_t)sinceEdgeUs;
+    }
+
+    return (uint32_t)((1000ULL * 1000ULL * 1000ULL) / meanUs);
+}
+
+void IRAM_ATTR FanDriverTachoIrqCallback(void* arg)
+{
+    if((uint32_t)arg != CFG_FAN_TACHO_GPIO_PIN){
+        return;
+    }
+
+    int64_t nowUs = esp_timer_get_time();
+    int64_t periodUs = nowUs - sTachoLastEdgeUs;
+
+    if(periodUs < TACHO_MIN_PERIOD_US){
+        return;
+    }
+
+    portENTER_CRITICAL_ISR(&sTachoLock);
+    if(periodUs > TACHO_STALL_PERIOD_US){
+        // first edge after the stop, no period yet
+        sTachoPeriodsCount = 0;
+    }else{
+        sTachoPeriodsUs[sTachoPeriodIdx] = (uint32_t)periodUs;
+        sTachoPeriodIdx = (sTachoPeriodIdx + 1) & (TACHO_PERIODS_COUNT - 1);
+        if(sTachoPeriodsCount < TACHO_PERIODS_COUNT){
+            sTachoPeriodsCount += 1;
+        }
+    }
+    sTachoLastEdgeUs = nowUs;
+    portEXIT_CRITICAL_ISR(&sTachoLock);
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static bool ConfigTimer(uint32_t freqHz, uint8_t resolutionBits)
+{
+    ledc_timer_config_t pwmTimer = {
+        .duty_resolution = (ledc_timer_bit_t)resolutionBits,   // resolution of PWM duty
+        .freq_hz = freqHz,                                      // frequency of PWM signal
+        .speed_mode = PWM_SPEED_MODE,                           // timer mode
+        .timer_num = PWM_TIMER_NUMBER,                          // timer index
+        .clk_cfg = LEDC_AUTO_CLK,                               // Auto select the source clock
+    };
+
+    return (ledc_timer_config(&pwmTimer) == ESP_OK);
+}
+
+static uint32_t ToTimerDuty(uint32_t duty)
+{
+    if(sPwmResolutionBits >= PWM_DUTY_BITS){
+        return duty << (sPwmResolutionBits - PWM_DUTY_BITS);
+    }
+
+    // rounded, the full duty stays full
+    uint8_t shift = PWM_DUTY_BITS - sPwmResolutionBits;
+    uint32_t timerDuty = (duty + (1U << (shift - 1U))) >> shift;
+    uint32_t timerDutyMax = (1U << sPwmResolutionBits) - 1U;
+
+    return (timerDuty > timerDutyMax) ? timerDutyMax : timerDuty;
+}
+
+static bool StopRamp(void)
+{
+    uint32_t timerDuty = ledc_get_duty(sPwmChannel.speed_mode, sPwmChannel.channel);
+    bool res = true;
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    res &= (ledc_fade_stop(sPwmChannel.speed_mode, sPwmChannel.channel) == ESP_OK);
+#else
+    // no fade stop in IDF v4.x: without the fade service the duty is written directly, the new
+    // duty without steps ends the hardware fade, the service is installed again for the next ramp
+    ledc_fade_func_uninstall();
+    res &= (ledc_set_duty_with_hpoint(sPwmChannel.speed_mode, sPwmChannel.channel, timerDuty, sPwmChannel.hpoint) == ESP_OK);
+    res &= (ledc_update_duty(sPwmChannel.speed_mode, sPwmChannel.channel) == ESP_OK);
+    res &= (ledc_fade_func_install(0) == ESP_OK);
+#endif
+
+    sRampDuty = timerDuty;
+    sRampEndUs = esp_timer_get_time();
+
+    if(res == false){
+        ESP_LOGE(TAG, "ramp not stopped");
+    }
+
+    return res;
+}
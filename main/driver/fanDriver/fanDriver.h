@@ -24,13 +24,54 @@
  */
 bool FanDriverInit(void);
 
-/** @brief Set PWM duty
- *  @param duty range of duty setting is [0, (2**12) - 1]
+/** @brief Set PWM duty at once, a running ramp is stopped
+ *  @param duty range of duty setting is [0, (2**12) - 1], scaled to the timer resolution
  *  @return return true if success
  */
 bool FanDriverSetDuty(uint32_t duty);
 
+/** @brief Ramp PWM duty linearly by the hardware fade, a running ramp is stopped at its present duty first,
+ *         the call doesn't wait for its end
+ *  @param duty range of duty setting is [0, (2**12) - 1]
+ *  @param rampMs ramp time, 0 sets the duty at once
+ *  @return return true if success
+ */
+bool FanDriverSetDutyWithRamp(uint32_t duty, uint32_t rampMs);
+
+/** @brief Check if the last ramp has reached its duty
+ *  @return true if done
+ */
+bool FanDriverIsRampDone(void);
+
+/** @brief Get actual PWM duty, changes during the ramp
+ *  @return duty
+ */
+uint32_t FanDriverGetDuty(void);
+
+/** @brief Change PWM frequency and timer resolution, the duty stays in 12 bits and is kept
+ *  @param freqHz frequency of PWM signal
+ *  @param resolutionBits timer resolution, 8 - 14 bits, frequency x 2**resolution up to 80 MHz
+ *  @return return true if success, the previous setting stays on failure
+ */
+bool FanDriverSetPwmConfig(uint32_t freqHz, uint8_t resolutionBits);
+
+/** @brief Get PWM frequency and timer resolution
+ *  @param freqHz [out] frequency of PWM signal
+ *  @param resolutionBits [out] timer resolution
+ */
+void FanDriverGetPwmConfig(uint32_t* freqHz, uint8_t* resolutionBits);
+
 /** @brief Get tacho count from fan
  *  @return actual count values
  */
-int16_t FanDriverGetTachoCount(void);
\ No newline at end of file
+int16_t FanDriverGetTachoCount(void);
+
+/** @brief Get tacho speed from the mean period of the last tacho edges
+ *  @return tacho count per second x 1000, 0 if the fan stands
+ */
+uint32_t FanDriverGetTachoMilliSpeed(void);
+
+/** @brief Callback function executed from gpio ISR on tacho rising edge, takes the edge period
+ *  @param arg pin number
+ */
+void FanDriverTachoIrqCallback(void* arg);
\ No newline at end of file
@@ -17,12 +17,12 @@
 
 #include <string.h>
 
-#include "driver/i2c.h"
-#include "hal/i2c_types.h"
+#include "driver/gpio.h"
 
 #include "esp_log.h"
 
 #include "gpioExpanderDriver/gpioExpanderDriver.h"
+#include "i2cBusDriver/i2cBusDriver.h"
 
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
@@ -32,10 +32,8 @@
 #define PCA9534_GPIO_AS_INPUT       (1)
 
 #define PCA9534_I2C_ADDRESS         (0x3A)
-#define I2C_PORT_NUMBER             (CFG_I2C_PORT_NUMBER)
 
-#define PCA9534_WTITE_TIMEOUT_MS    (1000U)
-#define PCA9534_READ_TIMEOUT_MS     (1000U)
+#define PCA9534_TIMEOUT_MS          (1000U)
 
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS
@@ -60,7 +58,16 @@ typedef union
                      PRIVATE VARIABLES
 *****************************************************************************/
 
-static i2c_port_t sI2cPortNumber = I2C_PORT_NUMBER;
+static const I2cBusDevice_t sPca9534Device = {
+    .address = PCA9534_I2C_ADDRESS,
+    .priority = I2C_BUS_PRIORITY_NORMAL,
+    .timeoutMs = PCA9534_TIMEOUT_MS,
+    .isStopBeforeRead = false,
+};
+
+// last written output port, outputs are changed without reading the port back
+static Pca9534Reg_t sOutput;
+
 static bool sExpanderIrqIsSet;
 static bool sBuzzerIsOn;
 static const char* TAG = "ExpaD";
@@ -83,11 +90,11 @@ static bool Pca9534Read(Pca9534RegAddr_t registerAddress, uint8_t *readValue);
  */
 static bool Pca9534Write(Pca9534RegAddr_t registerAddress, uint8_t writeValue);
 
-/** @brief Set gpio configuration
- *  @param config configuration bX -> 0 - gpio as output, 1 - gpio as input
+/** @brief Write output port and keep it as the last written value
+ *  @param output output port value
  *  @return return true if success
  */
-static bool GpioExpanderSetGpioConfiguration(GpioExpanderPinout_t config);
+static bool Pca9534SetOutput(Pca9534Reg_t output);
 
 /** @brief  Initialize Interrupt pin as input
  *  @return return true if success
@@ -101,34 +108,47 @@ static bool GpioInterruptPinInit(void);
 bool GpioExpanderDriverInit(void)
 {
     bool res = true;
-    uint8_t readConf = 0;
-    
+    Pca9534Reg_t readConf = {};
+
     // output must be set first or there will be a short sound of buzzer
     Pca9534Reg_t output = {};
     res &= Pca9534Read(OUTPUT_PORT_REGISTER_ADDRESS, &output.byte);
     output.pinout.buzzer = 0;
     output.pinout.ledEnable = 0;
-    res &= GpioExpanderDriverSetOutputPort(output.pinout);
 
-    GpioExpanderPinout_t configuration = {
-        .wifiSwitch = PCA9534_GPIO_AS_INPUT,
-        .limitSwitch3 = PCA9534_GPIO_AS_INPUT,
-        .limitSwitch2 = PCA9534_GPIO_AS_INPUT,
-        .limitSwitch1 = PCA9534_GPIO_AS_INPUT,
+    Pca9534Reg_t configuration = {
+        .pinout = {
+            .wifiSwitch = PCA9534_GPIO_AS_INPUT,
+            .limitSwitch3 = PCA9534_GPIO_AS_INPUT,
+            .limitSwitch2 = PCA9534_GPIO_AS_INPUT,
+            .limitSwitch1 = PCA9534_GPIO_AS_INPUT,
 
-        .ledEnable = PCA9534_GPIO_AS_OUTPUT,
-        .buzzer = PCA9534_GPIO_AS_OUTPUT,
+            .ledEnable = PCA9534_GPIO_AS_OUTPUT,
+            .buzzer = PCA9534_GPIO_AS_OUTPUT,
 
-        .nc1 = PCA9534_GPIO_AS_INPUT,
-        .nc2 = PCA9534_GPIO_AS_INPUT,
+            .nc1 = PCA9534_GPIO_AS_INPUT,
+            .nc2 = PCA9534_GPIO_AS_INPUT,
+        },
     };
 
-    res &= GpioExpanderSetGpioConfiguration(configuration);
-    res &= Pca9534Read(CONFIGURATION_REGISTER_ADDRESS, &readConf);
+    ESP_LOGI(TAG, "output %X", output.byte);
+    ESP_LOGI(TAG, "config %X", configuration.byte);
 
-    int cmpRes = memcmp(&configuration, &readConf, sizeof(Pca9534Reg_t));
-    if(cmpRes != 0){
-        ESP_LOGI(TAG, "incorrect config %X", readConf);
+    // output, configuration and configuration read back in this order in one bus transaction
+    const I2cBusTransfer_t transfers[] = {
+        { .dir = I2C_BUS_TRANSFER_WRITE, .registerAddress = OUTPUT_PORT_REGISTER_ADDRESS, .data = &output.byte, .length = 1 },
+        { .dir = I2C_BUS_TRANSFER_WRITE, .registerAddress = CONFIGURATION_REGISTER_ADDRESS, .data = &configuration.byte, .length = 1 },
+        { .dir = I2C_BUS_TRANSFER_READ, .registerAddress = CONFIGURATION_REGISTER_ADDRESS, .data = &readConf.byte, .length = 1 },
+    };
+
+    bool isWritten = I2cBusDriverBurst(&sPca9534Device, transfers, sizeof(transfers) / sizeof(transfers[0]));
+    if(isWritten == true){
+        sOutput = output;
+    }
+    res &= isWritten;
+
+    if(readConf.byte != configuration.byte){
+        ESP_LOGI(TAG, "incorrect config %X", readConf.byte);
         res = false;
     }
 
@@ -141,7 +161,7 @@ bool GpioExpanderDriverSetOutputPort(GpioExpanderPinout_t outputPort)
 {
     Pca9534Reg_t reg = {.pinout = outputPort};
     ESP_LOGI(TAG, "output %X", reg.byte);
-    return Pca9534Write(OUTPUT_PORT_REGISTER_ADDRESS, reg.byte);
+    return Pca9534SetOutput(reg);
 }
 
 bool GpioExpanderDriverGetInputPort(GpioExpanderPinout_t *inputPort)
@@ -157,30 +177,24 @@ bool GpioExpanderDriverGetInputPort(GpioExpanderPinout_t *inputPort)
 
 bool GpioExpanderDriverBuzzerOff(void)
 {
-    bool res = true;
-    Pca9534Reg_t readValue = {};
+    Pca9534Reg_t output = sOutput;
 
-    res &= Pca9534Read(OUTPUT_PORT_REGISTER_ADDRESS, &readValue.byte);
     // cppcheck-suppress unreadVariable
-    readValue.pinout.buzzer = false;
+    output.pinout.buzzer = false;
     sBuzzerIsOn = false;
-    res &= Pca9534Write(OUTPUT_PORT_REGISTER_ADDRESS, readValue.byte);
 
-    return res;
+    return Pca9534SetOutput(output);
 }
 
 bool GpioExpanderDriverBuzzerOn(void)
 {
-    bool res = true;
-    Pca9534Reg_t readValue = {};
+    Pca9534Reg_t output = sOutput;
 
-    res &= Pca9534Read(OUTPUT_PORT_REGISTER_ADDRESS, &readValue.byte);
     // cppcheck-suppress unreadVariable
-    readValue.pinout.buzzer = true;
+    output.pinout.buzzer = true;
     sBuzzerIsOn = true;
-    res &= Pca9534Write(OUTPUT_PORT_REGISTER_ADDRESS, readValue.byte);
 
-    return res;
+    return Pca9534SetOutput(output);
 }
 
 bool GpioExpanderDriverIsBuzzerOn(void)
@@ -190,28 +204,22 @@ bool GpioExpanderDriverIsBuzzerOn(void)
 
 bool GpioExpanderDriverLedOff(void)
 {
-    bool res = true;
-    Pca9534Reg_t readValue = {};
+    Pca9534Reg_t output = sOutput;
 
-    res &= Pca9534Read(OUTPUT_PORT_REGISTER_ADDRESS, &readValue.byte);
     // cppcheck-suppress unreadVariable
-    readValue.pinout.ledEnable = false;
-    res &= Pca9534Write(OUTPUT_PORT_REGISTER_ADDRESS, readValue.byte);
+    output.pinout.ledEnable = false;
 
-    return res;
+    return Pca9534SetOutput(output);
 }
 
 bool GpioExpanderDriverLedOn(void)
 {
-    bool res = true;
-    Pca9534Reg_t readValue = {};
+    Pca9534Reg_t output = sOutput;
 
-    res &= Pca9534Read(OUTPUT_PORT_REGISTER_ADDRESS, &readValue.byte);
     // cppcheck-suppress unreadVariable
-    readValue.pinout.ledEnable = true;
-    res &= Pca9534Write(OUTPUT_PORT_REGISTER_ADDRESS, readValue.byte);
+    output.pinout.ledEnable = true;
 
-    return res;
+    return Pca9534SetOutput(output);
 }
 
 bool GpioExpanderDriverIsInterruptSet(void)
@@ -266,63 +274,7 @@ static bool Pca9534Read(Pca9534RegAddr_t registerAddress, uint8_t *readValue)
         }
     }
 
-    bool res = true;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-
-    /*
-     * ______________________________________________________
-     * | start | slave_addr + wr_bit + ack | command_byte + ack  |
-     * --------|---------------------------|-----------------|
-    */
-    esp_err_t esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, PCA9534_I2C_ADDRESS << 1 | I2C_MASTER_WRITE, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, registerAddress, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    /*
-     * ______________________________________________________________
-     * | start | slave_addr + rd_bit + ack | reg_data + nack | stop |
-     * --------|---------------------------|-----------------|------|
-    */
-    esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, PCA9534_I2C_ADDRESS << 1 | I2C_MASTER_READ, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_read(cmd, readValue, 1, I2C_MASTER_LAST_NACK);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, PCA9534_READ_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    return res;
+    return I2cBusDriverRead(&sPca9534Device, registerAddress, readValue, 1);
 }
 
 static bool Pca9534Write(Pca9534RegAddr_t registerAddress, uint8_t writeValue)
@@ -341,55 +293,17 @@ static bool Pca9534Write(Pca9534RegAddr_t registerAddress, uint8_t writeValue)
         }
     }
 
-    bool res = true;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    /*
-     * _____________________________________________________________________________________________________
-     * | start | slave_addr + wr_bit + ack | reg_addr + ack  | reg_data + ack | ... | reg_data + ack | stop |
-     * --------|---------------------------|-----------------|----------------|-----|----------------|------|
-    */
-    esp_err_t esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, PCA9534_I2C_ADDRESS << 1 | I2C_MASTER_WRITE, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, registerAddress, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write(cmd, &writeValue, 1, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, PCA9534_WTITE_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    return res;
+    return I2cBusDriverWrite(&sPca9534Device, registerAddress, &writeValue, 1);
 }
 
-static bool GpioExpanderSetGpioConfiguration(GpioExpanderPinout_t config)
+static bool Pca9534SetOutput(Pca9534Reg_t output)
 {
-    Pca9534Reg_t reg = {.pinout = config};
-    ESP_LOGI(TAG, "config %X", reg.byte);
+    bool res = Pca9534Write(OUTPUT_PORT_REGISTER_ADDRESS, output.byte);
+    if(res == true){
+        sOutput = output;
+    }
 
-    return Pca9534Write(CONFIGURATION_REGISTER_ADDRESS, reg.byte);
+    return res;
 }
 
 static bool GpioInterruptPinInit(void)
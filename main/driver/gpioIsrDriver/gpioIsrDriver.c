@@ -19,6 +19,8 @@
 
 #include "gpioIsrDriver.h"
 #include "gpioExpanderDriver/gpioExpanderDriver.h"
+#include "touchDriver/touchDriver.h"
+#include "fanDriver/fanDriver.h"
 
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
@@ -39,6 +41,22 @@ static void IRAM_ATTR gpio_isr_handler(void* arg)
     GpioExpanderDriverIrqChangeCallback(arg);
 }
 
+/** @brief ISR handler function of the touch ALERT pin
+ *  @param arg parameter for ISR handler (in this solution the pin number)
+ */
+static void IRAM_ATTR touch_alert_isr_handler(void* arg)
+{
+    TouchDriverAlertIrqCallback(arg);
+}
+
+/** @brief ISR handler function of the fan tacho pin
+ *  @param arg parameter for ISR handler (in this solution the pin number)
+ */
+static void IRAM_ATTR fan_tacho_isr_handler(void* arg)
+{
+    FanDriverTachoIrqCallback(arg);
+}
+
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
 *****************************************************************************/
@@ -49,6 +67,10 @@ bool GpioIsrDriverInit(void)
     gpio_install_isr_service(ESP_INTR_FLAG_DEFAULT);
 
     gpio_isr_handler_add(CFG_GPIO_EXPANDER_INT_GPIO_PIN, gpio_isr_handler, (void*) CFG_GPIO_EXPANDER_INT_GPIO_PIN);
+    gpio_isr_handler_add(CFG_TOUCH_INTERRUPT_PIN, touch_alert_isr_handler, (void*) CFG_TOUCH_INTERRUPT_PIN);
+#if CFG_FAN_TACHO_PERIOD_MEASUREMENT
+    gpio_isr_handler_add(CFG_FAN_TACHO_GPIO_PIN, fan_tacho_isr_handler, (void*) CFG_FAN_TACHO_GPIO_PIN);
+#endif
         
     return true;
 }
\ No newline at end of file
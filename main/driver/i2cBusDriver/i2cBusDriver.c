@@ -0,0 +1,654 @@
+/**
+ * @file i2cBusDriver.c
+ *
+ * @brief I2C bus manager source file
+ *
+ * All devices on CFG_I2C_PORT_NUMBER go through one bus lock. A transaction
+ * waiting for the lock with lower priority gives way to higher priority ones
+ * still waiting, so touch reads are not queued behind rtc or expander access.
+ * Transfers of a burst are sent in one command link and one bus acquisition.
+ * IDF v4.3 has no static command links, there the links of each transaction
+ * shape are allocated once and sent again with new data under the bus lock.
+ * The bus runs at CFG_I2C_FREQ_HZ.
+ *
+ * @dir i2cBusDriver
+ * @brief I2C bus manager folder
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "i2cBusDriver.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "driver/i2c.h"
+#include "hal/i2c_types.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+ *****************************************************************************/
+
+#define I2C_PORT_NUMBER (CFG_I2C_PORT_NUMBER)
+
+#define PRIORITY_YIELD_DELAY_MS (1U)
+
+// static command links are available from IDF v4.4, older versions allocate the link on heap
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0)
+#define I2C_BUS_STATIC_CMD_LINK (1)
+// up to 7 commands per transfer: start, address, register, start, address, read, last read
+#define CMD_LINK_BUFFER_SIZE (I2C_LINK_RECOMMENDED_SIZE(2U * CFG_I2C_BUS_MAX_BURST_TRANSFERS))
+#else
+// transaction shapes with a kept command link, the drivers use about a dozen
+#define CMD_LINK_CACHE_SIZE (16U)
+// register data of a cached transaction, larger ones allocate the link per transaction
+#define CMD_LINK_DATA_SIZE (32U)
+// a stop before each read starts a new link
+#define CMD_LINK_MAX_LINKS (CFG_I2C_BUS_MAX_BURST_TRANSFERS + 1U)
+#endif
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+static const char* TAG = "i2cBus";
+
+static const i2c_config_t sConfig = {
+    .mode = I2C_MODE_MASTER,
+    .sda_io_num = CFG_I2C_DATA_PIN,
+    .sda_pullup_en = GPIO_PULLUP_ENABLE,
+    .scl_io_num = CFG_I2C_CLK_PIN,
+    .scl_pullup_en = GPIO_PULLUP_ENABLE,
+    .master.clk_speed = CFG_I2C_FREQ_HZ,
+};
+
+static SemaphoreHandle_t sBusMutex;
+static StaticSemaphore_t sBusMutexBuffer;
+
+#ifdef I2C_BUS_STATIC_CMD_LINK
+static uint8_t sCmdLinkBuffer[CMD_LINK_BUFFER_SIZE];
+#else
+// kept command links, the read and write commands point to the data buffer of the entry
+typedef struct{
+    uint8_t address;
+    bool isStopBeforeRead;
+    uint8_t count;
+    I2cBusTransferDir_t dir[CFG_I2C_BUS_MAX_BURST_TRANSFERS];
+    uint8_t registerAddress[CFG_I2C_BUS_MAX_BURST_TRANSFERS];
+    uint8_t length[CFG_I2C_BUS_MAX_BURST_TRANSFERS];
+    uint8_t linkCount;
+    i2c_cmd_handle_t link[CMD_LINK_MAX_LINKS];
+    uint8_t data[CMD_LINK_DATA_SIZE];
+}CmdLinkCacheEntry_t;
+
+// used only with the bus taken
+static CmdLinkCacheEntry_t sCmdLinkCache[CMD_LINK_CACHE_SIZE];
+static uint8_t sCmdLinkCacheCount;
+static uint32_t sCmdLinkAllocations;
+#endif
+
+// waiting transactions and statistics per priority
+static uint8_t sWaiting[I2C_BUS_PRIORITY_COUNT];
+static I2cBusStats_t sStats[I2C_BUS_PRIORITY_COUNT];
+static portMUX_TYPE sLock = portMUX_INITIALIZER_UNLOCKED;
+
+// bus busy time of all priorities since utilization was read
+static int64_t sUtilizationStartUs;
+static uint64_t sUtilizationBusyUs;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Take the bus lock, lower priority waits while higher priority transactions are waiting
+ *  @param device slave device, its priority and timeout are used
+ *  @return return true if the bus is taken
+ */
+static bool BusAcquire(const I2cBusDevice_t* device);
+
+/** @brief Give the bus lock and account the transaction
+ *  @param device slave device
+ *  @param busyUs bus occupancy time
+ *  @param bytes register data bytes of the transaction
+ *  @param isSuccess transaction result
+ */
+static void BusRelease(const I2cBusDevice_t* device, int64_t busyUs, uint32_t bytes, bool isSuccess);
+
+/** @brief Check if transaction of higher priority is waiting for the bus
+ *  @param priority own priority
+ *  @return return true if higher priority is waiting
+ */
+static bool IsHigherPriorityWaiting(I2cBusPriority_t priority);
+
+/** @brief Build and send command links of the transfers, the bus must be taken
+ *  @param device slave device
+ *  @param transfers register transfers
+ *  @param count transfers count
+ *  @return return true if success
+ */
+static bool SendTransfers(const I2cBusDevice_t* device, const I2cBusTransfer_t* transfers, uint8_t count);
+
+/** @brief Add start, write address and register address to command link
+ *  @param device slave device
+ *  @param cmd command link
+ *  @param registerAddress register address
+ *  @return return true if success
+ */
+static bool CmdLinkAddRegister(const I2cBusDevice_t* device, i2c_cmd_handle_t cmd, uint8_t registerAddress);
+
+/** @brief Add register data write, or repeated start, read address and data read to command link
+ *  @param device slave device
+ *  @param cmd command link
+ *  @param dir transfer direction
+ *  @param data data to write or read buffer, must live until the link is sent
+ *  @param length data length
+ *  @return return true if success
+ */
+static bool CmdLinkAddData(const I2cBusDevice_t* device, i2c_cmd_handle_t cmd, I2cBusTransferDir_t dir, uint8_t* data, uint8_t length);
+
+/** @brief Send command link ended with stop and delete it
+ *  @param device slave device
+ *  @param cmd command link
+ *  @return return true if success
+ */
+static bool CmdLinkSend(const I2cBusDevice_t* device, i2c_cmd_handle_t cmd);
+
+/** @brief Create empty command link, in the static buffer when available
+ *  @return command link or NULL
+ */
+static i2c_cmd_handle_t CmdLinkCreate(void);
+
+/** @brief Delete command link
+ *  @param cmd command link
+ */
+static void CmdLinkDelete(i2c_cmd_handle_t cmd);
+
+#ifndef I2C_BUS_STATIC_CMD_LINK
+/** @brief Find the kept command links of the transaction shape or build them, the bus must be taken
+ *  @param device slave device
+ *  @param transfers register transfers
+ *  @param count transfers count
+ *  @return cache entry or NULL if the transaction is not cached
+ */
+static CmdLinkCacheEntry_t* CmdLinkCacheGet(const I2cBusDevice_t* device, const I2cBusTransfer_t* transfers, uint8_t count);
+
+/** @brief Build command links of the cache entry shape on its data buffer
+ *  @param device slave device
+ *  @param entry cache entry with the shape set
+ *  @return return true if success
+ */
+static bool CmdLinkCacheBuild(const I2cBusDevice_t* device, CmdLinkCacheEntry_t* entry);
+
+/** @brief Send the kept command links with the transfers data, the bus must be taken
+ *  @param device slave device
+ *  @param entry cache entry
+ *  @param transfers register transfers
+ *  @return return true if success
+ */
+static bool CmdLinkCacheSend(const I2cBusDevice_t* device, CmdLinkCacheEntry_t* entry, const I2cBusTransfer_t* transfers);
+#endif
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool I2cBusDriverInit(void)
+{
+    if(sBusMutex != NULL){
+        return true;
+    }
+
+    esp_err_t err = i2c_param_config(I2C_PORT_NUMBER, &sConfig);
+    if(err != ESP_OK){
+        return false;
+    }
+
+    err = i2c_driver_install(I2C_PORT_NUMBER, sConfig.mode, 0, 0, 0);
+    if(err != ESP_OK){
+        return false;
+    }
+
+    memset(sWaiting, 0, sizeof(sWaiting));
+    memset(sStats, 0, sizeof(sStats));
+    sUtilizationStartUs = esp_timer_get_time();
+    sUtilizationBusyUs = 0;
+
+    sBusMutex = xSemaphoreCreateMutexStatic(&sBusMutexBuffer);
+
+    return sBusMutex != NULL;
+}
+
+bool I2cBusDriverRead(const I2cBusDevice_t* device, uint8_t registerAddress, uint8_t* data, uint8_t length)
+{
+    const I2cBusTransfer_t transfer = {
+        .dir = I2C_BUS_TRANSFER_READ,
+        .registerAddress = registerAddress,
+        .data = data,
+        .length = length,
+    };
+
+    return I2cBusDriverBurst(device, &transfer, 1);
+}
+
+bool I2cBusDriverWrite(const I2cBusDevice_t* device, uint8_t registerAddress, uint8_t* data, uint8_t length)
+{
+    const I2cBusTransfer_t transfer = {
+        .dir = I2C_BUS_TRANSFER_WRITE,
+        .registerAddress = registerAddress,
+        .data = data,
+        .length = length,
+    };
+
+    return I2cBusDriverBurst(device, &transfer, 1);
+}
+
+bool I2cBusDriverBurst(const I2cBusDevice_t* device, const I2cBusTransfer_t* transfers, uint8_t count)
+{
+    if((device == NULL) || (transfers == NULL) || (count == 0) || (count > CFG_I2C_BUS_MAX_BURST_TRANSFERS) ||
+       (device->priority >= I2C_BUS_PRIORITY_COUNT) || (sBusMutex == NULL)){
+        return false;
+    }
+
+    uint32_t bytes = 0;
+    for(uint8_t idx = 0; idx < count; ++idx){
+        if((transfers[idx].data == NULL) || (transfers[idx].length == 0)){
+            return false;
+        }
+
+        bytes += transfers[idx].length;
+    }
+
+    if(BusAcquire(device) == false){
+        ESP_LOGE(TAG, "bus timeout, device %02X", device->address);
+        return false;
+    }
+
+    int64_t startTime = esp_timer_get_time();
+    bool res = SendTransfers(device, transfers, count);
+
+    BusRelease(device, esp_timer_get_time() - startTime, bytes, res);
+
+    return res;
+}
+
+void I2cBusDriverGetStats(I2cBusPriority_t priority, I2cBusStats_t* stats)
+{
+    if((priority >= I2C_BUS_PRIORITY_COUNT) || (stats == NULL)){
+        return;
+    }
+
+    portENTER_CRITICAL(&sLock);
+    memcpy(stats, &sStats[priority], sizeof(I2cBusStats_t));
+    portEXIT_CRITICAL(&sLock);
+}
+
+uint16_t I2cBusDriverGetUtilization(void)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&sLock);
+    int64_t elapsedUs = now - sUtilizationStartUs;
+    uint64_t busyUs = sUtilizationBusyUs;
+    sUtilizationStartUs = now;
+    sUtilizationBusyUs = 0;
+    portEXIT_CRITICAL(&sLock);
+
+    if(elapsedUs <= 0){
+        return 0;
+    }
+
+    return (uint16_t)((busyUs * 1000ULL) / (uint64_t)elapsedUs);
+}
+
+void I2cBusDriverPrintStats(void)
+{
+    uint16_t utilization = I2cBusDriverGetUtilization();
+    ESP_LOGI(TAG, "utilization %u.%u %%, clock %u [Hz]", utilization / 10U, utilization % 10U, sConfig.master.clk_speed);
+#ifndef I2C_BUS_STATIC_CMD_LINK
+    ESP_LOGI(TAG, "kept command links %u, link allocations %u", sCmdLinkCacheCount, sCmdLinkAllocations);
+#endif
+
+    for(uint8_t priority = 0; priority < I2C_BUS_PRIORITY_COUNT; ++priority){
+        I2cBusStats_t stats = {};
+        I2cBusDriverGetStats(priority, &stats);
+
+        uint32_t meanWaitUs = (stats.transactions != 0) ? (uint32_t)(stats.totalWaitUs / stats.transactions) : 0;
+        uint32_t meanBusyUs = (stats.transactions != 0) ? (uint32_t)(stats.totalBusyUs / stats.transactions) : 0;
+
+        ESP_LOGI(TAG, "priority %u: transactions %u errors %u bytes %u contended %u timeouts %u", priority,
+                 stats.transactions, stats.errors, stats.bytes, stats.contended, stats.timeouts);
+        ESP_LOGI(TAG, "priority %u: wait mean %u max %u [us], busy mean %u max %u [us]", priority,
+                 meanWaitUs, stats.maxWaitUs, meanBusyUs, stats.maxBusyUs);
+    }
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static bool BusAcquire(const I2cBusDevice_t* device)
+{
+    const int64_t startTime = esp_timer_get_time();
+    const int64_t timeoutUs = (int64_t)device->timeoutMs * 1000LL;
+    bool isContended = false;
+    bool res = false;
+
+    portENTER_CRITICAL(&sLock);
+    sWaiting[device->priority]++;
+    portEXIT_CRITICAL(&sLock);
+
+    for(;;){
+        int64_t elapsedUs = esp_timer_get_time() - startTime;
+        if(elapsedUs >= timeoutUs){
+            break;
+        }
+
+        if(xSemaphoreTake(sBusMutex, 0) != pdTRUE){
+            isContended = true;
+
+            TickType_t ticks = (TickType_t)((timeoutUs - elapsedUs) / 1000LL) / portTICK_RATE_MS;
+            if(xSemaphoreTake(sBusMutex, ticks) != pdTRUE){
+                break;
+            }
+        }
+
+        if(IsHigherPriorityWaiting(device->priority) == false){
+            res = true;
+            break;
+        }
+
+        // higher priority transaction blocked on the lock takes it now
+        xSemaphoreGive(sBusMutex);
+        isContended = true;
+        vTaskDelay(PRIORITY_YIELD_DELAY_MS / portTICK_RATE_MS);
+    }
+
+    uint32_t waitUs = (uint32_t)(esp_timer_get_time() - startTime);
+    I2cBusStats_t* stats = &sStats[device->priority];
+
+    portENTER_CRITICAL(&sLock);
+    sWaiting[device->priority]--;
+
+    if(res == true){
+        stats->transactions++;
+        stats->totalWaitUs += waitUs;
+        stats->maxWaitUs = (waitUs > stats->maxWaitUs) ? waitUs : stats->maxWaitUs;
+        stats->contended += (isContended == true) ? 1U : 0U;
+    }
+    else{
+        stats->timeouts++;
+    }
+    portEXIT_CRITICAL(&sLock);
+
+    return res;
+}
+
+static void BusRelease(const I2cBusDevice_t* device, int64_t busyUs, uint32_t bytes, bool isSuccess)
+{
+    I2cBusStats_t* stats = &sStats[device->priority];
+
+    portENTER_CRITICAL(&sLock);
+    sUtilizationBusyUs += (uint64_t)busyUs;
+    stats->bytes += (isSuccess == true) ? bytes : 0U;
+    stats->totalBusyUs += (uint64_t)busyUs;
+    stats->maxBusyUs = ((uint32_t)busyUs > stats->maxBusyUs) ? (uint32_t)busyUs : stats->maxBusyUs;
+    stats->errors += (isSuccess == false) ? 1U : 0U;
+    portEXIT_CRITICAL(&sLock);
+
+    xSemaphoreGive(sBusMutex);
+}
+
+static bool IsHigherPriorityWaiting(I2cBusPriority_t priority)
+{
+    bool res = false;
+
+    portENTER_CRITICAL(&sLock);
+    for(uint8_t idx = 0; idx < priority; ++idx){
+        if(sWaiting[idx] != 0){
+            res = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&sLock);
+
+    return res;
+}
+
+static bool SendTransfers(const I2cBusDevice_t* device, const I2cBusTransfer_t* transfers, uint8_t count)
+{
+#ifndef I2C_BUS_STATIC_CMD_LINK
+    CmdLinkCacheEntry_t* entry = CmdLinkCacheGet(device, transfers, count);
+    if(entry != NULL){
+        return CmdLinkCacheSend(device, entry, transfers);
+    }
+#endif
+
+    i2c_cmd_handle_t cmd = CmdLinkCreate();
+    if(cmd == NULL){
+        return false;
+    }
+
+    bool res = true;
+
+    for(uint8_t idx = 0; idx < count; ++idx){
+        const I2cBusTransfer_t* transfer = &transfers[idx];
+
+        res &= CmdLinkAddRegister(device, cmd, transfer->registerAddress);
+
+        // stop can't be sent in the middle of a command link, the read is sent in the next one
+        if((transfer->dir == I2C_BUS_TRANSFER_READ) && (device->isStopBeforeRead == true)){
+            res &= (i2c_master_stop(cmd) == ESP_OK);
+            res &= CmdLinkSend(device, cmd);
+
+            cmd = CmdLinkCreate();
+            if(cmd == NULL){
+                return false;
+            }
+        }
+
+        res &= CmdLinkAddData(device, cmd, transfer->dir, transfer->data, transfer->length);
+    }
+
+    res &= (i2c_master_stop(cmd) == ESP_OK);
+    res &= CmdLinkSend(device, cmd);
+
+    return res;
+}
+
+static bool CmdLinkAddRegister(const I2cBusDevice_t* device, i2c_cmd_handle_t cmd, uint8_t registerAddress)
+{
+    bool res = true;
+
+    /*
+     * ______________________________________________________
+     * | start | slave_addr + wr_bit + ack | reg_addr + ack  |
+     * --------|---------------------------|-----------------|
+    */
+    res &= (i2c_master_start(cmd) == ESP_OK);
+    res &= (i2c_master_write_byte(cmd, device->address << 1 | I2C_MASTER_WRITE, true) == ESP_OK);
+    res &= (i2c_master_write_byte(cmd, registerAddress, true) == ESP_OK);
+
+    return res;
+}
+
+static bool CmdLinkAddData(const I2cBusDevice_t* device, i2c_cmd_handle_t cmd, I2cBusTransferDir_t dir, uint8_t* data, uint8_t length)
+{
+    bool res = true;
+
+    if(dir == I2C_BUS_TRANSFER_WRITE){
+        /*
+         * ________________________________________
+         * | reg_data + ack | ... | reg_data + ack |
+         * |----------------|-----|----------------|
+        */
+        return (i2c_master_write(cmd, data, length, true) == ESP_OK);
+    }
+
+    /*
+     * _____________________________________________________________________________________________
+     * | start | slave_addr + rd_bit + ack | reg_data + ack  | reg_data + ack | ... | reg_data + nack |
+     * --------|---------------------------|-----------------|----------------|-----|-----------------|
+    */
+    res &= (i2c_master_start(cmd) == ESP_OK);
+    res &= (i2c_master_write_byte(cmd, device->address << 1 | I2C_MASTER_READ, true) == ESP_OK);
+    res &= (i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK) == ESP_OK);
+
+    return res;
+}
+
+static bool CmdLinkSend(const I2cBusDevice_t* device, i2c_cmd_handle_t cmd)
+{
+    esp_err_t esp_res = i2c_master_cmd_begin(I2C_PORT_NUMBER, cmd, device->timeoutMs / portTICK_RATE_MS);
+
+    CmdLinkDelete(cmd);
+
+    return esp_res == ESP_OK;
+}
+
+static i2c_cmd_handle_t CmdLinkCreate(void)
+{
+#ifdef I2C_BUS_STATIC_CMD_LINK
+    return i2c_cmd_link_create_static(sCmdLinkBuffer, sizeof(sCmdLinkBuffer));
+#else
+    sCmdLinkAllocations++;
+    return i2c_cmd_link_create();
+#endif
+}
+
+static void CmdLinkDelete(i2c_cmd_handle_t cmd)
+{
+#ifdef I2C_BUS_STATIC_CMD_LINK
+    i2c_cmd_link_delete_static(cmd);
+#else
+    i2c_cmd_link_delete(cmd);
+#endif
+}
+
+#ifndef I2C_BUS_STATIC_CMD_LINK
+
+static CmdLinkCacheEntry_t* CmdLinkCacheGet(const I2cBusDevice_t* device, const I2cBusTransfer_t* transfers, uint8_t count)
+{
+    uint32_t length = 0;
+    for(uint8_t idx = 0; idx < count; ++idx){
+        length += transfers[idx].length;
+    }
+
+    if(length > CMD_LINK_DATA_SIZE){
+        return NULL;
+    }
+
+    for(uint8_t entryIdx = 0; entryIdx < sCmdLinkCacheCount; ++entryIdx){
+        CmdLinkCacheEntry_t* entry = &sCmdLinkCache[entryIdx];
+
+        bool isSame = (entry->address == device->address) && (entry->isStopBeforeRead == device->isStopBeforeRead) && (entry->count == count);
+        for(uint8_t idx = 0; (isSame == true) && (idx < count); ++idx){
+            isSame = (entry->dir[idx] == transfers[idx].dir) && (entry->registerAddress[idx] == transfers[idx].registerAddress) &&
+                     (entry->length[idx] == transfers[idx].length);
+        }
+
+        if(isSame == true){
+            return entry;
+        }
+    }
+
+    if(sCmdLinkCacheCount >= CMD_LINK_CACHE_SIZE){
+        return NULL;
+    }
+
+    CmdLinkCacheEntry_t* entry = &sCmdLinkCache[sCmdLinkCacheCount];
+    memset(entry, 0, sizeof(CmdLinkCacheEntry_t));
+
+    entry->address = device->address;
+    entry->isStopBeforeRead = device->isStopBeforeRead;
+    entry->count = count;
+    for(uint8_t idx = 0; idx < count; ++idx){
+        entry->dir[idx] = transfers[idx].dir;
+        entry->registerAddress[idx] = transfers[idx].registerAddress;
+        entry->length[idx] = transfers[idx].length;
+    }
+
+    if(CmdLinkCacheBuild(device, entry) == false){
+        for(uint8_t idx = 0; idx < entry->linkCount; ++idx){
+            CmdLinkDelete(entry->link[idx]);
+        }
+        return NULL;
+    }
+
+    sCmdLinkCacheCount++;
+    return entry;
+}
+
+static bool CmdLinkCacheBuild(const I2cBusDevice_t* device, CmdLinkCacheEntry_t* entry)
+{
+    i2c_cmd_handle_t cmd = CmdLinkCreate();
+    if(cmd == NULL){
+        return false;
+    }
+
+    entry->link[entry->linkCount++] = cmd;
+
+    bool res = true;
+    uint8_t* data = entry->data;
+
+    for(uint8_t idx = 0; idx < entry->count; ++idx){
+        res &= CmdLinkAddRegister(device, cmd, entry->registerAddress[idx]);
+
+        if((entry->dir[idx] == I2C_BUS_TRANSFER_READ) && (entry->isStopBeforeRead == true)){
+            res &= (i2c_master_stop(cmd) == ESP_OK);
+
+            cmd = CmdLinkCreate();
+            if(cmd == NULL){
+                return false;
+            }
+
+            entry->link[entry->linkCount++] = cmd;
+        }
+
+        res &= CmdLinkAddData(device, cmd, entry->dir[idx], data, entry->length[idx]);
+        data += entry->length[idx];
+    }
+
+    res &= (i2c_master_stop(cmd) == ESP_OK);
+
+    return res;
+}
+
+static bool CmdLinkCacheSend(const I2cBusDevice_t* device, CmdLinkCacheEntry_t* entry, const I2cBusTransfer_t* transfers)
+{
+    uint8_t* data = entry->data;
+    for(uint8_t idx = 0; idx < entry->count; ++idx){
+        if(transfers[idx].dir == I2C_BUS_TRANSFER_WRITE){
+            memcpy(data, transfers[idx].data, transfers[idx].length);
+        }
+        data += transfers[idx].length;
+    }
+
+    // the links stay built, i2c_master_cmd_begin only reads them
+    bool res = true;
+    for(uint8_t idx = 0; (res == true) && (idx < entry->linkCount); ++idx){
+        res = (i2c_master_cmd_begin(I2C_PORT_NUMBER, entry->link[idx], device->timeoutMs / portTICK_RATE_MS) == ESP_OK);
+    }
+
+    data = entry->data;
+    for(uint8_t idx = 0; idx < entry->count; ++idx){
+        if((res == true) && (transfers[idx].dir == I2C_BUS_TRANSFER_READ)){
+            memcpy(transfers[idx].data, data, transfers[idx].length);
+        }
+        data += transfers[idx].length;
+    }
+
+    return res;
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file i2cBusDriver.h
+ *
+ * @brief I2C bus manager header file
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#pragma once
+
+#include "config.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+typedef enum{
+    I2C_BUS_PRIORITY_HIGH = 0,      // touch panel, user input latency
+    I2C_BUS_PRIORITY_NORMAL,        // gpio expander
+    I2C_BUS_PRIORITY_LOW,           // rtc
+    I2C_BUS_PRIORITY_COUNT
+}I2cBusPriority_t;
+
+typedef enum{
+    I2C_BUS_TRANSFER_READ = 0,
+    I2C_BUS_TRANSFER_WRITE,
+}I2cBusTransferDir_t;
+
+/*****************************************************************************
+                       PUBLIC STRUCTS
+*****************************************************************************/
+
+typedef struct{
+    uint8_t address;                // 7 bit slave address
+    I2cBusPriority_t priority;
+    uint32_t timeoutMs;             // bus wait and transfer timeout
+    bool isStopBeforeRead;          // register address write is ended with stop instead of repeated start
+}I2cBusDevice_t;
+
+typedef struct{
+    I2cBusTransferDir_t dir;
+    uint8_t registerAddress;
+    uint8_t* data;
+    uint8_t length;
+}I2cBusTransfer_t;
+
+typedef struct{
+    uint32_t transactions;          // bus acquisitions
+    uint32_t errors;                // failed transfers
+    uint32_t bytes;                 // register data bytes transferred
+    uint32_t contended;             // acquisitions which waited for the bus
+    uint32_t timeouts;              // bus not acquired in device timeout
+    uint32_t maxWaitUs;
+    uint64_t totalWaitUs;
+    uint32_t maxBusyUs;             // longest bus occupancy of one acquisition
+    uint64_t totalBusyUs;
+}I2cBusStats_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Configure CFG_I2C_PORT_NUMBER master at CFG_I2C_FREQ_HZ, install i2c driver and create bus lock
+ *  @return return true if success
+ */
+bool I2cBusDriverInit(void);
+
+/** @brief Read contiguous registers
+ *  @param device slave device
+ *  @param registerAddress first register address
+ *  @param data [out] read data
+ *  @param length number bytes to read
+ *  @return return true if success
+ */
+bool I2cBusDriverRead(const I2cBusDevice_t* device, uint8_t registerAddress, uint8_t* data, uint8_t length);
+
+/** @brief Write contiguous registers
+ *  @param device slave device
+ *  @param registerAddress first register address
+ *  @param data data to write
+ *  @param length number bytes to write
+ *  @return return true if success
+ */
+bool I2cBusDriverWrite(const I2cBusDevice_t* device, uint8_t registerAddress, uint8_t* data, uint8_t length);
+
+/** @brief Run register transfers in order in one bus acquisition, joined with repeated start
+ *  @param device slave device
+ *  @param transfers register transfers
+ *  @param count transfers count, up to CFG_I2C_BUS_MAX_BURST_TRANSFERS
+ *  @return return true if all transfers succeeded
+ */
+bool I2cBusDriverBurst(const I2cBusDevice_t* device, const I2cBusTransfer_t* transfers, uint8_t count);
+
+/** @brief Get copy of bus statistics of one priority
+ *  @param priority transaction priority
+ *  @param stats [out] statistics
+ */
+void I2cBusDriverGetStats(I2cBusPriority_t priority, I2cBusStats_t* stats);
+
+/** @brief Get bus utilization since the previous call
+ *  @return bus busy time in per mille of the elapsed time
+ */
+uint16_t I2cBusDriverGetUtilization(void);
+
+/** @brief Log bus statistics of all priorities and bus utilization since the previous call
+ */
+void I2cBusDriverPrintStats(void);
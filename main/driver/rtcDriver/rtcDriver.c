@@ -28,8 +28,7 @@
 
 #include "cloud/iotHubClient.h"
 
-#include "driver/i2c.h"
-#include "hal/i2c_types.h"
+#include "i2cBusDriver/i2cBusDriver.h"
 
 #include <sys/time.h>
 #include "esp_timer.h"
@@ -38,8 +37,6 @@
                           PRIVATE DEFINES / MACROS
  *****************************************************************************/
 
-#define I2C_PORT_NUMBER (CFG_I2C_PORT_NUMBER)
-
 #define TIMER_PERIOD_MS (60U * 1000U) // 1 minute
 #define ADC_MEAN_SAMPLES_NUMBER (16U)
 
@@ -47,8 +44,7 @@
 
 #define PCF85063A_SLAVE_ADDRESS (0x51)
 
-#define PCF85063A_WTITE_TIMEOUT_MS (1000U)
-#define PCF85063A_READ_TIMEOUT_MS (1000U)
+#define PCF85063A_TIMEOUT_MS (1000U)
 
 #define RTC_IS_CORRECT_YEAR_SET (2022U)
 #define DEFAULT_RTC_CORRECTION_TIME_SEC (2U)
@@ -171,7 +167,13 @@ typedef union
 
 static const char* TAG = "rtc";
 
-static i2c_port_t sI2cPortNumber = I2C_PORT_NUMBER;
+// register address write is ended with stop before the read, as the rtc was always accessed
+static const I2cBusDevice_t sPcf85063aDevice = {
+    .address = PCF85063A_SLAVE_ADDRESS,
+    .priority = I2C_BUS_PRIORITY_LOW,
+    .timeoutMs = PCF85063A_TIMEOUT_MS,
+    .isStopBeforeRead = true,
+};
 
 static bool sRtcError;
 
@@ -214,25 +216,24 @@ static uint8_t bcd2dec(uint8_t bcdVal);
 bool RtcDriverInit(void)
 {   
     bool res = true;
-    uint8_t yearReg = 0;
- 
-    res &= Pcf85063aBlockRead(PCF85063A_YEARS, &yearReg, 1);
-    uint8_t year = bcd2dec(yearReg); // value from 0 to 99
-    ESP_LOGI(TAG, "read year %d", (year + 2000U));
+    struct tm rtcTime = {.tm_year = 100};
+
+    // year is taken from the date and time block, read once
+    res &= RtcDriverGetDateTime(&rtcTime);
+    uint16_t year = rtcTime.tm_year + 1900U;
+    ESP_LOGI(TAG, "read year %d", year);
 
-    if((year + 2000U) < RTC_IS_CORRECT_YEAR_SET){
+    if(year < RTC_IS_CORRECT_YEAR_SET){
         sRtcError = true;
 
-        ESP_LOGE(TAG, "read incorrect year %d", (year + 2000U));
+        ESP_LOGE(TAG, "read incorrect year %d", year);
         ESP_LOGE(TAG, "something is wrong with rtc battery");
     }
 
     SettingDevice_t setting = {};
     iotHubClientStatus_t clientStatus = {};
-    struct tm rtcTime = {};
 
     res &= SettingGet(&setting);
-    res &= RtcDriverGetDateTime(&rtcTime);
     res &= IotHubClientGetSetting(&clientStatus);
 
     time_t rtcUnix = mktime(&rtcTime);
@@ -362,128 +363,12 @@ bool RtcDriverIsError(void)
 
 static bool Pcf85063aBlockRead(RtcPcf85063aRegAddr_t registerAddress, uint8_t* data, uint8_t length)
 {
-    if((data == NULL) || (length == 0)){
-        return false;
-    }
-    
-    bool res = true;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    /*
-     * _____________________________________________________________
-     * | start | slave_addr + wr_bit + ack | reg_addr + ack  | stop |
-     * --------|---------------------------|-----------------|------|
-    */
-    esp_err_t esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, PCF85063A_SLAVE_ADDRESS << 1 | I2C_MASTER_WRITE, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, registerAddress, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, PCF85063A_READ_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    cmd = i2c_cmd_link_create();
-    /*
-     * ______________________________________________________________________________________________________
-     * | start | slave_addr + rd_bit + ack | reg_data + ack  | reg_data + ack | ... | reg_data + nack | stop |
-     * --------|---------------------------|-----------------|----------------|-----|-----------------|------|
-    */
-    esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, PCF85063A_SLAVE_ADDRESS << 1 | I2C_MASTER_READ, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, PCF85063A_READ_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    return res;
+    return I2cBusDriverRead(&sPcf85063aDevice, registerAddress, data, length);
 }
 
 static bool Pcf85063aBlockWrite(RtcPcf85063aRegAddr_t registerAddress, uint8_t* data, uint8_t length)
 {
-    if((data == NULL) || (length == 0)){
-        return false;
-    }
-
-    bool res = true;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    /*
-     * _____________________________________________________________________________________________________
-     * | start | slave_addr + wr_bit + ack | reg_addr + ack  | reg_data + ack | ... | reg_data + ack | stop |
-     * --------|---------------------------|-----------------|----------------|-----|----------------|------|
-    */
-    esp_err_t esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, PCF85063A_SLAVE_ADDRESS << 1 | I2C_MASTER_WRITE, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, registerAddress, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write(cmd, data, length, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, PCF85063A_WTITE_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    return res;
+    return I2cBusDriverWrite(&sPcf85063aDevice, registerAddress, data, length);
 }
 
 static uint8_t dec2bcd(uint8_t decVal)
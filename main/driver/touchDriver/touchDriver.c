@@ -18,20 +18,22 @@
 #include <string.h>
 
 #include "esp_log.h"
+#include "esp_timer.h"
 
-#include "driver/i2c.h"
-#include "hal/i2c_types.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "driver/gpio.h"
+
+#include "i2cBusDriver/i2cBusDriver.h"
 
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
  *****************************************************************************/
 
-#define I2C_PORT_NUMBER (CFG_I2C_PORT_NUMBER)
-
 #define CAPxxxx_ADDRESS (0b0101000)
 
-#define CAPxxxx_WTITE_TIMEOUT_MS (1000U)
-#define CAPxxxx_READ_TIMEOUT_MS (1000U)
+#define CAPxxxx_TIMEOUT_MS (1000U)
 
 #define UNUSED(x) ((void)(x))
 
@@ -85,17 +87,6 @@ typedef enum
 	REVISION = 0xFF,
 }TouchCap1293RegAddr_t;
 
-typedef enum{
-    TOUCH_SENSITIVITY_128X =    0x00,   // Most sensitive
-    TOUCH_SENSITIVITY_64X =     0x01,
-    TOUCH_SENSITIVITY_32X =     0x02,
-    TOUCH_SENSITIVITY_16X =     0x03,
-    TOUCH_SENSITIVITY_8X =      0x04,
-    TOUCH_SENSITIVITY_4X =      0x05,
-    TOUCH_SENSITIVITY_2X =      0x06,
-    TOUCH_SENSITIVITY_1X =      0x01,   // Least sensitive
-}TouchDriverSensitivity_t;
-
 typedef enum{
     TOUCH_POWER_BUTTON_INPUT_SENSOR_CS1 = 0,
     TOUCH_POWER_BUTTON_INPUT_SENSOR_CS2 = 1,
@@ -259,7 +250,28 @@ typedef union{
                      PRIVATE VARIABLES
 *****************************************************************************/
 
-static i2c_port_t sI2cPortNumber = I2C_PORT_NUMBER;
+static const I2cBusDevice_t sCapxxxxDevice = {
+    .address = CAPxxxx_ADDRESS,
+    .priority = I2C_BUS_PRIORITY_HIGH,
+    .timeoutMs = CAPxxxx_TIMEOUT_MS,
+    .isStopBeforeRead = false,
+};
+
+// CS input of the buttons
+static const uint8_t sButtonSensor[CFG_TOUCH_BUTTON_NAME_COUNT] = {
+    [CFG_TOUCH_BUTTON_NAME_POWER] = TOUCH_POWER_BUTTON_INPUT_SENSOR_CS1,
+    [CFG_TOUCH_BUTTON_NAME_FAN_DEC] = TOUCH_POWER_BUTTON_INPUT_SENSOR_CS2,
+    [CFG_TOUCH_BUTTON_NAME_FAN_INC] = TOUCH_POWER_BUTTON_INPUT_SENSOR_CS3,
+};
+
+// last written Main Control, the INT flag is cleared by writing it back without reading
+static Cap1293Reg_t sMainControl;
+
+// ALERT falling edge time and signal to the task reading the status
+static volatile int64_t sAlertTime;
+static SemaphoreHandle_t sAlertSemaphore;
+static StaticSemaphore_t sAlertSemaphoreBuffer;
+static portMUX_TYPE sAlertLock = portMUX_INITIALIZER_UNLOCKED;
 
 static const char* TAG = "touchDr";
 
@@ -309,16 +321,11 @@ static bool CapxxxxSetRepeatRateDisabled(void);
  */
 static bool GpioAlertPinInit(void);
 
-/** @brief  Clear INT flat in Main Control reg.
- *  @return return true if success
- */
-static bool CapxxxxClearIntFlag(void);
-
-/** @brief  Get input status
+/** @brief  Clear INT flag in Main Control reg. and get input status in one bus transaction
  *  @param buttoStatus [out] pointer to button status struct TouchDriverButtonStatus_t
  *  @return return true if success
  */
-static bool CapxxxxGetInputStatus(TouchDriverButtonStatus_t* buttoStatus);
+static bool CapxxxxClearIntFlagAndGetInputStatus(TouchDriverButtonStatus_t* buttoStatus);
 
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
@@ -328,6 +335,10 @@ bool TouchDriverInit(void)
 {
     bool res = true;
 
+    if(sAlertSemaphore == NULL){
+        sAlertSemaphore = xSemaphoreCreateBinaryStatic(&sAlertSemaphoreBuffer);
+    }
+
     res &= CapxxxxSetMultiTouchEnabled();
     res &= CapxxxxSetSensitivity(TOUCH_SENSITIVITY_32X);
     res &= CapxxxxSetRepeatRateDisabled();
@@ -346,15 +357,22 @@ bool TouchDriverGetDeviceInfo(TouchDriverInfo_t* deviceInfo)
 
 TouchDriverInputStatus_t TouchDriverIsButtonTouched(TouchDriverButtonStatus_t* buttonStatus)
 {
-    bool res = true;
-
     if(TouchDriverIsAlertSet() == false){
+        // GPIO36 gets spurious edges when some RTC peripherals are powered (ESP32 errata 3.11), its time is dropped
+        portENTER_CRITICAL(&sAlertLock);
+        sAlertTime = 0;
+        portEXIT_CRITICAL(&sAlertLock);
+
         return TOUCH_INPUT_STATUS_NOTHING_DETECTED;
     }
-    
-    res &= CapxxxxClearIntFlag();
-    res &= CapxxxxGetInputStatus(buttonStatus);
 
+    // edge time is taken once, 0 when the change was found without an edge
+    portENTER_CRITICAL(&sAlertLock);
+    buttonStatus->alertTime = sAlertTime;
+    sAlertTime = 0;
+    portEXIT_CRITICAL(&sAlertLock);
+
+    bool res = CapxxxxClearIntFlagAndGetInputStatus(buttonStatus);
     if(res == false){
         return TOUCH_INPUT_STATUS_ERROR;
     }
@@ -371,6 +389,84 @@ bool TouchDriverIsAlertSet(void)
     return true;
 }
 
+bool TouchDriverWaitForAlert(uint32_t timeoutMs)
+{
+    if(sAlertSemaphore == NULL){
+        return false;
+    }
+
+    return xSemaphoreTake(sAlertSemaphore, timeoutMs / portTICK_RATE_MS) == pdTRUE;
+}
+
+void IRAM_ATTR TouchDriverAlertIrqCallback(void* arg)
+{
+    if((uint32_t)arg != CFG_TOUCH_INTERRUPT_PIN){
+        return;
+    }
+
+    portENTER_CRITICAL_ISR(&sAlertLock);
+    sAlertTime = esp_timer_get_time() / 1000LL;
+    portEXIT_CRITICAL_ISR(&sAlertLock);
+
+    if(sAlertSemaphore != NULL){
+        BaseType_t isHigherPriorityTaskWoken = pdFALSE;
+        xSemaphoreGiveFromISR(sAlertSemaphore, &isHigherPriorityTaskWoken);
+
+        if(isHigherPriorityTaskWoken == pdTRUE){
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+bool TouchDriverGetNoiseSample(TouchDriverNoiseSample_t* sample)
+{
+    uint8_t noiseFlags = 0;
+    int8_t deltaCount[TOUCH_POWER_BUTTON_INPUT_SENSOR_CS3 + 1] = {};
+
+    // noise flags and delta counts of all inputs in one bus acquisition
+    const I2cBusTransfer_t transfers[] = {
+        { .dir = I2C_BUS_TRANSFER_READ, .registerAddress = NOISE_FLAG_STATUS, .data = &noiseFlags, .length = 1 },
+        { .dir = I2C_BUS_TRANSFER_READ, .registerAddress = SENSOR_INPUT_1_DELTA_COUNT, .data = (uint8_t*)deltaCount, .length = sizeof(deltaCount) },
+    };
+
+    bool res = I2cBusDriverBurst(&sCapxxxxDevice, transfers, sizeof(transfers) / sizeof(transfers[0]));
+
+    for(uint8_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        sample->deltaCount[idx] = deltaCount[sButtonSensor[idx]];
+        sample->isNoise[idx] = (noiseFlags & (1U << sButtonSensor[idx])) != 0;
+    }
+
+    return res;
+}
+
+bool TouchDriverSetSensitivity(TouchDriverSensitivity_t sensitivity)
+{
+    return CapxxxxSetSensitivity(sensitivity);
+}
+
+bool TouchDriverSetThreshold(CfgTouchButtonName_t button, uint8_t threshold)
+{
+    if(button >= CFG_TOUCH_BUTTON_NAME_COUNT){
+        return false;
+    }
+
+    // 7 bit threshold, touch is detected when delta count reaches it
+    threshold &= 0x7F;
+
+    return CapxxxxBlockWrite(SENSOR_1_INPUT_THRESH + sButtonSensor[button], &threshold, 1);
+}
+
+bool TouchDriverCalibrate(CfgTouchButtonName_t button)
+{
+    if(button >= CFG_TOUCH_BUTTON_NAME_COUNT){
+        return false;
+    }
+
+    uint8_t calibrate = (1U << sButtonSensor[button]);
+
+    return CapxxxxBlockWrite(CALIBRATION_ACTIVATE_AND_STATUS, &calibrate, 1);
+}
+
 bool TouchDriverSetPowerState(TouchDriverPowerState_t powerState)
 {
     bool res = true;
@@ -413,6 +509,10 @@ bool TouchDriverSetPowerState(TouchDriverPowerState_t powerState)
     }
 
     res &= CapxxxxBlockWrite(MAIN_CONTROL, &reg.byte, 1);
+    if(res == true){
+        sMainControl = reg;
+        sMainControl.mainControl.Int = 0;
+    }
 
     return res;
 }
@@ -423,115 +523,12 @@ bool TouchDriverSetPowerState(TouchDriverPowerState_t powerState)
 
 static bool CapxxxxBlockRead(TouchCap1293RegAddr_t registerAddress, uint8_t* data, uint8_t length)
 {
-    if((data == NULL) || (length == 0)){
-        return false;
-    }
-    
-    bool res = true;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    /*
-     * ______________________________________________________
-     * | start | slave_addr + wr_bit + ack | reg_addr + ack  |
-     * --------|---------------------------|-----------------|
-    */
-    esp_err_t esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, CAPxxxx_ADDRESS << 1 | I2C_MASTER_WRITE, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, registerAddress, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    /*
-     * ______________________________________________________________________________________________________
-     * | start | slave_addr + rd_bit + ack | reg_data + ack  | reg_data + ack | ... | reg_data + nack | stop |
-     * --------|---------------------------|-----------------|----------------|-----|-----------------|------|
-    */
-    esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, CAPxxxx_ADDRESS << 1 | I2C_MASTER_READ, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, CAPxxxx_READ_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    return res;
+    return I2cBusDriverRead(&sCapxxxxDevice, registerAddress, data, length);
 }
 
 static bool CapxxxxBlockWrite(TouchCap1293RegAddr_t registerAddress, uint8_t* data, uint8_t length)
 {
-    if((data == NULL) || (length == 0)){
-        return false;
-    }
-
-    bool res = true;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    /*
-     * _____________________________________________________________________________________________________
-     * | start | slave_addr + wr_bit + ack | reg_addr + ack  | reg_data + ack | ... | reg_data + ack | stop |
-     * --------|---------------------------|-----------------|----------------|-----|----------------|------|
-    */
-    esp_err_t esp_res = i2c_master_start(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, CAPxxxx_ADDRESS << 1 | I2C_MASTER_WRITE, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write_byte(cmd, registerAddress, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_write(cmd, data, length, true);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_stop(cmd);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    esp_res = i2c_master_cmd_begin(sI2cPortNumber, cmd, CAPxxxx_WTITE_TIMEOUT_MS / portTICK_RATE_MS);
-    if(esp_res != ESP_OK){
-        res &= false;
-    }
-
-    i2c_cmd_link_delete(cmd);
-
-    return res;
+    return I2cBusDriverWrite(&sCapxxxxDevice, registerAddress, data, length);
 }
 
 static bool CapxxxxForceCalibrateEnabled(void)
@@ -607,8 +604,8 @@ static bool GpioAlertPinInit(void)
     bool res = true;
     gpio_config_t io_conf;
 
-    //interrupt disable
-    io_conf.intr_type = GPIO_INTR_DISABLE;
+    //interrupt on ALERT assertion (active low), handler is added by gpioIsrDriver
+    io_conf.intr_type = GPIO_INTR_NEGEDGE;
 
     //bit mask of the pins
     io_conf.pin_bit_mask = (1ULL << CFG_TOUCH_INTERRUPT_PIN);
@@ -629,27 +626,19 @@ static bool GpioAlertPinInit(void)
     return res;
 }
 
-static bool CapxxxxClearIntFlag(void)
+static bool CapxxxxClearIntFlagAndGetInputStatus(TouchDriverButtonStatus_t* buttoStatus)
 {
-    bool res = true;
+    Cap1293Reg_t mainControl = sMainControl;
     Cap1293Reg_t reg = {0};
 
-    res &= CapxxxxBlockRead(MAIN_CONTROL, &reg.byte, 1);
-
-// cppcheck-suppress unreadVariable
-    reg.mainControl.Int = 0; 
+    // main control is written back from the last written value instead of read-modify-write,
+    // INT flag is cleared before the status is read as before
+    const I2cBusTransfer_t transfers[] = {
+        { .dir = I2C_BUS_TRANSFER_WRITE, .registerAddress = MAIN_CONTROL, .data = &mainControl.byte, .length = 1 },
+        { .dir = I2C_BUS_TRANSFER_READ, .registerAddress = SENSOR_INPUT_STATUS, .data = &reg.byte, .length = 1 },
+    };
 
-    res &= CapxxxxBlockWrite(MAIN_CONTROL, &reg.byte, 1);
-
-    return res;
-}
-
-static bool CapxxxxGetInputStatus(TouchDriverButtonStatus_t* buttoStatus)
-{
-    bool res = true;
-    Cap1293Reg_t reg = {0};
-
-    res &= CapxxxxBlockRead(SENSOR_INPUT_STATUS, &reg.byte, 1);
+    bool res = I2cBusDriverBurst(&sCapxxxxDevice, transfers, sizeof(transfers) / sizeof(transfers[0]));
 
     ESP_LOGI(TAG, "pressed button %X", reg.byte);
  
@@ -658,4 +647,4 @@ static bool CapxxxxGetInputStatus(TouchDriverButtonStatus_t* buttoStatus)
     buttoStatus->isPressNow[CFG_TOUCH_BUTTON_NAME_FAN_INC] = reg.sensorInputStatus.cs3;
 
     return res;
-}
\ No newline at end of file
+}
@@ -30,6 +30,17 @@ typedef enum{
     TOUCH_POWER_STATE_DSLEEP,
 }TouchDriverPowerState_t;
 
+typedef enum{
+    TOUCH_SENSITIVITY_128X =    0x00,   // Most sensitive
+    TOUCH_SENSITIVITY_64X =     0x01,
+    TOUCH_SENSITIVITY_32X =     0x02,
+    TOUCH_SENSITIVITY_16X =     0x03,
+    TOUCH_SENSITIVITY_8X =      0x04,
+    TOUCH_SENSITIVITY_4X =      0x05,
+    TOUCH_SENSITIVITY_2X =      0x06,
+    TOUCH_SENSITIVITY_1X =      0x07,   // Least sensitive
+}TouchDriverSensitivity_t;
+
 typedef enum{
     TOUCH_INPUT_STATUS_NOTHING_DETECTED = 0,
     TOUCH_INPUT_STATUS_ERROR = -1,
@@ -43,8 +54,15 @@ typedef enum{
 typedef struct 
 {
     bool isPressNow[CFG_TOUCH_BUTTON_NAME_COUNT];
+    int64_t alertTime;      // system tick [ms] of the ALERT edge reporting the change
 } __attribute__ ((packed)) TouchDriverButtonStatus_t;
 
+typedef struct
+{
+    int8_t deltaCount[CFG_TOUCH_BUTTON_NAME_COUNT];     // counts over the base count, scaled by the sensitivity
+    bool isNoise[CFG_TOUCH_BUTTON_NAME_COUNT];          // delta count over the noise threshold
+} TouchDriverNoiseSample_t;
+
 typedef struct
 {
     uint8_t productId;
@@ -79,6 +97,42 @@ TouchDriverInputStatus_t TouchDriverIsButtonTouched(TouchDriverButtonStatus_t* b
  */
 bool TouchDriverIsAlertSet(void);
 
+/** @brief  Wait for ALERT pin falling edge
+ *  @param timeoutMs wait timeout
+ *  @return return true if the edge occurred
+ */
+bool TouchDriverWaitForAlert(uint32_t timeoutMs);
+
+/** @brief Callback function executed from gpio ISR on ALERT pin falling edge, takes the edge time
+ *  @param arg pin number
+ */
+void TouchDriverAlertIrqCallback(void* arg);
+
+/** @brief Read delta counts and noise flags of the buttons
+ *  @param sample [out] pointer to TouchDriverNoiseSample_t
+ *  @return return true if success
+ */
+bool TouchDriverGetNoiseSample(TouchDriverNoiseSample_t* sample);
+
+/** @brief Set delta count sensitivity of all buttons
+ *  @param sensitivity touch sensitivity
+ *  @return return true if success
+ */
+bool TouchDriverSetSensitivity(TouchDriverSensitivity_t sensitivity);
+
+/** @brief Set touch threshold of the button
+ *  @param button button name
+ *  @param threshold delta count detected as touch, 0 - 127
+ *  @return return true if success
+ */
+bool TouchDriverSetThreshold(CfgTouchButtonName_t button, uint8_t threshold);
+
+/** @brief Start calibration of the button base count
+ *  @param button button name
+ *  @return return true if success
+ */
+bool TouchDriverCalibrate(CfgTouchButtonName_t button);
+
 /** @brief Set touch device power state
  *  @param powerState [in] selected power state
  *  @return return true if success
@@ -23,8 +23,13 @@
 #include "fanDriver/fanDriver.h"
 #include "factorySettingsDriver/factorySettingsDriver.h"
 #include "timeDriver/timeDriver.h"
+#include "timerDriver/timerDriver.h"
+#include "nvsDriver/nvsDriver.h"
 
 #include "fan/fan.h"
+#include "utils/piController/piController.h"
+#include "utils/filterLoad/filterLoad.h"
+#include "utils/pwmSweep/pwmSweep.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
@@ -39,10 +44,49 @@
 
 #define MUTEX_TIMEOUT_MS (1U * 1000U)
 
+#if CFG_FAN_TACHO_PERIOD_MEASUREMENT
+#define TIMER_PERIOD_MS (250U)
+#else
 #define TIMER_PERIOD_MS (1U * 1000U)
+#endif
 
+// the longest time the speed may take to settle after the duty change
 #define TIME_NEED_TO_START_FAN_SEC (30U * 1000U)
 
+// settled when the speed changes less than 1/32 (at least 1 count per second) between samples for 1 s after the ramp
+#define FAN_SETTLE_STABLE_MS (1U * 1000U)
+#define FAN_SETTLE_STABLE_TICKS ((FAN_SETTLE_STABLE_MS + TIMER_PERIOD_MS - 1U) / TIMER_PERIOD_MS)
+#define FAN_SETTLE_SPEED_SHIFT (5U)
+#define FAN_SETTLE_MIN_MILLI_SPEED (1000U)
+
+#define FAN_DUTY_MAX (0x0fff)
+
+// speed control starts when the fan has settled on the level pwm, corrections ramp over the period
+#define FAN_CONTROL_PERIOD_MS (1U * 1000U)
+#define FAN_CONTROL_TIMER_TICKS (FAN_CONTROL_PERIOD_MS / TIMER_PERIOD_MS)
+// controlled speed is in 1/16 tacho count per second
+#define FAN_CONTROL_SPEED_SHIFT (4U)
+// duty per tacho count per second of error, Q8
+#define FAN_CONTROL_KP_Q8 ((8 * 256) >> FAN_CONTROL_SPEED_SHIFT)
+#define FAN_CONTROL_KI_Q8 ((4 * 256) >> FAN_CONTROL_SPEED_SHIFT)
+// max duty change per timer period, about 1.5 % per second
+#define FAN_CONTROL_SLEW_MAX (64U)
+// filter load fit takes settled operating points, kept in nvs with the hepa timer value of the fit
+#define FAN_FILTER_SAMPLE_MS (10U * 1000U)
+#define FAN_FILTER_SAMPLE_TICKS (FAN_FILTER_SAMPLE_MS / TIMER_PERIOD_MS)
+#define FAN_FILTER_SAVE_MS (60U * 60U * 1000U)
+#define FAN_FILTER_NVS_KAY_NAME ("fanFilter")
+// the device saves its timers every 10 min, a power loss takes the hepa timer back by up to that
+#define FAN_FILTER_HEPA_ROLLBACK_SEC (15U * 60U)
+
+// pwm sweep measures the speed ripple of each setting on the level pwm after the fan has settled
+#define FAN_PWM_SWEEP_MEASURE_MS (10U * 1000U)
+#define FAN_PWM_SWEEP_MEASURE_TICKS (FAN_PWM_SWEEP_MEASURE_MS / TIMER_PERIOD_MS)
+
+// correction limit from the level pwm, half down and double up
+#define FAN_CONTROL_MIN_DUTY(pwm) ((pwm) / 2)
+#define FAN_CONTROL_MAX_DUTY(pwm) (((pwm) * 2) > FAN_DUTY_MAX ? FAN_DUTY_MAX : ((pwm) * 2))
+
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
 *****************************************************************************/
@@ -50,12 +94,54 @@
 static bool sFanIsOff = true;
 
 static int16_t sTachoRevolutionsPerSecond;
+static uint32_t sTachoMilliSpeed;
 
 // PWM counter timer size 12 bits
 static uint32_t sFanLevelPwmDuty[FAN_LEVEL_COUNT];
 
+// target tacho count of the level, 0 - open loop level pwm
+static uint32_t sFanLevelTacho[FAN_LEVEL_COUNT];
+
 static int64_t sFanStartTime = 0;
 
+static bool sIsEmergency = false;
+static bool sIsSettled = false;
+static uint32_t sSettleStableTicks;
+static uint32_t sSettleLastMilliSpeed;
+static SettingFanLevel_t sControlLevel = FAN_LEVEL_COUNT;
+static uint32_t sActualDuty = FAN_DAFAULT_OFF_DUTY;
+static piController_t sSpeedController;
+
+typedef struct{
+    filterLoad_t load;
+    uint64_t hepaSeconds;
+}FanFilterNvs_t;
+
+static FanFilterNvs_t sFilter;
+static bool sIsFilterSaveNeeded = false;
+static int64_t sFilterSaveTime = 0;
+
+// the first setting is the one the level pwm values were set with, the others are above the audible range
+// or near it, frequency x 2**resolution up to the 80 MHz timer clock
+static const pwmSweepSetting_t sPwmSweepSettings[] = {
+    {CFG_FAN_PWM_DEFAULT_FREQ_HZ, CFG_FAN_PWM_DEFAULT_RESOLUTION_BITS},
+    {10U * 1000U, 12U},
+    {16U * 1000U, 12U},
+    {19U * 1000U, 12U},
+    {22U * 1000U, 11U},
+    {25U * 1000U, 11U},
+    {25U * 1000U, 10U},
+    {30U * 1000U, 10U},
+};
+
+static FanPwmSweepState_t sPwmSweepState = FAN_PWM_SWEEP_IDLE;
+static pwmSweep_t sPwmSweep;
+static SettingFanLevel_t sPwmSweepLevel;
+static pwmSweepSetting_t sPwmSweepPrevious;
+static uint32_t sPwmSweepTicks;
+// nvs is written by the device task, not by the timer daemon
+static bool sIsPwmSweepSavePending;
+
 static const char* TAG = "fan";
 static const char* sTimerName = "fanTimer";
 
@@ -76,6 +162,50 @@ static void vFanTimerCallback(TimerHandle_t pxTimer);
  */
 static bool InitTimer(void);
 
+/** @brief Ramp fan to the duty and restart speed control, the fan timer mutex has to be taken
+ *  @param duty pwm duty
+ *  @param level level to control after start, FAN_LEVEL_COUNT for open loop duty
+ *  @param isRamp false sets the duty at once
+ *  @return return true if success
+ */
+static bool SetDuty(uint32_t duty, SettingFanLevel_t level, bool isRamp);
+
+/** @brief Get ramp time of the duty transition
+ *  @param fromDuty actual duty
+ *  @param toDuty new duty
+ *  @return ramp time in ms
+ */
+static uint32_t GetRampTime(uint32_t fromDuty, uint32_t toDuty);
+
+/** @brief Check if the speed has settled after the duty ramp, the fan timer mutex has to be taken
+ */
+static void UpdateSettle(void);
+
+/** @brief Add settled operating point to the filter load fit, the fan timer mutex has to be taken
+ */
+static void FilterSample(void);
+
+/** @brief Run speed control step on the new tacho sample, the fan timer mutex has to be taken
+ */
+static void SpeedControl(void);
+
+/** @brief Measure the settled speed of the swept setting and go to the next one, the fan timer mutex has to be taken
+ */
+static void PwmSweepStep(void);
+
+/** @brief Set the next pwm setting of the sweep, the fan timer mutex has to be taken
+ *  @return return false if no setting is left
+ */
+static bool PwmSweepApplySetting(void);
+
+/** @brief Select, save and apply the steadiest setting and restore the level, the fan timer mutex has to be taken
+ */
+static void PwmSweepFinish(void);
+
+/** @brief Restore the previous pwm setting if the sweep runs, the fan timer mutex has to be taken
+ */
+static void PwmSweepAbort(void);
+
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
 *****************************************************************************/
@@ -87,6 +217,15 @@ bool FanInit(void)
     res &= FanDriverInit();
     res &= FanDriverSetDuty(FAN_DAFAULT_OFF_DUTY);
 
+    uint32_t pwmFreq = 0;
+    uint32_t pwmBits = 0;
+    res &= FactorySettingsGetFanPwmConfig(&pwmFreq, &pwmBits);
+    if(pwmFreq != 0){
+        if(FanDriverSetPwmConfig(pwmFreq, pwmBits) == false){
+            ESP_LOGW(TAG, "factory pwm %u Hz, %u bits not set", pwmFreq, pwmBits);
+        }
+    }
+
     ESP_LOGI(TAG, "read factory pwm values");
     uint32_t pwmValue = 0;
 
@@ -94,6 +233,24 @@ bool FanInit(void)
         res &= FactorySettingsGetPwmFanLevel(idx, &pwmValue);
 
         sFanLevelPwmDuty[idx] = pwmValue;
+
+        res &= FactorySettingsGetTachoFanLevel(idx, &sFanLevelTacho[idx]);
+    }
+
+    piControllerConfig_t controlConfig = {
+        .kpQ8 = FAN_CONTROL_KP_Q8,
+        .kiQ8 = FAN_CONTROL_KI_Q8,
+        .outMin = FAN_DAFAULT_OFF_DUTY,
+        .outMax = FAN_DUTY_MAX,
+        .slewMax = FAN_CONTROL_SLEW_MAX,
+    };
+    res &= PiControllerInit(&sSpeedController, &controlConfig, FAN_DAFAULT_OFF_DUTY);
+
+    uint16_t loadDataLen = sizeof(FanFilterNvs_t);
+    if((NvsDriverLoad(FAN_FILTER_NVS_KAY_NAME, &sFilter, &loadDataLen) == false) || (loadDataLen != sizeof(FanFilterNvs_t))){
+        ESP_LOGI(TAG, "no filter load fit, start new");
+        FilterLoadInit(&sFilter.load);
+        sFilter.hepaSeconds = 0;
     }
 
     res &= InitTimer();
@@ -105,44 +262,60 @@ bool FanLevelChange(const SettingDevice_t* settingDevice)
 {
     static SettingFanLevel_t sLastFanLevel;
 
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
     bool res = true;
     if(settingDevice->alarmError.isDetected == true)
     {
+        PwmSweepAbort();
+        sIsEmergency = true;
+
         if((settingDevice->alarmError.stuckRelayUvLamp1 == true) || (settingDevice->alarmError.stuckRelayUvLamp2 == true)){
             uint32_t lampRelayFanLevel = FanGetActualPwmFanLevel(FAN_DAFAULT_UV_LAMP_BALLAST_RELAY);
             ESP_LOGI(TAG, "fan emergency set level 1");
-            res &= FanDriverSetDuty(lampRelayFanLevel);
+            res &= SetDuty(lampRelayFanLevel, FAN_LEVEL_COUNT, true);
 
+            xSemaphoreGive(sFanTimerMutex);
             return res;
         }
 
         ESP_LOGI(TAG, "fan emergency off");
-        res &= FanDriverSetDuty(FAN_DAFAULT_OFF_DUTY);
+        res &= SetDuty(FAN_DAFAULT_OFF_DUTY, FAN_LEVEL_COUNT, false);
 
+        xSemaphoreGive(sFanTimerMutex);
         return res;
     }
 
     if(settingDevice->restore.deviceStatus.isDeviceOn == false)
     {
-        res &= FanDriverSetDuty(FAN_DAFAULT_OFF_DUTY);
+        PwmSweepAbort();
+        res &= SetDuty(FAN_DAFAULT_OFF_DUTY, FAN_LEVEL_COUNT, true);
         sFanIsOff = true;
+        sIsEmergency = false;
 
         ESP_LOGI(TAG, "fan off");
-        
+
+        xSemaphoreGive(sFanTimerMutex);
         return res;
     }
 
-    if((sFanIsOff == false) && (sLastFanLevel == settingDevice->restore.deviceStatus.fanLevel)){
+    // the level pwm is restored after the emergency
+    if((sFanIsOff == false) && (sIsEmergency == false) && (sLastFanLevel == settingDevice->restore.deviceStatus.fanLevel)){
+        xSemaphoreGive(sFanTimerMutex);
         return true;
     }
+    PwmSweepAbort();
     sFanIsOff = false;
+    sIsEmergency = false;
     sLastFanLevel = settingDevice->restore.deviceStatus.fanLevel;
 
-    res &= FanDriverSetDuty(sFanLevelPwmDuty[sLastFanLevel]);
-      
-    sFanStartTime = TimeDriverGetSystemTickMs();
-    ESP_LOGI(TAG, "%llu change fan level to %d", sFanStartTime, (sLastFanLevel + 1));
+    res &= SetDuty(sFanLevelPwmDuty[sLastFanLevel], sLastFanLevel, true);
 
+    ESP_LOGI(TAG, "%llu change fan level to %d, target speed %u [RPS]", sFanStartTime, (sLastFanLevel + 1), sFanLevelTacho[sLastFanLevel]);
+
+    xSemaphoreGive(sFanTimerMutex);
     return res;
 }
 
@@ -164,18 +337,207 @@ void FanSetNewPwmFanLevel(SettingFanLevel_t level, uint32_t newPwmValue)
     sFanLevelPwmDuty[level] = newPwmValue;
 }
 
+uint32_t FanGetTargetTachoFanLevel(SettingFanLevel_t level)
+{
+    if(level >= FAN_LEVEL_COUNT){
+        return 0;
+    }
+
+    return sFanLevelTacho[level];
+}
+
+bool FanSetTargetTachoFanLevel(SettingFanLevel_t level, uint32_t tacho)
+{
+    if(level >= FAN_LEVEL_COUNT){
+        return false;
+    }
+
+    if(FactorySettingsUpdateTachoFanLevel(level, tacho) == false){
+        ESP_LOGE(TAG, "save target speed fail");
+        return false;
+    }
+
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
+    sFanLevelTacho[level] = tacho;
+
+    // running level starts again from the level pwm
+    bool res = true;
+    if(sControlLevel == level){
+        res = SetDuty(sFanLevelPwmDuty[level], level, true);
+    }
+
+    xSemaphoreGive(sFanTimerMutex);
+
+    return res;
+}
+
+bool FanGetControlStatus(FanControlStatus_t* status)
+{
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
+    status->duty = FanDriverGetDuty();
+    status->tacho = sTachoRevolutionsPerSecond;
+    status->tachoMilli = sTachoMilliSpeed;
+    status->targetTacho = (sControlLevel < FAN_LEVEL_COUNT) ? sFanLevelTacho[sControlLevel] : 0;
+    status->isRamping = (FanDriverIsRampDone() == false);
+    status->isSettled = sIsSettled;
+    status->isControlActive = (status->targetTacho != 0) && sIsSettled;
+    status->isLimited = status->isControlActive && PiControllerIsLimited(&sSpeedController);
+    FanDriverGetPwmConfig(&status->pwmFreqHz, &status->pwmResolutionBits);
+
+    xSemaphoreGive(sFanTimerMutex);
+
+    return true;
+}
+
+bool FanPwmSweepStart(void)
+{
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
+    // the sweep runs on a level, not while off, in emergency or already sweeping
+    if((sPwmSweepState == FAN_PWM_SWEEP_RUNNING) || (sIsPwmSweepSavePending == true) || (sControlLevel >= FAN_LEVEL_COUNT)){
+        ESP_LOGW(TAG, "pwm sweep needs the fan on a level");
+        xSemaphoreGive(sFanTimerMutex);
+        return false;
+    }
+
+    bool res = PwmSweepInit(&sPwmSweep, sPwmSweepSettings, (sizeof(sPwmSweepSettings) / sizeof(pwmSweepSetting_t)));
+    if(res == true){
+        FanDriverGetPwmConfig(&sPwmSweepPrevious.freqHz, &sPwmSweepPrevious.resolutionBits);
+        sPwmSweepLevel = sControlLevel;
+        sPwmSweepTicks = 0;
+        sPwmSweepState = FAN_PWM_SWEEP_RUNNING;
+        ESP_LOGI(TAG, "pwm sweep on level %d", (sPwmSweepLevel + 1));
+
+        res = PwmSweepApplySetting();
+        if(res == false){
+            PwmSweepAbort();
+        }
+    }
+
+    xSemaphoreGive(sFanTimerMutex);
+
+    return res;
+}
+
+FanPwmSweepState_t FanGetPwmSweepState(void)
+{
+    // the sweep is done when its setting is saved
+    if(sIsPwmSweepSavePending == true){
+        return FAN_PWM_SWEEP_RUNNING;
+    }
+
+    return sPwmSweepState;
+}
+
+bool FanPwmSweepProcess(void)
+{
+    if(sIsPwmSweepSavePending == false){
+        return true;
+    }
+
+    uint32_t freqHz = 0;
+    uint8_t resolutionBits = 0;
+
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+    FanDriverGetPwmConfig(&freqHz, &resolutionBits);
+    xSemaphoreGive(sFanTimerMutex);
+
+    // a new sweep waits for the save, the setting in use is the selected one
+    bool res = FactorySettingsUpdateFanPwmConfig(freqHz, resolutionBits);
+
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
+    if(res == false){
+        ESP_LOGE(TAG, "pwm %u Hz, %u bits save fail", freqHz, resolutionBits);
+        FanDriverSetPwmConfig(sPwmSweepPrevious.freqHz, sPwmSweepPrevious.resolutionBits);
+        sPwmSweepState = FAN_PWM_SWEEP_FAILED;
+        ESP_LOGW(TAG, "%u Hz, %u bits restored", sPwmSweepPrevious.freqHz, sPwmSweepPrevious.resolutionBits);
+    }
+    sIsPwmSweepSavePending = false;
+
+    xSemaphoreGive(sFanTimerMutex);
+
+    return res;
+}
+
+bool FanGetFilterLoad(FanFilterLoad_t* filterLoad)
+{
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
+    float change = 0.0f;
+    filterLoad->samples = sFilter.load.samples;
+    filterLoad->isEstimated = FilterLoadGetDutyChange(&sFilter.load, &change);
+    filterLoad->dutyChangePercent = (int16_t)(change * 100.0f);
+    filterLoad->loadPercent = 0;
+    FilterLoadGetPercent(&sFilter.load, (CFG_HEPA_CLOGGED_FAN_DUTY_CHANGE_PERCENT / 100.0f), &filterLoad->loadPercent);
+
+    xSemaphoreGive(sFanTimerMutex);
+
+    return true;
+}
+
+bool FanFilterLoadProcess(void)
+{
+    uint64_t hepaSeconds = 0;
+    if(TimerDriverGetCounterSec(TIMER_NAME_HEPA, &hepaSeconds) == false){
+        return false;
+    }
+
+    if(xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) != pdTRUE){
+        return false;
+    }
+
+    // the hepa timer is cleared on the filter replacement
+    if((hepaSeconds + FAN_FILTER_HEPA_ROLLBACK_SEC) < sFilter.hepaSeconds){
+        ESP_LOGI(TAG, "new hepa filter, filter load fit restarts");
+        FilterLoadInit(&sFilter.load);
+        sIsFilterSaveNeeded = true;
+    }
+    sFilter.hepaSeconds = hepaSeconds;
+
+    if((sIsFilterSaveNeeded == false) && (TimeDriverHasTimeElapsed(sFilterSaveTime, FAN_FILTER_SAVE_MS) == false)){
+        xSemaphoreGive(sFanTimerMutex);
+        return true;
+    }
+
+    FanFilterNvs_t filter = sFilter;
+    sIsFilterSaveNeeded = false;
+    sFilterSaveTime = TimeDriverGetSystemTickMs();
+
+    xSemaphoreGive(sFanTimerMutex);
+
+    return NvsDriverSave(FAN_FILTER_NVS_KAY_NAME, &filter, sizeof(FanFilterNvs_t));
+}
+
 FanTachoState_t FanGetTachoRevolutionsPerSecond(int16_t* revolutions)
 {
     if (xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
     {
         *revolutions = sTachoRevolutionsPerSecond;
+        bool isSettled = sIsSettled;
+        bool isStopped = (sActualDuty == FAN_DAFAULT_OFF_DUTY);
          xSemaphoreGive(sFanTimerMutex);
 
-        if(sFanIsOff == true){
+        // the emergency off stops the fan too
+        if((sFanIsOff == true) || (isStopped == true)){
             return FAN_TACHO_DEVICE_OFF;
         }
 
-        if(TimeDriverHasTimeElapsed(sFanStartTime, TIME_NEED_TO_START_FAN_SEC) == false){
+        if(isSettled == false){
             return FAN_TACHO_STARTS;
         }
 
@@ -193,8 +555,18 @@ static void vFanTimerCallback(TimerHandle_t pxTimer)
 {
     if (xSemaphoreTake(sFanTimerMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
     {
+#if CFG_FAN_TACHO_PERIOD_MEASUREMENT
+        sTachoMilliSpeed = FanDriverGetTachoMilliSpeed();
+        sTachoRevolutionsPerSecond = (sTachoMilliSpeed + 500U) / 1000U;
+#else
         sTachoRevolutionsPerSecond = FanDriverGetTachoCount();
-        
+        sTachoMilliSpeed = sTachoRevolutionsPerSecond * 1000U;
+#endif
+        UpdateSettle();
+        PwmSweepStep();
+        FilterSample();
+        SpeedControl();
+
         xSemaphoreGive(sFanTimerMutex);
     }
 }
@@ -219,4 +591,194 @@ static bool InitTimer(void)
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+static bool SetDuty(uint32_t duty, SettingFanLevel_t level, bool isRamp)
+{
+    uint32_t rampMs = isRamp ? GetRampTime(FanDriverGetDuty(), duty) : 0;
+
+    sControlLevel = level;
+    sActualDuty = duty;
+
+    sFanStartTime = TimeDriverGetSystemTickMs();
+    sIsSettled = false;
+    sSettleStableTicks = 0;
+
+    // the controller starts from the level pwm and corrects it in limited range
+    PiControllerSetLimits(&sSpeedController, FAN_CONTROL_MIN_DUTY(duty), FAN_CONTROL_MAX_DUTY(duty));
+    PiControllerReset(&sSpeedController, duty);
+
+    return FanDriverSetDutyWithRamp(duty, rampMs);
+}
+
+static uint32_t GetRampTime(uint32_t fromDuty, uint32_t toDuty)
+{
+    if(fromDuty == FAN_DAFAULT_OFF_DUTY){
+        return CFG_FAN_RAMP_START_MS;
+    }
+
+    if(toDuty > fromDuty){
+        return ((toDuty - fromDuty) * CFG_FAN_RAMP_UP_FULL_SCALE_MS) / FAN_DUTY_MAX;
+    }
+
+    return ((fromDuty - toDuty) * CFG_FAN_RAMP_DOWN_FULL_SCALE_MS) / FAN_DUTY_MAX;
+}
+
+static void UpdateSettle(void)
+{
+    if(sIsSettled == true){
+        return;
+    }
+
+    uint32_t lastMilliSpeed = sSettleLastMilliSpeed;
+    sSettleLastMilliSpeed = sTachoMilliSpeed;
+
+    if(FanDriverIsRampDone() == false){
+        sSettleStableTicks = 0;
+        return;
+    }
+
+    uint32_t change = (sTachoMilliSpeed > lastMilliSpeed) ? (sTachoMilliSpeed - lastMilliSpeed) : (lastMilliSpeed - sTachoMilliSpeed);
+    uint32_t tolerance = sTachoMilliSpeed >> FAN_SETTLE_SPEED_SHIFT;
+    if(tolerance < FAN_SETTLE_MIN_MILLI_SPEED){
+        tolerance = FAN_SETTLE_MIN_MILLI_SPEED;
+    }
+
+    sSettleStableTicks = (change <= tolerance) ? (sSettleStableTicks + 1U) : 0;
+
+    if((sSettleStableTicks >= FAN_SETTLE_STABLE_TICKS) || TimeDriverHasTimeElapsed(sFanStartTime, TIME_NEED_TO_START_FAN_SEC)){
+        sIsSettled = true;
+        ESP_LOGI(TAG, "fan settled in %lld ms, speed %u [mRPS]", (TimeDriverGetSystemTickMs() - sFanStartTime), sTachoMilliSpeed);
+    }
+}
+
+static void FilterSample(void)
+{
+    static uint32_t sTicks;
+
+    if((sIsSettled == false) || (sFanIsOff == true) || (sIsEmergency == true) || (sTachoMilliSpeed == 0) || (sPwmSweepState == FAN_PWM_SWEEP_RUNNING)){
+        sTicks = 0;
+        return;
+    }
+
+    sTicks += 1;
+    if(sTicks < FAN_FILTER_SAMPLE_TICKS){
+        return;
+    }
+    sTicks = 0;
+
+    bool isLearned = (sFilter.load.cleanRatio != 0.0f);
+
+    FilterLoadAddSample(&sFilter.load, (sTachoMilliSpeed / 1000.0f), (float)FanDriverGetDuty());
+
+    if((isLearned == false) && (sFilter.load.cleanRatio != 0.0f)){
+        ESP_LOGI(TAG, "new filter duty per speed %.2f", sFilter.load.cleanRatio);
+        sIsFilterSaveNeeded = true;
+    }
+}
+
+static void SpeedControl(void)
+{
+    static uint32_t sTicks;
+
+    sTicks += 1;
+    if(sTicks < FAN_CONTROL_TIMER_TICKS){
+        return;
+    }
+    sTicks = 0;
+
+    if((sControlLevel >= FAN_LEVEL_COUNT) || (sFanLevelTacho[sControlLevel] == 0)){
+        return;
+    }
+
+    if(sIsSettled == false){
+        return;
+    }
+
+    int32_t target = sFanLevelTacho[sControlLevel] << FAN_CONTROL_SPEED_SHIFT;
+    int32_t speed = (sTachoMilliSpeed << FAN_CONTROL_SPEED_SHIFT) / 1000U;
+
+    uint32_t duty = PiControllerUpdate(&sSpeedController, target, speed);
+    if(duty == sActualDuty){
+        return;
+    }
+
+    if(FanDriverSetDutyWithRamp(duty, FAN_CONTROL_PERIOD_MS) == true){
+        sActualDuty = duty;
+    }
+}
+
+static void PwmSweepStep(void)
+{
+    if((sPwmSweepState != FAN_PWM_SWEEP_RUNNING) || (sIsSettled == false)){
+        return;
+    }
+
+    PwmSweepAddSample(&sPwmSweep, sTachoMilliSpeed);
+
+    sPwmSweepTicks += 1;
+    if(sPwmSweepTicks < FAN_PWM_SWEEP_MEASURE_TICKS){
+        return;
+    }
+    sPwmSweepTicks = 0;
+
+    uint8_t idx = sPwmSweep.index;
+    PwmSweepNext(&sPwmSweep, true);
+    ESP_LOGI(TAG, "pwm %u Hz, %u bits: speed %u [mRPS], ripple %u [1/1000]", sPwmSweep.settings[idx].freqHz, sPwmSweep.settings[idx].resolutionBits,
+        sPwmSweep.results[idx].meanMilliSpeed, sPwmSweep.results[idx].ripplePerMille);
+
+    if(PwmSweepApplySetting() == false){
+        PwmSweepFinish();
+    }
+}
+
+static bool PwmSweepApplySetting(void)
+{
+    pwmSweepSetting_t setting = {};
+
+    while(PwmSweepGetSetting(&sPwmSweep, &setting) == true){
+        if(FanDriverSetPwmConfig(setting.freqHz, setting.resolutionBits) == true){
+            return SetDuty(sFanLevelPwmDuty[sPwmSweepLevel], FAN_LEVEL_COUNT, false);
+        }
+
+        ESP_LOGW(TAG, "pwm %u Hz, %u bits not set", setting.freqHz, setting.resolutionBits);
+        PwmSweepNext(&sPwmSweep, false);
+    }
+
+    return false;
+}
+
+static void PwmSweepFinish(void)
+{
+    pwmSweepSetting_t best = {};
+
+    if(PwmSweepGetBest(&sPwmSweep, &best) == false){
+        ESP_LOGE(TAG, "pwm sweep found no setting");
+        PwmSweepAbort();
+        SetDuty(sFanLevelPwmDuty[sPwmSweepLevel], sPwmSweepLevel, true);
+        return;
+    }
+
+    if(FanDriverSetPwmConfig(best.freqHz, best.resolutionBits) == false){
+        ESP_LOGE(TAG, "pwm %u Hz, %u bits not set", best.freqHz, best.resolutionBits);
+        PwmSweepAbort();
+        SetDuty(sFanLevelPwmDuty[sPwmSweepLevel], sPwmSweepLevel, true);
+        return;
+    }
+
+    ESP_LOGI(TAG, "pwm sweep selected %u Hz, %u bits", best.freqHz, best.resolutionBits);
+    sPwmSweepState = FAN_PWM_SWEEP_DONE;
+    sIsPwmSweepSavePending = true;
+    SetDuty(sFanLevelPwmDuty[sPwmSweepLevel], sPwmSweepLevel, true);
+}
+
+static void PwmSweepAbort(void)
+{
+    if(sPwmSweepState != FAN_PWM_SWEEP_RUNNING){
+        return;
+    }
+
+    FanDriverSetPwmConfig(sPwmSweepPrevious.freqHz, sPwmSweepPrevious.resolutionBits);
+    sPwmSweepState = FAN_PWM_SWEEP_FAILED;
+    ESP_LOGW(TAG, "pwm sweep stopped, %u Hz, %u bits restored", sPwmSweepPrevious.freqHz, sPwmSweepPrevious.resolutionBits);
+}
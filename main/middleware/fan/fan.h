@@ -28,6 +28,33 @@ typedef enum{
     FAN_TACHO_WORKS,
 }FanTachoState_t;
 
+typedef enum{
+    FAN_PWM_SWEEP_IDLE = 0,
+    FAN_PWM_SWEEP_RUNNING,
+    FAN_PWM_SWEEP_DONE,
+    FAN_PWM_SWEEP_FAILED,
+}FanPwmSweepState_t;
+
+typedef struct{
+    uint32_t duty;
+    uint32_t targetTacho;
+    int16_t tacho;
+    uint32_t tachoMilli;            // tacho count per second x 1000
+    bool isRamping;
+    bool isSettled;                 // ramp done and the speed stable
+    bool isControlActive;
+    bool isLimited;
+    uint32_t pwmFreqHz;
+    uint8_t pwmResolutionBits;
+}FanControlStatus_t;
+
+typedef struct{
+    bool isEstimated;               // false until the new filter fan curve is learned
+    uint8_t loadPercent;            // 0 - new, 100 - clogged
+    int16_t dutyChangePercent;      // duty needed for the same speed against the new filter, follows the pressure drop
+    uint32_t samples;
+}FanFilterLoad_t;
+
 /*****************************************************************************
                          PUBLIC INTERFACE DECLARATION
 *****************************************************************************/
@@ -55,8 +82,56 @@ uint32_t FanGetActualPwmFanLevel(SettingFanLevel_t level);
  */
 void FanSetNewPwmFanLevel(SettingFanLevel_t level, uint32_t newPwmValue);
 
+/** @brief Get target tacho speed for selected fan level (ft tool use it)
+ *  @param level fan level number
+ *  @return return target tacho count per second, 0 if the level runs on the pwm value
+ */
+uint32_t FanGetTargetTachoFanLevel(SettingFanLevel_t level);
+
+/** @brief Set and save target tacho speed for selected fan level (ft tool use it)
+ *  @param level fan level number
+ *  @param tacho target tacho count per second, 0 disables speed control of the level
+ *  @return return true if success
+ */
+bool FanSetTargetTachoFanLevel(SettingFanLevel_t level, uint32_t tacho);
+
+/** @brief Get speed control status
+ *  @param status [out] pointer to result
+ *  @return return true if success
+ */
+bool FanGetControlStatus(FanControlStatus_t* status);
+
+/** @brief Start sweep of pwm frequency / resolution settings on the running level (ft tool use it),
+ *         the steadiest setting is saved to factory partition by FanPwmSweepProcess, a level change or off aborts the sweep
+ *  @return return true if started
+ */
+bool FanPwmSweepStart(void);
+
+/** @brief Get pwm sweep state
+ *  @return state of the last sweep
+ */
+FanPwmSweepState_t FanGetPwmSweepState(void);
+
+/** @brief Save the setting selected by the pwm sweep to factory partition, out of the fan timer,
+ *         call it periodically from the device task
+ *  @return return true if success
+ */
+bool FanPwmSweepProcess(void);
+
+/** @brief Get hepa filter load estimated from the fan duty and speed
+ *  @param filterLoad [out] pointer to result
+ *  @return return true if success
+ */
+bool FanGetFilterLoad(FanFilterLoad_t* filterLoad);
+
+/** @brief Restart the filter load fit after the hepa timer clear and save it to nvs from time to time,
+ *         call it periodically from the device task
+ *  @return return true if success
+ */
+bool FanFilterLoadProcess(void);
+
 /** @brief Get tacho revolutions per second
  *  @param revolutions [out] pointer to result
- *  @return tacho status
+ *  @return tacho status, FAN_TACHO_STARTS until the speed settles after the duty ramp
  */
 FanTachoState_t FanGetTachoRevolutionsPerSecond(int16_t* revolutions);
\ No newline at end of file
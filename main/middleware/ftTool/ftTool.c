@@ -85,8 +85,28 @@ void FtToolMainLoop(void *argument)
             FtToolUserReadPwmFanLevel, FtToolUserWritePwmFanLevel },
         {{ "TAC", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, 1, 2, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "RPS", "Tacho speed" },
             FtToolUserReadTachoSpeed, NULL },
+        {{ "FTG", FT_TOOL_DIAG_PARAM_PERMISSION_READ_WRITE, FAN_LEVEL_COUNT, 2, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "RPS", "Fan target speed" },
+            FtToolUserReadTargetTachoFanLevel, FtToolUserWriteTargetTachoFanLevel },
+        {{ "FDU", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, 1, 2, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "bit", "Fan pwm duty" },
+            FtToolUserReadFanDuty, NULL },
+        {{ "FPW", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, 2, 4, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "Hz,bit", "Fan pwm frequency, resolution" },
+            FtToolUserReadFanPwmConfig, NULL },
+        {{ "FPS", FT_TOOL_DIAG_PARAM_PERMISSION_READ_WRITE, 1, 1, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "-", "Fan pwm sweep, 1 - start" },
+            FtToolUserReadFanPwmSweep, FtToolUserWriteFanPwmSweep },
         {{ "BAV", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, 2, 4, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "mV", "Uv lamp" },
             FtToolUserReadUvLampVoltage, NULL },
+        {{ "WEP", FT_TOOL_DIAG_PARAM_PERMISSION_READ_WRITE, 1, 1, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "-", "Web metrics endpoint" },
+            FtToolUserReadWebMetricsEndpoint, FtToolUserWriteWebMetricsEndpoint },
+        {{ "WMT", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, 6, 4, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "-", "Web metrics n,err,B,avg,p95,max" },
+            FtToolUserReadWebMetrics, NULL },
+        {{ "TFT", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, CFG_TOUCH_BUTTON_NAME_COUNT, 4, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "-", "Touch false triggers" },
+            FtToolUserReadTouchFalseTriggers, NULL },
+        {{ "TNS", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, CFG_TOUCH_BUTTON_NAME_COUNT, 1, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "cnt", "Touch noise peak" },
+            FtToolUserReadTouchNoisePeak, NULL },
+        {{ "TTH", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, CFG_TOUCH_BUTTON_NAME_COUNT, 1, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "cnt", "Touch threshold" },
+            FtToolUserReadTouchThreshold, NULL },
+        {{ "TSN", FT_TOOL_DIAG_PARAM_PERMISSION_READ_ONLY, 1, 1, FT_TOOL_DIAG_PARAM_TYPE_UNSIGNED, 10, 0, "-", "Touch sensitivity" },
+            FtToolUserReadTouchSensitivity, NULL },
     };
 
     uint8_t singleChar = 0;
@@ -19,6 +19,15 @@
 #include "fan/fan.h"
 #include "ledDriver/ledDriver.h"
 #include "uvLamp/uvLamp.h"
+#include "touch/touch.h"
+#include "webServer/webMetrics.h"
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+// web server endpoint read by the web metrics parameter
+static uint8_t sWebMetricsEndpoint;
 
 /*****************************************************************************
                          PRIVATE FUNCTION DECLARATION
@@ -133,6 +142,58 @@ bool FtToolUserReadTachoSpeed(uint8_t channel, void *dataPtr, uint32_t dataSize)
     return true;
 }
 
+bool FtToolUserReadTargetTachoFanLevel(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    uint16_t tacho = FanGetTargetTachoFanLevel(channel);
+
+    *(uint16_t *)dataPtr = tacho;
+
+    return true;
+}
+
+bool FtToolUserWriteTargetTachoFanLevel(uint8_t channel, const void *dataPtr, uint32_t dataSize)
+{
+    uint16_t newTacho = *(uint16_t *)dataPtr;
+
+    return FanSetTargetTachoFanLevel(channel, newTacho);
+}
+
+bool FtToolUserReadFanDuty(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    FanControlStatus_t status = {};
+    FanGetControlStatus(&status);
+
+    *(uint16_t *)dataPtr = status.duty;
+
+    return true;
+}
+
+bool FtToolUserReadFanPwmConfig(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    FanControlStatus_t status = {};
+    FanGetControlStatus(&status);
+
+    *(uint32_t *)dataPtr = (channel == 0) ? status.pwmFreqHz : status.pwmResolutionBits;
+
+    return true;
+}
+
+bool FtToolUserReadFanPwmSweep(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    *(uint8_t *)dataPtr = FanGetPwmSweepState();
+
+    return true;
+}
+
+bool FtToolUserWriteFanPwmSweep(uint8_t channel, const void *dataPtr, uint32_t dataSize)
+{
+    if(*(uint8_t *)dataPtr != 1){
+        return false;
+    }
+
+    return FanPwmSweepStart();
+}
+
 bool FtToolUserReadUvLampVoltage(uint8_t channel, void *dataPtr, uint32_t dataSize)
 {
     uint32_t voltage = 0;
@@ -149,6 +210,110 @@ bool FtToolUserReadUvLampVoltage(uint8_t channel, void *dataPtr, uint32_t dataSi
     return true;
 }
 
+bool FtToolUserReadWebMetricsEndpoint(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    *(uint8_t *)dataPtr = sWebMetricsEndpoint;
+
+    return true;
+}
+
+bool FtToolUserWriteWebMetricsEndpoint(uint8_t channel, const void *dataPtr, uint32_t dataSize)
+{
+    uint8_t endpoint = *(uint8_t *)dataPtr;
+
+    if (endpoint >= WebMetricsGetEndpointsCount()) {
+        return false;
+    }
+
+    sWebMetricsEndpoint = endpoint;
+    return true;
+}
+
+bool FtToolUserReadWebMetrics(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    requestMetrics_t metrics = {};
+    uint32_t data = 0;
+
+    if (WebMetricsGet(sWebMetricsEndpoint, &metrics) == false) {
+        return false;
+    }
+
+    if(channel == 0){
+        data = metrics.count;
+    }
+    else if(channel == 1){
+        data = metrics.errors;
+    }
+    else if(channel == 2){
+        data = metrics.bytesSent;
+    }
+    else if(channel == 3){
+        data = RequestMetricsGetMeanUs(&metrics);
+    }
+    else if(channel == 4){
+        data = RequestMetricsGetPercentileUs(&metrics, 95);
+    }
+    else if(channel == 5){
+        data = metrics.latencyMaxUs;
+    }
+
+    *(uint32_t *)dataPtr = data;
+
+    return true;
+}
+
+bool FtToolUserReadTouchFalseTriggers(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    TouchStats_t stats = {};
+
+    if((channel >= CFG_TOUCH_BUTTON_NAME_COUNT) || (TouchGetStats(&stats) == false)){
+        return false;
+    }
+
+    *(uint32_t *)dataPtr = stats.button[channel].falseTriggers;
+
+    return true;
+}
+
+bool FtToolUserReadTouchNoisePeak(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    TouchStats_t stats = {};
+
+    if((channel >= CFG_TOUCH_BUTTON_NAME_COUNT) || (TouchGetStats(&stats) == false)){
+        return false;
+    }
+
+    *(uint8_t *)dataPtr = stats.button[channel].noisePeak;
+
+    return true;
+}
+
+bool FtToolUserReadTouchThreshold(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    TouchStats_t stats = {};
+
+    if((channel >= CFG_TOUCH_BUTTON_NAME_COUNT) || (TouchGetStats(&stats) == false)){
+        return false;
+    }
+
+    *(uint8_t *)dataPtr = stats.button[channel].threshold;
+
+    return true;
+}
+
+bool FtToolUserReadTouchSensitivity(uint8_t channel, void *dataPtr, uint32_t dataSize)
+{
+    TouchStats_t stats = {};
+
+    if(TouchGetStats(&stats) == false){
+        return false;
+    }
+
+    *(uint8_t *)dataPtr = stats.sensitivity;
+
+    return true;
+}
+
 /******************************************************************************
                         PRIVATE FUNCTION IMPLEMENTATION
 ******************************************************************************/
@@ -78,6 +78,58 @@ bool FtToolUserWriteColorOrangeComponent(uint8_t channel, const void *dataPtr, u
  */
 bool FtToolUserReadTachoSpeed(uint8_t channel, void *dataPtr, uint32_t dataSize);
 
+/** @brief Read target tacho speed of fan level
+ */
+bool FtToolUserReadTargetTachoFanLevel(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Set target tacho speed of fan level
+ */
+bool FtToolUserWriteTargetTachoFanLevel(uint8_t channel, const void *dataPtr, uint32_t dataSize);
+
+/** @brief Read actual fan pwm duty
+ */
+bool FtToolUserReadFanDuty(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read fan pwm frequency (channel 0) and timer resolution (channel 1)
+ */
+bool FtToolUserReadFanPwmConfig(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read fan pwm sweep state, 0 - idle, 1 - running, 2 - done, 3 - failed
+ */
+bool FtToolUserReadFanPwmSweep(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Start fan pwm sweep on the running level
+ */
+bool FtToolUserWriteFanPwmSweep(uint8_t channel, const void *dataPtr, uint32_t dataSize);
+
 /** @brief Read uv lamp ballast mili volt
  */
-bool FtToolUserReadUvLampVoltage(uint8_t channel, void *dataPtr, uint32_t dataSize);
\ No newline at end of file
+bool FtToolUserReadUvLampVoltage(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read web server endpoint selected for web metrics
+ */
+bool FtToolUserReadWebMetricsEndpoint(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Select web server endpoint for web metrics, in registration order as listed by GET /metrics
+ */
+bool FtToolUserWriteWebMetricsEndpoint(uint8_t channel, const void *dataPtr, uint32_t dataSize);
+
+/** @brief Read web metrics of selected endpoint: count, errors, bytes, mean us, p95 us, max us
+ */
+bool FtToolUserReadWebMetrics(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read touch false triggers of the button
+ */
+bool FtToolUserReadTouchFalseTriggers(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read touch idle noise peak delta count of the button
+ */
+bool FtToolUserReadTouchNoisePeak(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read touch threshold of the button
+ */
+bool FtToolUserReadTouchThreshold(uint8_t channel, void *dataPtr, uint32_t dataSize);
+
+/** @brief Read touch sensitivity, 0 most sensitive
+ */
+bool FtToolUserReadTouchSensitivity(uint8_t channel, void *dataPtr, uint32_t dataSize);
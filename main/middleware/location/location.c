@@ -92,7 +92,7 @@ bool LocationLoad(void)
 
 void LocationPrintf(Location_t* location)
 {
-    ESP_LOGI(TAG, "Location size %d", sizeof(Location_t));
+    ESP_LOGI(TAG, "Location size %u", (unsigned int)sizeof(Location_t));
 
     ESP_LOGI(TAG, "Address %s", location->address);
 
@@ -21,6 +21,7 @@
 #include <mbedtls/md.h>
 
 #include "esp_ota_ops.h"
+#include "esp_partition.h"
 
 #include "esp_http_client.h"
 
@@ -32,6 +33,7 @@
 #include "mcuDriver/mcuDriver.h"
 #include "timeDriver/timeDriver.h"
 #include "factorySettingsDriver/factorySettingsDriver.h"
+#include "nvsDriver/nvsDriver.h"
 
 /*****************************************************************************
                           PRIVATE DEFINES / MACROS
@@ -45,10 +47,17 @@
 
 #define UPDATE_DOWNLOAD_TIMEOUT (25U * 60U * 1000U)        // 25 minute
 
+#define WEB_ASSETS_NVS_KAY_NAME ("WebAssets")
+
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
 *****************************************************************************/
 
+typedef struct {
+    uint8_t isValid : 1;
+    uint32_t size;
+} __attribute__ ((packed)) OtaWebAssets_t;
+
 static OtaStatus_t sOtaStatus = OTA_NOTHING_TO_DO;
 
 static TaskHandle_t sTaskHandle;
@@ -73,6 +82,12 @@ static void DelayTask(void);
  */
 static void OtaMainLoop(void *argument);
 
+/** @brief Save web assets staging partition state to Non-volatile storage
+ *  @param webAssets [in] pointer to OtaWebAssets_t
+ *  @return return true if success
+ */
+static bool WebAssetsSave(OtaWebAssets_t* webAssets);
+
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
 *****************************************************************************/
@@ -205,6 +220,11 @@ static void DelayTask(void)
     }
 }
 
+static bool WebAssetsSave(OtaWebAssets_t* webAssets)
+{
+    return NvsDriverSave(WEB_ASSETS_NVS_KAY_NAME, webAssets, sizeof(OtaWebAssets_t));
+}
+
 void OtaMainLoop(void *argument)
 {
     Ota_t* otaCandidate = argument;
@@ -440,4 +460,99 @@ esp_err_t OtaUploadByWebserver(httpd_req_t* req)
     
 
     return ESP_FAIL;
-}
\ No newline at end of file
+}
+
+esp_err_t OtaUploadWebAssetsByWebserver(httpd_req_t* req)
+{
+    char buf[DATA_BUFFOR_SIZE] = {};
+    const uint32_t totalFileSize = req->content_len;
+
+    ESP_LOGI(TAG, "web assets start");
+    ESP_LOGI(TAG, "total file size %u", totalFileSize);
+
+    const esp_partition_t* stagingPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, CFG_WEB_ASSETS_PARTITION_SUBTYPE, CFG_WEB_ASSETS_OTA_PARTITION_LABEL);
+    if (stagingPartition == NULL){
+        ESP_LOGE(TAG, "can't get web assets partition");
+        return ESP_FAIL;
+    }
+
+    if ((totalFileSize == 0) || (totalFileSize > stagingPartition->size)){
+        ESP_LOGE(TAG, "incorrect file size, partition size %u", stagingPartition->size);
+        return ESP_FAIL;
+    }
+
+    // a power cut during the upload must not leave half written image in use
+    if (OtaWebAssetsInvalidate() == false){
+        ESP_LOGE(TAG, "can't invalidate web assets");
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Writing to partition %s at offset 0x%x", stagingPartition->label, stagingPartition->address);
+
+    esp_err_t err = esp_partition_erase_range(stagingPartition, 0, stagingPartition->size);
+    if (err != ESP_OK){
+        ESP_LOGE(TAG, "erase error %d", err);
+        return ESP_FAIL;
+    }
+
+    uint32_t currentReadDataFromBinFile = 0;
+
+    for(;;){
+        int singleDataPackageSize = httpd_req_recv(req, buf, DATA_BUFFOR_SIZE);
+        if (singleDataPackageSize > 0) {
+            err = esp_partition_write(stagingPartition, currentReadDataFromBinFile, buf, singleDataPackageSize);
+            if(err != ESP_OK){
+                ESP_LOGE(TAG, "web assets write error %d", err);
+                return ESP_FAIL;
+            }
+
+            currentReadDataFromBinFile += singleDataPackageSize;
+            ESP_LOGI(TAG, "upload %d, left to upload %d", singleDataPackageSize, totalFileSize - currentReadDataFromBinFile);
+        }
+        else if(singleDataPackageSize < 0){
+            ESP_LOGE(TAG, "read http req error %d", singleDataPackageSize);
+            return ESP_FAIL;
+        }
+        else{
+            ESP_LOGI(TAG, "end of web assets upload");
+
+            if(currentReadDataFromBinFile != totalFileSize){
+                ESP_LOGE(TAG, "incomplete web assets image");
+                return ESP_FAIL;
+            }
+
+            OtaWebAssets_t webAssets = {
+                .isValid = true,
+                .size = totalFileSize,
+            };
+
+            if(WebAssetsSave(&webAssets) == false){
+                return ESP_FAIL;
+            }
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+bool OtaIsWebAssetsValid(void)
+{
+    OtaWebAssets_t webAssets = {};
+    uint16_t loadDataLen = sizeof(OtaWebAssets_t);
+
+    bool res = NvsDriverLoad(WEB_ASSETS_NVS_KAY_NAME, &webAssets, &loadDataLen);
+    if((res == false) || (loadDataLen != sizeof(OtaWebAssets_t))){
+        return false;
+    }
+
+    return webAssets.isValid;
+}
+
+bool OtaWebAssetsInvalidate(void)
+{
+    OtaWebAssets_t webAssets = {};
+
+    return WebAssetsSave(&webAssets);
+}
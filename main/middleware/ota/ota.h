@@ -101,4 +101,21 @@ void  OtaMarkInvalid(void);
  *  @param req HTTP request data structure
  *  @return return status 
  */
-esp_err_t OtaUploadByWebserver(httpd_req_t* req);
\ No newline at end of file
+esp_err_t OtaUploadByWebserver(httpd_req_t* req);
+
+/** @brief Upload web assets image send by post and save it in the web assets staging partition.
+ *  The staging partition is invalidated before writing, so the base web assets are used until the upload succeeds
+ *  @param req HTTP request data structure
+ *  @return return status 
+ */
+esp_err_t OtaUploadWebAssetsByWebserver(httpd_req_t* req);
+
+/** @brief Check if the web assets staging partition holds complete uploaded image
+ *  @return return true if image can be used
+ */
+bool OtaIsWebAssetsValid(void);
+
+/** @brief Discard the web assets uploaded to the staging partition
+ *  @return return true if success
+ */
+bool OtaWebAssetsInvalidate(void);
\ No newline at end of file
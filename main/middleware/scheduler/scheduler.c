@@ -45,6 +45,7 @@
 *****************************************************************************/
 
 static bool sSchedulerIsChange;
+static volatile uint32_t sSchedulerGeneration;      // incremented on every change of sScheduler
 static SemaphoreHandle_t sSchedulerMutex;
 static Scheduler_t sScheduler;
 
@@ -88,12 +89,14 @@ bool SchedulerLoad(void)
             if(loadDataLen == sizeof(Scheduler_t)){
                 ESP_LOGI(TAG, "load scheduler from nvs");
                 memcpy(&sScheduler, &loadScheduler, sizeof(Scheduler_t));
+                sSchedulerGeneration++;
             }else{
                 ESP_LOGI(TAG, "read factory mismatch size");
 
                 nvsRes = FactorySettingsGetScheduler(&loadScheduler);
                 if(nvsRes == true){
                     memcpy(&sScheduler, &loadScheduler, sizeof(Scheduler_t));
+                    sSchedulerGeneration++;
                     NvsDriverSave(NVS_KAY_NAME, &sScheduler, sizeof(Scheduler_t));
                 }
             }
@@ -104,6 +107,7 @@ bool SchedulerLoad(void)
             nvsRes = FactorySettingsGetScheduler(&loadScheduler);
             if(nvsRes == true){
                 memcpy(&sScheduler, &loadScheduler, sizeof(Scheduler_t));
+                sSchedulerGeneration++;
                 nvsRes = NvsDriverSave(NVS_KAY_NAME, &sScheduler, sizeof(Scheduler_t));
             }
         }
@@ -144,6 +148,7 @@ bool SchedulerSetAll(Scheduler_t* scheduler)
     if (xSemaphoreTake(sSchedulerMutex, MUTEX_TIMEOUT_MS) == pdTRUE) {
         memcpy(&sScheduler, scheduler, sizeof(Scheduler_t));
         sSchedulerIsChange = true;
+        sSchedulerGeneration++;
 
         xSemaphoreGive(sSchedulerMutex);
         return true;
@@ -177,6 +182,7 @@ bool SchedulerSetSingleDay(SchedulerDay_t day, SchedulerofDay_t* dayScheduler)
     if (xSemaphoreTake(sSchedulerMutex, MUTEX_TIMEOUT_MS) == pdTRUE) {
         memcpy(&sScheduler.days[day], dayScheduler, sizeof(SchedulerofDay_t));
         sSchedulerIsChange = true;
+        sSchedulerGeneration++;
 
         xSemaphoreGive(sSchedulerMutex);
         return true;
@@ -283,6 +289,11 @@ bool SchedulerIsDeviceStatusUpdateNeeded(SettingDevice_t* deviceSetting)
     return false;
 }
 
+uint32_t SchedulerGetGeneration(void)
+{
+    return sSchedulerGeneration;
+}
+
 const char* SchedulerGetStringDayName(SchedulerDay_t day)
 {
     if(day >= SCHEDULER_DAY_COUNT){
@@ -294,7 +305,7 @@ const char* SchedulerGetStringDayName(SchedulerDay_t day)
 
 void SchedulerPrintf(Scheduler_t* scheduler)
 {
-    ESP_LOGI(TAG, "Scheduler size %d", sizeof(Scheduler_t));
+    ESP_LOGI(TAG, "Scheduler size %u", (unsigned int)sizeof(Scheduler_t));
     for(uint16_t dayIdx = 0; dayIdx < SCHEDULER_DAY_COUNT; ++dayIdx)
     {
         for(uint16_t hourIdx = 0; hourIdx < SCHEDULER_HOUR_COUNT; ++hourIdx)
@@ -137,6 +137,12 @@ bool SchedulerGetCurrentDeviceStatus(SettingDevice_t* deviceSetting);
  */
 bool SchedulerIsDeviceStatusUpdateNeeded(SettingDevice_t* deviceSetting);
 
+/** @brief Get scheduler generation, it changes on every change of the scheduler.
+ *  Lets readers skip rebuilding data derived from the scheduler
+ *  @return generation counter
+ */
+uint32_t SchedulerGetGeneration(void);
+
 /** @brief Get day name string
  *  @param day [in] day enum SchedulerDay_t
  *  @return string pointer
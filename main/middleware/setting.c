@@ -46,6 +46,7 @@ static bool sIsSaveError;
 
 static SemaphoreHandle_t sSettingMutex;
 static SettingDevice_t sSettingDevice;
+static volatile uint32_t sSettingGeneration;        // incremented on every change of sSettingDevice
 
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
@@ -82,6 +83,7 @@ bool SettingLoad(void)
                 // Load setting OK
                 ESP_LOGI(TAG, "load setting from nvs");
                 memcpy(&sSettingDevice.restore, &loadSetting, sizeof(SettingRestore_t));
+                sSettingGeneration++;
             }else{
                 ESP_LOGI(TAG, "read mismatch size");
                 NvsDriverSave(NVS_KAY_NAME, &sSettingDevice.restore, sizeof(SettingRestore_t));
@@ -129,7 +131,10 @@ bool SettingGet(SettingDevice_t* setting)
 bool SettingSet(SettingDevice_t* setting)
 {
     if (xSemaphoreTake(sSettingMutex, SETTING_MUTEX_TIMEOUT_MS) == pdTRUE) {
-        memcpy(&sSettingDevice, setting, sizeof(SettingDevice_t));
+        if(memcmp(&sSettingDevice, setting, sizeof(SettingDevice_t)) != 0){
+            memcpy(&sSettingDevice, setting, sizeof(SettingDevice_t));
+            sSettingGeneration++;
+        }
         xSemaphoreGive(sSettingMutex);
         return true;
     }
@@ -142,6 +147,7 @@ bool SettingUpdateDeviceStatus(SettingDevice_t* setting)
 
         if(memcmp(&sSettingDevice.restore.deviceStatus, &setting->restore.deviceStatus, sizeof(SettingDeviceStatust_t)) != 0){
             memcpy(&sSettingDevice.restore.deviceStatus, &setting->restore.deviceStatus, sizeof(SettingDeviceStatust_t));
+            sSettingGeneration++;
         }
         
         xSemaphoreGive(sSettingMutex);
@@ -153,7 +159,10 @@ bool SettingUpdateDeviceStatus(SettingDevice_t* setting)
 bool SettingUpdateDeviceMode(SettingDevice_t* setting)
 {
     if (xSemaphoreTake(sSettingMutex, SETTING_MUTEX_TIMEOUT_MS) == pdTRUE) {
-        sSettingDevice.restore.deviceMode = setting->restore.deviceMode;
+        if(sSettingDevice.restore.deviceMode != setting->restore.deviceMode){
+            sSettingDevice.restore.deviceMode = setting->restore.deviceMode;
+            sSettingGeneration++;
+        }
         
         xSemaphoreGive(sSettingMutex);
         return true;
@@ -167,6 +176,7 @@ bool SettingUpdateTimers(SettingDevice_t* timer)
 
         if(memcmp(&sSettingDevice.restore.liveTime, timer->restore.liveTime, (TIMER_NAME_COUNTER * sizeof(uint64_t))) != 0){
             memcpy(&sSettingDevice.restore.liveTime, timer->restore.liveTime, (TIMER_NAME_COUNTER * sizeof(uint64_t)));
+            sSettingGeneration++;
         }
         
         xSemaphoreGive(sSettingMutex);
@@ -178,7 +188,10 @@ bool SettingUpdateTimers(SettingDevice_t* timer)
 bool SettingUpdateTouchScreen(const bool lock)
 {
     if (xSemaphoreTake(sSettingMutex, SETTING_MUTEX_TIMEOUT_MS) == pdTRUE) {
-        sSettingDevice.restore.touchLock = lock;
+        if(sSettingDevice.restore.touchLock != lock){
+            sSettingDevice.restore.touchLock = lock;
+            sSettingGeneration++;
+        }
 
         xSemaphoreGive(sSettingMutex);
         return true;
@@ -189,4 +202,9 @@ bool SettingUpdateTouchScreen(const bool lock)
 bool SettingIsError(void)
 {
     return sIsSaveError;
+}
+
+uint32_t SettingGetGeneration(void)
+{
+    return sSettingGeneration;
 }
\ No newline at end of file
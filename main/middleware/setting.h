@@ -184,4 +184,10 @@ bool SettingUpdateTouchScreen(const bool lock);
 /** @brief Is nvs memory error occurs
  *  @return true if error occurs
  */
-bool SettingIsError(void);
\ No newline at end of file
+bool SettingIsError(void);
+
+/** @brief Get settings generation, it changes on every change of SettingDevice_t.
+ *  Lets readers skip rebuilding data derived from the settings
+ *  @return generation counter
+ */
+uint32_t SettingGetGeneration(void);
\ No newline at end of file
@@ -16,11 +16,19 @@
 #include "config.h"
 
 #include <stdio.h>
+#include <string.h>
 #include <sys/time.h>
 #include <esp_log.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
 #include "touch.h"
 
+#include "utils/gesture/gesture.h"
+#include "utils/noiseFloor/noiseFloor.h"
+
 #include "touchDriver/touchDriver.h"
 #include "timeDriver/timeDriver.h"
 
@@ -32,25 +40,104 @@
 #define LONG_PRESS_TIME_MS (2U * 1000U)
 #define VERY_LONG_PRESS_TIME_MS (10U * 1000U)
 
+#define TOUCH_TASK_STACK_SIZE (3U * 1024U)
+#define TOUCH_TASK_PRIORITY (4U)                    // above device manager, press edges are read at once
+#define TOUCH_ALERT_CHECK_MS (1000U)                // ALERT level check without edge, e.g. INT flag clear failed
+
+#define TOUCH_GESTURE_GLITCH (0xFFU)                // rule id of a press too short for a finger
+#define TOUCH_GLITCH_MS (60U)
+
+#define TOUCH_NOISE_SAMPLE_MS (1000U)               // idle delta count sample period
+#define TOUCH_NOISE_MARGIN (3U)                     // threshold to noise peak ratio
+#define TOUCH_THRESHOLD_DEFAULT (0x40U)             // CAP1293 reset value
+#define TOUCH_THRESHOLD_MIN (0x30U)
+#define TOUCH_THRESHOLD_MAX (0x7FU)
+#define TOUCH_THRESHOLD_HYSTERESIS (4U)
+#define TOUCH_THRESHOLD_GLITCH_STEP (8U)            // threshold raise on a glitch
+#define TOUCH_BASELINE_DRIFT (16)                   // idle delta count offset recalibrated
+#define TOUCH_SENSITIVITY_MOST (TOUCH_SENSITIVITY_32X)
+#define TOUCH_SENSITIVITY_LEAST (TOUCH_SENSITIVITY_8X)
+#define TOUCH_QUIET_SAMPLES (300U)                  // low noise samples before sensitivity is raised back
+
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
 *****************************************************************************/
 
-typedef struct{
-    int64_t risingTime;
-    int64_t fallingTime;
-    uint8_t isPress : 1;
-    uint8_t isReleas : 1;
-    uint8_t shortPressDetected : 1;
-    uint8_t longPressDetected : 1;
-    uint8_t veryLongPressDetected : 1;
-}__attribute__ ((packed)) touchStatus_t;
-
 static const char* TAG = "touch";
 
-/******************************************************************************
-                        PRIVATE FUNCTION IMPLEMENTATION
-******************************************************************************/
+// HOLD gestures of the single buttons, rule id is the reported TouchButtonPress_t
+static const gestureRule_t sTouchRules[] = {
+    {.id = TOUCH_BUTTON_PRESS_SHORT,     .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_POWER),   .minMs = SHORT_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_LONG,      .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_POWER),   .minMs = LONG_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_VERY_LONG, .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_POWER),   .minMs = VERY_LONG_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_SHORT,     .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_INC), .minMs = SHORT_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_LONG,      .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_INC), .minMs = LONG_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_VERY_LONG, .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_INC), .minMs = VERY_LONG_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_SHORT,     .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_DEC), .minMs = SHORT_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_LONG,      .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_DEC), .minMs = LONG_PRESS_TIME_MS},
+    {.id = TOUCH_BUTTON_PRESS_VERY_LONG, .type = GESTURE_TYPE_HOLD, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_DEC), .minMs = VERY_LONG_PRESS_TIME_MS},
+    {.id = TOUCH_GESTURE_GLITCH,         .type = GESTURE_TYPE_RELEASE, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_POWER),   .maxMs = TOUCH_GLITCH_MS},
+    {.id = TOUCH_GESTURE_GLITCH,         .type = GESTURE_TYPE_RELEASE, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_INC), .maxMs = TOUCH_GLITCH_MS},
+    {.id = TOUCH_GESTURE_GLITCH,         .type = GESTURE_TYPE_RELEASE, .mask = GESTURE_INPUT(CFG_TOUCH_BUTTON_NAME_FAN_DEC), .maxMs = TOUCH_GLITCH_MS},
+};
+
+// gestures are detected by the touch task and taken by the device manager, both under sTouchMutex
+static gesture_t sGesture;
+static TouchButtons_t sPendingButtons;
+static bool sIsGesture;
+
+// noise tracking and thresholds are used by the touch task only
+static noiseFloor_t sNoise[CFG_TOUCH_BUTTON_NAME_COUNT];
+static uint8_t sThreshold[CFG_TOUCH_BUTTON_NAME_COUNT];
+static TouchDriverSensitivity_t sSensitivity;
+static uint32_t sQuietSamples;
+static int64_t sNoiseSampleTime;
+
+// under sTouchMutex
+static TouchStats_t sStats;
+
+static SemaphoreHandle_t sTouchMutex;
+static StaticSemaphore_t sTouchMutexBuffer;
+
+// given by the touch task on gesture
+static SemaphoreHandle_t sEventSemaphore;
+static StaticSemaphore_t sEventSemaphoreBuffer;
+
+static TaskHandle_t sTaskHandle;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Touch task, reads buttons status when ALERT is asserted and runs the gesture engine
+ *  @param arg unused
+ */
+static void TouchTask(void* arg);
+
+/** @brief Gesture engine callback, stores the press of the button for the device manager
+ *  @param event detected gesture
+ *  @param ctx unused
+ */
+static void TouchGestureCallback(const gestureEvent_t* event, void* ctx);
+
+/** @brief Get time to wait for ALERT, up to the next gesture threshold
+ *  @return wait time in ms
+ */
+static uint32_t TouchGetWaitTime(void);
+
+/** @brief Set default thresholds and sensitivity, clear noise tracking
+ *  @return return true if success
+ */
+static bool TouchAdaptiveInit(void);
+
+/** @brief Sample idle delta counts, adjust thresholds and sensitivity to the noise floor, recalibrate drifted buttons
+ */
+static void TouchTrackNoise(void);
+
+/** @brief Change sensitivity of all buttons and rescale the tracked noise
+ *  @param sensitivity new sensitivity
+ */
+static void TouchChangeSensitivity(TouchDriverSensitivity_t sensitivity);
 
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
@@ -63,109 +150,84 @@ bool TouchInit(void)
 
     res &= TouchDriverInit();
     res &= TouchDriverGetDeviceInfo(&deviceInfo);
+    res &= TouchAdaptiveInit();
 
     ESP_LOGI(TAG, "Touch Product ID %X, Manufacturer ID %X, Revision %X\n", deviceInfo.productId, deviceInfo.manufacturedId, deviceInfo.revision);
-    
-    return res;
-}
-
-bool TouchButtonStatus(TouchButtons_t* buttons)
-{
-    static touchStatus_t sTouchStatus[CFG_TOUCH_BUTTON_NAME_COUNT] = {
-        [CFG_TOUCH_BUTTON_NAME_POWER] = {.isReleas = true},
-        [CFG_TOUCH_BUTTON_NAME_FAN_INC] = {.isReleas = true},
-        [CFG_TOUCH_BUTTON_NAME_FAN_DEC] = {.isReleas = true},
-    };
-
-    TouchDriverButtonStatus_t buttonStatus = {};
 
-    TouchDriverInputStatus_t buttonReadStatus = TouchDriverIsButtonTouched(&buttonStatus);
-    if(buttonReadStatus == TOUCH_INPUT_STATUS_ERROR){
-        ESP_LOGE(TAG, "TouchDriverIsButtonTouched read error");
+    if(sTaskHandle != NULL){
+        return res;
     }
 
-    uint16_t idx;
-    bool isAnyButtonPress = false;
+    GestureInit(&sGesture, sTouchRules, sizeof(sTouchRules) / sizeof(sTouchRules[0]), TouchGestureCallback, NULL);
 
-    for(idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx)
-    {
-        if((buttonReadStatus == TOUCH_INPUT_STATUS_CHANGES_DETECTED) || (sTouchStatus[idx].isPress == true) || (sTouchStatus[idx].isReleas == false)){
-            isAnyButtonPress = true;
-        }
+    sTouchMutex = xSemaphoreCreateMutexStatic(&sTouchMutexBuffer);
+    sEventSemaphore = xSemaphoreCreateBinaryStatic(&sEventSemaphoreBuffer);
+
+    BaseType_t taskRes = xTaskCreate(TouchTask, "TouchTask", TOUCH_TASK_STACK_SIZE, NULL, TOUCH_TASK_PRIORITY, &sTaskHandle);
+    if(taskRes != pdPASS){
+        ESP_LOGE(TAG, "task not created");
+        res = false;
     }
 
-    if(isAnyButtonPress == false){
+    return res;
+}
+
+bool TouchButtonStatus(TouchButtons_t* buttons)
+{
+    if(sTouchMutex == NULL){
         return false;
     }
 
-    if(buttonReadStatus == TOUCH_INPUT_STATUS_CHANGES_DETECTED){
+    xSemaphoreTake(sTouchMutex, portMAX_DELAY);
 
-        for(idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx)
-        {
-            if(buttonStatus.isPressNow[idx] == true){
-                sTouchStatus[idx].risingTime = TimeDriverGetSystemTickMs();
-                sTouchStatus[idx].isPress = true;
+    bool isPressLongEnought = sIsGesture;
+    memcpy(buttons, &sPendingButtons, sizeof(TouchButtons_t));
 
-                ESP_LOGI(TAG, "pressing detected %d", idx);
-            }
+    memset(&sPendingButtons, 0, sizeof(TouchButtons_t));
+    sIsGesture = false;
 
-            if((buttonStatus.isPressNow[idx] == false) && (sTouchStatus[idx].isPress == true)){
-                sTouchStatus[idx].fallingTime = TimeDriverGetSystemTickMs();
-                sTouchStatus[idx].isReleas = true;
-                sTouchStatus[idx].isPress = false;
+    xSemaphoreGive(sTouchMutex);
 
-                sTouchStatus[idx].shortPressDetected = false;
-                sTouchStatus[idx].longPressDetected = false;
-                sTouchStatus[idx].veryLongPressDetected = false;
+    return isPressLongEnought;
+}
 
-                ESP_LOGI(TAG, "release detected %d", idx);
-            }
-        } 
-    }
-
-    bool isPressLongEnought = false;
-    for(idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx)
-    {
-        if(sTouchStatus[idx].isPress == true){
-            buttons->status[idx] = TOUCH_BUTTON_PRESS_NO;
-
-            int64_t delaTime = TimeDriverGetSystemTickMs() - sTouchStatus[idx].risingTime;
-        
-            if(delaTime > VERY_LONG_PRESS_TIME_MS){
-                if(sTouchStatus[idx].veryLongPressDetected == false){
-                    buttons->status[idx] = TOUCH_BUTTON_PRESS_VERY_LONG;
-                    sTouchStatus[idx].veryLongPressDetected = true;
-                    
-                    isPressLongEnought = true;
-                    ESP_LOGI(TAG, "very long %d", idx);
-                }
+bool TouchWaitForEvent(uint32_t timeoutMs)
+{
+    if(sEventSemaphore == NULL){
+        vTaskDelay(timeoutMs / portTICK_RATE_MS);
+        return false;
+    }
 
-                 
-            }else if(delaTime > LONG_PRESS_TIME_MS){
-                if(sTouchStatus[idx].longPressDetected == false){
-                    buttons->status[idx] = TOUCH_BUTTON_PRESS_LONG;
-                    sTouchStatus[idx].longPressDetected = true;
+    return xSemaphoreTake(sEventSemaphore, timeoutMs / portTICK_RATE_MS) == pdTRUE;
+}
 
-                    isPressLongEnought = true;
-                    ESP_LOGI(TAG, "long %d", idx);
-                }
+bool TouchGetStats(TouchStats_t* stats)
+{
+    if(sTouchMutex == NULL){
+        return false;
+    }
 
-            }else if(delaTime > SHORT_PRESS_TIME_MS){
-                if(sTouchStatus[idx].shortPressDetected == false){
-                    buttons->status[idx] = TOUCH_BUTTON_PRESS_SHORT;
-                    sTouchStatus[idx].shortPressDetected = true;
+    xSemaphoreTake(sTouchMutex, portMAX_DELAY);
+    memcpy(stats, &sStats, sizeof(TouchStats_t));
+    xSemaphoreGive(sTouchMutex);
 
-                    isPressLongEnought = true;
-                    ESP_LOGI(TAG, "short %d", idx);
-                }
+    return true;
+}
 
-            }else{
-                buttons->status[idx] = TOUCH_BUTTON_PRESS_NO;
-            }
-        }
+void TouchPrintStats(void)
+{
+    TouchStats_t stats = {};
+    if(TouchGetStats(&stats) == false){
+        return;
     }
 
-    return isPressLongEnought;
+    ESP_LOGI(TAG, "sensitivity %d, spurious alerts %u", stats.sensitivity, stats.spuriousAlerts);
+
+    for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        const TouchButtonStats_t* button = &stats.button[idx];
+        ESP_LOGI(TAG, "button %d: threshold %d, noise mean %d peak %d, false triggers %u, noise flags %u, recalibrations %u",
+                idx, button->threshold, button->noiseMean, button->noisePeak, button->falseTriggers, button->noiseFlags, button->recalibrations);
+    }
 }
 
 bool TouchChangeDeviceSetting(SettingDevice_t* settingDevice, TouchButtons_t* buttons)
@@ -210,4 +272,213 @@ bool TouchChangeDeviceSetting(SettingDevice_t* settingDevice, TouchButtons_t* bu
 
 /******************************************************************************
                         PRIVATE FUNCTION IMPLEMENTATION
-******************************************************************************/
\ No newline at end of file
+******************************************************************************/
+
+static void TouchTask(void* arg)
+{
+    (void)arg;
+
+    for(;;){
+        bool isAlert = TouchDriverWaitForAlert(TouchGetWaitTime());
+
+        // status is read only with ALERT low, GPIO36 gets spurious edges when some RTC peripherals are powered
+        TouchDriverButtonStatus_t buttonStatus = {};
+        TouchDriverInputStatus_t buttonReadStatus = TouchDriverIsButtonTouched(&buttonStatus);
+        if(buttonReadStatus == TOUCH_INPUT_STATUS_ERROR){
+            ESP_LOGE(TAG, "TouchDriverIsButtonTouched read error");
+        }
+
+        xSemaphoreTake(sTouchMutex, portMAX_DELAY);
+
+        // device manager already signaled takes all pending gestures
+        bool isSignaled = sIsGesture;
+
+        if((isAlert == true) && (buttonReadStatus == TOUCH_INPUT_STATUS_NOTHING_DETECTED)){
+            sStats.spuriousAlerts += 1;
+        }
+
+        if(buttonReadStatus == TOUCH_INPUT_STATUS_CHANGES_DETECTED){
+            uint32_t pressed = 0;
+            for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+                if(buttonStatus.isPressNow[idx] == true){
+                    pressed |= GESTURE_INPUT(idx);
+                }
+            }
+
+            int64_t edgeTime = (buttonStatus.alertTime != 0) ? buttonStatus.alertTime : TimeDriverGetSystemTickMs();
+            GestureSetInputs(&sGesture, pressed, edgeTime);
+            ESP_LOGI(TAG, "buttons pressed 0x%X", pressed);
+        }
+        else{
+            GestureTick(&sGesture, TimeDriverGetSystemTickMs());
+        }
+
+        bool isNewGesture = (sIsGesture == true) && (isSignaled == false);
+        bool isIdle = (sGesture.pressed == 0);
+
+        xSemaphoreGive(sTouchMutex);
+
+        // delta counts are noise only when no button is touched
+        if((isIdle == true) && (TimeDriverHasTimeElapsed(sNoiseSampleTime, TOUCH_NOISE_SAMPLE_MS) == true)){
+            sNoiseSampleTime = TimeDriverGetSystemTickMs();
+            TouchTrackNoise();
+        }
+
+        // device manager handles the press at once instead of in its next loop
+        if(isNewGesture == true){
+            xSemaphoreGive(sEventSemaphore);
+        }
+    }
+}
+
+static void TouchGestureCallback(const gestureEvent_t* event, void* ctx)
+{
+    (void)ctx;
+
+    // touch rules are single button ones
+    uint8_t button = __builtin_ctz(event->rule->mask);
+
+    // noise reached the threshold, it is raised with the next noise sample
+    if(event->rule->id == TOUCH_GESTURE_GLITCH){
+        sStats.button[button].falseTriggers += 1;
+        NoiseFloorAddSample(&sNoise[button], (int8_t)((sThreshold[button] + TOUCH_THRESHOLD_GLITCH_STEP) / TOUCH_NOISE_MARGIN));
+
+        ESP_LOGW(TAG, "button %d false trigger, %d ms", button, event->heldMs);
+        return;
+    }
+
+    sPendingButtons.status[button] = (TouchButtonPress_t)event->rule->id;
+    sIsGesture = true;
+
+    ESP_LOGI(TAG, "button %d press %d after %d ms", button, event->rule->id, event->heldMs);
+}
+
+static uint32_t TouchGetWaitTime(void)
+{
+    xSemaphoreTake(sTouchMutex, portMAX_DELAY);
+    int64_t deadline = GestureGetNextDeadline(&sGesture);
+    xSemaphoreGive(sTouchMutex);
+
+    if(deadline == GESTURE_NO_DEADLINE){
+        return TOUCH_ALERT_CHECK_MS;
+    }
+
+    int64_t waitMs = deadline - TimeDriverGetSystemTickMs();
+    if(waitMs <= 0){
+        return 0;
+    }
+
+    return (waitMs < TOUCH_ALERT_CHECK_MS) ? (uint32_t)waitMs : TOUCH_ALERT_CHECK_MS;
+}
+
+static bool TouchAdaptiveInit(void)
+{
+    bool res = true;
+
+    // driver init sets the most sensitive setting
+    sSensitivity = TOUCH_SENSITIVITY_MOST;
+    sQuietSamples = 0;
+
+    for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        NoiseFloorInit(&sNoise[idx]);
+        sThreshold[idx] = TOUCH_THRESHOLD_DEFAULT;
+        res &= TouchDriverSetThreshold(idx, sThreshold[idx]);
+
+        sStats.button[idx].threshold = sThreshold[idx];
+    }
+
+    sStats.sensitivity = sSensitivity;
+
+    return res;
+}
+
+static void TouchTrackNoise(void)
+{
+    TouchDriverNoiseSample_t sample = {};
+    if(TouchDriverGetNoiseSample(&sample) == false){
+        return;
+    }
+
+    bool isSaturated = false;
+    bool isQuiet = true;
+    bool isRecalibrated[CFG_TOUCH_BUTTON_NAME_COUNT] = {};
+
+    for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        NoiseFloorAddSample(&sNoise[idx], sample.deltaCount[idx]);
+
+        // base count drifted (temperature, humidity) while the button is not touched
+        int8_t offset = NoiseFloorGetOffset(&sNoise[idx]);
+        if((offset > TOUCH_BASELINE_DRIFT) || (offset < -TOUCH_BASELINE_DRIFT)){
+            if(TouchDriverCalibrate(idx) == true){
+                NoiseFloorInit(&sNoise[idx]);
+                isRecalibrated[idx] = true;
+                ESP_LOGI(TAG, "button %d recalibrated, offset %d", idx, offset);
+            }
+            continue;
+        }
+
+        uint16_t threshold = NoiseFloorGetThreshold(&sNoise[idx], TOUCH_NOISE_MARGIN);
+
+        // noise would stay low with doubled sensitivity
+        if((threshold * 2U) > TOUCH_THRESHOLD_MIN){
+            isQuiet = false;
+        }
+
+        if(threshold > TOUCH_THRESHOLD_MAX){
+            isSaturated = true;
+            threshold = TOUCH_THRESHOLD_MAX;
+        }
+        else if(threshold < TOUCH_THRESHOLD_MIN){
+            threshold = TOUCH_THRESHOLD_MIN;
+        }
+
+        if(((threshold + TOUCH_THRESHOLD_HYSTERESIS) <= sThreshold[idx]) || (threshold >= (sThreshold[idx] + TOUCH_THRESHOLD_HYSTERESIS))){
+            if(TouchDriverSetThreshold(idx, (uint8_t)threshold) == true){
+                ESP_LOGI(TAG, "button %d threshold %d -> %d", idx, sThreshold[idx], threshold);
+                sThreshold[idx] = (uint8_t)threshold;
+            }
+        }
+    }
+
+    sQuietSamples = (isQuiet == true) ? (sQuietSamples + 1) : 0;
+
+    if((isSaturated == true) && (sSensitivity < TOUCH_SENSITIVITY_LEAST)){
+        TouchChangeSensitivity(sSensitivity + 1);
+    }
+    else if((sQuietSamples >= TOUCH_QUIET_SAMPLES) && (sSensitivity > TOUCH_SENSITIVITY_MOST)){
+        TouchChangeSensitivity(sSensitivity - 1);
+        sQuietSamples = 0;
+    }
+
+    xSemaphoreTake(sTouchMutex, portMAX_DELAY);
+
+    for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        TouchButtonStats_t* button = &sStats.button[idx];
+
+        button->noiseFlags += (sample.isNoise[idx] == true) ? 1 : 0;
+        button->recalibrations += (isRecalibrated[idx] == true) ? 1 : 0;
+        button->noiseMean = NoiseFloorGetMean(&sNoise[idx]);
+        button->noisePeak = NoiseFloorGetPeak(&sNoise[idx]);
+        button->threshold = sThreshold[idx];
+    }
+
+    sStats.sensitivity = sSensitivity;
+
+    xSemaphoreGive(sTouchMutex);
+}
+
+static void TouchChangeSensitivity(TouchDriverSensitivity_t sensitivity)
+{
+    if(TouchDriverSetSensitivity(sensitivity) == false){
+        return;
+    }
+
+    // each step halves or doubles the delta counts
+    bool isHalf = (sensitivity > sSensitivity);
+    for(uint16_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx){
+        NoiseFloorScale(&sNoise[idx], isHalf);
+    }
+
+    ESP_LOGI(TAG, "sensitivity %d -> %d", sSensitivity, sensitivity);
+    sSensitivity = sensitivity;
+}
@@ -37,6 +37,21 @@ typedef struct{
     TouchButtonPress_t status[CFG_TOUCH_BUTTON_NAME_COUNT];
 } __attribute__ ((packed)) TouchButtons_t;
 
+typedef struct{
+    uint32_t falseTriggers;     // presses too short for a finger
+    uint32_t noiseFlags;        // idle samples over the sensor noise threshold
+    uint32_t recalibrations;    // base count drift recalibrations
+    uint8_t noiseMean;          // idle delta count
+    uint8_t noisePeak;
+    uint8_t threshold;          // touch delta count threshold
+} TouchButtonStats_t;
+
+typedef struct{
+    TouchButtonStats_t button[CFG_TOUCH_BUTTON_NAME_COUNT];
+    uint32_t spuriousAlerts;    // ALERT edges without the ALERT level
+    uint8_t sensitivity;        // CAP1293 delta sense, 0 most sensitive
+} TouchStats_t;
+
 /*****************************************************************************
                          PUBLIC INTERFACE DECLARATION
 *****************************************************************************/
@@ -52,6 +67,22 @@ bool TouchInit(void);
  */
 bool TouchButtonStatus(TouchButtons_t* buttons);
 
+/** @brief Wait for touch event: button held short, long or very long time
+ *  @param timeoutMs wait timeout
+ *  @return return true if event occurred
+ */
+bool TouchWaitForEvent(uint32_t timeoutMs);
+
+/** @brief Get copy of touch noise and false trigger statistics
+ *  @param stats [out] pointer to TouchStats_t
+ *  @return return true if success
+ */
+bool TouchGetStats(TouchStats_t* stats);
+
+/** @brief Log touch noise and false trigger statistics
+ */
+void TouchPrintStats(void);
+
 /** @brief Change the device setting according to which button is pressed
  *  @param settingDevice [out] pointer to SettingDevice_t
  *  @param buttons [in] pointer to TouchButtons_t
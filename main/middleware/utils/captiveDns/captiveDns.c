@@ -0,0 +1,169 @@
+/*****************************************************************************
+ * @file captiveDns.c
+ *
+ * @brief dns responses of the captive portal: every A query is answered with
+ *        the device address, so phones joining the access point find the
+ *        configuration page without typing the ip
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/captiveDns/captiveDns.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define HEADER_LEN (12U)
+#define QUESTION_FIXED_LEN (4U)                 // type and class after the name
+#define ANSWER_LEN (16U)
+#define MAX_LABEL_LEN (63U)
+
+#define FLAG_QR (0x8000U)
+#define FLAG_AA (0x0400U)
+#define FLAG_RD (0x0100U)
+#define FLAG_RA (0x0080U)
+#define OPCODE_MASK (0x7800U)
+#define RCODE_NOT_IMPLEMENTED (4U)
+
+#define TYPE_A (1U)
+#define TYPE_ANY (255U)
+#define CLASS_IN (1U)
+#define NAME_POINTER_TO_QUESTION (0xC00CU)
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Read big endian 16 bits
+ *  @param data - pointer to data
+ *  @return value
+ */
+static uint16_t Read16(const uint8_t *data);
+
+/** @brief Write big endian 16 bits
+ *  @param data - pointer to data
+ *  @param value - value
+ */
+static void Write16(uint8_t *data, uint16_t value);
+
+/** @brief Get length of the question name
+ *  @param data - pointer to the name
+ *  @param len - bytes left in the packet
+ *  @return name length including terminating zero, 0 if malformed
+ */
+static uint32_t GetNameLen(const uint8_t *data, uint32_t len);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool CaptiveDnsBuildResponse(const uint8_t *query, uint32_t queryLen, const uint8_t ip[4], uint8_t *response,
+                             uint32_t responseSize, uint32_t *responseLen)
+{
+    assert(query);
+    assert(ip);
+    assert(response);
+    assert(responseLen);
+
+    if ((queryLen < HEADER_LEN) || (responseSize < HEADER_LEN)) {
+        return false;
+    }
+
+    uint16_t flags = Read16(&query[2]);
+    if ((flags & FLAG_QR) != 0U) {
+        return false;
+    }
+
+    memset(response, 0, HEADER_LEN);
+    memcpy(response, query, 2);                 // id
+
+    uint16_t responseFlags = FLAG_QR | FLAG_AA | FLAG_RA | (flags & (OPCODE_MASK | FLAG_RD));
+
+    // only standard query with single question, usual for resolvers
+    if (((flags & OPCODE_MASK) != 0U) || (Read16(&query[4]) != 1U)) {
+        Write16(&response[2], responseFlags | RCODE_NOT_IMPLEMENTED);
+        *responseLen = HEADER_LEN;
+        return true;
+    }
+
+    uint32_t nameLen = GetNameLen(&query[HEADER_LEN], queryLen - HEADER_LEN);
+    uint32_t questionLen = nameLen + QUESTION_FIXED_LEN;
+    if ((nameLen == 0U) || ((HEADER_LEN + questionLen) > queryLen)) {
+        return false;
+    }
+
+    uint16_t type = Read16(&query[HEADER_LEN + nameLen]);
+    uint16_t dnsClass = Read16(&query[HEADER_LEN + nameLen + 2U]);
+    bool isAnswered = ((type == TYPE_A) || (type == TYPE_ANY)) && (dnsClass == CLASS_IN);
+
+    uint32_t len = HEADER_LEN + questionLen + (isAnswered ? ANSWER_LEN : 0U);
+    if (len > responseSize) {
+        return false;
+    }
+
+    Write16(&response[2], responseFlags);
+    Write16(&response[4], 1);
+    Write16(&response[6], isAnswered ? 1U : 0U);
+    memcpy(&response[HEADER_LEN], &query[HEADER_LEN], questionLen);
+
+    if (isAnswered) {
+        uint8_t *answer = &response[HEADER_LEN + questionLen];
+
+        Write16(&answer[0], NAME_POINTER_TO_QUESTION);
+        Write16(&answer[2], TYPE_A);
+        Write16(&answer[4], CLASS_IN);
+        Write16(&answer[6], (CAPTIVE_DNS_TTL_S >> 16) & 0xFFFFU);
+        Write16(&answer[8], CAPTIVE_DNS_TTL_S & 0xFFFFU);
+        Write16(&answer[10], 4);
+        memcpy(&answer[12], ip, 4);
+    }
+
+    *responseLen = len;
+
+    return true;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static uint16_t Read16(const uint8_t *data)
+{
+    return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+static void Write16(uint8_t *data, uint16_t value)
+{
+    data[0] = value >> 8;
+    data[1] = value & 0xFFU;
+}
+
+static uint32_t GetNameLen(const uint8_t *data, uint32_t len)
+{
+    uint32_t pos = 0;
+
+    // compression pointers are not expected in the question of a query
+    while (pos < len) {
+        uint8_t labelLen = data[pos];
+
+        if (labelLen == 0U) {
+            return pos + 1U;
+        }
+
+        if (labelLen > MAX_LABEL_LEN) {
+            return 0;
+        }
+
+        pos += labelLen + 1U;
+    }
+
+    return 0;
+}
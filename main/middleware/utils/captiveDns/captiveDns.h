@@ -0,0 +1,42 @@
+/*****************************************************************************
+ * @file captiveDns.h
+ *
+ * @brief dns responses of the captive portal: every A query is answered with
+ *        the device address, so phones joining the access point find the
+ *        configuration page without typing the ip
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define CAPTIVE_DNS_PORT (53U)
+#define CAPTIVE_DNS_MAX_PACKET_LEN (512U)       // plain udp dns message limit
+#define CAPTIVE_DNS_TTL_S (60U)                 // short, wrong answers expire soon after the phone leaves the access point
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Build response to dns query. A queries get the device address,
+ *         other types get an empty answer, other opcodes "not implemented"
+ *  @param query - received packet
+ *  @param queryLen - packet length
+ *  @param ip - device ipv4 address, network order
+ *  @param response - response buffer
+ *  @param responseSize - response buffer size
+ *  @param responseLen [out] - response length
+ *  @return false - packet is not a query or malformed, nothing should be sent
+ */
+bool CaptiveDnsBuildResponse(const uint8_t *query, uint32_t queryLen, const uint8_t ip[4], uint8_t *response,
+                             uint32_t responseSize, uint32_t *responseLen);
@@ -0,0 +1,291 @@
+/*****************************************************************************
+ * @file deflate.c
+ *
+ * @brief small zlib (RFC 1950/1951) compressor for short in-memory buffers
+ *        like json responses. Fixed huffman codes and a single entry hash
+ *        of the whole input, no window buffer is allocated.
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/deflate/deflate.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define HASH_BITS (9U)
+#define HASH_SIZE (1U << HASH_BITS)
+#define NO_POSITION (0xFFFFU)
+
+#define MIN_MATCH (3U)
+#define MAX_MATCH (258U)
+
+#define END_OF_BLOCK (256U)
+#define LENGTH_CODES_COUNT (29U)
+#define DISTANCE_CODES_COUNT (30U)
+
+#define ZLIB_HEADER_CMF (0x78U)         // deflate, 32 kB window
+#define ZLIB_HEADER_FLG (0x01U)         // fastest compression, check bits
+#define ADLER_MOD (65521U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef struct {
+    uint8_t *dst;
+    uint32_t dstSize;
+    uint32_t len;
+    uint32_t bitBuf;
+    uint8_t bitCount;
+    bool isOverflow;
+} bitWriter_t;
+
+static const uint16_t sLengthBase[LENGTH_CODES_COUNT] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t sLengthExtraBits[LENGTH_CODES_COUNT] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t sDistanceBase[DISTANCE_CODES_COUNT] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint8_t sDistanceExtraBits[DISTANCE_CODES_COUNT] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Write bits, least significant first
+ *  @param writer - bit writer
+ *  @param value - bits
+ *  @param count - number of bits
+ */
+static void WriteBits(bitWriter_t *writer, uint32_t value, uint8_t count);
+
+/** @brief Write huffman code, codes are stored most significant bit first
+ *  @param writer - bit writer
+ *  @param code - huffman code
+ *  @param count - code length
+ */
+static void WriteCode(bitWriter_t *writer, uint32_t code, uint8_t count);
+
+/** @brief Write literal/length symbol with fixed huffman code
+ *  @param writer - bit writer
+ *  @param symbol - symbol 0..287
+ */
+static void WriteSymbol(bitWriter_t *writer, uint16_t symbol);
+
+/** @brief Write match length and distance
+ *  @param writer - bit writer
+ *  @param length - match length
+ *  @param distance - match distance
+ */
+static void WriteMatch(bitWriter_t *writer, uint32_t length, uint32_t distance);
+
+/** @brief Flush remaining bits to full byte
+ *  @param writer - bit writer
+ */
+static void FlushBits(bitWriter_t *writer);
+
+/** @brief Hash of three bytes
+ *  @param data - pointer to the bytes
+ *  @return hash
+ */
+static uint32_t Hash(const uint8_t *data);
+
+/** @brief Adler-32 checksum of zlib stream
+ *  @param data - data
+ *  @param len - data length
+ *  @return checksum
+ */
+static uint32_t Adler32(const uint8_t *data, uint32_t len);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool DeflateCompress(const uint8_t *src, uint32_t srcLen, uint8_t *dst, uint32_t dstSize, uint32_t *dstLen)
+{
+    assert(src || (srcLen == 0));
+    assert(dst);
+    assert(dstLen);
+
+    if (srcLen > DEFLATE_MAX_INPUT_LEN) {
+        return false;
+    }
+
+    uint16_t head[HASH_SIZE];
+    memset(head, 0xFF, sizeof(head));
+
+    bitWriter_t writer = {
+        .dst = dst,
+        .dstSize = dstSize,
+    };
+
+    WriteBits(&writer, ZLIB_HEADER_CMF, 8);
+    WriteBits(&writer, ZLIB_HEADER_FLG + (31U - (((ZLIB_HEADER_CMF << 8) | ZLIB_HEADER_FLG) % 31U)) % 31U, 8);
+
+    // single final block with fixed codes
+    WriteBits(&writer, 1, 1);
+    WriteBits(&writer, 1, 2);
+
+    uint32_t pos = 0;
+    while ((pos < srcLen) && (writer.isOverflow == false)) {
+        uint32_t matchLen = 0;
+        uint32_t matchPos = 0;
+
+        if ((pos + MIN_MATCH) <= srcLen) {
+            uint32_t hash = Hash(&src[pos]);
+            matchPos = head[hash];
+            head[hash] = pos;
+
+            if (matchPos != NO_POSITION) {
+                uint32_t maxLen = srcLen - pos;
+                if (maxLen > MAX_MATCH) {
+                    maxLen = MAX_MATCH;
+                }
+
+                while ((matchLen < maxLen) && (src[matchPos + matchLen] == src[pos + matchLen])) {
+                    matchLen++;
+                }
+            }
+        }
+
+        if (matchLen >= MIN_MATCH) {
+            WriteMatch(&writer, matchLen, pos - matchPos);
+
+            // positions inside the match are hashed too, later matches are found more often
+            for (uint32_t idx = pos + 1; (idx < (pos + matchLen)) && ((idx + MIN_MATCH) <= srcLen); ++idx) {
+                head[Hash(&src[idx])] = idx;
+            }
+            pos += matchLen;
+        } else {
+            WriteSymbol(&writer, src[pos]);
+            pos++;
+        }
+    }
+
+    WriteSymbol(&writer, END_OF_BLOCK);
+    FlushBits(&writer);
+
+    uint32_t adler = Adler32(src, srcLen);
+    WriteBits(&writer, (adler >> 24) & 0xFFU, 8);
+    WriteBits(&writer, (adler >> 16) & 0xFFU, 8);
+    WriteBits(&writer, (adler >> 8) & 0xFFU, 8);
+    WriteBits(&writer, adler & 0xFFU, 8);
+
+    *dstLen = writer.len;
+
+    return (writer.isOverflow == false);
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void WriteBits(bitWriter_t *writer, uint32_t value, uint8_t count)
+{
+    writer->bitBuf |= value << writer->bitCount;
+    writer->bitCount += count;
+
+    while (writer->bitCount >= 8U) {
+        if (writer->len < writer->dstSize) {
+            writer->dst[writer->len++] = writer->bitBuf & 0xFFU;
+        } else {
+            writer->isOverflow = true;
+        }
+
+        writer->bitBuf >>= 8;
+        writer->bitCount -= 8U;
+    }
+}
+
+static void WriteCode(bitWriter_t *writer, uint32_t code, uint8_t count)
+{
+    uint32_t reversed = 0;
+
+    for (uint8_t idx = 0; idx < count; ++idx) {
+        reversed = (reversed << 1) | ((code >> idx) & 1U);
+    }
+
+    WriteBits(writer, reversed, count);
+}
+
+static void WriteSymbol(bitWriter_t *writer, uint16_t symbol)
+{
+    // RFC 1951 3.2.6 fixed literal/length codes
+    if (symbol < 144U) {
+        WriteCode(writer, 0x30U + symbol, 8);
+    } else if (symbol < 256U) {
+        WriteCode(writer, 0x190U + (symbol - 144U), 9);
+    } else if (symbol < 280U) {
+        WriteCode(writer, symbol - 256U, 7);
+    } else {
+        WriteCode(writer, 0xC0U + (symbol - 280U), 8);
+    }
+}
+
+static void WriteMatch(bitWriter_t *writer, uint32_t length, uint32_t distance)
+{
+    uint8_t code = LENGTH_CODES_COUNT - 1U;
+    while (sLengthBase[code] > length) {
+        code--;
+    }
+
+    WriteSymbol(writer, 257U + code);
+    WriteBits(writer, length - sLengthBase[code], sLengthExtraBits[code]);
+
+    code = DISTANCE_CODES_COUNT - 1U;
+    while (sDistanceBase[code] > distance) {
+        code--;
+    }
+
+    // fixed distance codes are plain 5 bit numbers
+    WriteCode(writer, code, 5);
+    WriteBits(writer, distance - sDistanceBase[code], sDistanceExtraBits[code]);
+}
+
+static void FlushBits(bitWriter_t *writer)
+{
+    if (writer->bitCount > 0U) {
+        WriteBits(writer, 0, 8U - writer->bitCount);
+    }
+}
+
+static uint32_t Hash(const uint8_t *data)
+{
+    uint32_t value = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2];
+
+    return ((value * 2654435761U) >> (32U - HASH_BITS)) & (HASH_SIZE - 1U);
+}
+
+static uint32_t Adler32(const uint8_t *data, uint32_t len)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+
+    for (uint32_t idx = 0; idx < len; ++idx) {
+        a = (a + data[idx]) % ADLER_MOD;
+        b = (b + a) % ADLER_MOD;
+    }
+
+    return (b << 16) | a;
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * @file deflate.h
+ *
+ * @brief small zlib (RFC 1950/1951) compressor for short in-memory buffers
+ *        like json responses. Fixed huffman codes and a single entry hash
+ *        of the whole input, no window buffer is allocated.
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define DEFLATE_MAX_INPUT_LEN (32U * 1024U)     // whole input fits in the deflate window
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Compress buffer to zlib stream ("Content-Encoding: deflate")
+ *  @param src - data to compress
+ *  @param srcLen - data length, up to DEFLATE_MAX_INPUT_LEN
+ *  @param dst - output buffer
+ *  @param dstSize - output buffer size
+ *  @param dstLen [out] - compressed length
+ *  @return false - input too long or output doesn't fit in dstSize
+ */
+bool DeflateCompress(const uint8_t *src, uint32_t srcLen, uint8_t *dst, uint32_t dstSize, uint32_t *dstLen);
@@ -0,0 +1,378 @@
+/*****************************************************************************
+ * @file dspFilter.h
+ *
+ * @brief header only, allocation free fixed point filters: boxcar mean, EMA, median of N,
+ *        biquad IIR with Q14 / Q30 (2.14 / 2.30) coefficients and hysteresis comparator
+ *
+ * The storage of the windowed filters is sized at compile time by the DEFINE macros,
+ * the filters take no heap and need no deinit. Cost per sample:
+ * boxcar, EMA, biquad and hysteresis O(1), median O(N).
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define DSP_EMA_FRAC_BITS (8U)                  // EMA state is Q8, samples within +-2**23
+#define DSP_BIQUAD_Q14_COEF_SHIFT (14U)         // coefficients are 2.14, range [-2, 2)
+#define DSP_BIQUAD_Q30_COEF_SHIFT (30U)         // coefficients are 2.30, range [-2, 2)
+
+typedef struct {
+    uint32_t *buffer;
+    uint16_t size;
+    uint16_t index;
+    uint16_t count;
+    uint64_t sum;
+} dspBoxcar_t;
+
+typedef struct {
+    int32_t stateQ8;
+    uint8_t shift;                              // weight of the new sample is 1 / 2**shift
+    bool isStarted;
+} dspEma_t;
+
+typedef struct {
+    int32_t *window;                            // samples in arrival order
+    int32_t *sorted;                            // the same samples sorted
+    uint16_t size;
+    uint16_t index;
+    uint16_t count;
+} dspMedian_t;
+
+// y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2, a0 normalized to 1
+typedef struct {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+} dspBiquadCoef_t;
+
+// 16 bit samples, 2.14 coefficients lose the gain below a cutoff of about sample rate / 20, use Q30 there
+typedef struct {
+    int16_t b0, b1, b2, a1, a2;
+    int16_t x1, x2, y1, y2;
+} dspBiquadQ14_t;
+
+// the input needs 2 bits of headroom, within +-2**29
+typedef struct {
+    int32_t b0, b1, b2, a1, a2;
+    int32_t x1, x2, y1, y2;
+} dspBiquadQ30_t;
+
+typedef struct {
+    int32_t low;
+    int32_t high;
+    bool isHigh;
+} dspHysteresis_t;
+
+/** @brief Define boxcar mean filter with static storage
+ *  @param name - filter variable name
+ *  @param windowSize - samples in the mean
+ */
+#define DSP_BOXCAR_DEFINE(name, windowSize)                                             \
+    static uint32_t name##Buffer[(windowSize)];                                         \
+    static dspBoxcar_t name = { .buffer = name##Buffer, .size = (windowSize) }
+
+/** @brief Define median filter with static storage
+ *  @param name - filter variable name
+ *  @param windowSize - samples in the window, odd
+ */
+#define DSP_MEDIAN_DEFINE(name, windowSize)                                             \
+    _Static_assert(((windowSize) & 1U) == 1U, "median window has to be odd");           \
+    static int32_t name##Window[(windowSize)];                                          \
+    static int32_t name##Sorted[(windowSize)];                                          \
+    static dspMedian_t name = { .window = name##Window, .sorted = name##Sorted, .size = (windowSize) }
+
+/** @brief Initializer of EMA filter
+ *  @param weightShift - weight of the new sample is 1 / 2**weightShift
+ */
+#define DSP_EMA_INIT(weightShift) { .stateQ8 = 0, .shift = (weightShift), .isStarted = false }
+
+/** @brief Initializer of hysteresis comparator
+ *  @param lowLevel - output goes low at or below the level
+ *  @param highLevel - output goes high at or above the level
+ */
+#define DSP_HYSTERESIS_INIT(lowLevel, highLevel) { .low = (lowLevel), .high = (highLevel), .isHigh = false }
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Clear boxcar mean filter
+ *  @param boxcar - filter handler
+ */
+static inline void DspBoxcarReset(dspBoxcar_t *boxcar)
+{
+    assert(boxcar);
+    assert(boxcar->size != 0);
+
+    memset(boxcar->buffer, 0, boxcar->size * sizeof(uint32_t));
+    boxcar->index = 0;
+    boxcar->count = 0;
+    boxcar->sum = 0;
+}
+
+/** @brief Add sample to boxcar mean filter
+ *  @param boxcar - filter handler
+ *  @param sample - new sample
+ *  @return mean of the window, of the samples so far until the window is full
+ */
+static inline uint32_t DspBoxcarFilter(dspBoxcar_t *boxcar, uint32_t sample)
+{
+    assert(boxcar);
+
+    boxcar->sum -= boxcar->buffer[boxcar->index];
+    boxcar->sum += sample;
+    boxcar->buffer[boxcar->index] = sample;
+
+    boxcar->index = (boxcar->index + 1U < boxcar->size) ? (boxcar->index + 1U) : 0;
+    if (boxcar->count < boxcar->size) {
+        boxcar->count += 1;
+    }
+
+    return (uint32_t)(boxcar->sum / boxcar->count);
+}
+
+/** @brief Restart EMA filter, the next sample seeds it
+ *  @param ema - filter handler
+ */
+static inline void DspEmaReset(dspEma_t *ema)
+{
+    assert(ema);
+
+    ema->stateQ8 = 0;
+    ema->isStarted = false;
+}
+
+/** @brief Add sample to EMA filter
+ *  @param ema - filter handler
+ *  @param sample - new sample, within +-2**23
+ *  @return filtered value, rounded
+ */
+static inline int32_t DspEmaFilter(dspEma_t *ema, int32_t sample)
+{
+    assert(ema);
+
+    int32_t sampleQ8 = sample * (1 << DSP_EMA_FRAC_BITS);
+
+    if (ema->isStarted == false) {
+        ema->stateQ8 = sampleQ8;
+        ema->isStarted = true;
+    } else {
+        ema->stateQ8 += (sampleQ8 - ema->stateQ8) / (1 << ema->shift);
+    }
+
+    int32_t half = (ema->stateQ8 < 0) ? -(1 << (DSP_EMA_FRAC_BITS - 1U)) : (1 << (DSP_EMA_FRAC_BITS - 1U));
+
+    return (ema->stateQ8 + half) / (1 << DSP_EMA_FRAC_BITS);
+}
+
+/** @brief Clear median filter
+ *  @param median - filter handler
+ */
+static inline void DspMedianReset(dspMedian_t *median)
+{
+    assert(median);
+
+    median->index = 0;
+    median->count = 0;
+}
+
+/** @brief Add sample to median filter, the sorted window is kept by one removal and one insertion
+ *  @param median - filter handler
+ *  @param sample - new sample
+ *  @return median of the window, the upper middle sample until the window is full with an even count
+ */
+static inline int32_t DspMedianFilter(dspMedian_t *median, int32_t sample)
+{
+    assert(median);
+    assert(median->size != 0);
+
+    uint16_t count = median->count;
+
+    // the oldest sample leaves the sorted window when the window is full
+    if (count == median->size) {
+        int32_t oldest = median->window[median->index];
+        uint16_t idx = 0;
+        while (median->sorted[idx] != oldest) {
+            ++idx;
+        }
+        memmove(&median->sorted[idx], &median->sorted[idx + 1U], (count - idx - 1U) * sizeof(int32_t));
+        count -= 1;
+    }
+
+    uint16_t pos = count;
+    while ((pos > 0) && (median->sorted[pos - 1U] > sample)) {
+        median->sorted[pos] = median->sorted[pos - 1U];
+        --pos;
+    }
+    median->sorted[pos] = sample;
+    count += 1;
+
+    median->window[median->index] = sample;
+    median->index = (median->index + 1U < median->size) ? (median->index + 1U) : 0;
+    median->count = count;
+
+    return median->sorted[count / 2U];
+}
+
+/** @brief Design second order Butterworth low pass (bilinear transform), call it at init, it uses float
+ *  @param coef [out] coefficients
+ *  @param cutoffHz - cutoff frequency, below half of the sample rate
+ *  @param sampleHz - sample rate
+ *  @return true if success
+ */
+static inline bool DspBiquadDesignLowPass(dspBiquadCoef_t *coef, float cutoffHz, float sampleHz)
+{
+    assert(coef);
+
+    if ((cutoffHz <= 0.0f) || (sampleHz <= 0.0f) || (cutoffHz >= (sampleHz / 2.0f))) {
+        return false;
+    }
+
+    const float pi = 3.14159265f;
+    float omega = 2.0f * pi * cutoffHz / sampleHz;
+    float alpha = sinf(omega) / (2.0f * 0.70710678f);
+    float cosOmega = cosf(omega);
+    float a0 = 1.0f + alpha;
+
+    coef->b0 = ((1.0f - cosOmega) / 2.0f) / a0;
+    coef->b1 = (1.0f - cosOmega) / a0;
+    coef->b2 = coef->b0;
+    coef->a1 = (-2.0f * cosOmega) / a0;
+    coef->a2 = (1.0f - alpha) / a0;
+
+    return true;
+}
+
+/** @brief Initialize biquad with 2.14 coefficients
+ *  @param biquad - filter handler
+ *  @param coef - coefficients, each within [-2, 2)
+ *  @return true if the coefficients fit
+ */
+static inline bool DspBiquadQ14Init(dspBiquadQ14_t *biquad, const dspBiquadCoef_t *coef)
+{
+    assert(biquad);
+    assert(coef);
+
+    memset(biquad, 0, sizeof(dspBiquadQ14_t));
+
+    const float coefs[] = { coef->b0, coef->b1, coef->b2, coef->a1, coef->a2 };
+    int16_t *fixed[] = { &biquad->b0, &biquad->b1, &biquad->b2, &biquad->a1, &biquad->a2 };
+    const float scale = (float)(1L << DSP_BIQUAD_Q14_COEF_SHIFT);
+
+    for (uint8_t idx = 0; idx < 5U; ++idx) {
+        float value = roundf(coefs[idx] * scale);
+        if ((value < (float)INT16_MIN) || (value > (float)INT16_MAX)) {
+            return false;
+        }
+        *fixed[idx] = (int16_t)value;
+    }
+
+    return true;
+}
+
+/** @brief Run 2.14 coefficient biquad on 16 bit samples, direct form I with 64 bit accumulator
+ *  @param biquad - filter handler
+ *  @param sample - new sample
+ *  @return filtered sample, saturated
+ */
+static inline int16_t DspBiquadQ14Filter(dspBiquadQ14_t *biquad, int16_t sample)
+{
+    assert(biquad);
+
+    int64_t acc = (int64_t)biquad->b0 * sample + (int64_t)biquad->b1 * biquad->x1 + (int64_t)biquad->b2 * biquad->x2
+                - (int64_t)biquad->a1 * biquad->y1 - (int64_t)biquad->a2 * biquad->y2;
+
+    acc = (acc + (1LL << (DSP_BIQUAD_Q14_COEF_SHIFT - 1U))) >> DSP_BIQUAD_Q14_COEF_SHIFT;
+    int16_t output = (acc > INT16_MAX) ? INT16_MAX : ((acc < INT16_MIN) ? INT16_MIN : (int16_t)acc);
+
+    biquad->x2 = biquad->x1;
+    biquad->x1 = sample;
+    biquad->y2 = biquad->y1;
+    biquad->y1 = output;
+
+    return output;
+}
+
+/** @brief Initialize biquad with 2.30 coefficients
+ *  @param biquad - filter handler
+ *  @param coef - coefficients, each within [-2, 2)
+ *  @return true if the coefficients fit
+ */
+static inline bool DspBiquadQ30Init(dspBiquadQ30_t *biquad, const dspBiquadCoef_t *coef)
+{
+    assert(biquad);
+    assert(coef);
+
+    memset(biquad, 0, sizeof(dspBiquadQ30_t));
+
+    const double coefs[] = { coef->b0, coef->b1, coef->b2, coef->a1, coef->a2 };
+    int32_t *fixed[] = { &biquad->b0, &biquad->b1, &biquad->b2, &biquad->a1, &biquad->a2 };
+    const double scale = (double)(1L << DSP_BIQUAD_Q30_COEF_SHIFT);
+
+    for (uint8_t idx = 0; idx < 5U; ++idx) {
+        double value = round(coefs[idx] * scale);
+        if ((value < (double)INT32_MIN) || (value > (double)INT32_MAX)) {
+            return false;
+        }
+        *fixed[idx] = (int32_t)value;
+    }
+
+    return true;
+}
+
+/** @brief Run 2.30 coefficient biquad on 32 bit samples, direct form I with 64 bit accumulator
+ *  @param biquad - filter handler
+ *  @param sample - new sample, within +-2**29
+ *  @return filtered sample, saturated
+ */
+static inline int32_t DspBiquadQ30Filter(dspBiquadQ30_t *biquad, int32_t sample)
+{
+    assert(biquad);
+
+    int64_t acc = (int64_t)biquad->b0 * sample + (int64_t)biquad->b1 * biquad->x1 + (int64_t)biquad->b2 * biquad->x2
+                - (int64_t)biquad->a1 * biquad->y1 - (int64_t)biquad->a2 * biquad->y2;
+
+    acc = (acc + (1LL << (DSP_BIQUAD_Q30_COEF_SHIFT - 1U))) >> DSP_BIQUAD_Q30_COEF_SHIFT;
+    int32_t output = (acc > INT32_MAX) ? INT32_MAX : ((acc < INT32_MIN) ? INT32_MIN : (int32_t)acc);
+
+    biquad->x2 = biquad->x1;
+    biquad->x1 = sample;
+    biquad->y2 = biquad->y1;
+    biquad->y1 = output;
+
+    return output;
+}
+
+/** @brief Run hysteresis comparator
+ *  @param hysteresis - comparator handler
+ *  @param value - compared value
+ *  @return true if high
+ */
+static inline bool DspHysteresisUpdate(dspHysteresis_t *hysteresis, int32_t value)
+{
+    assert(hysteresis);
+
+    if (value >= hysteresis->high) {
+        hysteresis->isHigh = true;
+    } else if (value <= hysteresis->low) {
+        hysteresis->isHigh = false;
+    }
+
+    return hysteresis->isHigh;
+}
@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * @file filterLoad.c
+ *
+ * @brief air filter load estimation from the fan operating points: duty = ratio * speed fit by
+ *        exponentially weighted least squares, compared with the ratio learned on the new filter
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/filterLoad/filterLoad.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+void FilterLoadInit(filterLoad_t *load)
+{
+    assert(load);
+
+    memset(load, 0, sizeof(filterLoad_t));
+}
+
+void FilterLoadAddSample(filterLoad_t *load, float speed, float duty)
+{
+    assert(load);
+
+    if (speed <= 0.0f) {
+        return;
+    }
+
+    load->sumSpeedSquare = load->sumSpeedSquare * FILTER_LOAD_FORGET + speed * speed;
+    load->sumSpeedDuty = load->sumSpeedDuty * FILTER_LOAD_FORGET + speed * duty;
+
+    if (load->samples < UINT32_MAX) {
+        load->samples += 1;
+    }
+
+    if ((load->cleanRatio == 0.0f) && (load->samples >= FILTER_LOAD_LEARN_SAMPLES)) {
+        FilterLoadGetRatio(load, &load->cleanRatio);
+    }
+}
+
+bool FilterLoadGetRatio(const filterLoad_t *load, float *ratio)
+{
+    assert(load);
+    assert(ratio);
+
+    if ((load->samples < FILTER_LOAD_MIN_SAMPLES) || (load->sumSpeedSquare <= 0.0f)) {
+        return false;
+    }
+
+    *ratio = load->sumSpeedDuty / load->sumSpeedSquare;
+
+    return true;
+}
+
+bool FilterLoadGetDutyChange(const filterLoad_t *load, float *change)
+{
+    assert(load);
+    assert(change);
+
+    float ratio = 0.0f;
+    if ((load->cleanRatio <= 0.0f) || (FilterLoadGetRatio(load, &ratio) == false)) {
+        return false;
+    }
+
+    *change = (ratio / load->cleanRatio) - 1.0f;
+
+    return true;
+}
+
+bool FilterLoadGetPercent(const filterLoad_t *load, float cloggedChange, uint8_t *percent)
+{
+    assert(load);
+    assert(percent);
+    assert(cloggedChange != 0.0f);
+
+    float change = 0.0f;
+    if (FilterLoadGetDutyChange(load, &change) == false) {
+        return false;
+    }
+
+    float value = 100.0f * change / cloggedChange;
+
+    if (value < 0.0f) {
+        value = 0.0f;
+    } else if (value > 100.0f) {
+        value = 100.0f;
+    }
+
+    *percent = (uint8_t)(value + 0.5f);
+
+    return true;
+}
@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * @file filterLoad.h
+ *
+ * @brief air filter load estimation from the fan operating points: duty = ratio * speed fit by
+ *        exponentially weighted least squares, compared with the ratio learned on the new filter
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define FILTER_LOAD_FORGET (1.0f - (1.0f / 64.0f))  // sample weight decay, fit over the last ~64 samples
+#define FILTER_LOAD_MIN_SAMPLES (8U)                // ratio is valid after
+#define FILTER_LOAD_LEARN_SAMPLES (64U)             // new filter ratio is taken after
+
+typedef struct {
+    float sumSpeedSquare;
+    float sumSpeedDuty;
+    uint32_t samples;
+    float cleanRatio;                               // duty per speed of the new filter, 0 - not learned
+} filterLoad_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Start estimation of the new filter
+ *  @param load - estimator handler
+ */
+void FilterLoadInit(filterLoad_t *load);
+
+/** @brief Add fan operating point, the new filter ratio is learned from the first ones
+ *  @param load - estimator handler
+ *  @param speed - fan speed, not positive values are skipped
+ *  @param duty - fan pwm duty
+ */
+void FilterLoadAddSample(filterLoad_t *load, float speed, float duty);
+
+/** @brief Get fitted duty per speed ratio
+ *  @param load - estimator handler
+ *  @param ratio [out] duty per speed
+ *  @return true if there are enough samples
+ */
+bool FilterLoadGetRatio(const filterLoad_t *load, float *ratio);
+
+/** @brief Get relative change of the duty needed for the same speed against the new filter,
+ *         it follows the pressure drop on the filter
+ *  @param load - estimator handler
+ *  @param change [out] e.g. 0.2 for 20 % more duty
+ *  @return true if the new filter ratio is learned
+ */
+bool FilterLoadGetDutyChange(const filterLoad_t *load, float *change);
+
+/** @brief Get filter load
+ *  @param load - estimator handler
+ *  @param cloggedChange - duty change of the clogged filter, negative for fans unloading with the filter load
+ *  @param percent [out] 0 - new, 100 - clogged
+ *  @return true if the new filter ratio is learned
+ */
+bool FilterLoadGetPercent(const filterLoad_t *load, float cloggedChange, uint8_t *percent);
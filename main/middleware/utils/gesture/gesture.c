@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * @file gesture.c
+ *
+ * @brief table driven gesture engine of up to 32 binary inputs (touch buttons, switches),
+ *        fed by timestamped input changes
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/gesture/gesture.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define RULE_BIT(idx) (1UL << (idx))
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Get time of the next HOLD or REPEAT gesture of the rule
+ *  @param gesture - engine handler
+ *  @param idx - rule index
+ *  @return gesture time, GESTURE_NO_DEADLINE if the rule is not pending
+ */
+static int64_t GetRuleDeadline(const gesture_t *gesture, uint8_t idx);
+
+/** @brief Fire RELEASE and DOUBLE_TAP gestures of the finished session
+ *  @param gesture - engine handler
+ *  @param timeMs - release time
+ */
+static void EndSession(gesture_t *gesture, int64_t timeMs);
+
+/** @brief Call the gesture callback
+ *  @param gesture - engine handler
+ *  @param idx - rule index
+ *  @param timeMs - gesture time
+ *  @param heldMs - held time
+ *  @param repeat - repeat count
+ */
+static void Fire(const gesture_t *gesture, uint8_t idx, int64_t timeMs, uint32_t heldMs, uint16_t repeat);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool GestureInit(gesture_t *gesture, const gestureRule_t *rules, uint8_t rulesCount, gestureCallback_t callback, void *ctx)
+{
+    assert(gesture);
+
+    memset(gesture, 0, sizeof(gesture_t));
+
+    if ((rules == NULL) || (rulesCount > GESTURE_MAX_RULES)) {
+        return false;
+    }
+
+    gesture->rules = rules;
+    gesture->rulesCount = rulesCount;
+    gesture->callback = callback;
+    gesture->ctx = ctx;
+
+    return true;
+}
+
+void GestureSetInputs(gesture_t *gesture, uint32_t pressed, int64_t timeMs)
+{
+    assert(gesture);
+
+    // thresholds passed before the change are reported first
+    GestureTick(gesture, timeMs);
+
+    if (pressed == gesture->pressed) {
+        return;
+    }
+
+    if (gesture->pressed == 0) {
+        gesture->sessionTimeMs = timeMs;
+        gesture->sessionMask = 0;
+    }
+
+    gesture->pressed = pressed;
+    gesture->pressedTimeMs = timeMs;
+    gesture->sessionMask |= pressed;
+    gesture->holdFired = 0;
+    memset(gesture->repeats, 0, sizeof(gesture->repeats));
+
+    if (pressed == 0) {
+        EndSession(gesture, timeMs);
+        return;
+    }
+
+    for (uint8_t idx = 0; idx < gesture->rulesCount; ++idx) {
+        if ((gesture->rules[idx].type == GESTURE_TYPE_PRESS) && (gesture->rules[idx].mask == pressed)) {
+            Fire(gesture, idx, timeMs, 0, 0);
+        }
+    }
+}
+
+void GestureInputEvent(gesture_t *gesture, uint8_t input, bool isPressed, int64_t timeMs)
+{
+    assert(gesture);
+    assert(input < 32U);
+
+    uint32_t pressed = gesture->pressed & ~GESTURE_INPUT(input);
+    if (isPressed) {
+        pressed |= GESTURE_INPUT(input);
+    }
+
+    GestureSetInputs(gesture, pressed, timeMs);
+}
+
+void GestureTick(gesture_t *gesture, int64_t timeMs)
+{
+    assert(gesture);
+
+    if (gesture->pressed == 0) {
+        return;
+    }
+
+    for (uint8_t idx = 0; idx < gesture->rulesCount; ++idx) {
+        const gestureRule_t *rule = &gesture->rules[idx];
+
+        int64_t deadline = GetRuleDeadline(gesture, idx);
+        if ((deadline == GESTURE_NO_DEADLINE) || (timeMs < deadline)) {
+            continue;
+        }
+
+        Fire(gesture, idx, deadline, (uint32_t)(deadline - gesture->pressedTimeMs), gesture->repeats[idx]);
+
+        if ((rule->type == GESTURE_TYPE_HOLD) || (rule->periodMs == 0)) {
+            gesture->holdFired |= RULE_BIT(idx);
+        } else {
+            // a late tick fires once and skips the missed periods
+            gesture->repeats[idx] = (uint16_t)((timeMs - gesture->pressedTimeMs - rule->minMs) / rule->periodMs + 1);
+        }
+    }
+}
+
+int64_t GestureGetNextDeadline(const gesture_t *gesture)
+{
+    assert(gesture);
+
+    int64_t next = GESTURE_NO_DEADLINE;
+
+    for (uint8_t idx = 0; idx < gesture->rulesCount; ++idx) {
+        int64_t deadline = GetRuleDeadline(gesture, idx);
+        if ((deadline != GESTURE_NO_DEADLINE) && ((next == GESTURE_NO_DEADLINE) || (deadline < next))) {
+            next = deadline;
+        }
+    }
+
+    return next;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static int64_t GetRuleDeadline(const gesture_t *gesture, uint8_t idx)
+{
+    const gestureRule_t *rule = &gesture->rules[idx];
+
+    if ((gesture->pressed == 0) || (rule->mask != gesture->pressed) || (gesture->holdFired & RULE_BIT(idx))) {
+        return GESTURE_NO_DEADLINE;
+    }
+
+    if (rule->type == GESTURE_TYPE_HOLD) {
+        return gesture->pressedTimeMs + rule->minMs;
+    }
+
+    if (rule->type == GESTURE_TYPE_REPEAT) {
+        return gesture->pressedTimeMs + rule->minMs + (int64_t)gesture->repeats[idx] * rule->periodMs;
+    }
+
+    return GESTURE_NO_DEADLINE;
+}
+
+static void EndSession(gesture_t *gesture, int64_t timeMs)
+{
+    uint32_t heldMs = (uint32_t)(timeMs - gesture->sessionTimeMs);
+    bool isDoubleTap = false;
+
+    for (uint8_t idx = 0; idx < gesture->rulesCount; ++idx) {
+        const gestureRule_t *rule = &gesture->rules[idx];
+
+        if (rule->mask != gesture->sessionMask) {
+            continue;
+        }
+
+        if ((rule->type == GESTURE_TYPE_RELEASE) && (heldMs >= rule->minMs) && ((rule->maxMs == 0) || (heldMs < rule->maxMs))) {
+            Fire(gesture, idx, timeMs, heldMs, 0);
+        }
+
+        if ((rule->type == GESTURE_TYPE_DOUBLE_TAP) && (gesture->tapMask == gesture->sessionMask) &&
+            (heldMs < rule->maxMs) && (gesture->tapHeldMs < rule->maxMs) &&
+            ((gesture->sessionTimeMs - gesture->tapReleaseMs) < rule->maxMs)) {
+            Fire(gesture, idx, timeMs, heldMs, 0);
+            isDoubleTap = true;
+        }
+    }
+
+    // the second tap of a double tap does not start another one
+    gesture->tapMask = isDoubleTap ? 0 : gesture->sessionMask;
+    gesture->tapHeldMs = heldMs;
+    gesture->tapReleaseMs = timeMs;
+}
+
+static void Fire(const gesture_t *gesture, uint8_t idx, int64_t timeMs, uint32_t heldMs, uint16_t repeat)
+{
+    if (gesture->callback == NULL) {
+        return;
+    }
+
+    gestureEvent_t event = {
+        .rule = &gesture->rules[idx],
+        .timeMs = timeMs,
+        .heldMs = heldMs,
+        .repeat = repeat,
+    };
+
+    gesture->callback(&event, gesture->ctx);
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * @file gesture.h
+ *
+ * @brief table driven gesture engine of up to 32 binary inputs (touch buttons, switches),
+ *        fed by timestamped input changes
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define GESTURE_MAX_RULES (16U)
+#define GESTURE_NO_DEADLINE (-1LL)
+
+#define GESTURE_INPUT(input) (1UL << (input))
+
+/*
+ * A rule matches when exactly its mask inputs are pressed, more than one input is a chord.
+ * Press session lasts from the first press until all inputs are released.
+ *
+ * PRESS        fired when the mask becomes pressed
+ * RELEASE      fired when the session of only the mask inputs ends, held time in <minMs, maxMs), maxMs 0 no limit
+ * HOLD         fired once when the mask is held minMs
+ * DOUBLE_TAP   fired when the second session of the mask ends, both shorter than maxMs and maxMs apart
+ * REPEAT       fired when the mask is held minMs and then every periodMs
+ */
+typedef enum {
+    GESTURE_TYPE_PRESS = 0,
+    GESTURE_TYPE_RELEASE,
+    GESTURE_TYPE_HOLD,
+    GESTURE_TYPE_DOUBLE_TAP,
+    GESTURE_TYPE_REPEAT,
+} gestureType_t;
+
+typedef struct {
+    uint8_t id;                     // user gesture id, passed to the callback
+    gestureType_t type;
+    uint32_t mask;                  // GESTURE_INPUT() of the inputs
+    uint32_t minMs;
+    uint32_t maxMs;
+    uint32_t periodMs;
+} gestureRule_t;
+
+typedef struct {
+    const gestureRule_t *rule;
+    int64_t timeMs;                 // input change or threshold time, not the processing time
+    uint32_t heldMs;                // time the mask is held (session time for RELEASE and DOUBLE_TAP)
+    uint16_t repeat;                // REPEAT count, 0 for the first one
+} gestureEvent_t;
+
+/** @brief Gesture handler, called from the function processing the input change or tick
+ *  @param event - detected gesture
+ *  @param ctx - user context
+ */
+typedef void (*gestureCallback_t)(const gestureEvent_t *event, void *ctx);
+
+typedef struct {
+    const gestureRule_t *rules;
+    uint8_t rulesCount;
+    gestureCallback_t callback;
+    void *ctx;
+
+    uint32_t pressed;               // current inputs
+    int64_t pressedTimeMs;          // time current inputs are pressed from
+    uint32_t sessionMask;           // inputs pressed in the session
+    int64_t sessionTimeMs;
+
+    uint32_t holdFired;             // bit per rule fired for current inputs
+    uint16_t repeats[GESTURE_MAX_RULES];
+
+    uint32_t tapMask;               // last session, for double tap
+    uint32_t tapHeldMs;
+    int64_t tapReleaseMs;
+} gesture_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Initialize engine, all inputs released
+ *  @param gesture - engine handler
+ *  @param rules - rules table, must stay valid
+ *  @param rulesCount - number of rules, up to GESTURE_MAX_RULES
+ *  @param callback - gesture handler
+ *  @param ctx - user context passed to the callback
+ *  @return true if success
+ */
+bool GestureInit(gesture_t *gesture, const gestureRule_t *rules, uint8_t rulesCount, gestureCallback_t callback, void *ctx);
+
+/** @brief Set state of all inputs, e.g. from one status register read
+ *  @param gesture - engine handler
+ *  @param pressed - GESTURE_INPUT() of the pressed inputs
+ *  @param timeMs - time of the change, not earlier than previous calls
+ */
+void GestureSetInputs(gesture_t *gesture, uint32_t pressed, int64_t timeMs);
+
+/** @brief Set state of a single input
+ *  @param gesture - engine handler
+ *  @param input - input number 0-31
+ *  @param isPressed - input state
+ *  @param timeMs - time of the change, not earlier than previous calls
+ */
+void GestureInputEvent(gesture_t *gesture, uint8_t input, bool isPressed, int64_t timeMs);
+
+/** @brief Fire HOLD and REPEAT gestures due until the time
+ *  @param gesture - engine handler
+ *  @param timeMs - current time
+ */
+void GestureTick(gesture_t *gesture, int64_t timeMs);
+
+/** @brief Get time of the next HOLD or REPEAT gesture of the current inputs
+ *  @param gesture - engine handler
+ *  @return time when GestureTick() should be called, GESTURE_NO_DEADLINE if none is pending
+ */
+int64_t GestureGetNextDeadline(const gesture_t *gesture);
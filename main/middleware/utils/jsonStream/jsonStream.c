@@ -0,0 +1,366 @@
+/*****************************************************************************
+ * @file jsonStream.c
+ *
+ * @brief incremental (push) parser of a json object, fed with data chunks as
+ *        they arrive. Values of the top level keys are passed to the callback,
+ *        long strings in pieces, so memory use doesn't depend on the json size.
+ *        Nested objects and arrays are skipped.
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/jsonStream/jsonStream.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define IS_WHITESPACE(c) (((c) == ' ') || ((c) == '\t') || ((c) == '\r') || ((c) == '\n'))
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef enum {
+    STATE_BEGIN = 0,
+    STATE_FIRST_KEY,            // key or closing brace of an empty object
+    STATE_KEY,                  // key expected after comma
+    STATE_KEY_STRING,
+    STATE_KEY_ESCAPE,
+    STATE_COLON,
+    STATE_VALUE,
+    STATE_STRING,
+    STATE_STRING_ESCAPE,
+    STATE_STRING_UNICODE,
+    STATE_PRIMITIVE,
+    STATE_SKIP,
+    STATE_AFTER_VALUE,
+    STATE_DONE,
+    STATE_ERROR,
+} jsonStreamState_t;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Process one character
+ *  @param stream - parser handler
+ *  @param c - character
+ *  @return next state
+ */
+static jsonStreamState_t ParseChar(jsonStream_t *stream, char c);
+
+/** @brief Append character to the string value, full chunk is passed to the callback
+ *  @param stream - parser handler
+ *  @param c - character
+ *  @return true - if success
+ */
+static bool AppendChar(jsonStream_t *stream, char c);
+
+/** @brief Pass collected value piece to the callback
+ *  @param stream - parser handler
+ *  @param type - value type
+ *  @param isEnd - last piece of the value
+ *  @return callback result
+ */
+static bool Flush(jsonStream_t *stream, jsonStreamType_t type, bool isEnd);
+
+/** @brief Finish number or literal value
+ *  @param stream - parser handler
+ *  @return true - if value is correct
+ */
+static bool FinishPrimitive(jsonStream_t *stream);
+
+/** @brief Skip character of nested object or array
+ *  @param stream - parser handler
+ *  @param c - character
+ *  @return next state
+ */
+static jsonStreamState_t SkipChar(jsonStream_t *stream, char c);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+void JsonStreamInit(jsonStream_t *stream, jsonStreamCallback_t callback, void *ctx)
+{
+    assert(stream);
+    assert(callback);
+
+    memset(stream, 0, sizeof(jsonStream_t));
+
+    stream->callback = callback;
+    stream->ctx = ctx;
+    stream->state = STATE_BEGIN;
+}
+
+bool JsonStreamParse(jsonStream_t *stream, const char *data, uint32_t len)
+{
+    assert(stream);
+    assert(data);
+
+    for (uint32_t idx = 0; (idx < len) && (stream->state != STATE_ERROR); ++idx) {
+        stream->state = ParseChar(stream, data[idx]);
+    }
+
+    return (stream->state != STATE_ERROR);
+}
+
+bool JsonStreamIsComplete(const jsonStream_t *stream)
+{
+    assert(stream);
+
+    return (stream->state == STATE_DONE);
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static jsonStreamState_t ParseChar(jsonStream_t *stream, char c)
+{
+    switch (stream->state) {
+    case STATE_BEGIN:
+        if (IS_WHITESPACE(c)) {
+            return STATE_BEGIN;
+        }
+        return (c == '{') ? STATE_FIRST_KEY : STATE_ERROR;
+
+    case STATE_FIRST_KEY:
+    case STATE_KEY:
+        if (IS_WHITESPACE(c)) {
+            return stream->state;
+        }
+        if ((c == '}') && (stream->state == STATE_FIRST_KEY)) {
+            return STATE_DONE;
+        }
+        if (c != '"') {
+            return STATE_ERROR;
+        }
+        stream->keyLen = 0;
+        return STATE_KEY_STRING;
+
+    case STATE_KEY_STRING:
+    case STATE_KEY_ESCAPE:
+        // keys are plain names, escaped character is taken literally
+        if ((stream->state == STATE_KEY_STRING) && (c == '\\')) {
+            return STATE_KEY_ESCAPE;
+        }
+        if ((stream->state == STATE_KEY_STRING) && (c == '"')) {
+            stream->key[stream->keyLen] = '\0';
+            return STATE_COLON;
+        }
+        if (stream->keyLen >= (JSON_STREAM_KEY_MAX_LEN - 1U)) {
+            return STATE_ERROR;
+        }
+        stream->key[stream->keyLen++] = c;
+        return STATE_KEY_STRING;
+
+    case STATE_COLON:
+        if (IS_WHITESPACE(c)) {
+            return STATE_COLON;
+        }
+        return (c == ':') ? STATE_VALUE : STATE_ERROR;
+
+    case STATE_VALUE:
+        if (IS_WHITESPACE(c)) {
+            return STATE_VALUE;
+        }
+        stream->chunkLen = 0;
+        if (c == '"') {
+            return STATE_STRING;
+        }
+        if ((c == '{') || (c == '[')) {
+            stream->skipDepth = 1;
+            stream->isSkipString = false;
+            return STATE_SKIP;
+        }
+        if ((c == '-') || ((c >= '0') && (c <= '9')) || (c == 't') || (c == 'f') || (c == 'n')) {
+            stream->chunk[stream->chunkLen++] = c;
+            return STATE_PRIMITIVE;
+        }
+        return STATE_ERROR;
+
+    case STATE_STRING:
+        if (c == '\\') {
+            return STATE_STRING_ESCAPE;
+        }
+        if (c == '"') {
+            return Flush(stream, JSON_STREAM_TYPE_STRING, true) ? STATE_AFTER_VALUE : STATE_ERROR;
+        }
+        if ((unsigned char)c < 0x20U) {
+            return STATE_ERROR;
+        }
+        return AppendChar(stream, c) ? STATE_STRING : STATE_ERROR;
+
+    case STATE_STRING_ESCAPE: {
+        char unescaped;
+        switch (c) {
+        case '"':  unescaped = '"';  break;
+        case '\\': unescaped = '\\'; break;
+        case '/':  unescaped = '/';  break;
+        case 'b':  unescaped = '\b'; break;
+        case 'f':  unescaped = '\f'; break;
+        case 'n':  unescaped = '\n'; break;
+        case 'r':  unescaped = '\r'; break;
+        case 't':  unescaped = '\t'; break;
+        case 'u':
+            stream->unicode = 0;
+            stream->unicodeDigits = 0;
+            return STATE_STRING_UNICODE;
+        default:
+            return STATE_ERROR;
+        }
+        return AppendChar(stream, unescaped) ? STATE_STRING : STATE_ERROR;
+    }
+
+    case STATE_STRING_UNICODE: {
+        uint32_t digit;
+        if ((c >= '0') && (c <= '9')) {
+            digit = c - '0';
+        } else if ((c >= 'a') && (c <= 'f')) {
+            digit = c - 'a' + 10U;
+        } else if ((c >= 'A') && (c <= 'F')) {
+            digit = c - 'A' + 10U;
+        } else {
+            return STATE_ERROR;
+        }
+
+        stream->unicode = (stream->unicode << 4) | digit;
+        if (++stream->unicodeDigits < 4U) {
+            return STATE_STRING_UNICODE;
+        }
+
+        // UTF-8, surrogate pairs are not supported
+        bool res = true;
+        uint32_t cp = stream->unicode;
+        if (cp < 0x80U) {
+            res &= AppendChar(stream, (char)cp);
+        } else if (cp < 0x800U) {
+            res &= AppendChar(stream, (char)(0xC0U | (cp >> 6)));
+            res &= AppendChar(stream, (char)(0x80U | (cp & 0x3FU)));
+        } else {
+            res &= AppendChar(stream, (char)(0xE0U | (cp >> 12)));
+            res &= AppendChar(stream, (char)(0x80U | ((cp >> 6) & 0x3FU)));
+            res &= AppendChar(stream, (char)(0x80U | (cp & 0x3FU)));
+        }
+        return res ? STATE_STRING : STATE_ERROR;
+    }
+
+    case STATE_PRIMITIVE:
+        if ((c == ',') || (c == '}') || IS_WHITESPACE(c)) {
+            if (FinishPrimitive(stream) == false) {
+                return STATE_ERROR;
+            }
+            stream->state = STATE_AFTER_VALUE;
+            return ParseChar(stream, c);
+        }
+        if (stream->chunkLen >= (JSON_STREAM_CHUNK_LEN - 1U)) {
+            return STATE_ERROR;
+        }
+        stream->chunk[stream->chunkLen++] = c;
+        return STATE_PRIMITIVE;
+
+    case STATE_SKIP:
+        return SkipChar(stream, c);
+
+    case STATE_AFTER_VALUE:
+        if (IS_WHITESPACE(c)) {
+            return STATE_AFTER_VALUE;
+        }
+        if (c == ',') {
+            return STATE_KEY;
+        }
+        return (c == '}') ? STATE_DONE : STATE_ERROR;
+
+    case STATE_DONE:
+        return IS_WHITESPACE(c) ? STATE_DONE : STATE_ERROR;
+
+    default:
+        return STATE_ERROR;
+    }
+}
+
+static bool AppendChar(jsonStream_t *stream, char c)
+{
+    if ((stream->chunkLen == JSON_STREAM_CHUNK_LEN) && (Flush(stream, JSON_STREAM_TYPE_STRING, false) == false)) {
+        return false;
+    }
+
+    stream->chunk[stream->chunkLen++] = c;
+
+    return true;
+}
+
+static bool Flush(jsonStream_t *stream, jsonStreamType_t type, bool isEnd)
+{
+    bool res = stream->callback(stream->ctx, stream->key, type, stream->chunk, stream->chunkLen, isEnd);
+    stream->chunkLen = 0;
+
+    return res;
+}
+
+static bool FinishPrimitive(jsonStream_t *stream)
+{
+    static const struct {
+        const char *name;
+        jsonStreamType_t type;
+    } literals[] = {
+        { "true", JSON_STREAM_TYPE_TRUE },
+        { "false", JSON_STREAM_TYPE_FALSE },
+        { "null", JSON_STREAM_TYPE_NULL },
+    };
+
+    stream->chunk[stream->chunkLen] = '\0';
+
+    for (uint8_t idx = 0; idx < (sizeof(literals) / sizeof(literals[0])); ++idx) {
+        if (strcmp(stream->chunk, literals[idx].name) == 0) {
+            return Flush(stream, literals[idx].type, true);
+        }
+    }
+
+    // number: only the allowed characters are checked, the callback converts it
+    if ((stream->chunk[0] != '-') && ((stream->chunk[0] < '0') || (stream->chunk[0] > '9'))) {
+        return false;
+    }
+
+    if (strspn(stream->chunk, "-+.eE0123456789") != stream->chunkLen) {
+        return false;
+    }
+
+    return Flush(stream, JSON_STREAM_TYPE_NUMBER, true);
+}
+
+static jsonStreamState_t SkipChar(jsonStream_t *stream, char c)
+{
+    if (stream->isSkipString == true) {
+        if (stream->returnState == STATE_STRING_ESCAPE) {
+            stream->returnState = STATE_SKIP;
+        } else if (c == '\\') {
+            stream->returnState = STATE_STRING_ESCAPE;
+        } else if (c == '"') {
+            stream->isSkipString = false;
+        }
+        return STATE_SKIP;
+    }
+
+    if (c == '"') {
+        stream->isSkipString = true;
+        stream->returnState = STATE_SKIP;
+    } else if ((c == '{') || (c == '[')) {
+        stream->skipDepth++;
+    } else if ((c == '}') || (c == ']')) {
+        if (--stream->skipDepth == 0) {
+            return STATE_AFTER_VALUE;
+        }
+    }
+
+    return STATE_SKIP;
+}
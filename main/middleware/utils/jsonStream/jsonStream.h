@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * @file jsonStream.h
+ *
+ * @brief incremental (push) parser of a json object, fed with data chunks as
+ *        they arrive. Values of the top level keys are passed to the callback,
+ *        long strings in pieces, so memory use doesn't depend on the json size.
+ *        Nested objects and arrays are skipped.
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define JSON_STREAM_KEY_MAX_LEN (32U)           // including terminating zero
+#define JSON_STREAM_CHUNK_LEN (64U)             // string values are passed in pieces of this size
+
+typedef enum {
+    JSON_STREAM_TYPE_STRING = 0,
+    JSON_STREAM_TYPE_NUMBER,
+    JSON_STREAM_TYPE_TRUE,
+    JSON_STREAM_TYPE_FALSE,
+    JSON_STREAM_TYPE_NULL,
+} jsonStreamType_t;
+
+/** @brief Value callback
+ *  @param ctx - user context
+ *  @param key - top level key
+ *  @param type - value type
+ *  @param data - piece of the value (string without quotes, unescaped), not terminated
+ *  @param len - piece length
+ *  @param isEnd - last piece of the value
+ *  @return false aborts parsing
+ */
+typedef bool (*jsonStreamCallback_t)(void *ctx, const char *key, jsonStreamType_t type, const char *data, uint32_t len, bool isEnd);
+
+typedef struct {
+    jsonStreamCallback_t callback;
+    void *ctx;
+    uint8_t state;
+    uint8_t returnState;
+    uint32_t skipDepth;
+    bool isSkipString;
+    char key[JSON_STREAM_KEY_MAX_LEN];
+    uint32_t keyLen;
+    char chunk[JSON_STREAM_CHUNK_LEN];
+    uint32_t chunkLen;
+    uint32_t unicode;
+    uint8_t unicodeDigits;
+} jsonStream_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Initialize parser
+ *  @param stream - parser handler
+ *  @param callback - called for every value piece
+ *  @param ctx - user context passed to the callback
+ */
+void JsonStreamInit(jsonStream_t *stream, jsonStreamCallback_t callback, void *ctx);
+
+/** @brief Parse next piece of json
+ *  @param stream - parser handler
+ *  @param data - json piece
+ *  @param len - piece length
+ *  @return false - syntax error, too long key or aborted by the callback
+ */
+bool JsonStreamParse(jsonStream_t *stream, const char *data, uint32_t len);
+
+/** @brief Check if the whole object was parsed
+ *  @param stream - parser handler
+ *  @return true - closing brace received
+ */
+bool JsonStreamIsComplete(const jsonStream_t *stream);
@@ -0,0 +1,226 @@
+/*****************************************************************************
+ * @file lruCache.c
+ *
+ * @brief generic byte-budgeted least recently used cache with string keys
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/lruCache/lruCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Find used entry with the key
+ *  @param cache - cache handler
+ *  @param key - entry key
+ *  @return pointer to entry, NULL if not found
+ */
+static lruCacheEntry_t *FindEntry(lruCache_t *cache, const char *key);
+
+/** @brief Find free entry or evict least recently used one
+ *  @param cache - cache handler
+ *  @return pointer to free entry
+ */
+static lruCacheEntry_t *GetFreeEntry(lruCache_t *cache);
+
+/** @brief Evict least recently used entry
+ *  @param cache - cache handler
+ *  @return true if something was evicted
+ */
+static bool EvictLeastRecentlyUsed(lruCache_t *cache);
+
+/** @brief Free entry data
+ *  @param cache - cache handler
+ *  @param entry - entry to free
+ */
+static void FreeEntry(lruCache_t *cache, lruCacheEntry_t *entry);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool LruCacheInit(lruCache_t *cache, lruCacheEntry_t *entries, uint32_t entriesCount, uint32_t budget)
+{
+    assert(cache);
+
+    memset(cache, 0, sizeof(lruCache_t));
+
+    if ((entries == NULL) || (entriesCount == 0) || (budget == 0)) {
+        return false;
+    }
+
+    memset(entries, 0, entriesCount * sizeof(lruCacheEntry_t));
+
+    cache->entries = entries;
+    cache->entriesCount = entriesCount;
+    cache->budget = budget;
+
+    return true;
+}
+
+void LruCacheDeinit(lruCache_t *cache)
+{
+    assert(cache);
+
+    LruCacheClear(cache);
+    memset(cache, 0, sizeof(lruCache_t));
+}
+
+const uint8_t *LruCacheGet(lruCache_t *cache, const char *key, uint32_t *size)
+{
+    assert(cache);
+    assert(key);
+
+    lruCacheEntry_t *entry = FindEntry(cache, key);
+    if (entry == NULL) {
+        cache->misses += 1;
+        return NULL;
+    }
+
+    cache->hits += 1;
+    cache->useCounter += 1;
+    entry->lastUse = cache->useCounter;
+
+    if (size != NULL) {
+        *size = entry->size;
+    }
+
+    return entry->data;
+}
+
+uint8_t *LruCachePut(lruCache_t *cache, const char *key, uint32_t size)
+{
+    assert(cache);
+    assert(key);
+
+    if ((strlen(key) >= LRU_CACHE_KEY_MAX_LEN) || (size == 0) || (size > cache->budget)) {
+        return NULL;
+    }
+
+    LruCacheRemove(cache, key);
+
+    while ((cache->usedBytes + size) > cache->budget) {
+        if (EvictLeastRecentlyUsed(cache) == false) {
+            return NULL;
+        }
+    }
+
+    lruCacheEntry_t *entry = GetFreeEntry(cache);
+
+    entry->data = malloc(size);
+    if (entry->data == NULL) {
+        return NULL;
+    }
+
+    strncpy(entry->key, key, LRU_CACHE_KEY_MAX_LEN);
+    entry->size = size;
+    entry->isUsed = true;
+
+    cache->useCounter += 1;
+    entry->lastUse = cache->useCounter;
+    cache->usedBytes += size;
+
+    return entry->data;
+}
+
+void LruCacheRemove(lruCache_t *cache, const char *key)
+{
+    assert(cache);
+    assert(key);
+
+    lruCacheEntry_t *entry = FindEntry(cache, key);
+    if (entry != NULL) {
+        FreeEntry(cache, entry);
+    }
+}
+
+void LruCacheClear(lruCache_t *cache)
+{
+    assert(cache);
+
+    for (uint32_t idx = 0; idx < cache->entriesCount; ++idx) {
+        if (cache->entries[idx].isUsed) {
+            FreeEntry(cache, &cache->entries[idx]);
+        }
+    }
+}
+
+uint32_t LruCacheGetHitRatePercent(const lruCache_t *cache)
+{
+    assert(cache);
+
+    uint32_t requests = cache->hits + cache->misses;
+    if (requests == 0) {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)cache->hits * 100U) / requests);
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static lruCacheEntry_t *FindEntry(lruCache_t *cache, const char *key)
+{
+    for (uint32_t idx = 0; idx < cache->entriesCount; ++idx) {
+        if (cache->entries[idx].isUsed && (strcmp(cache->entries[idx].key, key) == 0)) {
+            return &cache->entries[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static lruCacheEntry_t *GetFreeEntry(lruCache_t *cache)
+{
+    for (uint32_t idx = 0; idx < cache->entriesCount; ++idx) {
+        if (cache->entries[idx].isUsed == false) {
+            return &cache->entries[idx];
+        }
+    }
+
+    // all entries in use, at least one can be evicted
+    EvictLeastRecentlyUsed(cache);
+
+    return GetFreeEntry(cache);
+}
+
+static bool EvictLeastRecentlyUsed(lruCache_t *cache)
+{
+    lruCacheEntry_t *oldest = NULL;
+
+    for (uint32_t idx = 0; idx < cache->entriesCount; ++idx) {
+        lruCacheEntry_t *entry = &cache->entries[idx];
+
+        if (entry->isUsed && ((oldest == NULL) || (entry->lastUse < oldest->lastUse))) {
+            oldest = entry;
+        }
+    }
+
+    if (oldest == NULL) {
+        return false;
+    }
+
+    FreeEntry(cache, oldest);
+
+    return true;
+}
+
+static void FreeEntry(lruCache_t *cache, lruCacheEntry_t *entry)
+{
+    free(entry->data);
+
+    cache->usedBytes -= entry->size;
+    memset(entry, 0, sizeof(lruCacheEntry_t));
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ * @file lruCache.h
+ *
+ * @brief generic byte-budgeted least recently used cache with string keys
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define LRU_CACHE_KEY_MAX_LEN (64U)
+
+typedef struct {
+    char key[LRU_CACHE_KEY_MAX_LEN];
+    uint8_t *data;
+    uint32_t size;
+    uint32_t lastUse;
+    bool isUsed;
+} lruCacheEntry_t;
+
+typedef struct {
+    lruCacheEntry_t *entries;
+    uint32_t entriesCount;
+    uint32_t budget;
+    uint32_t usedBytes;
+    uint32_t useCounter;
+    uint32_t hits;
+    uint32_t misses;
+} lruCache_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Initializes cache with pre-allocated entries table
+ *  @param cache - cache handler
+ *  @param entries - pre-allocated entries table
+ *  @param entriesCount - number of entries in the table
+ *  @param budget - maximum number of data bytes held by all entries
+ *  @return true - if correctly initialized
+ */
+bool LruCacheInit(lruCache_t *cache, lruCacheEntry_t *entries, uint32_t entriesCount, uint32_t budget);
+
+/** @brief Frees all entries
+ *  @param cache - cache handler
+ */
+void LruCacheDeinit(lruCache_t *cache);
+
+/** @brief Get data for the key and mark entry as most recently used, counts hit or miss
+ *  @param cache - cache handler
+ *  @param key - entry key
+ *  @param size [out] - data size
+ *  @return pointer to cached data, valid until entry is evicted; NULL if not found
+ */
+const uint8_t *LruCacheGet(lruCache_t *cache, const char *key, uint32_t *size);
+
+/** @brief Allocate data buffer for the key, least recently used entries are evicted to fit the budget
+ *  @param cache - cache handler
+ *  @param key - entry key, previous entry with the same key is replaced
+ *  @param size - data size
+ *  @return pointer to buffer to be filled by caller; NULL if key is too long, size exceeds budget or no memory
+ */
+uint8_t *LruCachePut(lruCache_t *cache, const char *key, uint32_t size);
+
+/** @brief Remove entry with the key
+ *  @param cache - cache handler
+ *  @param key - entry key
+ */
+void LruCacheRemove(lruCache_t *cache, const char *key);
+
+/** @brief Remove all entries, statistics are kept
+ *  @param cache - cache handler
+ */
+void LruCacheClear(lruCache_t *cache);
+
+/** @brief Get hit rate
+ *  @param cache - cache handler
+ *  @return hits in percent of all get requests
+ */
+uint32_t LruCacheGetHitRatePercent(const lruCache_t *cache);
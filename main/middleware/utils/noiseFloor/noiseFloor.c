@@ -0,0 +1,105 @@
+/*****************************************************************************
+ * @file noiseFloor.c
+ *
+ * @brief noise floor tracker of a signed 8 bit sensor reading (e.g. touch delta count) taken while idle:
+ *        mean and decaying peak of the magnitude, and mean of the value as the baseline offset
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/noiseFloor/noiseFloor.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define Q4_SHIFT (4U)
+#define Q4_ONE (1 << Q4_SHIFT)
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+void NoiseFloorInit(noiseFloor_t *noise)
+{
+    assert(noise);
+
+    memset(noise, 0, sizeof(noiseFloor_t));
+}
+
+void NoiseFloorAddSample(noiseFloor_t *noise, int8_t sample)
+{
+    assert(noise);
+
+    int16_t valueQ4 = (int16_t)sample * Q4_ONE;
+    uint16_t magnitudeQ4 = (valueQ4 < 0) ? (uint16_t)(-valueQ4) : (uint16_t)valueQ4;
+
+    // first sample starts the means instead of rising from 0
+    if (noise->samples == 0) {
+        noise->offsetQ4 = valueQ4;
+        noise->meanQ4 = magnitudeQ4;
+    } else {
+        noise->offsetQ4 += (valueQ4 - noise->offsetQ4) / (1 << NOISE_FLOOR_MEAN_SHIFT);
+        noise->meanQ4 = (uint16_t)((int16_t)noise->meanQ4 + ((int16_t)magnitudeQ4 - (int16_t)noise->meanQ4) / (1 << NOISE_FLOOR_MEAN_SHIFT));
+    }
+
+    // decay rounded up, reaches 0 when the noise is gone
+    noise->peakQ4 -= (noise->peakQ4 + (1 << NOISE_FLOOR_PEAK_DECAY_SHIFT) - 1) >> NOISE_FLOOR_PEAK_DECAY_SHIFT;
+    if (magnitudeQ4 > noise->peakQ4) {
+        noise->peakQ4 = magnitudeQ4;
+    }
+
+    noise->samples += 1;
+}
+
+void NoiseFloorScale(noiseFloor_t *noise, bool isHalf)
+{
+    assert(noise);
+
+    if (isHalf) {
+        noise->offsetQ4 /= 2;
+        noise->meanQ4 /= 2;
+        noise->peakQ4 /= 2;
+    } else {
+        noise->offsetQ4 *= 2;
+        noise->meanQ4 *= 2;
+        noise->peakQ4 *= 2;
+    }
+}
+
+uint8_t NoiseFloorGetMean(const noiseFloor_t *noise)
+{
+    assert(noise);
+
+    return (uint8_t)((noise->meanQ4 + Q4_ONE / 2) >> Q4_SHIFT);
+}
+
+uint8_t NoiseFloorGetPeak(const noiseFloor_t *noise)
+{
+    assert(noise);
+
+    return (uint8_t)((noise->peakQ4 + Q4_ONE - 1) >> Q4_SHIFT);
+}
+
+int8_t NoiseFloorGetOffset(const noiseFloor_t *noise)
+{
+    assert(noise);
+
+    int16_t half = (noise->offsetQ4 < 0) ? -(Q4_ONE / 2) : (Q4_ONE / 2);
+
+    return (int8_t)((noise->offsetQ4 + half) / Q4_ONE);
+}
+
+uint16_t NoiseFloorGetThreshold(const noiseFloor_t *noise, uint8_t margin)
+{
+    assert(noise);
+
+    return (uint16_t)NoiseFloorGetPeak(noise) * margin;
+}
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * @file noiseFloor.h
+ *
+ * @brief noise floor tracker of a signed 8 bit sensor reading (e.g. touch delta count) taken while idle:
+ *        mean and decaying peak of the magnitude, and mean of the value as the baseline offset
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define NOISE_FLOOR_MEAN_SHIFT (3U)             // mean of the last ~8 samples
+#define NOISE_FLOOR_PEAK_DECAY_SHIFT (5U)       // peak decays by 1/32 of itself per sample
+
+// values are kept in Q4 fixed point
+typedef struct {
+    int16_t offsetQ4;
+    uint16_t meanQ4;
+    uint16_t peakQ4;
+    uint32_t samples;
+} noiseFloor_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Clear tracker
+ *  @param noise - tracker handler
+ */
+void NoiseFloorInit(noiseFloor_t *noise);
+
+/** @brief Add idle sample
+ *  @param noise - tracker handler
+ *  @param sample - sensor reading
+ */
+void NoiseFloorAddSample(noiseFloor_t *noise, int8_t sample);
+
+/** @brief Rescale the tracked values after the sensor gain change
+ *  @param noise - tracker handler
+ *  @param isHalf - true if the gain is halved, false if doubled
+ */
+void NoiseFloorScale(noiseFloor_t *noise, bool isHalf);
+
+/** @brief Get mean magnitude
+ *  @param noise - tracker handler
+ *  @return mean magnitude, rounded
+ */
+uint8_t NoiseFloorGetMean(const noiseFloor_t *noise);
+
+/** @brief Get decaying peak magnitude
+ *  @param noise - tracker handler
+ *  @return peak magnitude, rounded up
+ */
+uint8_t NoiseFloorGetPeak(const noiseFloor_t *noise);
+
+/** @brief Get mean value, the baseline offset
+ *  @param noise - tracker handler
+ *  @return mean value, rounded
+ */
+int8_t NoiseFloorGetOffset(const noiseFloor_t *noise);
+
+/** @brief Get detection threshold keeping the noise peak below it
+ *  @param noise - tracker handler
+ *  @param margin - threshold to peak ratio
+ *  @return threshold, not clamped to the sensor range
+ */
+uint16_t NoiseFloorGetThreshold(const noiseFloor_t *noise, uint8_t margin);
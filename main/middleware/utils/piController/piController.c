@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * @file piController.c
+ *
+ * @brief fixed point PI controller with output limits, slew rate limit and
+ *        anti-windup by tracking of the applied output
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/piController/piController.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define Q8_ONE (1L << PI_CONTROLLER_GAIN_SHIFT)
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Clamp value to range
+ *  @param value - value
+ *  @param min - range min
+ *  @param max - range max
+ *  @return clamped value
+ */
+static int32_t Clamp(int32_t value, int32_t min, int32_t max);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool PiControllerInit(piController_t *pi, const piControllerConfig_t *config, int32_t output)
+{
+    assert(pi);
+    assert(config);
+
+    memset(pi, 0, sizeof(piController_t));
+
+    if ((config->outMin > config->outMax) || (config->kpQ8 < 0) || (config->kiQ8 < 0)) {
+        return false;
+    }
+
+    pi->config = *config;
+    PiControllerReset(pi, output);
+
+    return true;
+}
+
+void PiControllerReset(piController_t *pi, int32_t output)
+{
+    assert(pi);
+
+    pi->output = Clamp(output, pi->config.outMin, pi->config.outMax);
+    pi->integralQ8 = pi->output * Q8_ONE;
+    pi->isLimited = false;
+}
+
+void PiControllerSetLimits(piController_t *pi, int32_t outMin, int32_t outMax)
+{
+    assert(pi);
+    assert(outMin <= outMax);
+
+    pi->config.outMin = outMin;
+    pi->config.outMax = outMax;
+}
+
+int32_t PiControllerUpdate(piController_t *pi, int32_t setpoint, int32_t measurement)
+{
+    assert(pi);
+
+    int32_t error = setpoint - measurement;
+    int32_t proportionalQ8 = pi->config.kpQ8 * error;
+
+    pi->integralQ8 += pi->config.kiQ8 * error;
+
+    int32_t demand = (proportionalQ8 + pi->integralQ8 + (Q8_ONE / 2)) >> PI_CONTROLLER_GAIN_SHIFT;
+    int32_t output = Clamp(demand, pi->config.outMin, pi->config.outMax);
+
+    if (pi->config.slewMax != PI_CONTROLLER_NO_SLEW_LIMIT) {
+        output = Clamp(output, pi->output - (int32_t)pi->config.slewMax, pi->output + (int32_t)pi->config.slewMax);
+    }
+
+    // anti-windup: the integral follows the output that was really applied
+    pi->isLimited = (output != demand);
+    if (pi->isLimited) {
+        pi->integralQ8 = output * Q8_ONE - proportionalQ8;
+    }
+
+    pi->output = output;
+
+    return output;
+}
+
+int32_t PiControllerGetOutput(const piController_t *pi)
+{
+    assert(pi);
+
+    return pi->output;
+}
+
+bool PiControllerIsLimited(const piController_t *pi)
+{
+    assert(pi);
+
+    return pi->isLimited;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static int32_t Clamp(int32_t value, int32_t min, int32_t max)
+{
+    if (value < min) {
+        return min;
+    }
+
+    if (value > max) {
+        return max;
+    }
+
+    return value;
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * @file piController.h
+ *
+ * @brief fixed point PI controller with output limits, slew rate limit and
+ *        anti-windup by tracking of the applied output
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define PI_CONTROLLER_GAIN_SHIFT (8U)           // gains are in Q8, output units per error unit
+#define PI_CONTROLLER_NO_SLEW_LIMIT (0U)
+
+typedef struct {
+    int32_t kpQ8;
+    int32_t kiQ8;                               // per update
+    int32_t outMin;
+    int32_t outMax;
+    uint32_t slewMax;                           // max output change per update
+} piControllerConfig_t;
+
+typedef struct {
+    piControllerConfig_t config;
+    int32_t integralQ8;
+    int32_t output;
+    bool isLimited;
+} piController_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Initialize controller
+ *  @param pi - controller handler
+ *  @param config - gains and limits, copied
+ *  @param output - initial output, e.g. feed forward value
+ *  @return true if config is valid
+ */
+bool PiControllerInit(piController_t *pi, const piControllerConfig_t *config, int32_t output);
+
+/** @brief Restart controller from the given output without a bump
+ *  @param pi - controller handler
+ *  @param output - new output, clamped to the limits
+ */
+void PiControllerReset(piController_t *pi, int32_t output);
+
+/** @brief Change output limits, the output is clamped to them at the next update
+ *  @param pi - controller handler
+ *  @param outMin - min output
+ *  @param outMax - max output
+ */
+void PiControllerSetLimits(piController_t *pi, int32_t outMin, int32_t outMax);
+
+/** @brief Run controller step
+ *  @param pi - controller handler
+ *  @param setpoint - requested value
+ *  @param measurement - measured value
+ *  @return new output
+ */
+int32_t PiControllerUpdate(piController_t *pi, int32_t setpoint, int32_t measurement);
+
+/** @brief Get last output
+ *  @param pi - controller handler
+ *  @return output
+ */
+int32_t PiControllerGetOutput(const piController_t *pi);
+
+/** @brief Check if the last output was cut by the limits or slew rate
+ *  @param pi - controller handler
+ *  @return true if limited
+ */
+bool PiControllerIsLimited(const piController_t *pi);
@@ -0,0 +1,183 @@
+/*****************************************************************************
+ * @file pwmSweep.c
+ *
+ * @brief sweep of pwm frequency / resolution settings: speed ripple of each setting at the same duty
+ *        and selection of the steadiest one, the highest frequency of the near steadiest wins
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/pwmSweep/pwmSweep.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Check if the setting ran the fan at the reference speed
+ *  @param sweep - sweep handler
+ *  @param index - setting index
+ *  @return true if the setting qualifies
+ */
+static bool IsQualified(const pwmSweep_t *sweep, uint8_t index);
+
+/** @brief Clear speed statistic of the measured setting
+ *  @param sweep - sweep handler
+ */
+static void ClearSamples(pwmSweep_t *sweep);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool PwmSweepInit(pwmSweep_t *sweep, const pwmSweepSetting_t *settings, uint8_t count)
+{
+    assert(sweep);
+    assert(settings);
+
+    memset(sweep, 0, sizeof(pwmSweep_t));
+
+    if ((count == 0) || (count > PWM_SWEEP_MAX_SETTINGS)) {
+        return false;
+    }
+
+    memcpy(sweep->settings, settings, count * sizeof(pwmSweepSetting_t));
+    sweep->count = count;
+    ClearSamples(sweep);
+
+    return true;
+}
+
+bool PwmSweepGetSetting(const pwmSweep_t *sweep, pwmSweepSetting_t *setting)
+{
+    assert(sweep);
+    assert(setting);
+
+    if (sweep->index >= sweep->count) {
+        return false;
+    }
+
+    *setting = sweep->settings[sweep->index];
+
+    return true;
+}
+
+void PwmSweepAddSample(pwmSweep_t *sweep, uint32_t milliSpeed)
+{
+    assert(sweep);
+
+    sweep->sumMilliSpeed += milliSpeed;
+    sweep->samples += 1;
+
+    if (milliSpeed < sweep->minMilliSpeed) {
+        sweep->minMilliSpeed = milliSpeed;
+    }
+
+    if (milliSpeed > sweep->maxMilliSpeed) {
+        sweep->maxMilliSpeed = milliSpeed;
+    }
+}
+
+bool PwmSweepNext(pwmSweep_t *sweep, bool isValid)
+{
+    assert(sweep);
+
+    if (sweep->index >= sweep->count) {
+        return false;
+    }
+
+    pwmSweepResult_t *result = &sweep->results[sweep->index];
+
+    result->isMeasured = false;
+    if (isValid && (sweep->samples != 0)) {
+        result->meanMilliSpeed = (uint32_t)(sweep->sumMilliSpeed / sweep->samples);
+        if (result->meanMilliSpeed != 0) {
+            uint64_t ripple = ((uint64_t)(sweep->maxMilliSpeed - sweep->minMilliSpeed) * 1000U) / result->meanMilliSpeed;
+            result->ripplePerMille = (ripple > UINT16_MAX) ? UINT16_MAX : (uint16_t)ripple;
+            result->isMeasured = true;
+        }
+    }
+
+    sweep->index += 1;
+    ClearSamples(sweep);
+
+    return sweep->index < sweep->count;
+}
+
+bool PwmSweepGetBest(const pwmSweep_t *sweep, pwmSweepSetting_t *setting)
+{
+    assert(sweep);
+    assert(setting);
+
+    uint16_t minRipple = UINT16_MAX;
+    bool isFound = false;
+
+    for (uint8_t idx = 0; idx < sweep->count; ++idx) {
+        if (IsQualified(sweep, idx) && (sweep->results[idx].ripplePerMille <= minRipple)) {
+            minRipple = sweep->results[idx].ripplePerMille;
+            isFound = true;
+        }
+    }
+
+    if (isFound == false) {
+        return false;
+    }
+
+    // the near steadiest settings are equal, the higher frequency is quieter and the finer resolution smoother
+    uint8_t bestIdx = sweep->count;
+    for (uint8_t idx = 0; idx < sweep->count; ++idx) {
+        if ((IsQualified(sweep, idx) == false) || (sweep->results[idx].ripplePerMille > (minRipple + PWM_SWEEP_RIPPLE_TIE_PER_MILLE))) {
+            continue;
+        }
+
+        if (bestIdx == sweep->count) {
+            bestIdx = idx;
+            continue;
+        }
+
+        const pwmSweepSetting_t *best = &sweep->settings[bestIdx];
+        const pwmSweepSetting_t *candidate = &sweep->settings[idx];
+        if ((candidate->freqHz > best->freqHz) ||
+            ((candidate->freqHz == best->freqHz) && (candidate->resolutionBits > best->resolutionBits))) {
+            bestIdx = idx;
+        }
+    }
+
+    *setting = sweep->settings[bestIdx];
+
+    return true;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static bool IsQualified(const pwmSweep_t *sweep, uint8_t index)
+{
+    const pwmSweepResult_t *reference = &sweep->results[0];
+    const pwmSweepResult_t *result = &sweep->results[index];
+
+    if ((reference->isMeasured == false) || (result->isMeasured == false)) {
+        return false;
+    }
+
+    uint32_t tolerance = reference->meanMilliSpeed >> PWM_SWEEP_SPEED_TOLERANCE_SHIFT;
+    uint32_t difference = (result->meanMilliSpeed > reference->meanMilliSpeed) ? (result->meanMilliSpeed - reference->meanMilliSpeed)
+                                                                                : (reference->meanMilliSpeed - result->meanMilliSpeed);
+
+    return difference <= tolerance;
+}
+
+static void ClearSamples(pwmSweep_t *sweep)
+{
+    sweep->sumMilliSpeed = 0;
+    sweep->minMilliSpeed = UINT32_MAX;
+    sweep->maxMilliSpeed = 0;
+    sweep->samples = 0;
+}
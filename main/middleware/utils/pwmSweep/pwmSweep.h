@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * @file pwmSweep.h
+ *
+ * @brief sweep of pwm frequency / resolution settings: speed ripple of each setting at the same duty
+ *        and selection of the steadiest one, the highest frequency of the near steadiest wins
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define PWM_SWEEP_MAX_SETTINGS (8U)
+#define PWM_SWEEP_SPEED_TOLERANCE_SHIFT (3U)    // mean speed within 1/8 of the first setting, the level pwm values stay valid
+#define PWM_SWEEP_RIPPLE_TIE_PER_MILLE (5U)     // ripple difference counted as equal
+
+typedef struct {
+    uint32_t freqHz;
+    uint8_t resolutionBits;
+} pwmSweepSetting_t;
+
+typedef struct {
+    uint32_t meanMilliSpeed;
+    uint16_t ripplePerMille;                    // (max - min) / mean speed
+    bool isMeasured;
+} pwmSweepResult_t;
+
+// the first setting is the reference, e.g. the one the level pwm values were set with
+typedef struct {
+    pwmSweepSetting_t settings[PWM_SWEEP_MAX_SETTINGS];
+    pwmSweepResult_t results[PWM_SWEEP_MAX_SETTINGS];
+    uint8_t count;
+    uint8_t index;
+    uint64_t sumMilliSpeed;
+    uint32_t minMilliSpeed;
+    uint32_t maxMilliSpeed;
+    uint16_t samples;
+} pwmSweep_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Start sweep
+ *  @param sweep - sweep handler
+ *  @param settings - settings to measure, copied
+ *  @param count - number of settings, 1 - PWM_SWEEP_MAX_SETTINGS
+ *  @return true if success
+ */
+bool PwmSweepInit(pwmSweep_t *sweep, const pwmSweepSetting_t *settings, uint8_t count);
+
+/** @brief Get setting to measure
+ *  @param sweep - sweep handler
+ *  @param setting [out] setting
+ *  @return false if all settings are done
+ */
+bool PwmSweepGetSetting(const pwmSweep_t *sweep, pwmSweepSetting_t *setting);
+
+/** @brief Add speed sample of the measured setting
+ *  @param sweep - sweep handler
+ *  @param milliSpeed - speed x 1000
+ */
+void PwmSweepAddSample(pwmSweep_t *sweep, uint32_t milliSpeed);
+
+/** @brief Close measurement of the setting and go to the next one
+ *  @param sweep - sweep handler
+ *  @param isValid - false if the setting could not be applied or measured
+ *  @return false if all settings are done
+ */
+bool PwmSweepNext(pwmSweep_t *sweep, bool isValid);
+
+/** @brief Get the steadiest setting running the fan at the reference speed
+ *  @param sweep - sweep handler
+ *  @param setting [out] selected setting
+ *  @return false if no setting qualifies
+ */
+bool PwmSweepGetBest(const pwmSweep_t *sweep, pwmSweepSetting_t *setting);
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * @file requestMetrics.c
+ *
+ * @brief request count, latency histogram and sent bytes of a single endpoint
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/requestMetrics/requestMetrics.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+void RequestMetricsInit(requestMetrics_t *metrics, const char *name)
+{
+    assert(metrics);
+
+    memset(metrics, 0, sizeof(requestMetrics_t));
+    metrics->name = name;
+}
+
+void RequestMetricsRecord(requestMetrics_t *metrics, uint32_t latencyUs, bool isError)
+{
+    assert(metrics);
+
+    metrics->count += 1;
+    metrics->latencySumUs += latencyUs;
+    metrics->buckets[RequestMetricsGetBucket(latencyUs)] += 1;
+
+    if (latencyUs > metrics->latencyMaxUs) {
+        metrics->latencyMaxUs = latencyUs;
+    }
+
+    if (isError) {
+        metrics->errors += 1;
+    }
+}
+
+void RequestMetricsAddBytes(requestMetrics_t *metrics, uint32_t bytes)
+{
+    assert(metrics);
+
+    metrics->bytesSent += bytes;
+}
+
+uint32_t RequestMetricsGetBucket(uint32_t latencyUs)
+{
+    uint32_t bucket = 0;
+    uint32_t bound = REQUEST_METRICS_FIRST_BUCKET_US;
+
+    while ((bucket < (REQUEST_METRICS_BUCKETS_COUNT - 1)) && (latencyUs >= bound)) {
+        bucket += 1;
+        bound <<= 1;
+    }
+
+    return bucket;
+}
+
+uint32_t RequestMetricsGetMeanUs(const requestMetrics_t *metrics)
+{
+    assert(metrics);
+
+    if (metrics->count == 0) {
+        return 0;
+    }
+
+    return (uint32_t)(metrics->latencySumUs / metrics->count);
+}
+
+uint32_t RequestMetricsGetPercentileUs(const requestMetrics_t *metrics, uint32_t percent)
+{
+    assert(metrics);
+
+    if (metrics->count == 0) {
+        return 0;
+    }
+
+    // rank of the request at the percentile, rounded up
+    uint32_t rank = (uint32_t)((((uint64_t)metrics->count * percent) + 99U) / 100U);
+    uint32_t total = 0;
+
+    for (uint32_t bucket = 0; bucket < (REQUEST_METRICS_BUCKETS_COUNT - 1); ++bucket) {
+        total += metrics->buckets[bucket];
+        if (total >= rank) {
+            uint32_t bound = REQUEST_METRICS_FIRST_BUCKET_US << bucket;
+            return (bound < metrics->latencyMaxUs) ? bound : metrics->latencyMaxUs;
+        }
+    }
+
+    return metrics->latencyMaxUs;
+}
+
+bool RequestMetricsFormat(const requestMetrics_t *metrics, char *buf, size_t bufSize, size_t *len)
+{
+    assert(metrics);
+    assert(buf);
+    assert(len);
+
+    int ret = snprintf(buf, bufSize, "%s %u %u %u %u %u %u ", (metrics->name != NULL) ? metrics->name : "-",
+                       (unsigned int)metrics->count, (unsigned int)metrics->errors, (unsigned int)metrics->bytesSent,
+                       (unsigned int)RequestMetricsGetMeanUs(metrics), (unsigned int)RequestMetricsGetPercentileUs(metrics, 95),
+                       (unsigned int)metrics->latencyMaxUs);
+
+    for (uint32_t bucket = 0; (bucket < REQUEST_METRICS_BUCKETS_COUNT) && (ret >= 0) && ((size_t)ret < bufSize); ++bucket) {
+        ret += snprintf(&buf[ret], bufSize - ret, (bucket == (REQUEST_METRICS_BUCKETS_COUNT - 1)) ? "%u\n" : "%u,",
+                        (unsigned int)metrics->buckets[bucket]);
+    }
+
+    if ((ret < 0) || ((size_t)ret >= bufSize)) {
+        *len = 0;
+        return false;
+    }
+
+    *len = (size_t)ret;
+
+    return true;
+}
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * @file requestMetrics.h
+ *
+ * @brief request count, latency histogram and sent bytes of a single endpoint
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+// bucket n counts latencies below (1 ms << n), the last one all longer
+#define REQUEST_METRICS_BUCKETS_COUNT (10U)
+#define REQUEST_METRICS_FIRST_BUCKET_US (1000U)
+
+typedef struct {
+    const char *name;
+    uint32_t count;
+    uint32_t errors;
+    uint32_t bytesSent;
+    uint32_t latencyMaxUs;
+    uint64_t latencySumUs;
+    uint32_t buckets[REQUEST_METRICS_BUCKETS_COUNT];
+} requestMetrics_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Clear metrics
+ *  @param metrics - metrics handler
+ *  @param name - endpoint name, must stay valid
+ */
+void RequestMetricsInit(requestMetrics_t *metrics, const char *name);
+
+/** @brief Record finished request
+ *  @param metrics - metrics handler
+ *  @param latencyUs - request handling time
+ *  @param isError - request failed
+ */
+void RequestMetricsRecord(requestMetrics_t *metrics, uint32_t latencyUs, bool isError);
+
+/** @brief Add bytes sent for the endpoint, also after the request is recorded (e.g. streamed files)
+ *  @param metrics - metrics handler
+ *  @param bytes - number of bytes sent
+ */
+void RequestMetricsAddBytes(requestMetrics_t *metrics, uint32_t bytes);
+
+/** @brief Get histogram bucket for the latency
+ *  @param latencyUs - request handling time
+ *  @return bucket index
+ */
+uint32_t RequestMetricsGetBucket(uint32_t latencyUs);
+
+/** @brief Get mean latency
+ *  @param metrics - metrics handler
+ *  @return mean latency in us, 0 if no request recorded
+ */
+uint32_t RequestMetricsGetMeanUs(const requestMetrics_t *metrics);
+
+/** @brief Get upper bound of the latency percentile from the histogram
+ *  @param metrics - metrics handler
+ *  @param percent - percentile 1-100
+ *  @return upper bound of the bucket holding the percentile in us, max latency for the last bucket; 0 if no request recorded
+ */
+uint32_t RequestMetricsGetPercentileUs(const requestMetrics_t *metrics, uint32_t percent);
+
+/** @brief Format metrics as a single text line: name count errors bytes mean_us p95_us max_us hist
+ *  @param metrics - metrics handler
+ *  @param buf - output buffer
+ *  @param bufSize - output buffer size
+ *  @param len [out] - formatted line length without null
+ *  @return true if the line fits in the buffer
+ */
+bool RequestMetricsFormat(const requestMetrics_t *metrics, char *buf, size_t bufSize, size_t *len);
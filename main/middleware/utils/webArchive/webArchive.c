@@ -0,0 +1,173 @@
+/*****************************************************************************
+ * @file webArchive.c
+ *
+ * @brief read-only archive of web assets: sorted name table followed by
+ *        file data, designed to be used directly from memory mapped flash
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/webArchive/webArchive.h"
+
+#include <string.h>
+#include <assert.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define CRC32_POLYNOMIAL (0xEDB88320U)
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Calculate crc32, same as zlib.crc32
+ *  @param data - data
+ *  @param size - data size
+ *  @return crc32
+ */
+static uint32_t Crc32(const uint8_t *data, uint32_t size);
+
+/** @brief Check if entry name is terminated and data fits in the archive
+ *  @param archive - archive handler
+ *  @param entry - entry to check
+ *  @return true - if entry is correct
+ */
+static bool IsEntryValid(const webArchive_t *archive, const webArchiveEntry_t *entry);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool WebArchiveCheckHeader(const webArchiveHeader_t *header, uint32_t maxSize)
+{
+    assert(header);
+
+    if ((header->magic != WEB_ARCHIVE_MAGIC) || (header->version != WEB_ARCHIVE_VERSION)) {
+        return false;
+    }
+
+    uint32_t tableEnd = sizeof(webArchiveHeader_t) + ((uint32_t)header->entriesCount * sizeof(webArchiveEntry_t));
+
+    return ((header->size >= tableEnd) && (header->size <= maxSize));
+}
+
+bool WebArchiveOpen(webArchive_t *archive, const uint8_t *data, uint32_t dataSize, bool checkCrc)
+{
+    assert(archive);
+
+    memset(archive, 0, sizeof(webArchive_t));
+
+    if ((data == NULL) || (dataSize < sizeof(webArchiveHeader_t))) {
+        return false;
+    }
+
+    webArchiveHeader_t header;
+    memcpy(&header, data, sizeof(webArchiveHeader_t));
+
+    if (WebArchiveCheckHeader(&header, dataSize) == false) {
+        return false;
+    }
+
+    if (checkCrc && (Crc32(&data[sizeof(webArchiveHeader_t)], header.size - sizeof(webArchiveHeader_t)) != header.crc)) {
+        return false;
+    }
+
+    archive->data = data;
+    archive->size = header.size;
+    archive->entries = (const webArchiveEntry_t *)&data[sizeof(webArchiveHeader_t)];
+    archive->entriesCount = header.entriesCount;
+    archive->crc = header.crc;
+    archive->baseCrc = header.baseCrc;
+
+    // binary search relies on strictly sorted names
+    for (uint16_t idx = 0; idx < archive->entriesCount; ++idx) {
+        if ((IsEntryValid(archive, &archive->entries[idx]) == false) ||
+            ((idx > 0) && (strcmp(archive->entries[idx - 1].name, archive->entries[idx].name) >= 0))) {
+            memset(archive, 0, sizeof(webArchive_t));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void WebArchiveClose(webArchive_t *archive)
+{
+    assert(archive);
+
+    memset(archive, 0, sizeof(webArchive_t));
+}
+
+bool WebArchiveIsBundleOf(const webArchive_t *bundle, const webArchive_t *base)
+{
+    assert(bundle);
+    assert(base);
+
+    return (bundle->entries != NULL) && (base->entries != NULL) && (bundle->baseCrc != 0) && (bundle->baseCrc == base->crc);
+}
+
+bool WebArchiveFind(const webArchive_t *archive, const char *name, webArchiveFile_t *file)
+{
+    assert(archive);
+    assert(name);
+    assert(file);
+
+    uint32_t low = 0;
+    uint32_t high = archive->entriesCount;
+
+    while (low < high) {
+        uint32_t mid = low + ((high - low) / 2U);
+        const webArchiveEntry_t *entry = &archive->entries[mid];
+
+        int cmp = strcmp(name, entry->name);
+        if (cmp == 0) {
+            file->data = &archive->data[entry->offset];
+            file->size = entry->size;
+            file->hash = entry->hash;
+            return true;
+        }
+
+        if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1U;
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static uint32_t Crc32(const uint8_t *data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for (uint32_t idx = 0; idx < size; ++idx) {
+        crc ^= data[idx];
+        for (uint8_t bit = 0; bit < 8U; ++bit) {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0U - (crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
+
+static bool IsEntryValid(const webArchive_t *archive, const webArchiveEntry_t *entry)
+{
+    if (memchr(entry->name, '\0', WEB_ARCHIVE_NAME_MAX_LEN) == NULL) {
+        return false;
+    }
+
+    uint32_t dataStart = sizeof(webArchiveHeader_t) + ((uint32_t)archive->entriesCount * sizeof(webArchiveEntry_t));
+
+    return ((entry->offset >= dataStart) && (entry->offset <= archive->size) && (entry->size <= (archive->size - entry->offset)));
+}
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * @file webArchive.h
+ *
+ * @brief read-only archive of web assets: sorted name table followed by
+ *        file data, designed to be used directly from memory mapped flash
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+#define WEB_ARCHIVE_MAGIC (0x41575757U)         // "WWWA"
+#define WEB_ARCHIVE_VERSION (2U)
+#define WEB_ARCHIVE_NAME_MAX_LEN (48U)          // including terminating zero
+
+// Layout (little endian), created by webServer/tools/packWebAssets.py:
+// header | entries sorted by name | file data aligned to 4 bytes
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entriesCount;
+    uint32_t size;                              // whole archive size
+    uint32_t crc;                               // crc32 of everything after the header
+    uint32_t baseCrc;                           // crc of the base archive a bundle is built on, 0 for a base archive
+} __attribute__ ((packed)) webArchiveHeader_t;
+
+typedef struct {
+    char name[WEB_ARCHIVE_NAME_MAX_LEN];        // absolute path: /index.html
+    uint32_t offset;                            // from the archive start
+    uint32_t size;
+    uint32_t hash;                              // crc32 of the file data
+    uint32_t reserved;
+} __attribute__ ((packed)) webArchiveEntry_t;
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    const webArchiveEntry_t *entries;
+    uint16_t entriesCount;
+    uint32_t crc;
+    uint32_t baseCrc;
+} webArchive_t;
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t hash;
+} webArchiveFile_t;
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Check archive header
+ *  @param header - archive header
+ *  @param maxSize - maximum archive size, e.g. partition size
+ *  @return true - if header is correct
+ */
+bool WebArchiveCheckHeader(const webArchiveHeader_t *header, uint32_t maxSize);
+
+/** @brief Open archive, the name table is validated, data is not copied
+ *  @param archive - archive handler
+ *  @param data - archive data, must stay valid until archive is closed
+ *  @param dataSize - available data size
+ *  @param checkCrc - verify crc of the whole archive
+ *  @return true - if archive is correct
+ */
+bool WebArchiveOpen(webArchive_t *archive, const uint8_t *data, uint32_t dataSize, bool checkCrc);
+
+/** @brief Close archive
+ *  @param archive - archive handler
+ */
+void WebArchiveClose(webArchive_t *archive);
+
+/** @brief Check bundle of changed files was built on the base archive
+ *  @param bundle - opened bundle archive
+ *  @param base - opened base archive
+ *  @return true - if files of the bundle can be served over the base archive
+ */
+bool WebArchiveIsBundleOf(const webArchive_t *bundle, const webArchive_t *base);
+
+/** @brief Find file by binary search in the name table
+ *  @param archive - archive handler
+ *  @param name - absolute file path
+ *  @param file [out] - file data, points into archive data
+ *  @return true - if file found
+ */
+bool WebArchiveFind(const webArchive_t *archive, const char *name, webArchiveFile_t *file);
@@ -17,7 +17,7 @@
 #include "setting.h"
 
 #include "freertos/FreeRTOS.h"
-#include "freertos/timers.h"
+#include "freertos/task.h"
 #include "freertos/semphr.h"
 
 #include "esp_log.h"
@@ -27,7 +27,7 @@
 #include "factorySettingsDriver/factorySettingsDriver.h"
 #include "timeDriver/timeDriver.h"
 
-#include "utils/meanFilter/meanFilter.h"
+#include "utils/dspFilter/dspFilter.h"
 
 #include "uvLamp.h"
 
@@ -35,9 +35,13 @@
                           PRIVATE DEFINES / MACROS
  *****************************************************************************/
 
-#define TIMER_PERIOD_MS (1U * 1000U)
+// the adc oversamples the ballast voltage between the task reads
+#define SAMPLE_PERIOD_MS (10U)
 #define MUTEX_TIMEOUT_MS (1U * 1000U)
 
+#define UV_LAMP_TASK_STACK_SIZE (3U * 1024U)
+#define UV_LAMP_TASK_PRIORITY (4U)                  // above device manager, keeps the 10 ms period
+
 #define TIME_NEEDED_TO_STABILIZE_MEASUREMENT (90U * 1000U)
 
 #define LAMP_ON_DELAY_TIMIE_MS (CFG_UV_LAMP_ON_DELAY_TIMIE_SEC * 1000U)
@@ -48,7 +52,10 @@
     #define UV_LAMP_ECO_MODE_SWITCH_TIMIE_MS ((2U * 60U) * 1000U)                             // 2 minute
 #endif
 
-#define MEAN_BUFFER_SIZE (32U)
+// mean of the last 80 ms, a status has to last 50 ms to be taken
+#define MEAN_BUFFER_SIZE (8U)
+#define STATUS_CONFIRM_MS (50U)
+#define STATUS_CONFIRM_TICKS (STATUS_CONFIRM_MS / SAMPLE_PERIOD_MS)
 
 /*****************************************************************************
                      PRIVATE STRUCTS / ENUMS / VARIABLES
@@ -61,17 +68,24 @@ static uint32_t sOnMinInMiliVolt;
 static uint32_t sOnMaxInMiliVolt;
 
 static const char* TAG = "uvLamp";
-static const char* sTimerName = "uvLampTimer";
-
-static TimerHandle_t sTimerHandler;
-static SemaphoreHandle_t sUvLampTimerMutex;
+static TaskHandle_t sTaskHandle;
+static SemaphoreHandle_t sUvLampMutex;
 
-static meanFilter_t sFilterUvLamp1;
-static meanFilter_t sFilterUvLamp2;
+DSP_BOXCAR_DEFINE(sFilterUvLamp1, MEAN_BUFFER_SIZE);
+DSP_BOXCAR_DEFINE(sFilterUvLamp2, MEAN_BUFFER_SIZE);
 
 static uint32_t sMeanVoltageUvLamp1;
 static uint32_t sMeanVoltageUvLamp2;
 
+typedef struct{
+    uvLampStatus_t status;
+    uvLampStatus_t candidate;
+    uint32_t candidateTicks;
+    int64_t changeTime;
+}UvLampStatusFilter_t;
+
+static UvLampStatusFilter_t sStatusUvLamp[UV_LAMP_COUNT];
+
 static int64_t sUvLampBallastStabilizationTime;
 static int64_t sUvLampDelayTime;
 static int64_t sUvLampNextEcoModeSwitchTime;
@@ -85,15 +99,15 @@ static int64_t sUvLampNextEcoModeSwitchTime;
  */
 static uvLampNumber_t WhichLampWornOutMost(void);
 
-/** @brief Calback function. Call when the timer expires
- *  @param pxTimer pointer to TimerHandle_t
+/** @brief Uv lamp task, reads and filters the ballast voltage every SAMPLE_PERIOD_MS
+ *  @param arg unused
  */
-static void vUvLampTimerCallback(TimerHandle_t pxTimer);
+static void UvLampTask(void* arg);
 
-/** @brief Free Rtos timer init and start
+/** @brief Free Rtos task init and start
  *  @return return true if success
  */
-static bool InitTimer(void);
+static bool InitTask(void);
 
 /** @brief Calculate min, max for uv lamp on off depending on the voltage
  *  @return return true if success
@@ -105,6 +119,19 @@ static bool SetMinMaxVoltageLevels(void);
  */
 static bool InitMeanStruct(void);
 
+/** @brief Get ballast status of the voltage
+ *  @param miliVoltage ballast voltage
+ *  @return status
+ */
+static uvLampStatus_t GetStatusFromVoltage(uint32_t miliVoltage);
+
+/** @brief Take the ballast status when it lasts STATUS_CONFIRM_MS, the mutex has to be taken
+ *  @param lampNumber uv lamp number
+ *  @param miliVoltage mean ballast voltage
+ *  @return return true if the status was taken now
+ */
+static bool UpdateStatus(uvLampNumber_t lampNumber, uint32_t miliVoltage);
+
 /*****************************************************************************
                            INTERFACE IMPLEMENTATION
 *****************************************************************************/
@@ -116,7 +143,7 @@ bool UvLampInit(void)
     res &= UvLampDriverInit();
     res &= SetMinMaxVoltageLevels();
     res &= InitMeanStruct();
-    res &= InitTimer();
+    res &= InitTask();
 
     return res;
 }
@@ -244,17 +271,16 @@ uvLampStatus_t UvLampDriverGetUvLampStatus(uvLampNumber_t lampNumber)
             return UV_LAMP_STATUS_UNKNOWN;
     }
 
-    uint32_t miliVoltage = UvLampGetMeanMiliVolt(lampNumber);
+    uvLampStatus_t status = UV_LAMP_STATUS_UNKNOWN;
 
-    if((miliVoltage >= sOffMinInMiliVolt) && (miliVoltage <= sOffMaxInMiliVolt)){
-        return UV_LAMP_STATUS_OFF;
-    }
+    if (xSemaphoreTake(sUvLampMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
+    {
+        status = sStatusUvLamp[lampNumber].status;
 
-    if((miliVoltage >= sOnMinInMiliVolt) && (miliVoltage <= sOnMaxInMiliVolt)){
-        return UV_LAMP_STATUS_ON;
+        xSemaphoreGive(sUvLampMutex);
     }
- 
-    return UV_LAMP_STATUS_ERROR;
+
+    return status;
 }
 
 void UvLampEmergencyOff(void)
@@ -273,7 +299,7 @@ uint32_t UvLampGetMeanMiliVolt(uvLampNumber_t lampNumber)
         return miliVoltage;
     }
 
-    if (xSemaphoreTake(sUvLampTimerMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
+    if (xSemaphoreTake(sUvLampMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
     {
         if(lampNumber == UV_LAMP_1){
             miliVoltage = sMeanVoltageUvLamp1;
@@ -282,7 +308,7 @@ uint32_t UvLampGetMeanMiliVolt(uvLampNumber_t lampNumber)
             miliVoltage = sMeanVoltageUvLamp2;
         }
 
-        xSemaphoreGive(sUvLampTimerMutex);
+        xSemaphoreGive(sUvLampMutex);
     }
 
     return miliVoltage;
@@ -313,41 +339,59 @@ static uvLampNumber_t WhichLampWornOutMost(void)
     return lampNumber;
 }
 
-static void vUvLampTimerCallback(TimerHandle_t pxTimer)
+static void UvLampTask(void* arg)
 {
-    if (xSemaphoreTake(sUvLampTimerMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
-    {
-        float voltage = AdcDriverGetMilliVoltageData(ADC_DRIVER_CHANNEL_UV_1);
-        sMeanVoltageUvLamp1 = MeanFilterFilterData(&sFilterUvLamp1, (uint32_t)voltage);
-        
-        xSemaphoreGive(sUvLampTimerMutex);        
-    }
+    (void)arg;
 
-    if (xSemaphoreTake(sUvLampTimerMutex, MUTEX_TIMEOUT_MS) == pdTRUE)
-    {
-        float voltage = AdcDriverGetMilliVoltageData(ADC_DRIVER_CHANNEL_UV_2);
-        sMeanVoltageUvLamp2 = MeanFilterFilterData(&sFilterUvLamp2, (uint32_t)voltage);
+    TickType_t wakeTime = xTaskGetTickCount();
 
-        xSemaphoreGive(sUvLampTimerMutex);
+    while(1){
+        vTaskDelayUntil(&wakeTime, SAMPLE_PERIOD_MS / portTICK_RATE_MS);
+
+        AdcDriverSample_t sample = {};
+        if(AdcDriverReadSample(&sample) == false){
+            continue;
+        }
+
+        if (xSemaphoreTake(sUvLampMutex, MUTEX_TIMEOUT_MS) != pdTRUE)
+        {
+            continue;
+        }
+
+        sMeanVoltageUvLamp1 = DspBoxcarFilter(&sFilterUvLamp1, sample.milliVolt[ADC_DRIVER_CHANNEL_UV_1]);
+        sMeanVoltageUvLamp2 = DspBoxcarFilter(&sFilterUvLamp2, sample.milliVolt[ADC_DRIVER_CHANNEL_UV_2]);
+
+        uint32_t miliVoltage[UV_LAMP_COUNT] = {[UV_LAMP_1] = sMeanVoltageUvLamp1, [UV_LAMP_2] = sMeanVoltageUvLamp2};
+        UvLampStatusFilter_t taken[UV_LAMP_COUNT] = {};
+        bool isTaken[UV_LAMP_COUNT] = {};
+
+        for(uint16_t idx = 0; idx < UV_LAMP_COUNT; ++idx){
+            isTaken[idx] = UpdateStatus(idx, miliVoltage[idx]);
+            taken[idx] = sStatusUvLamp[idx];
+        }
+
+        xSemaphoreGive(sUvLampMutex);
+
+        // logged after the mutex is given, the status readers don't wait for the uart
+        for(uint16_t idx = 0; idx < UV_LAMP_COUNT; ++idx){
+            if(isTaken[idx] == true){
+                ESP_LOGI(TAG, "ballast %d status %d, %u [mV], taken in %lld ms", (idx + 1), taken[idx].status, miliVoltage[idx],
+                    (TimeDriverGetSystemTickMs() - taken[idx].changeTime));
+            }
+        }
     }
 }
 
-static bool InitTimer(void)
+static bool InitTask(void)
 {
-    sUvLampTimerMutex = xSemaphoreCreateMutex();
-    if (sUvLampTimerMutex == NULL) {
+    sUvLampMutex = xSemaphoreCreateMutex();
+    if (sUvLampMutex == NULL) {
         ESP_LOGE(TAG, "Mutex Fail");
         return false;
     }
 
-    sTimerHandler = xTimerCreate(sTimerName, TIMER_PERIOD_MS, pdTRUE, (void *) 0, vUvLampTimerCallback);
-    if(sTimerHandler == NULL){
-        ESP_LOGE(TAG, "Can't allocate heap");
-        return false;
-    }
-
-    if(xTimerStart(sTimerHandler, 0) != pdPASS){
-        ESP_LOGE(TAG, "Start Timer Fail");
+    if(xTaskCreate(UvLampTask, "UvLampTask", UV_LAMP_TASK_STACK_SIZE, NULL, UV_LAMP_TASK_PRIORITY, &sTaskHandle) != pdPASS){
+        ESP_LOGE(TAG, "Task Fail");
         return false;
     }
     return true;
@@ -372,11 +416,41 @@ static bool SetMinMaxVoltageLevels(void)
 }
 
 static bool InitMeanStruct(void)
-{   
-    bool res = true;
+{
+    DspBoxcarReset(&sFilterUvLamp1);
+    DspBoxcarReset(&sFilterUvLamp2);
 
-    res &= MeanFilterInit(&sFilterUvLamp1, MEAN_BUFFER_SIZE);
-    res &= MeanFilterInit(&sFilterUvLamp2, MEAN_BUFFER_SIZE);
+    return true;
+}
 
-    return res;
-}
\ No newline at end of file
+static uvLampStatus_t GetStatusFromVoltage(uint32_t miliVoltage)
+{
+    if((miliVoltage >= sOffMinInMiliVolt) && (miliVoltage <= sOffMaxInMiliVolt)){
+        return UV_LAMP_STATUS_OFF;
+    }
+
+    if((miliVoltage >= sOnMinInMiliVolt) && (miliVoltage <= sOnMaxInMiliVolt)){
+        return UV_LAMP_STATUS_ON;
+    }
+
+    return UV_LAMP_STATUS_ERROR;
+}
+
+static bool UpdateStatus(uvLampNumber_t lampNumber, uint32_t miliVoltage)
+{
+    UvLampStatusFilter_t* filter = &sStatusUvLamp[lampNumber];
+    uvLampStatus_t status = GetStatusFromVoltage(miliVoltage);
+
+    if(status != filter->candidate){
+        filter->candidate = status;
+        filter->candidateTicks = 0;
+        filter->changeTime = TimeDriverGetSystemTickMs();
+    }
+
+    if((filter->candidate == filter->status) || (++filter->candidateTicks < STATUS_CONFIRM_TICKS)){
+        return false;
+    }
+
+    filter->status = filter->candidate;
+    return true;
+}
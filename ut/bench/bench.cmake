@@ -0,0 +1,8 @@
+# Host micro-benchmarks of the utils, run by hand: ./dspFilter-bench
+# Built without coverage instrumentation and optimized, the numbers are relative only.
+
+add_executable(dspFilter-bench bench/dspFilterBench.c)
+
+target_include_directories(dspFilter-bench PRIVATE ${UT_INCLUDE_SRC_DIRECTORIES})
+target_compile_options(dspFilter-bench PRIVATE -O2 -fno-profile-arcs -fno-test-coverage)
+target_link_libraries(dspFilter-bench m)
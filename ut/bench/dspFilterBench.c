@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * @file dspFilterBench.c
+ *
+ * @brief host micro-benchmark of the dspFilter filters, ns per sample
+ *
+ * @author matfio
+ * @date 18.10.2026
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ ****************************************************************************/
+
+#include "utils/dspFilter/dspFilter.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define SAMPLES_COUNT (4096U)
+#define ROUNDS (2000U)
+#define WINDOW_SIZE (8U)
+#define MEDIAN_SIZE (9U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+static int32_t sSamples[SAMPLES_COUNT];
+static volatile int64_t sSink;
+
+DSP_BOXCAR_DEFINE(sBoxcar, WINDOW_SIZE);
+DSP_MEDIAN_DEFINE(sMedian, MEDIAN_SIZE);
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Get monotonic time
+ *  @return time in ns
+ */
+static int64_t GetTimeNs(void);
+
+/** @brief Print result of one filter
+ *  @param name - filter name
+ *  @param startNs - start time
+ *  @param sum - sum of the outputs, keeps the loop alive
+ */
+static void Report(const char *name, int64_t startNs, int64_t sum);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+int main(void)
+{
+    uint32_t seed = 12345U;
+    for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+        seed = seed * 1103515245U + 12345U;
+        sSamples[idx] = 2000 + (int32_t)((seed >> 16) & 0x3FFU);
+    }
+
+    printf("%-16s %10s\n", "filter", "ns/sample");
+
+    int64_t sum = 0;
+    int64_t start = GetTimeNs();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+            sum += DspBoxcarFilter(&sBoxcar, (uint32_t)sSamples[idx]);
+        }
+    }
+    Report("DspBoxcar", start, sum);
+
+    dspEma_t ema = DSP_EMA_INIT(3);
+    sum = 0;
+    start = GetTimeNs();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+            sum += DspEmaFilter(&ema, sSamples[idx]);
+        }
+    }
+    Report("DspEma", start, sum);
+
+    sum = 0;
+    start = GetTimeNs();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+            sum += DspMedianFilter(&sMedian, sSamples[idx]);
+        }
+    }
+    Report("DspMedian9", start, sum);
+
+    dspBiquadCoef_t coef = {};
+    dspBiquadQ14_t biquad14 = {};
+    dspBiquadQ30_t biquad30 = {};
+    DspBiquadDesignLowPass(&coef, 10.0f, 1000.0f);
+    DspBiquadQ14Init(&biquad14, &coef);
+    DspBiquadQ30Init(&biquad30, &coef);
+
+    sum = 0;
+    start = GetTimeNs();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+            sum += DspBiquadQ14Filter(&biquad14, (int16_t)sSamples[idx]);
+        }
+    }
+    Report("DspBiquadQ14", start, sum);
+
+    sum = 0;
+    start = GetTimeNs();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+            sum += DspBiquadQ30Filter(&biquad30, sSamples[idx] << 16);
+        }
+    }
+    Report("DspBiquadQ30", start, sum);
+
+    dspHysteresis_t hysteresis = DSP_HYSTERESIS_INIT(2300, 2700);
+    sum = 0;
+    start = GetTimeNs();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (uint32_t idx = 0; idx < SAMPLES_COUNT; ++idx) {
+            sum += DspHysteresisUpdate(&hysteresis, sSamples[idx]);
+        }
+    }
+    Report("DspHysteresis", start, sum);
+
+    return 0;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static int64_t GetTimeNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void Report(const char *name, int64_t startNs, int64_t sum)
+{
+    int64_t elapsedNs = GetTimeNs() - startNs;
+    sSink = sum;
+
+    printf("%-16s %10.2f\n", name, (double)elapsedNs / ((double)SAMPLES_COUNT * ROUNDS));
+}
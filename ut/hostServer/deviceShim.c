@@ -0,0 +1,406 @@
+/**
+ * @file deviceShim.c
+ *
+ * @brief host web server build: fakes of the device drivers and middleware used by the web server,
+ *        settings are kept in memory and lost on exit
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include <pthread.h>
+
+#include "config.h"
+#include "setting.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_partition.h"
+#include "device/alarmHandling.h"
+#include "factorySettingsDriver/factorySettingsDriver.h"
+#include "fan/fan.h"
+#include "mcuDriver/mcuDriver.h"
+#include "nvsDriver/nvsDriver.h"
+#include "ota/ota.h"
+#include "rtcDriver/rtcDriver.h"
+#include "timeDriver/timeDriver.h"
+#include "timerDriver/timerDriver.h"
+#include "touch/touch.h"
+#include "uvLamp/uvLamp.h"
+#include "wifi/wifi.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define NVS_MAX_KEYS            (16U)
+#define NVS_KEY_MAX_LEN         (16U)
+#define DEVICE_NAME_STRING_LEN  (CFG_WIFI_AP_SSID_STRING_LEN)
+#define LOCAL_TIME_STRING_LEN   (32U)
+#define OTA_DRAIN_BUF_LEN       (1024U)
+
+#define HOST_DEVICE_NAME          "iCON-host"
+#define HOST_HARDWARE_VERSION     "host"
+#define HOST_SERVICE_PASSWORD     "service"
+#define HOST_DIAGNOSTIC_PASSWORD  "diagnostic"
+#define HOST_FAN_REVOLUTIONS      (42)
+#define HOST_UV_LAMP_MILIVOLT     (1200U)
+#define HOST_TOUCH_THRESHOLD      (0x40U)
+#define HOST_HEPA_LOAD_PERCENT    (25U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef struct {
+    char key[NVS_KEY_MAX_LEN];
+    void *value;
+    uint16_t len;
+} nvsEntry_t;
+
+static const char *TAG = "deviceShim";
+
+static nvsEntry_t sNvs[NVS_MAX_KEYS];
+static pthread_mutex_t sNvsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static char sDeviceName[DEVICE_NAME_STRING_LEN + 1] = HOST_DEVICE_NAME;
+
+static const uint32_t sServiceParams[FACTORY_SETTING_SERVICE_COUNT] = {
+    [FACTORY_SETTING_SERVICE_HEPA_LIFETIME_HOURS] =     CFG_HEPA_SERVICE_LIFETIME_HOURS,
+    [FACTORY_SETTING_SERVICE_HEPA_WARNING_HOURS] =      CFG_HEPA_SERVICE_REPLACEMENT_REMINDER,
+    [FACTORY_SETTING_SERVICE_UV_LIFETIME_HOURS] =       CFG_UV_LAMP_SERVICE_LIFETIME_HOURS,
+    [FACTORY_SETTING_SERVICE_UV_WARNING_HOURS] =        CFG_UV_LAMP_SERVICE_REPLACEMENT_REMINDER,
+    [FACTORY_SETTING_SERVICE_UV_OFF_MIN_MILIVOLT] =     CFG_UV_LAMP_BALAST_OFF_MIN_VOLT_LEVEL,
+    [FACTORY_SETTING_SERVICE_UV_OFF_MAX_MILIVOLT] =     CFG_UV_LAMP_BALAST_OFF_MAX_VOLT_LEVEL,
+    [FACTORY_SETTING_SERVICE_UV_ON_MIN_MILIVOLT] =      CFG_UV_LAMP_BALAST_ON_MIN_VOLT_LEVEL,
+    [FACTORY_SETTING_SERVICE_UV_ON_MAX_MILIVOLT] =      CFG_UV_LAMP_BALAST_ON_MAX_VOLT_LEVEL,
+    [FACTORY_SETTING_SERVICE_LOGO_LED_COLOR] =          CFG_TOUCH_DEFAULT_LOGO_COLOR,
+    [FACTORY_SETTING_SERVICE_CLOUD_PORT] =              CFG_HTTP_CLIENT_PORT_NUMBER,
+};
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Read and drop the request body
+ *  @param req http request
+ */
+static void DrainRequestBody(httpd_req_t *req);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+bool NvsDriverSave(char *key, void *outValue, uint16_t valueLen)
+{
+    bool res = false;
+
+    pthread_mutex_lock(&sNvsMutex);
+
+    nvsEntry_t *freeEntry = NULL;
+    for (uint8_t idx = 0; idx < NVS_MAX_KEYS; ++idx) {
+        if ((sNvs[idx].value != NULL) && (strcmp(sNvs[idx].key, key) == 0)) {
+            free(sNvs[idx].value);
+            sNvs[idx].value = NULL;
+        }
+
+        if ((freeEntry == NULL) && (sNvs[idx].value == NULL)) {
+            freeEntry = &sNvs[idx];
+        }
+    }
+
+    if (freeEntry != NULL) {
+        freeEntry->value = malloc(valueLen);
+        if (freeEntry->value != NULL) {
+            snprintf(freeEntry->key, sizeof(freeEntry->key), "%s", key);
+            memcpy(freeEntry->value, outValue, valueLen);
+            freeEntry->len = valueLen;
+            res = true;
+        }
+    }
+
+    pthread_mutex_unlock(&sNvsMutex);
+
+    return res;
+}
+
+bool NvsDriverLoad(char *key, void *inValue, uint16_t* valueLen)
+{
+    bool res = false;
+
+    pthread_mutex_lock(&sNvsMutex);
+
+    for (uint8_t idx = 0; idx < NVS_MAX_KEYS; ++idx) {
+        if ((sNvs[idx].value != NULL) && (strcmp(sNvs[idx].key, key) == 0)) {
+            // mismatched size is reported as on the device, the caller stores defaults again
+            if (sNvs[idx].len <= *valueLen) {
+                memcpy(inValue, sNvs[idx].value, sNvs[idx].len);
+            }
+            *valueLen = sNvs[idx].len;
+            res = true;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&sNvsMutex);
+
+    return res;
+}
+
+char* FactorySettingsGetDevceName(void)
+{
+    return sDeviceName;
+}
+
+bool FactorySettingsSetDevceName(char* newDeviceName)
+{
+    if (strlen(newDeviceName) > DEVICE_NAME_STRING_LEN) {
+        return false;
+    }
+
+    snprintf(sDeviceName, sizeof(sDeviceName), "%s", newDeviceName);
+
+    return true;
+}
+
+char* FactorySettingsGetHardwareVersion(void)
+{
+    static char sHardwareVersion[] = HOST_HARDWARE_VERSION;
+
+    return sHardwareVersion;
+}
+
+bool FactorySettingsGetScheduler(Scheduler_t* scheduler)
+{
+    // as with disabled factory partition
+    memset(scheduler, 0, sizeof(Scheduler_t));
+
+    return true;
+}
+
+bool FactorySettingsGetServiceParam(FactorySettingServiceParam_t serviceParam, uint32_t* serviceValue)
+{
+    if (serviceParam >= FACTORY_SETTING_SERVICE_COUNT) {
+        return false;
+    }
+
+    *serviceValue = sServiceParams[serviceParam];
+
+    return true;
+}
+
+char* FactorySettingsGetServicePassword(void)
+{
+    static char sServicePassword[] = HOST_SERVICE_PASSWORD;
+
+    return sServicePassword;
+}
+
+char* FactorySettingsGetDiagnosticPassword(void)
+{
+    static char sDiagnosticPassword[] = HOST_DIAGNOSTIC_PASSWORD;
+
+    return sDiagnosticPassword;
+}
+
+bool AlarmHandlingTimersWornOutCheck(SettingDevice_t* setting)
+{
+    (void)setting;
+
+    return false;
+}
+
+FanTachoState_t FanGetTachoRevolutionsPerSecond(int16_t* revolutions)
+{
+    SettingDevice_t setting = {};
+    SettingGet(&setting);
+
+    if (setting.restore.deviceStatus.isDeviceOn == false) {
+        *revolutions = 0;
+        return FAN_TACHO_DEVICE_OFF;
+    }
+
+    *revolutions = HOST_FAN_REVOLUTIONS;
+
+    return FAN_TACHO_WORKS;
+}
+
+bool FanGetFilterLoad(FanFilterLoad_t* filterLoad)
+{
+    filterLoad->isEstimated = true;
+    filterLoad->loadPercent = HOST_HEPA_LOAD_PERCENT;
+    filterLoad->dutyChangePercent = (int16_t)(HOST_HEPA_LOAD_PERCENT * CFG_HEPA_CLOGGED_FAN_DUTY_CHANGE_PERCENT / 100);
+    filterLoad->samples = 64;
+
+    return true;
+}
+
+uint32_t UvLampGetMeanMiliVolt(uvLampNumber_t lampNumber)
+{
+    (void)lampNumber;
+
+    return HOST_UV_LAMP_MILIVOLT;
+}
+
+bool TouchGetStats(TouchStats_t* stats)
+{
+    memset(stats, 0, sizeof(TouchStats_t));
+
+    for (uint8_t idx = 0; idx < CFG_TOUCH_BUTTON_NAME_COUNT; ++idx) {
+        stats->button[idx].threshold = HOST_TOUCH_THRESHOLD;
+    }
+
+    return true;
+}
+
+void McuDriverDeviceSafeRestart(void)
+{
+    esp_restart();
+}
+
+esp_err_t OtaUploadByWebserver(httpd_req_t* req)
+{
+    ESP_LOGW(TAG, "firmware upload is not supported on host, %u bytes dropped", (unsigned int)req->content_len);
+    DrainRequestBody(req);
+
+    return ESP_FAIL;
+}
+
+esp_err_t OtaUploadWebAssetsByWebserver(httpd_req_t* req)
+{
+    ESP_LOGW(TAG, "web assets upload is not supported on host, %u bytes dropped", (unsigned int)req->content_len);
+    DrainRequestBody(req);
+
+    return ESP_FAIL;
+}
+
+bool OtaIsWebAssetsValid(void)
+{
+    // staging image is used when it is present in the partition directory
+    return esp_partition_find_first(ESP_PARTITION_TYPE_DATA, CFG_WEB_ASSETS_PARTITION_SUBTYPE, CFG_WEB_ASSETS_OTA_PARTITION_LABEL) != NULL;
+}
+
+bool OtaWebAssetsInvalidate(void)
+{
+    return true;
+}
+
+bool RtcDriverSetDateTime(struct tm *time)
+{
+    (void)time;
+
+    return true;
+}
+
+bool RtcDriverGetDateTime(struct tm *time)
+{
+    time_t now = (time_t)TimeDriverGetUTCUnixTime();
+    gmtime_r(&now, time);
+
+    return true;
+}
+
+bool RtcDriverIsError(void)
+{
+    return false;
+}
+
+uint32_t TimeDriverGetUTCUnixTime(void)
+{
+    return (uint32_t)time(NULL);
+}
+
+uint32_t TimeDriverGetLocalUnixTime(void)
+{
+    time_t now = time(NULL);
+    struct tm local = {};
+    localtime_r(&now, &local);
+
+    return (uint32_t)(now + local.tm_gmtoff);
+}
+
+struct tm* TimeDriverGetLocalTime(void)
+{
+    static struct tm sLocalTime;
+
+    time_t now = time(NULL);
+    localtime_r(&now, &sLocalTime);
+
+    return &sLocalTime;
+}
+
+int64_t TimeDriverGetSystemTickMs(void)
+{
+    return esp_timer_get_time() / 1000LL;
+}
+
+bool TimeDriverHasTimeElapsed(int64_t startTime, uint32_t deltaMsTime)
+{
+    return (TimeDriverGetSystemTickMs() - startTime) >= deltaMsTime;
+}
+
+void TimeDriverSetEspTime(struct tm* newTime)
+{
+    // host clock is not changed
+    (void)newTime;
+}
+
+char* TimeDriverGetLocalTimeStr(void)
+{
+    static char sLocalTimeStr[LOCAL_TIME_STRING_LEN];
+
+    strftime(sLocalTimeStr, sizeof(sLocalTimeStr), "%F %X", TimeDriverGetLocalTime());
+
+    return sLocalTimeStr;
+}
+
+void TimerDriverClearCounter(SettingTimerName_t timer)
+{
+    ESP_LOGI(TAG, "timer %d cleared", (int)timer);
+}
+
+bool TimerDriverUpdateTimerSetting(SettingDevice_t* setting)
+{
+    (void)setting;
+
+    return true;
+}
+
+bool WifiSettingSave(wifiSetting_t* setting)
+{
+    ESP_LOGI(TAG, "wifi setting saved, ssid %s", setting->ssid);
+
+    return true;
+}
+
+bool WifiReinit(void)
+{
+    return true;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void DrainRequestBody(httpd_req_t *req)
+{
+    char buf[OTA_DRAIN_BUF_LEN];
+    size_t left = req->content_len;
+
+    while (left > 0) {
+        int ret = httpd_req_recv(req, buf, (left < sizeof(buf)) ? left : sizeof(buf));
+        if (ret <= 0) {
+            return;
+        }
+
+        left -= ret;
+    }
+}
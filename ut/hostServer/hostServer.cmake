@@ -0,0 +1,73 @@
+# Host build of the web server, handlers and web assets are the device ones,
+# IDF and the device drivers are replaced by the shims in ut/hostServer.
+# cJSON is taken from IDF (IDF_PATH) or CJSON_DIR sources, or from the system library.
+
+find_path(CJSON_INCLUDE_DIR cJSON.h
+          HINTS ${CJSON_DIR}
+                $ENV{CJSON_DIR}
+                $ENV{IDF_PATH}/components/json/cJSON
+          PATH_SUFFIXES cjson)
+
+if(CJSON_INCLUDE_DIR AND EXISTS ${CJSON_INCLUDE_DIR}/cJSON.c)
+    set(CJSON_SOURCES ${CJSON_INCLUDE_DIR}/cJSON.c)
+elseif(CJSON_INCLUDE_DIR)
+    find_library(CJSON_LIBRARY cjson)
+endif()
+
+if(NOT CJSON_SOURCES AND NOT CJSON_LIBRARY)
+    message(STATUS "cJSON not found, host-server is not built (set IDF_PATH or CJSON_DIR)")
+    return()
+endif()
+
+set(HOST_SERVER_SOURCES hostServer/hostServerMain.c
+                        hostServer/httpdShim.c
+                        hostServer/idfShim.c
+                        hostServer/deviceShim.c
+                        ../main/app/webServer/webServer.c
+                        ../main/app/webServer/webWorker.c
+                        ../main/app/webServer/webMetrics.c
+                        ../main/app/webServer/liveStatus.c
+                        ../main/app/webServer/captivePortal.c
+                        ../main/app/common/messageCache.c
+                        ../main/app/common/messageParserAndSerializer.c
+                        ../main/app/common/messageType.c
+                        ../main/middleware/setting.c
+                        ../main/middleware/scheduler/scheduler.c
+                        ../main/middleware/location/location.c
+                        ../main/middleware/utils/webArchive/webArchive.c
+                        ../main/middleware/utils/deflate/deflate.c
+                        ../main/middleware/utils/captiveDns/captiveDns.c
+                        ../main/middleware/utils/requestMetrics/requestMetrics.c
+                        ../main/middleware/utils/jsonStream/jsonStream.c
+                        ../main/middleware/utils/lruCache/lruCache.c
+                        ${CJSON_SOURCES}
+                        )
+
+add_executable(host-server ${HOST_SERVER_SOURCES})
+
+# shim headers shadow the IDF ones, utPlatformIncludes are for the unit tests only
+target_include_directories(host-server PRIVATE hostServer/include
+                                               ${CJSON_INCLUDE_DIR}
+                                               ${UT_INCLUDE_SRC_DIRECTORIES})
+
+target_compile_definitions(host-server PRIVATE _GNU_SOURCE)
+target_compile_options(host-server PRIVATE -include ${CMAKE_CURRENT_SOURCE_DIR}/hostServer/include/hostCompat.h)
+
+find_package(Threads REQUIRED)
+target_link_libraries(host-server Threads::Threads ${CJSON_LIBRARY})
+
+# web assets image of the front end build, read by host-server from the build directory
+find_package(Python3 COMPONENTS Interpreter)
+set(HOST_SERVER_FRONT_DIR ${CMAKE_CURRENT_SOURCE_DIR}/../main/app/webServer/front/dist)
+
+if(Python3_FOUND AND EXISTS ${HOST_SERVER_FRONT_DIR})
+    file(GLOB_RECURSE HOST_SERVER_FRONT_FILES ${HOST_SERVER_FRONT_DIR}/*)
+
+    add_custom_command(OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/www.bin
+                       COMMAND ${Python3_EXECUTABLE} ${CMAKE_CURRENT_SOURCE_DIR}/../main/app/webServer/tools/packWebAssets.py
+                               ${HOST_SERVER_FRONT_DIR} ${CMAKE_CURRENT_BINARY_DIR}/www.bin
+                       DEPENDS ${HOST_SERVER_FRONT_FILES} ${CMAKE_CURRENT_SOURCE_DIR}/../main/app/webServer/tools/packWebAssets.py
+                       COMMENT "Packing web assets for host-server")
+
+    add_custom_target(host-server-www ALL DEPENDS ${CMAKE_CURRENT_BINARY_DIR}/www.bin)
+endif()
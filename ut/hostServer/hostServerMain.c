@@ -0,0 +1,113 @@
+/**
+ * @file hostServerMain.c
+ *
+ * @brief host web server build: runs the device web server on a development machine,
+ *        web assets are read from the partition images in a local directory
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "hostShim.h"
+#include "esp_log.h"
+#include "setting.h"
+#include "scheduler/scheduler.h"
+#include "location/location.h"
+#include "common/messageCache.h"
+#include "webServer/webServer.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define DEFAULT_PORT (8080U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+static const char *TAG = "hostServer";
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Print usage
+ *  @param name program name
+ */
+static void PrintUsage(const char *name);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    unsigned long port = DEFAULT_PORT;
+    const char *partitionDir = ".";
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:d:vh")) != -1) {
+        switch (opt) {
+        case 'p':
+            port = strtoul(optarg, NULL, 10);
+            break;
+        case 'd':
+            partitionDir = optarg;
+            break;
+        case 'v':
+            esp_log_level_set("*", ESP_LOG_DEBUG);
+            break;
+        default:
+            PrintUsage(argv[0]);
+            return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if ((port == 0) || (port > UINT16_MAX)) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // closed client sockets are reported by send errors as on the device
+    signal(SIGPIPE, SIG_IGN);
+
+    HostPartitionSetDirectory(partitionDir);
+    HostHttpdSetPort((uint16_t)port);
+
+    // settings start from defaults, there is no persistent nvs on host
+    if ((SettingInit() == false) || (SchedulerInit() == false) || (LocationInit() == false) ||
+        (MessageCacheInit() == false) || (WebServerInit() == false)) {
+        ESP_LOGE(TAG, "init failed");
+        return EXIT_FAILURE;
+    }
+
+    WebServerStart();
+    ESP_LOGI(TAG, "http://localhost:%lu/ web assets from %s", port, partitionDir);
+
+    while (1) {
+        pause();
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void PrintUsage(const char *name)
+{
+    printf("usage: %s [-p port] [-d partition dir] [-v]\n"
+           "  -p  tcp port, default %u\n"
+           "  -d  directory with www.bin and optional www_ota.bin, default current directory\n"
+           "  -v  debug logs\n", name, DEFAULT_PORT);
+}
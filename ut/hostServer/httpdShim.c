@@ -0,0 +1,1570 @@
+/**
+ * @file httpdShim.c
+ *
+ * @brief host web server build: esp_http_server subset on a POSIX socket server.
+ *        As on the device a single server thread accepts sessions, runs uri handlers
+ *        and work queued by httpd_queue_work, handlers are matched in registration order.
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "hostShim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include "esp_log.h"
+#include "esp_http_server.h"
+#include "lwip/sockets.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define REQ_HDR_MAX_LEN         (CONFIG_HTTPD_MAX_REQ_HDR_LEN + CONFIG_HTTPD_MAX_URI_LEN)
+#define METHOD_MAX_LEN          (8U)
+#define RESP_HDR_MAX_LEN        (1024U)
+#define PURGE_BUF_LEN           (512U)
+#define CHUNK_HEADER_MAX_LEN    (16U)
+
+#define WS_GUID                 "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#define WS_KEY_MAX_LEN          (64U)
+#define WS_ACCEPT_LEN           (29U)
+#define WS_FRAME_HEADER_MAX_LEN (10U)
+#define WS_CONTROL_MAX_LEN      (125U)
+#define WS_OPCODE_MASK          (0x0FU)
+#define WS_FIN                  (0x80U)
+#define WS_MASK                 (0x80U)
+#define WS_LEN_16               (126U)
+#define WS_LEN_64               (127U)
+
+#define SHA1_DIGEST_LEN         (20U)
+#define SHA1_BLOCK_LEN          (64U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+typedef struct {
+    bool isUsed;
+    bool isWebsocket;
+    bool isCloseRequested;
+    int fd;
+    uint64_t lastUse;
+    void *ctx;
+    httpd_free_ctx_fn_t freeCtx;
+    httpd_send_func_t send;
+    const httpd_uri_t *wsHandler;
+} hostSession_t;
+
+typedef struct hostWork {
+    httpd_work_fn_t work;
+    void *arg;
+    struct hostWork *next;
+} hostWork_t;
+
+typedef struct {
+    httpd_config_t config;
+    httpd_uri_t *handlers;
+    uint16_t handlersCount;
+    hostSession_t *sessions;
+    uint64_t useCounter;
+    int listenFd;
+    int wakeFd[2];
+    bool isRunning;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_mutex_t workLock;
+    hostWork_t *workHead;
+    hostWork_t *workTail;
+} hostServer_t;
+
+typedef struct {
+    const char *field;
+    const char *value;
+} hostRespHeader_t;
+
+typedef struct {
+    hostServer_t *server;
+    hostSession_t *session;
+    char headers[REQ_HDR_MAX_LEN + 1];
+    size_t bodyLeft;
+    bool isKeepAlive;
+    const char *status;
+    const char *type;
+    hostRespHeader_t *respHeaders;
+    uint16_t respHeadersCount;
+    bool isHeaderSent;
+    bool isChunked;
+    bool isSendError;
+    httpd_ws_type_t wsType;
+    bool wsFinal;
+    size_t wsLen;
+    uint8_t wsMask[4];
+    bool isWsHeaderRead;
+} hostReq_t;
+
+typedef struct {
+    uint32_t state[5];
+    uint64_t len;
+    uint8_t block[SHA1_BLOCK_LEN];
+    uint32_t blockLen;
+} sha1_t;
+
+static const char *TAG = "httpdShim";
+
+static uint16_t sPortOverride;
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Server thread, waits for sockets and queued work
+ *  @param arg server handle
+ *  @return NULL
+ */
+static void *ServerTask(void *arg);
+
+/** @brief Run all queued work
+ *  @param server server handle
+ */
+static void RunWork(hostServer_t *server);
+
+/** @brief Accept new session, least recently used one is closed if there is no free slot
+ *  @param server server handle
+ */
+static void AcceptSession(hostServer_t *server);
+
+/** @brief Close session and free its context
+ *  @param server server handle
+ *  @param session session to close
+ */
+static void CloseSession(hostServer_t *server, hostSession_t *session);
+
+/** @brief Find session of the socket
+ *  @param server server handle
+ *  @param fd socket
+ *  @return session, NULL if not found
+ */
+static hostSession_t *FindSession(hostServer_t *server, int fd);
+
+/** @brief Read and process http request or websocket frame
+ *  @param server server handle
+ *  @param session session with data to read
+ *  @return true if session stays open
+ */
+static bool ProcessSession(hostServer_t *server, hostSession_t *session);
+
+/** @brief Read request line and headers
+ *  @param session session to read
+ *  @param buf [out] headers buffer
+ *  @param size buffer size
+ *  @return length of headers, 0 on error
+ */
+static size_t ReadHeaders(hostSession_t *session, char *buf, size_t size);
+
+/** @brief Find uri handler
+ *  @param server server handle
+ *  @param uri request uri
+ *  @param method request method
+ *  @param isMethodMismatch [out] true if uri is handled only for other methods
+ *  @return handler, NULL if not found
+ */
+static const httpd_uri_t *FindHandler(hostServer_t *server, const char *uri, int method, bool *isMethodMismatch);
+
+/** @brief Run handler and clean up the request
+ *  @param session request session
+ *  @param req request
+ *  @param handler uri handler
+ *  @return true if session stays open
+ */
+static bool RunHandler(hostSession_t *session, httpd_req_t *req, const httpd_uri_t *handler);
+
+/** @brief Process websocket frame, control frames are answered here
+ *  @param server server handle
+ *  @param session websocket session
+ *  @return true if session stays open
+ */
+static bool ProcessWsFrame(hostServer_t *server, hostSession_t *session);
+
+/** @brief Send websocket handshake response
+ *  @param req handshake request
+ *  @return true if sent
+ */
+static bool SendWsHandshake(httpd_req_t *req);
+
+/** @brief Send websocket frame header and payload
+ *  @param server server handle
+ *  @param session websocket session
+ *  @param type frame type
+ *  @param payload frame payload
+ *  @param len payload length
+ *  @return true if sent
+ */
+static bool SendWsFrame(hostServer_t *server, hostSession_t *session, httpd_ws_type_t type, const uint8_t *payload, size_t len);
+
+/** @brief Send all bytes with the session send function
+ *  @param server server handle
+ *  @param session session
+ *  @param buf data
+ *  @param len data length
+ *  @return true if sent
+ */
+static bool SendAll(hostServer_t *server, hostSession_t *session, const char *buf, size_t len);
+
+/** @brief Receive exactly len bytes
+ *  @param fd socket
+ *  @param buf [out] buffer
+ *  @param len number of bytes
+ *  @return true if received
+ */
+static bool RecvAll(int fd, void *buf, size_t len);
+
+/** @brief Send response status line and headers
+ *  @param req request
+ *  @param contentLen body length, negative for chunked response
+ *  @return true if sent
+ */
+static bool SendRespHeaders(httpd_req_t *req, ssize_t contentLen);
+
+/** @brief Default send function
+ */
+static int DefaultSend(httpd_handle_t hd, int sockfd, const char *buf, size_t buf_len, int flags);
+
+/** @brief Find header value in the request headers
+ *  @param hostReq request
+ *  @param field header name, case insensitive
+ *  @param len [out] value length
+ *  @return pointer to value, NULL if not found
+ */
+static const char *FindHeader(const hostReq_t *hostReq, const char *field, size_t *len);
+
+/** @brief Parse method name
+ *  @param method method name
+ *  @return method, -1 if not supported
+ */
+static int ParseMethod(const char *method);
+
+/** @brief Get status line of the error code
+ *  @param error error code
+ *  @return status line
+ */
+static const char *GetErrorStatus(httpd_err_code_t error);
+
+static void Sha1Init(sha1_t *sha);
+static void Sha1Update(sha1_t *sha, const uint8_t *data, size_t len);
+static void Sha1Final(sha1_t *sha, uint8_t digest[SHA1_DIGEST_LEN]);
+static void Sha1Block(sha1_t *sha, const uint8_t block[SHA1_BLOCK_LEN]);
+
+/** @brief Encode data in base64
+ *  @param data data to encode
+ *  @param len data length
+ *  @param out [out] terminated output, 4 * ((len + 2) / 3) + 1 bytes
+ */
+static void Base64Encode(const uint8_t *data, size_t len, char *out);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+void HostHttpdSetPort(uint16_t port)
+{
+    sPortOverride = port;
+}
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
+{
+    hostServer_t *server = calloc(1, sizeof(hostServer_t));
+    if (server == NULL) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+
+    server->config = *config;
+    if (sPortOverride != 0) {
+        server->config.server_port = sPortOverride;
+    }
+
+    server->handlers = calloc(config->max_uri_handlers, sizeof(httpd_uri_t));
+    server->sessions = calloc(config->max_open_sockets, sizeof(hostSession_t));
+    if ((server->handlers == NULL) || (server->sessions == NULL) || (pipe(server->wakeFd) != 0)) {
+        free(server->handlers);
+        free(server->sessions);
+        free(server);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&server->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    pthread_mutex_init(&server->workLock, NULL);
+
+    server->listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int enable = 1;
+    setsockopt(server->listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+        .sin_port = htons(server->config.server_port),
+    };
+
+    if ((server->listenFd < 0) ||
+        (bind(server->listenFd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+        (listen(server->listenFd, server->config.backlog_conn) != 0)) {
+        ESP_LOGE(TAG, "can't listen on port %u (%s)", server->config.server_port, strerror(errno));
+        close(server->listenFd);
+        close(server->wakeFd[0]);
+        close(server->wakeFd[1]);
+        free(server->handlers);
+        free(server->sessions);
+        free(server);
+        return ESP_ERR_HTTPD_TASK;
+    }
+
+    server->isRunning = true;
+    if (pthread_create(&server->thread, NULL, ServerTask, server) != 0) {
+        close(server->listenFd);
+        return ESP_ERR_HTTPD_TASK;
+    }
+
+    ESP_LOGI(TAG, "listening on port %u", server->config.server_port);
+    *handle = server;
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle)
+{
+    hostServer_t *server = handle;
+    if (server == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    server->isRunning = false;
+    write(server->wakeFd[1], "s", 1);
+    pthread_join(server->thread, NULL);
+
+    for (uint16_t idx = 0; idx < server->config.max_open_sockets; ++idx) {
+        if (server->sessions[idx].isUsed) {
+            CloseSession(server, &server->sessions[idx]);
+        }
+    }
+
+    close(server->listenFd);
+    close(server->wakeFd[0]);
+    close(server->wakeFd[1]);
+    free(server->handlers);
+    free(server->sessions);
+    free(server);
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler)
+{
+    hostServer_t *server = handle;
+    if ((server == NULL) || (uri_handler == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&server->lock);
+
+    esp_err_t err = ESP_OK;
+    for (uint16_t idx = 0; idx < server->handlersCount; ++idx) {
+        if ((server->handlers[idx].method == uri_handler->method) && (strcmp(server->handlers[idx].uri, uri_handler->uri) == 0)) {
+            err = ESP_ERR_HTTPD_HANDLER_EXISTS;
+        }
+    }
+
+    if ((err == ESP_OK) && (server->handlersCount == server->config.max_uri_handlers)) {
+        err = ESP_ERR_HTTPD_HANDLERS_FULL;
+    }
+
+    if (err == ESP_OK) {
+        server->handlers[server->handlersCount] = *uri_handler;
+        server->handlersCount += 1;
+    } else {
+        ESP_LOGW(TAG, "handler %s not registered (%s)", uri_handler->uri, esp_err_to_name(err));
+    }
+
+    pthread_mutex_unlock(&server->lock);
+
+    return err;
+}
+
+esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void *arg)
+{
+    hostServer_t *server = handle;
+    if ((server == NULL) || (work == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    hostWork_t *item = malloc(sizeof(hostWork_t));
+    if (item == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    item->work = work;
+    item->arg = arg;
+    item->next = NULL;
+
+    pthread_mutex_lock(&server->workLock);
+    if (server->workTail == NULL) {
+        server->workHead = item;
+    } else {
+        server->workTail->next = item;
+    }
+    server->workTail = item;
+    pthread_mutex_unlock(&server->workLock);
+
+    write(server->wakeFd[1], "w", 1);
+
+    return ESP_OK;
+}
+
+bool httpd_uri_match_wildcard(const char *uri_template, const char *uri_to_match, size_t match_upto)
+{
+    size_t templateLen = strlen(uri_template);
+    char last = (templateLen > 0) ? uri_template[templateLen - 1] : '\0';
+    char prevLast = (templateLen > 1) ? uri_template[templateLen - 2] : '\0';
+
+    // '*' at the end matches any rest, '?' makes the preceding character optional
+    bool isAsterisk = (last == '*') || ((prevLast == '*') && (last == '?'));
+    bool isQuest = (last == '?') || ((prevLast == '?') && (last == '*'));
+    size_t literalLen = templateLen - (isAsterisk ? 1U : 0U) - (isQuest ? 1U : 0U);
+    size_t requiredLen = literalLen - (isQuest ? 1U : 0U);
+
+    if ((match_upto < requiredLen) || (strncmp(uri_template, uri_to_match, requiredLen) != 0)) {
+        return false;
+    }
+
+    if (isAsterisk) {
+        return (isQuest == false) || (match_upto == requiredLen) || (uri_to_match[requiredLen] == uri_template[requiredLen]);
+    }
+
+    if (isQuest && (match_upto == requiredLen)) {
+        return true;
+    }
+
+    return (match_upto == literalLen) && (strncmp(uri_template, uri_to_match, literalLen) == 0);
+}
+
+const char *http_method_str(int method)
+{
+    switch (method) {
+    case HTTP_DELETE:
+        return "DELETE";
+    case HTTP_GET:
+        return "GET";
+    case HTTP_HEAD:
+        return "HEAD";
+    case HTTP_POST:
+        return "POST";
+    case HTTP_PUT:
+        return "PUT";
+    case HTTP_OPTIONS:
+        return "OPTIONS";
+    default:
+        return "<unknown>";
+    }
+}
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len)
+{
+    hostReq_t *hostReq = r->aux;
+
+    if (hostReq->bodyLeft == 0) {
+        return 0;
+    }
+
+    size_t len = (buf_len < hostReq->bodyLeft) ? buf_len : hostReq->bodyLeft;
+    ssize_t ret = recv(hostReq->session->fd, buf, len, 0);
+    if (ret < 0) {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+    }
+
+    hostReq->bodyLeft -= (size_t)ret;
+
+    return (int)ret;
+}
+
+int httpd_req_to_sockfd(httpd_req_t *r)
+{
+    hostReq_t *hostReq = r->aux;
+
+    return hostReq->session->fd;
+}
+
+size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
+{
+    size_t len = 0;
+
+    return (FindHeader(r->aux, field, &len) != NULL) ? len : 0;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *val, size_t val_size)
+{
+    size_t len = 0;
+    const char *value = FindHeader(r->aux, field, &len);
+    if (value == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (val_size == 0) {
+        return ESP_ERR_HTTPD_RESULT_TRUNC;
+    }
+
+    size_t copyLen = (len < val_size) ? len : (val_size - 1);
+    memcpy(val, value, copyLen);
+    val[copyLen] = '\0';
+
+    return (copyLen < len) ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+size_t httpd_req_get_url_query_len(httpd_req_t *r)
+{
+    const char *query = strchr(r->uri, '?');
+
+    return (query == NULL) ? 0 : strlen(query + 1);
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len)
+{
+    const char *query = strchr(r->uri, '?');
+    if (query == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    size_t len = strlen(query + 1);
+    snprintf(buf, buf_len, "%s", query + 1);
+
+    return (len >= buf_len) ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size)
+{
+    size_t keyLen = strlen(key);
+    const char *pos = qry;
+
+    while ((pos != NULL) && (*pos != '\0')) {
+        const char *end = strchr(pos, '&');
+        size_t pairLen = (end == NULL) ? strlen(pos) : (size_t)(end - pos);
+
+        if ((pairLen > keyLen) && (strncmp(pos, key, keyLen) == 0) && (pos[keyLen] == '=')) {
+            size_t valueLen = pairLen - keyLen - 1;
+            size_t copyLen = (valueLen < val_size) ? valueLen : (val_size - 1);
+            memcpy(val, &pos[keyLen + 1], copyLen);
+            val[copyLen] = '\0';
+            return (copyLen < valueLen) ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+        }
+
+        pos = (end == NULL) ? NULL : (end + 1);
+    }
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status)
+{
+    hostReq_t *hostReq = r->aux;
+    hostReq->status = status;
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type)
+{
+    hostReq_t *hostReq = r->aux;
+    hostReq->type = type;
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value)
+{
+    hostReq_t *hostReq = r->aux;
+
+    // as on the device only pointers are kept, strings must live until the response is sent
+    if (hostReq->respHeadersCount == hostReq->server->config.max_resp_headers) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+
+    hostReq->respHeaders[hostReq->respHeadersCount].field = field;
+    hostReq->respHeaders[hostReq->respHeadersCount].value = value;
+    hostReq->respHeadersCount += 1;
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    hostReq_t *hostReq = r->aux;
+
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = (buf == NULL) ? 0 : (ssize_t)strlen(buf);
+    }
+
+    if ((SendRespHeaders(r, buf_len) == false) ||
+        ((buf_len > 0) && (SendAll(hostReq->server, hostReq->session, buf, (size_t)buf_len) == false))) {
+        hostReq->isSendError = true;
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    hostReq_t *hostReq = r->aux;
+
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = (buf == NULL) ? 0 : (ssize_t)strlen(buf);
+    }
+
+    if ((hostReq->isHeaderSent == false) && (SendRespHeaders(r, -1) == false)) {
+        hostReq->isSendError = true;
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+
+    char header[CHUNK_HEADER_MAX_LEN];
+    int headerLen = snprintf(header, sizeof(header), "%zx\r\n", (size_t)buf_len);
+
+    bool res = SendAll(hostReq->server, hostReq->session, header, (size_t)headerLen);
+    if (res && (buf_len > 0)) {
+        res = SendAll(hostReq->server, hostReq->session, buf, (size_t)buf_len);
+    }
+    if (res) {
+        res = SendAll(hostReq->server, hostReq->session, "\r\n", 2);
+    }
+
+    if (res == false) {
+        hostReq->isSendError = true;
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t *req, httpd_err_code_t error, const char *msg)
+{
+    const char *status = GetErrorStatus(error);
+
+    httpd_resp_set_status(req, status);
+    httpd_resp_set_type(req, HTTPD_TYPE_TEXT);
+
+    return httpd_resp_send(req, (msg != NULL) ? msg : status, HTTPD_RESP_USE_STRLEN);
+}
+
+void *httpd_sess_get_ctx(httpd_handle_t handle, int sockfd)
+{
+    hostServer_t *server = handle;
+
+    pthread_mutex_lock(&server->lock);
+    hostSession_t *session = FindSession(server, sockfd);
+    void *ctx = (session == NULL) ? NULL : session->ctx;
+    pthread_mutex_unlock(&server->lock);
+
+    return ctx;
+}
+
+void httpd_sess_set_ctx(httpd_handle_t handle, int sockfd, void *ctx, httpd_free_ctx_fn_t free_fn)
+{
+    hostServer_t *server = handle;
+
+    pthread_mutex_lock(&server->lock);
+
+    hostSession_t *session = FindSession(server, sockfd);
+    if (session != NULL) {
+        if ((session->ctx != NULL) && (session->ctx != ctx)) {
+            if (session->freeCtx != NULL) {
+                session->freeCtx(session->ctx);
+            } else {
+                free(session->ctx);
+            }
+        }
+
+        session->ctx = ctx;
+        session->freeCtx = free_fn;
+    }
+
+    pthread_mutex_unlock(&server->lock);
+}
+
+esp_err_t httpd_sess_set_send_override(httpd_handle_t hd, int sockfd, httpd_send_func_t send_func)
+{
+    hostServer_t *server = hd;
+
+    pthread_mutex_lock(&server->lock);
+    hostSession_t *session = FindSession(server, sockfd);
+    if (session != NULL) {
+        session->send = send_func;
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    return (session == NULL) ? ESP_ERR_NOT_FOUND : ESP_OK;
+}
+
+esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd)
+{
+    hostServer_t *server = handle;
+
+    // closed by the server thread, the session may be in use by the caller
+    pthread_mutex_lock(&server->lock);
+    hostSession_t *session = FindSession(server, sockfd);
+    if (session != NULL) {
+        session->isCloseRequested = true;
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    if (session == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    write(server->wakeFd[1], "c", 1);
+
+    return ESP_OK;
+}
+
+int httpd_socket_send(httpd_handle_t hd, int sockfd, const char *buf, size_t buf_len, int flags)
+{
+    hostServer_t *server = hd;
+
+    pthread_mutex_lock(&server->lock);
+    hostSession_t *session = FindSession(server, sockfd);
+    httpd_send_func_t sendFn = (session == NULL) ? NULL : session->send;
+    pthread_mutex_unlock(&server->lock);
+
+    if (sendFn == NULL) {
+        return HTTPD_SOCK_ERR_INVALID;
+    }
+
+    return sendFn(hd, sockfd, buf, buf_len, flags);
+}
+
+esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *pkt, size_t max_len)
+{
+    hostReq_t *hostReq = req->aux;
+
+    if ((hostReq == NULL) || (hostReq->isWsHeaderRead == false)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    pkt->type = hostReq->wsType;
+    pkt->final = hostReq->wsFinal;
+    pkt->fragmented = false;
+
+    if (max_len == 0) {
+        pkt->len = hostReq->wsLen;
+        return ESP_OK;
+    }
+
+    size_t len = (hostReq->wsLen < max_len) ? hostReq->wsLen : max_len;
+    if ((pkt->payload == NULL) || (RecvAll(hostReq->session->fd, pkt->payload, len) == false)) {
+        return ESP_FAIL;
+    }
+
+    for (size_t idx = 0; idx < len; ++idx) {
+        pkt->payload[idx] ^= hostReq->wsMask[idx % 4U];
+    }
+
+    pkt->len = len;
+    hostReq->wsLen -= len;
+
+    return ESP_OK;
+}
+
+esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *pkt)
+{
+    hostReq_t *hostReq = req->aux;
+
+    return SendWsFrame(hostReq->server, hostReq->session, pkt->type, pkt->payload, pkt->len) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+{
+    hostServer_t *server = hd;
+
+    pthread_mutex_lock(&server->lock);
+    hostSession_t *session = FindSession(server, fd);
+    bool res = (session != NULL) && session->isWebsocket && SendWsFrame(server, session, frame->type, frame->payload, frame->len);
+    pthread_mutex_unlock(&server->lock);
+
+    return res ? ESP_OK : ESP_FAIL;
+}
+
+httpd_ws_client_info_t httpd_ws_get_fd_info(httpd_handle_t hd, int fd)
+{
+    hostServer_t *server = hd;
+
+    pthread_mutex_lock(&server->lock);
+    hostSession_t *session = FindSession(server, fd);
+    httpd_ws_client_info_t info = (session == NULL) ? HTTPD_WS_CLIENT_INVALID :
+                                  (session->isWebsocket ? HTTPD_WS_CLIENT_WEBSOCKET : HTTPD_WS_CLIENT_HTTP);
+    pthread_mutex_unlock(&server->lock);
+
+    return info;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void *ServerTask(void *arg)
+{
+    hostServer_t *server = arg;
+
+    while (server->isRunning) {
+        fd_set readFds;
+        FD_ZERO(&readFds);
+        FD_SET(server->listenFd, &readFds);
+        FD_SET(server->wakeFd[0], &readFds);
+        int maxFd = (server->listenFd > server->wakeFd[0]) ? server->listenFd : server->wakeFd[0];
+
+        pthread_mutex_lock(&server->lock);
+        for (uint16_t idx = 0; idx < server->config.max_open_sockets; ++idx) {
+            hostSession_t *session = &server->sessions[idx];
+            if (session->isUsed && session->isCloseRequested) {
+                CloseSession(server, session);
+            }
+
+            if (session->isUsed) {
+                FD_SET(session->fd, &readFds);
+                maxFd = (session->fd > maxFd) ? session->fd : maxFd;
+            }
+        }
+        pthread_mutex_unlock(&server->lock);
+
+        if (select(maxFd + 1, &readFds, NULL, NULL, NULL) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ESP_LOGE(TAG, "select error %s", strerror(errno));
+            break;
+        }
+
+        if (FD_ISSET(server->wakeFd[0], &readFds)) {
+            char drain[64];
+            read(server->wakeFd[0], drain, sizeof(drain));
+        }
+
+        pthread_mutex_lock(&server->lock);
+
+        RunWork(server);
+
+        for (uint16_t idx = 0; idx < server->config.max_open_sockets; ++idx) {
+            hostSession_t *session = &server->sessions[idx];
+            if (session->isUsed && (session->isCloseRequested == false) && FD_ISSET(session->fd, &readFds)) {
+                server->useCounter += 1;
+                session->lastUse = server->useCounter;
+
+                if (ProcessSession(server, session) == false) {
+                    CloseSession(server, session);
+                }
+            }
+        }
+
+        if (FD_ISSET(server->listenFd, &readFds)) {
+            AcceptSession(server);
+        }
+
+        pthread_mutex_unlock(&server->lock);
+    }
+
+    return NULL;
+}
+
+static void RunWork(hostServer_t *server)
+{
+    pthread_mutex_lock(&server->workLock);
+    hostWork_t *item = server->workHead;
+    server->workHead = NULL;
+    server->workTail = NULL;
+    pthread_mutex_unlock(&server->workLock);
+
+    while (item != NULL) {
+        hostWork_t *next = item->next;
+        item->work(item->arg);
+        free(item);
+        item = next;
+    }
+}
+
+static void AcceptSession(hostServer_t *server)
+{
+    int fd = accept(server->listenFd, NULL, NULL);
+    if (fd < 0) {
+        return;
+    }
+
+    hostSession_t *session = NULL;
+    hostSession_t *oldest = NULL;
+    for (uint16_t idx = 0; idx < server->config.max_open_sockets; ++idx) {
+        if (server->sessions[idx].isUsed == false) {
+            session = &server->sessions[idx];
+            break;
+        }
+
+        if ((oldest == NULL) || (server->sessions[idx].lastUse < oldest->lastUse)) {
+            oldest = &server->sessions[idx];
+        }
+    }
+
+    if ((session == NULL) && server->config.lru_purge_enable) {
+        ESP_LOGD(TAG, "purge least recently used session %d", oldest->fd);
+        CloseSession(server, oldest);
+        session = oldest;
+    }
+
+    if (session == NULL) {
+        ESP_LOGW(TAG, "no free session, connection refused");
+        close(fd);
+        return;
+    }
+
+    struct timeval recvTimeout = { .tv_sec = server->config.recv_wait_timeout };
+    struct timeval sendTimeout = { .tv_sec = server->config.send_wait_timeout };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &recvTimeout, sizeof(recvTimeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+
+    memset(session, 0, sizeof(hostSession_t));
+    session->isUsed = true;
+    session->fd = fd;
+    session->send = DefaultSend;
+    server->useCounter += 1;
+    session->lastUse = server->useCounter;
+
+    if ((server->config.open_fn != NULL) && (server->config.open_fn(server, fd) != ESP_OK)) {
+        CloseSession(server, session);
+    }
+}
+
+static void CloseSession(hostServer_t *server, hostSession_t *session)
+{
+    if (session->ctx != NULL) {
+        if (session->freeCtx != NULL) {
+            session->freeCtx(session->ctx);
+        } else {
+            free(session->ctx);
+        }
+    }
+
+    if (server->config.close_fn != NULL) {
+        server->config.close_fn(server, session->fd);
+    } else {
+        close(session->fd);
+    }
+
+    memset(session, 0, sizeof(hostSession_t));
+}
+
+static hostSession_t *FindSession(hostServer_t *server, int fd)
+{
+    for (uint16_t idx = 0; idx < server->config.max_open_sockets; ++idx) {
+        if (server->sessions[idx].isUsed && (server->sessions[idx].fd == fd)) {
+            return &server->sessions[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static bool ProcessSession(hostServer_t *server, hostSession_t *session)
+{
+    if (session->isWebsocket) {
+        return ProcessWsFrame(server, session);
+    }
+
+    hostReq_t *hostReq = calloc(1, sizeof(hostReq_t));
+    httpd_req_t *req = calloc(1, sizeof(httpd_req_t));
+    hostRespHeader_t *respHeaders = calloc(server->config.max_resp_headers, sizeof(hostRespHeader_t));
+    if ((hostReq == NULL) || (req == NULL) || (respHeaders == NULL)) {
+        free(hostReq);
+        free(req);
+        free(respHeaders);
+        return false;
+    }
+
+    hostReq->server = server;
+    hostReq->session = session;
+    hostReq->respHeaders = respHeaders;
+    hostReq->status = HTTPD_200;
+    hostReq->type = HTTPD_TYPE_TEXT;
+    req->handle = server;
+    req->aux = hostReq;
+
+    bool res = false;
+    size_t headersLen = ReadHeaders(session, hostReq->headers, sizeof(hostReq->headers));
+
+    char method[METHOD_MAX_LEN + 1] = {};
+    char version[METHOD_MAX_LEN + 1] = {};
+    char *uri = (char *)req->uri;
+    int methodId = -1;
+
+    if (headersLen > 0) {
+        char format[32];
+        snprintf(format, sizeof(format), "%%%us %%%us %%%us", METHOD_MAX_LEN, CONFIG_HTTPD_MAX_URI_LEN, METHOD_MAX_LEN);
+        if (sscanf(hostReq->headers, format, method, uri, version) == 3) {
+            methodId = ParseMethod(method);
+        }
+    }
+
+    if (methodId < 0) {
+        if (headersLen > 0) {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, NULL);
+        }
+    } else {
+        req->method = methodId;
+
+        size_t len = 0;
+        const char *value = FindHeader(hostReq, "Content-Length", &len);
+        req->content_len = (value == NULL) ? 0 : strtoul(value, NULL, 10);
+        hostReq->bodyLeft = req->content_len;
+
+        value = FindHeader(hostReq, "Connection", &len);
+        hostReq->isKeepAlive = (strcmp(version, "HTTP/1.1") == 0) ? ((value == NULL) || (strncasecmp(value, "close", len) != 0)) :
+                               ((value != NULL) && (strncasecmp(value, "keep-alive", len) == 0));
+
+        bool isMethodMismatch = false;
+        const httpd_uri_t *handler = FindHandler(server, uri, methodId, &isMethodMismatch);
+
+        if (handler != NULL) {
+            res = RunHandler(session, req, handler);
+        } else {
+            httpd_resp_send_err(req, isMethodMismatch ? HTTPD_405_METHOD_NOT_ALLOWED : HTTPD_404_NOT_FOUND, NULL);
+            res = hostReq->isKeepAlive && (hostReq->isSendError == false);
+        }
+
+        // not read request body is dropped, the session is ready for the next request
+        char purge[PURGE_BUF_LEN];
+        while (res && (hostReq->bodyLeft > 0) && (session->isWebsocket == false)) {
+            res = (httpd_req_recv(req, purge, sizeof(purge)) > 0);
+        }
+    }
+
+    free(respHeaders);
+    free(hostReq);
+    free(req);
+
+    return res;
+}
+
+static size_t ReadHeaders(hostSession_t *session, char *buf, size_t size)
+{
+    size_t len = 0;
+
+    // byte by byte, bytes after the headers belong to the body
+    while (len < (size - 1)) {
+        ssize_t ret = recv(session->fd, &buf[len], 1, 0);
+        if (ret <= 0) {
+            return 0;
+        }
+
+        len += 1;
+        buf[len] = '\0';
+
+        if ((len >= 4) && (memcmp(&buf[len - 4], "\r\n\r\n", 4) == 0)) {
+            return len;
+        }
+    }
+
+    ESP_LOGW(TAG, "request headers too long");
+
+    return 0;
+}
+
+static const httpd_uri_t *FindHandler(hostServer_t *server, const char *uri, int method, bool *isMethodMismatch)
+{
+    size_t matchLen = strcspn(uri, "?");
+
+    for (uint16_t idx = 0; idx < server->handlersCount; ++idx) {
+        const httpd_uri_t *handler = &server->handlers[idx];
+
+        bool isMatch = (server->config.uri_match_fn != NULL) ? server->config.uri_match_fn(handler->uri, uri, matchLen) :
+                       ((strlen(handler->uri) == matchLen) && (strncmp(handler->uri, uri, matchLen) == 0));
+        if (isMatch == false) {
+            continue;
+        }
+
+        if ((int)handler->method == method) {
+            return handler;
+        }
+
+        *isMethodMismatch = true;
+    }
+
+    return NULL;
+}
+
+static bool RunHandler(hostSession_t *session, httpd_req_t *req, const httpd_uri_t *handler)
+{
+    hostReq_t *hostReq = req->aux;
+
+    if (handler->is_websocket) {
+        if (SendWsHandshake(req) == false) {
+            return false;
+        }
+
+        session->isWebsocket = true;
+        session->wsHandler = handler;
+    }
+
+    req->user_ctx = handler->user_ctx;
+    req->sess_ctx = session->ctx;
+    req->free_ctx = session->freeCtx;
+
+    esp_err_t err = handler->handler(req);
+
+    // context set by the handler is kept by the session as on the device
+    if ((req->ignore_sess_ctx_changes == false) && (req->sess_ctx != session->ctx)) {
+        if (session->ctx != NULL) {
+            if (session->freeCtx != NULL) {
+                session->freeCtx(session->ctx);
+            } else {
+                free(session->ctx);
+            }
+        }
+        session->ctx = req->sess_ctx;
+    }
+    session->freeCtx = req->free_ctx;
+
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "handler %s failed, session %d closed", handler->uri, session->fd);
+        return false;
+    }
+
+    return (hostReq->isKeepAlive || session->isWebsocket) && (hostReq->isSendError == false);
+}
+
+static bool ProcessWsFrame(hostServer_t *server, hostSession_t *session)
+{
+    uint8_t header[WS_FRAME_HEADER_MAX_LEN];
+
+    if (RecvAll(session->fd, header, 2) == false) {
+        return false;
+    }
+
+    bool isMasked = ((header[1] & WS_MASK) != 0);
+    hostReq_t hostReq = {
+        .server = server,
+        .session = session,
+        .wsType = (httpd_ws_type_t)(header[0] & WS_OPCODE_MASK),
+        .wsFinal = ((header[0] & WS_FIN) != 0),
+        .wsLen = header[1] & 0x7FU,
+        .isWsHeaderRead = true,
+    };
+
+    if (hostReq.wsLen == WS_LEN_16) {
+        if (RecvAll(session->fd, header, 2) == false) {
+            return false;
+        }
+        hostReq.wsLen = ((size_t)header[0] << 8) | header[1];
+    } else if (hostReq.wsLen == WS_LEN_64) {
+        if (RecvAll(session->fd, header, 8) == false) {
+            return false;
+        }
+        hostReq.wsLen = 0;
+        for (uint8_t idx = 0; idx < 8; ++idx) {
+            hostReq.wsLen = (hostReq.wsLen << 8) | header[idx];
+        }
+    }
+
+    // client frames are masked, mask of zeros keeps not masked frames intact
+    if (isMasked && (RecvAll(session->fd, hostReq.wsMask, sizeof(hostReq.wsMask)) == false)) {
+        return false;
+    }
+
+    httpd_req_t req = {
+        .handle = server,
+        .method = 0,
+        .aux = &hostReq,
+    };
+
+    if ((hostReq.wsType == HTTPD_WS_TYPE_PING) || (hostReq.wsType == HTTPD_WS_TYPE_CLOSE)) {
+        uint8_t payload[WS_CONTROL_MAX_LEN];
+        httpd_ws_frame_t frame = { .payload = payload };
+
+        if ((hostReq.wsLen > sizeof(payload)) || (httpd_ws_recv_frame(&req, &frame, sizeof(payload)) != ESP_OK)) {
+            return false;
+        }
+
+        if (hostReq.wsType == HTTPD_WS_TYPE_CLOSE) {
+            SendWsFrame(server, session, HTTPD_WS_TYPE_CLOSE, NULL, 0);
+            return false;
+        }
+
+        return SendWsFrame(server, session, HTTPD_WS_TYPE_PONG, payload, frame.len);
+    }
+
+    if (hostReq.wsType == HTTPD_WS_TYPE_PONG) {
+        uint8_t payload[WS_CONTROL_MAX_LEN];
+        httpd_ws_frame_t frame = { .payload = payload };
+        return (hostReq.wsLen <= sizeof(payload)) && (httpd_ws_recv_frame(&req, &frame, sizeof(payload)) == ESP_OK);
+    }
+
+    strncpy((char *)req.uri, session->wsHandler->uri, CONFIG_HTTPD_MAX_URI_LEN);
+    req.user_ctx = session->wsHandler->user_ctx;
+    req.sess_ctx = session->ctx;
+    req.free_ctx = session->freeCtx;
+
+    if (session->wsHandler->handler(&req) != ESP_OK) {
+        return false;
+    }
+
+    // not read payload is dropped
+    uint8_t purge[PURGE_BUF_LEN];
+    while (hostReq.wsLen > 0) {
+        size_t len = (hostReq.wsLen < sizeof(purge)) ? hostReq.wsLen : sizeof(purge);
+        if (RecvAll(session->fd, purge, len) == false) {
+            return false;
+        }
+        hostReq.wsLen -= len;
+    }
+
+    return true;
+}
+
+static bool SendWsHandshake(httpd_req_t *req)
+{
+    hostReq_t *hostReq = req->aux;
+    char key[WS_KEY_MAX_LEN + sizeof(WS_GUID)];
+
+    if ((httpd_req_get_hdr_value_str(req, "Sec-WebSocket-Key", key, WS_KEY_MAX_LEN) != ESP_OK) ||
+        (req->method != HTTP_GET)) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "websocket handshake expected");
+        return false;
+    }
+
+    strcat(key, WS_GUID);
+
+    sha1_t sha;
+    uint8_t digest[SHA1_DIGEST_LEN];
+    char accept[WS_ACCEPT_LEN];
+    Sha1Init(&sha);
+    Sha1Update(&sha, (const uint8_t *)key, strlen(key));
+    Sha1Final(&sha, digest);
+    Base64Encode(digest, sizeof(digest), accept);
+
+    char resp[RESP_HDR_MAX_LEN];
+    int len = snprintf(resp, sizeof(resp),
+                       "HTTP/1.1 101 Switching Protocols\r\n"
+                       "Upgrade: websocket\r\n"
+                       "Connection: Upgrade\r\n"
+                       "Sec-WebSocket-Accept: %s\r\n\r\n", accept);
+
+    return SendAll(hostReq->server, hostReq->session, resp, (size_t)len);
+}
+
+static bool SendWsFrame(hostServer_t *server, hostSession_t *session, httpd_ws_type_t type, const uint8_t *payload, size_t len)
+{
+    uint8_t header[WS_FRAME_HEADER_MAX_LEN];
+    size_t headerLen = 2;
+
+    // server frames are not masked
+    header[0] = WS_FIN | (uint8_t)type;
+    if (len < WS_LEN_16) {
+        header[1] = (uint8_t)len;
+    } else if (len <= UINT16_MAX) {
+        header[1] = WS_LEN_16;
+        header[2] = (uint8_t)(len >> 8);
+        header[3] = (uint8_t)len;
+        headerLen = 4;
+    } else {
+        header[1] = WS_LEN_64;
+        for (uint8_t idx = 0; idx < 8; ++idx) {
+            header[2 + idx] = (uint8_t)((uint64_t)len >> (56U - (8U * idx)));
+        }
+        headerLen = 10;
+    }
+
+    return SendAll(server, session, (const char *)header, headerLen) &&
+           ((len == 0) || SendAll(server, session, (const char *)payload, len));
+}
+
+static bool SendAll(hostServer_t *server, hostSession_t *session, const char *buf, size_t len)
+{
+    while (len > 0) {
+        int ret = session->send(server, session->fd, buf, len, 0);
+        if (ret <= 0) {
+            return false;
+        }
+
+        buf += ret;
+        len -= (size_t)ret;
+    }
+
+    return true;
+}
+
+static bool RecvAll(int fd, void *buf, size_t len)
+{
+    uint8_t *pos = buf;
+
+    while (len > 0) {
+        ssize_t ret = recv(fd, pos, len, 0);
+        if (ret <= 0) {
+            return false;
+        }
+
+        pos += ret;
+        len -= (size_t)ret;
+    }
+
+    return true;
+}
+
+static bool SendRespHeaders(httpd_req_t *req, ssize_t contentLen)
+{
+    hostReq_t *hostReq = req->aux;
+    char headers[RESP_HDR_MAX_LEN];
+
+    if (hostReq->isHeaderSent) {
+        return false;
+    }
+
+    int len = snprintf(headers, sizeof(headers), "HTTP/1.1 %s\r\nContent-Type: %s\r\n", hostReq->status, hostReq->type);
+
+    if (contentLen < 0) {
+        hostReq->isChunked = true;
+        len += snprintf(&headers[len], sizeof(headers) - len, "Transfer-Encoding: chunked\r\n");
+    } else {
+        len += snprintf(&headers[len], sizeof(headers) - len, "Content-Length: %zd\r\n", contentLen);
+    }
+
+    for (uint16_t idx = 0; (idx < hostReq->respHeadersCount) && ((size_t)len < sizeof(headers)); ++idx) {
+        len += snprintf(&headers[len], sizeof(headers) - len, "%s: %s\r\n",
+                        hostReq->respHeaders[idx].field, hostReq->respHeaders[idx].value);
+    }
+
+    if (hostReq->isKeepAlive == false) {
+        len += snprintf(&headers[len], sizeof(headers) - len, "Connection: close\r\n");
+    }
+
+    len += snprintf(&headers[len], sizeof(headers) - len, "\r\n");
+    if ((size_t)len >= sizeof(headers)) {
+        ESP_LOGE(TAG, "response headers too long");
+        return false;
+    }
+
+    hostReq->isHeaderSent = true;
+
+    return SendAll(hostReq->server, hostReq->session, headers, (size_t)len);
+}
+
+static int DefaultSend(httpd_handle_t hd, int sockfd, const char *buf, size_t buf_len, int flags)
+{
+    (void)hd;
+
+    ssize_t ret = send(sockfd, buf, buf_len, flags | MSG_NOSIGNAL);
+    if (ret < 0) {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+    }
+
+    return (int)ret;
+}
+
+static const char *FindHeader(const hostReq_t *hostReq, const char *field, size_t *len)
+{
+    size_t fieldLen = strlen(field);
+
+    // first line is the request line
+    const char *line = strstr(hostReq->headers, "\r\n");
+
+    while ((line != NULL) && (line[2] != '\r')) {
+        line += 2;
+
+        const char *end = strstr(line, "\r\n");
+        if ((strncasecmp(line, field, fieldLen) == 0) && (line[fieldLen] == ':')) {
+            const char *value = &line[fieldLen + 1];
+            while ((value < end) && isspace((unsigned char)*value)) {
+                value++;
+            }
+
+            const char *valueEnd = end;
+            while ((valueEnd > value) && isspace((unsigned char)valueEnd[-1])) {
+                valueEnd--;
+            }
+
+            *len = (size_t)(valueEnd - value);
+            return value;
+        }
+
+        line = end;
+    }
+
+    return NULL;
+}
+
+static int ParseMethod(const char *method)
+{
+    static const int sMethods[] = { HTTP_DELETE, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_OPTIONS };
+
+    for (uint8_t idx = 0; idx < (sizeof(sMethods) / sizeof(sMethods[0])); ++idx) {
+        if (strcmp(method, http_method_str(sMethods[idx])) == 0) {
+            return sMethods[idx];
+        }
+    }
+
+    return -1;
+}
+
+static const char *GetErrorStatus(httpd_err_code_t error)
+{
+    switch (error) {
+    case HTTPD_501_METHOD_NOT_IMPLEMENTED:
+        return "501 Method Not Implemented";
+    case HTTPD_505_VERSION_NOT_SUPPORTED:
+        return "505 Version Not Supported";
+    case HTTPD_400_BAD_REQUEST:
+        return HTTPD_400;
+    case HTTPD_401_UNAUTHORIZED:
+        return "401 Unauthorized";
+    case HTTPD_403_FORBIDDEN:
+        return "403 Forbidden";
+    case HTTPD_404_NOT_FOUND:
+        return HTTPD_404;
+    case HTTPD_405_METHOD_NOT_ALLOWED:
+        return "405 Method Not Allowed";
+    case HTTPD_408_REQ_TIMEOUT:
+        return HTTPD_408;
+    case HTTPD_411_LENGTH_REQUIRED:
+        return "411 Length Required";
+    case HTTPD_414_URI_TOO_LONG:
+        return "414 URI Too Long";
+    case HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE:
+        return "431 Request Header Fields Too Large";
+    default:
+        return HTTPD_500;
+    }
+}
+
+static void Sha1Init(sha1_t *sha)
+{
+    static const uint32_t sInitState[5] = { 0x67452301U, 0xEFCDAB89U, 0x98BADCFEU, 0x10325476U, 0xC3D2E1F0U };
+
+    memset(sha, 0, sizeof(sha1_t));
+    memcpy(sha->state, sInitState, sizeof(sInitState));
+}
+
+static void Sha1Update(sha1_t *sha, const uint8_t *data, size_t len)
+{
+    sha->len += len;
+
+    while (len > 0) {
+        sha->block[sha->blockLen++] = *data++;
+        len--;
+
+        if (sha->blockLen == SHA1_BLOCK_LEN) {
+            Sha1Block(sha, sha->block);
+            sha->blockLen = 0;
+        }
+    }
+}
+
+static void Sha1Final(sha1_t *sha, uint8_t digest[SHA1_DIGEST_LEN])
+{
+    uint64_t bitLen = sha->len * 8U;
+    uint8_t pad = 0x80U;
+
+    Sha1Update(sha, &pad, 1);
+    pad = 0;
+    while (sha->blockLen != (SHA1_BLOCK_LEN - 8U)) {
+        Sha1Update(sha, &pad, 1);
+    }
+
+    uint8_t lenBytes[8];
+    for (uint8_t idx = 0; idx < 8; ++idx) {
+        lenBytes[idx] = (uint8_t)(bitLen >> (56U - (8U * idx)));
+    }
+    Sha1Update(sha, lenBytes, sizeof(lenBytes));
+
+    for (uint8_t idx = 0; idx < SHA1_DIGEST_LEN; ++idx) {
+        digest[idx] = (uint8_t)(sha->state[idx / 4U] >> (24U - (8U * (idx % 4U))));
+    }
+}
+
+static void Sha1Block(sha1_t *sha, const uint8_t block[SHA1_BLOCK_LEN])
+{
+    uint32_t w[80];
+
+    for (uint8_t idx = 0; idx < 16; ++idx) {
+        w[idx] = ((uint32_t)block[4 * idx] << 24) | ((uint32_t)block[4 * idx + 1] << 16) |
+                 ((uint32_t)block[4 * idx + 2] << 8) | (uint32_t)block[4 * idx + 3];
+    }
+    for (uint8_t idx = 16; idx < 80; ++idx) {
+        uint32_t value = w[idx - 3] ^ w[idx - 8] ^ w[idx - 14] ^ w[idx - 16];
+        w[idx] = (value << 1) | (value >> 31);
+    }
+
+    uint32_t a = sha->state[0];
+    uint32_t b = sha->state[1];
+    uint32_t c = sha->state[2];
+    uint32_t d = sha->state[3];
+    uint32_t e = sha->state[4];
+
+    for (uint8_t idx = 0; idx < 80; ++idx) {
+        uint32_t f;
+        uint32_t k;
+
+        if (idx < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999U;
+        } else if (idx < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1U;
+        } else if (idx < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDCU;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6U;
+        }
+
+        uint32_t temp = ((a << 5) | (a >> 27)) + f + e + k + w[idx];
+        e = d;
+        d = c;
+        c = (b << 30) | (b >> 2);
+        b = a;
+        a = temp;
+    }
+
+    sha->state[0] += a;
+    sha->state[1] += b;
+    sha->state[2] += c;
+    sha->state[3] += d;
+    sha->state[4] += e;
+}
+
+static void Base64Encode(const uint8_t *data, size_t len, char *out)
+{
+    static const char sAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    size_t pos = 0;
+    for (size_t idx = 0; idx < len; idx += 3) {
+        uint32_t value = (uint32_t)data[idx] << 16;
+        if ((idx + 1) < len) {
+            value |= (uint32_t)data[idx + 1] << 8;
+        }
+        if ((idx + 2) < len) {
+            value |= data[idx + 2];
+        }
+
+        out[pos++] = sAlphabet[(value >> 18) & 0x3FU];
+        out[pos++] = sAlphabet[(value >> 12) & 0x3FU];
+        out[pos++] = ((idx + 1) < len) ? sAlphabet[(value >> 6) & 0x3FU] : '=';
+        out[pos++] = ((idx + 2) < len) ? sAlphabet[value & 0x3FU] : '=';
+    }
+
+    out[pos] = '\0';
+}
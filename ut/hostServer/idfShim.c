@@ -0,0 +1,588 @@
+/**
+ * @file idfShim.c
+ *
+ * @brief host web server build: FreeRTOS, logging, timer and partition shims on top of POSIX
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "hostShim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_spi_flash.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "lwip/sockets.h"
+
+/*****************************************************************************
+                          PRIVATE DEFINES / MACROS
+*****************************************************************************/
+
+#define PARTITION_MAX_COUNT     (4U)
+#define PARTITION_PATH_MAX_LEN  (512U)
+
+/*****************************************************************************
+                     PRIVATE STRUCTS / ENUMS / VARIABLES
+*****************************************************************************/
+
+struct hostTask {
+    pthread_t thread;
+    TaskFunction_t function;
+    void *parameters;
+};
+
+struct hostSemaphore {
+    pthread_mutex_t mutex;
+};
+
+struct hostQueue {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint8_t *items;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+typedef struct {
+    esp_partition_t partition;
+    uint8_t *data;
+} hostPartition_t;
+
+static esp_log_level_t sLogLevel = ESP_LOG_INFO;
+static pthread_mutex_t sLogMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t sRandomSeedOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t sRandomMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static char sPartitionDir[PARTITION_PATH_MAX_LEN] = ".";
+static hostPartition_t sPartitions[PARTITION_MAX_COUNT];
+static pthread_mutex_t sPartitionMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const esp_app_desc_t sAppDesc = {
+    .version = "host",
+    .project_name = "iCON",
+    .time = __TIME__,
+    .date = __DATE__,
+    .idf_ver = "host",
+};
+
+/*****************************************************************************
+                         PRIVATE FUNCTION DECLARATION
+*****************************************************************************/
+
+/** @brief Thread entry of the task
+ *  @param arg task handle
+ *  @return NULL
+ */
+static void *TaskEntry(void *arg);
+
+/** @brief Seed random generator with the start time
+ */
+static void SeedRandom(void);
+
+/** @brief Get absolute time after the ticks
+ *  @param ticks number of ticks
+ *  @param deadline [out] absolute realtime clock deadline
+ */
+static void GetDeadline(TickType_t ticks, struct timespec *deadline);
+
+/*****************************************************************************
+                           INTERFACE IMPLEMENTATION
+*****************************************************************************/
+
+void HostPartitionSetDirectory(const char *dir)
+{
+    snprintf(sPartitionDir, sizeof(sPartitionDir), "%s", dir);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    (void)tag;
+
+    if (level > sLogLevel) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    pthread_mutex_lock(&sLogMutex);
+    vfprintf(stderr, format, args);
+    pthread_mutex_unlock(&sLogMutex);
+    va_end(args);
+}
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+
+    sLogLevel = level;
+}
+
+uint32_t esp_random(void)
+{
+    pthread_once(&sRandomSeedOnce, SeedRandom);
+
+    pthread_mutex_lock(&sRandomMutex);
+    uint32_t value = ((uint32_t)random() << 16) ^ (uint32_t)random();
+    pthread_mutex_unlock(&sRandomMutex);
+
+    return value;
+}
+
+void esp_restart(void)
+{
+    ESP_LOGW("idfShim", "restart requested, host server exits");
+    exit(EXIT_SUCCESS);
+}
+
+esp_reset_reason_t esp_reset_reason(void)
+{
+    return ESP_RST_POWERON;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((int64_t)now.tv_sec * 1000000LL) + (now.tv_nsec / 1000);
+}
+
+esp_err_t esp_event_loop_create_default(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_dhcps_stop(tcpip_adapter_if_t tcpip_if)
+{
+    (void)tcpip_if;
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_dhcps_start(tcpip_adapter_if_t tcpip_if)
+{
+    (void)tcpip_if;
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_set_ip_info(tcpip_adapter_if_t tcpip_if, const tcpip_adapter_ip_info_t *ip_info)
+{
+    (void)tcpip_if;
+    (void)ip_info;
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_set_dns_info(tcpip_adapter_if_t tcpip_if, tcpip_adapter_dns_type_t type, tcpip_adapter_dns_info_t *dns)
+{
+    (void)tcpip_if;
+    (void)type;
+    (void)dns;
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_dhcps_option(tcpip_adapter_dhcp_option_mode_t opt_op, tcpip_adapter_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len)
+{
+    (void)opt_op;
+    (void)opt_id;
+    (void)opt_val;
+    (void)opt_len;
+    return ESP_OK;
+}
+
+const esp_app_desc_t *esp_ota_get_app_description(void)
+{
+    return &sAppDesc;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label)
+{
+    const esp_partition_t *found = NULL;
+
+    pthread_mutex_lock(&sPartitionMutex);
+
+    hostPartition_t *freeSlot = NULL;
+    for (uint8_t idx = 0; idx < PARTITION_MAX_COUNT; ++idx) {
+        if ((sPartitions[idx].data != NULL) && (strcmp(sPartitions[idx].partition.label, label) == 0)) {
+            found = &sPartitions[idx].partition;
+            break;
+        }
+
+        if ((freeSlot == NULL) && (sPartitions[idx].data == NULL)) {
+            freeSlot = &sPartitions[idx];
+        }
+    }
+
+    if ((found == NULL) && (freeSlot != NULL)) {
+        char path[PARTITION_PATH_MAX_LEN + sizeof(freeSlot->partition.label) + 8];
+        snprintf(path, sizeof(path), "%s/%s.bin", sPartitionDir, label);
+
+        // the whole image is kept in memory, mapping is a pointer into it
+        FILE *file = fopen(path, "rb");
+        if (file != NULL) {
+            fseek(file, 0, SEEK_END);
+            long size = ftell(file);
+            fseek(file, 0, SEEK_SET);
+
+            uint8_t *data = (size > 0) ? malloc(size) : NULL;
+            if ((data != NULL) && (fread(data, 1, size, file) == (size_t)size)) {
+                freeSlot->data = data;
+                freeSlot->partition.type = type;
+                freeSlot->partition.subtype = subtype;
+                freeSlot->partition.size = (uint32_t)size;
+                snprintf(freeSlot->partition.label, sizeof(freeSlot->partition.label), "%s", label);
+                found = &freeSlot->partition;
+            } else {
+                free(data);
+            }
+
+            fclose(file);
+        }
+    }
+
+    pthread_mutex_unlock(&sPartitionMutex);
+
+    return found;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size)
+{
+    const hostPartition_t *hostPartition = (const hostPartition_t *)partition;
+
+    if ((src_offset > partition->size) || (size > (partition->size - src_offset))) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memcpy(dst, &hostPartition->data[src_offset], size);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size)
+{
+    hostPartition_t *hostPartition = (hostPartition_t *)partition;
+
+    if ((dst_offset > partition->size) || (size > (partition->size - dst_offset))) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memcpy(&hostPartition->data[dst_offset], src, size);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    hostPartition_t *hostPartition = (hostPartition_t *)partition;
+
+    if ((offset > partition->size) || (size > (partition->size - offset))) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memset(&hostPartition->data[offset], 0xFF, size);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             spi_flash_mmap_memory_t memory, const void **out_ptr, spi_flash_mmap_handle_t *out_handle)
+{
+    (void)memory;
+
+    const hostPartition_t *hostPartition = (const hostPartition_t *)partition;
+
+    if ((offset > partition->size) || (size > (partition->size - offset))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *out_ptr = &hostPartition->data[offset];
+    *out_handle = (spi_flash_mmap_handle_t)(uintptr_t)hostPartition;
+
+    return ESP_OK;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t handle)
+{
+    // image stays in memory until exit
+    (void)handle;
+}
+
+char *inet_ntoa_r(struct in_addr addr, char *buf, int buflen)
+{
+    return (char *)inet_ntop(AF_INET, &addr, buf, (socklen_t)buflen);
+}
+
+#ifdef HOST_COMPAT_STRLCPY
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+
+    if (size > 0) {
+        size_t copyLen = (len < size) ? len : (size - 1);
+        memcpy(dst, src, copyLen);
+        dst[copyLen] = '\0';
+    }
+
+    return len;
+}
+#endif
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *createdTask)
+{
+    (void)stackDepth;
+    (void)priority;
+
+    struct hostTask *handle = calloc(1, sizeof(struct hostTask));
+    if (handle == NULL) {
+        return pdFAIL;
+    }
+
+    handle->function = task;
+    handle->parameters = parameters;
+
+    if (pthread_create(&handle->thread, NULL, TaskEntry, handle) != 0) {
+        free(handle);
+        return pdFAIL;
+    }
+
+    pthread_detach(handle->thread);
+    ESP_LOGD("idfShim", "task %s created", name);
+
+    if (createdTask != NULL) {
+        *createdTask = handle;
+    }
+
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if ((task == NULL) || pthread_equal(task->thread, pthread_self())) {
+        pthread_exit(NULL);
+    }
+
+    // other tasks can't be stopped safely on host, they keep running until exit
+    ESP_LOGW("idfShim", "vTaskDelete of other task ignored");
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec delay = {
+        .tv_sec = ticks / 1000U,
+        .tv_nsec = (long)(ticks % 1000U) * 1000000L,
+    };
+
+    while ((nanosleep(&delay, &delay) != 0) && (errno == EINTR)) {
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000LL);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    SemaphoreHandle_t semaphore = calloc(1, sizeof(struct hostSemaphore));
+    if (semaphore == NULL) {
+        return NULL;
+    }
+
+    // FreeRTOS mutexes are not recursive, default mutex type is the closest one
+    pthread_mutex_init(&semaphore->mutex, NULL);
+
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    if (ticks == portMAX_DELAY) {
+        return (pthread_mutex_lock(&semaphore->mutex) == 0) ? pdTRUE : pdFALSE;
+    }
+
+    struct timespec deadline;
+    GetDeadline(ticks, &deadline);
+
+    return (pthread_mutex_timedlock(&semaphore->mutex, &deadline) == 0) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    pthread_mutex_destroy(&semaphore->mutex);
+    free(semaphore);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    QueueHandle_t queue = calloc(1, sizeof(struct hostQueue));
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    queue->items = malloc((size_t)length * itemSize);
+    if (queue->items == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    queue->length = length;
+    queue->itemSize = itemSize;
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    pthread_cond_destroy(&queue->cond);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue->items);
+    free(queue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    struct timespec deadline;
+    GetDeadline(ticks, &deadline);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (queue->count == queue->length) {
+        if ((ticks == 0) ||
+            ((ticks == portMAX_DELAY) ? (pthread_cond_wait(&queue->cond, &queue->mutex) != 0) :
+                                        (pthread_cond_timedwait(&queue->cond, &queue->mutex, &deadline) != 0))) {
+            pthread_mutex_unlock(&queue->mutex);
+            return pdFALSE;
+        }
+    }
+
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(&queue->items[(size_t)tail * queue->itemSize], item, queue->itemSize);
+    queue->count += 1;
+
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    struct timespec deadline;
+    GetDeadline(ticks, &deadline);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (queue->count == 0) {
+        if ((ticks == 0) ||
+            ((ticks == portMAX_DELAY) ? (pthread_cond_wait(&queue->cond, &queue->mutex) != 0) :
+                                        (pthread_cond_timedwait(&queue->cond, &queue->mutex, &deadline) != 0))) {
+            pthread_mutex_unlock(&queue->mutex);
+            return pdFALSE;
+        }
+    }
+
+    memcpy(item, &queue->items[(size_t)queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count -= 1;
+
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return pdTRUE;
+}
+
+/******************************************************************************
+                        PRIVATE FUNCTION IMPLEMENTATION
+******************************************************************************/
+
+static void *TaskEntry(void *arg)
+{
+    struct hostTask *handle = arg;
+
+    handle->function(handle->parameters);
+
+    return NULL;
+}
+
+static void SeedRandom(void)
+{
+    srandom((unsigned int)(time(NULL) ^ esp_timer_get_time()));
+}
+
+static void GetDeadline(TickType_t ticks, struct timespec *deadline)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+
+    if (ticks == portMAX_DELAY) {
+        return;
+    }
+
+    deadline->tv_sec += ticks / 1000U;
+    deadline->tv_nsec += (long)(ticks % 1000U) * 1000000L;
+
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
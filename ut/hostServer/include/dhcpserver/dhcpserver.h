@@ -0,0 +1,20 @@
+/**
+ * @file dhcpserver.h
+ *
+ * @brief host web server build: dhcp server options
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t dhcps_offer_t;
+
+#define OFFER_START  (0x00U)
+#define OFFER_ROUTER (0x01U)
+#define OFFER_DNS    (0x02U)
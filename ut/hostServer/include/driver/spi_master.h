@@ -0,0 +1,14 @@
+/**
+ * @file spi_master.h
+ *
+ * @brief host web server build: spi types
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+typedef struct spi_device_t *spi_device_handle_t;
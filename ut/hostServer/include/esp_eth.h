@@ -0,0 +1,16 @@
+/**
+ * @file esp_eth.h
+ *
+ * @brief host web server build: nothing of esp_eth is used by the host build
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "esp_err.h"
+
+#include "esp_eth_mac.h"
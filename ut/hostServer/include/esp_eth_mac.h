@@ -0,0 +1,27 @@
+/**
+ * @file esp_eth_mac.h
+ *
+ * @brief host web server build: ethernet types used by the settings
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "esp_err.h"
+
+typedef enum {
+    ETHERNET_EVENT_START,
+    ETHERNET_EVENT_STOP,
+    ETHERNET_EVENT_CONNECTED,
+    ETHERNET_EVENT_DISCONNECTED,
+} eth_event_t;
+
+typedef struct esp_eth_mac_s esp_eth_mac_t;
+
+typedef struct {
+    int unused;
+} eth_mac_config_t;
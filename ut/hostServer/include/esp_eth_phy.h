@@ -0,0 +1,18 @@
+/**
+ * @file esp_eth_phy.h
+ *
+ * @brief host web server build: ethernet phy types
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+typedef struct esp_eth_phy_s esp_eth_phy_t;
+
+typedef struct {
+    int unused;
+} eth_phy_config_t;
@@ -0,0 +1,19 @@
+/**
+ * @file esp_event.h
+ *
+ * @brief host web server build: esp_event subset
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "esp_err.h"
+
+/** @brief Create default event loop, nothing to do on host
+ *  @return ESP_OK
+ */
+esp_err_t esp_event_loop_create_default(void);
@@ -0,0 +1,79 @@
+/**
+ * @file esp_netif.h
+ *
+ * @brief host web server build: esp_netif and tcpip_adapter subset, the access point setup is a no-op
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+
+typedef struct {
+    uint32_t addr;
+} esp_ip4_addr_t;
+
+typedef struct {
+    union {
+        esp_ip4_addr_t ip4;
+        uint32_t ip6[4];
+    } u_addr;
+    uint8_t type;
+} esp_ip_addr_t;
+
+#define ESP_IPADDR_TYPE_V4 (0U)
+
+// address is kept in network order as on the device
+#define IP4_ADDR(ipaddr, a, b, c, d) \
+    ((ipaddr)->addr = ((uint32_t)((d) & 0xff) << 24) | ((uint32_t)((c) & 0xff) << 16) | ((uint32_t)((b) & 0xff) << 8) | (uint32_t)((a) & 0xff))
+
+typedef enum {
+    TCPIP_ADAPTER_IF_STA = 0,
+    TCPIP_ADAPTER_IF_AP,
+    TCPIP_ADAPTER_IF_ETH,
+} tcpip_adapter_if_t;
+
+typedef enum {
+    TCPIP_ADAPTER_DNS_MAIN = 0,
+    TCPIP_ADAPTER_DNS_BACKUP,
+    TCPIP_ADAPTER_DNS_FALLBACK,
+} tcpip_adapter_dns_type_t;
+
+typedef enum {
+    TCPIP_ADAPTER_OP_START = 0,
+    TCPIP_ADAPTER_OP_SET,
+    TCPIP_ADAPTER_OP_GET,
+} tcpip_adapter_dhcp_option_mode_t;
+
+typedef enum {
+    TCPIP_ADAPTER_DOMAIN_NAME_SERVER = 6,
+    TCPIP_ADAPTER_REQUESTED_IP_ADDRESS = 50,
+} tcpip_adapter_dhcp_option_id_t;
+
+typedef struct {
+    esp_ip4_addr_t ip;
+    esp_ip4_addr_t netmask;
+    esp_ip4_addr_t gw;
+} tcpip_adapter_ip_info_t;
+
+typedef struct {
+    esp_ip_addr_t ip;
+} tcpip_adapter_dns_info_t;
+
+/** @brief Initialize network interfaces, nothing to do on host
+ *  @return ESP_OK
+ */
+esp_err_t esp_netif_init(void);
+
+esp_err_t tcpip_adapter_dhcps_stop(tcpip_adapter_if_t tcpip_if);
+esp_err_t tcpip_adapter_dhcps_start(tcpip_adapter_if_t tcpip_if);
+esp_err_t tcpip_adapter_set_ip_info(tcpip_adapter_if_t tcpip_if, const tcpip_adapter_ip_info_t *ip_info);
+esp_err_t tcpip_adapter_set_dns_info(tcpip_adapter_if_t tcpip_if, tcpip_adapter_dns_type_t type, tcpip_adapter_dns_info_t *dns);
+esp_err_t tcpip_adapter_dhcps_option(tcpip_adapter_dhcp_option_mode_t opt_op, tcpip_adapter_dhcp_option_id_t opt_id, void *opt_val, uint32_t opt_len);
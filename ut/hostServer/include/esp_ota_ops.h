@@ -0,0 +1,33 @@
+/**
+ * @file esp_ota_ops.h
+ *
+ * @brief host web server build: application description
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_system.h"
+
+typedef struct {
+    uint32_t magic_word;
+    uint32_t secure_version;
+    uint32_t reserv1[2];
+    char version[32];
+    char project_name[32];
+    char time[16];
+    char date[16];
+    char idf_ver[32];
+    uint8_t app_elf_sha256[32];
+} esp_app_desc_t;
+
+/** @brief Get description of the running application
+ *  @return host build description
+ */
+const esp_app_desc_t *esp_ota_get_app_description(void);
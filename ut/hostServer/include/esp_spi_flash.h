@@ -0,0 +1,27 @@
+/**
+ * @file esp_spi_flash.h
+ *
+ * @brief host web server build: flash mapping is a copy of the partition file in memory
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    SPI_FLASH_MMAP_DATA,
+    SPI_FLASH_MMAP_INST,
+} spi_flash_mmap_memory_t;
+
+typedef uintptr_t spi_flash_mmap_handle_t;
+
+/** @brief Release mapped partition
+ *  @param handle mapping handle
+ */
+void spi_flash_munmap(spi_flash_mmap_handle_t handle);
@@ -0,0 +1,44 @@
+/**
+ * @file esp_system.h
+ *
+ * @brief host web server build: esp_system subset
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO,
+} esp_reset_reason_t;
+
+/** @brief Get random number
+ *  @return random number
+ */
+uint32_t esp_random(void);
+
+/** @brief Terminate the host server
+ */
+void esp_restart(void) __attribute__((noreturn));
+
+/** @brief Get reset reason
+ *  @return ESP_RST_POWERON on host
+ */
+esp_reset_reason_t esp_reset_reason(void);
@@ -0,0 +1,19 @@
+/**
+ * @file esp_timer.h
+ *
+ * @brief host web server build: esp_timer subset
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/** @brief Get time since start
+ *  @return monotonic time in us
+ */
+int64_t esp_timer_get_time(void);
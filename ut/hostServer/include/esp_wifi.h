@@ -0,0 +1,17 @@
+/**
+ * @file esp_wifi.h
+ *
+ * @brief host web server build: nothing of esp_wifi is used by the host build
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "esp_err.h"
+
+#include "esp_wifi_types.h"
+#include "esp_netif.h"
@@ -0,0 +1,48 @@
+/**
+ * @file FreeRTOS.h
+ *
+ * @brief host web server build: FreeRTOS subset on top of POSIX threads, one tick is one millisecond
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "sdkconfig.h"
+#include "esp_system.h"
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE             ((BaseType_t)0)
+#define pdTRUE              ((BaseType_t)1)
+#define pdPASS              (pdTRUE)
+#define pdFAIL              (pdFALSE)
+
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS  ((TickType_t)1)
+#define portTICK_RATE_MS    (portTICK_PERIOD_MS)
+#define configTICK_RATE_HZ  (1000)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+
+#define configMAX_TASK_NAME_LEN (16)
+
+// critical sections are a recursive-free mutex, good enough for the short sections in the web server
+typedef pthread_mutex_t portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    PTHREAD_MUTEX_INITIALIZER
+#define portENTER_CRITICAL(mux)         pthread_mutex_lock(mux)
+#define portEXIT_CRITICAL(mux)          pthread_mutex_unlock(mux)
+#define portENTER_CRITICAL_ISR(mux)     pthread_mutex_lock(mux)
+#define portEXIT_CRITICAL_ISR(mux)      pthread_mutex_unlock(mux)
+#define taskENTER_CRITICAL(mux)         pthread_mutex_lock(mux)
+#define taskEXIT_CRITICAL(mux)          pthread_mutex_unlock(mux)
@@ -0,0 +1,44 @@
+/**
+ * @file queue.h
+ *
+ * @brief host web server build: fixed item size queues
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct hostQueue *QueueHandle_t;
+
+/** @brief Create queue
+ *  @param length maximum number of items
+ *  @param itemSize item size in bytes
+ *  @return queue handle, NULL if no memory
+ */
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+
+/** @brief Delete queue, nobody may wait on it
+ *  @param queue queue handle
+ */
+void vQueueDelete(QueueHandle_t queue);
+
+/** @brief Copy item to the back of the queue
+ *  @param queue queue handle
+ *  @param item item to copy
+ *  @param ticks maximum wait time for free space
+ *  @return pdTRUE if queued
+ */
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+
+/** @brief Copy item from the front of the queue
+ *  @param queue queue handle
+ *  @param item [out] item buffer
+ *  @param ticks maximum wait time for an item
+ *  @return pdTRUE if received
+ */
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
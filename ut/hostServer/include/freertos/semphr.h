@@ -0,0 +1,39 @@
+/**
+ * @file semphr.h
+ *
+ * @brief host web server build: mutexes with timed take
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct hostSemaphore *SemaphoreHandle_t;
+
+/** @brief Create mutex
+ *  @return mutex handle, NULL if no memory
+ */
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+
+/** @brief Take mutex
+ *  @param semaphore mutex handle
+ *  @param ticks maximum wait time
+ *  @return pdTRUE if taken
+ */
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+
+/** @brief Give mutex
+ *  @param semaphore mutex handle
+ *  @return pdTRUE
+ */
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+
+/** @brief Delete mutex
+ *  @param semaphore mutex handle
+ */
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
@@ -0,0 +1,44 @@
+/**
+ * @file task.h
+ *
+ * @brief host web server build: tasks are detached POSIX threads
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+typedef struct hostTask *TaskHandle_t;
+
+/** @brief Create task as detached thread, stack size and priority are ignored
+ *  @param task task function
+ *  @param name task name
+ *  @param stackDepth ignored
+ *  @param parameters task parameter
+ *  @param priority ignored
+ *  @param createdTask [out] task handle, may be NULL
+ *  @return pdPASS if created
+ */
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *createdTask);
+
+/** @brief Delete task, only the calling task can be deleted on host
+ *  @param task NULL or handle of the calling task
+ */
+void vTaskDelete(TaskHandle_t task);
+
+/** @brief Sleep
+ *  @param ticks number of ticks
+ */
+void vTaskDelay(TickType_t ticks);
+
+/** @brief Get tick count
+ *  @return milliseconds since start
+ */
+TickType_t xTaskGetTickCount(void);
@@ -0,0 +1,28 @@
+/**
+ * @file hostCompat.h
+ *
+ * @brief host web server build: newlib functions missing in older host C libraries,
+ *        force included in every host server source
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+#define HOST_COMPAT_STRLCPY
+
+/** @brief Copy string with truncation, always terminated if size is not zero
+ *  @param dst destination buffer
+ *  @param src source string
+ *  @param size destination buffer size
+ *  @return length of the source string
+ */
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
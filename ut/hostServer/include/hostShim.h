@@ -0,0 +1,24 @@
+/**
+ * @file hostShim.h
+ *
+ * @brief host web server build: host only configuration of the shims
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/** @brief Set directory with partition images, partition "label" is read from "dir/label.bin"
+ *  @param dir directory path
+ */
+void HostPartitionSetDirectory(const char *dir);
+
+/** @brief Override port from httpd_config_t, the device port 80 needs privileges on host
+ *  @param port tcp port, 0 keeps the configured port
+ */
+void HostHttpdSetPort(uint16_t port);
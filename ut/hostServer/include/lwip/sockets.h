@@ -0,0 +1,33 @@
+/**
+ * @file sockets.h
+ *
+ * @brief host web server build: lwip sockets are the POSIX sockets
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "sdkconfig.h"
+
+#define LWIP_SOCKET_OFFSET (0)
+
+/** @brief Convert address to dotted decimal string, reentrant lwip variant of inet_ntoa
+ *  @param addr ipv4 address
+ *  @param buf [out] string buffer
+ *  @param buflen buffer size
+ *  @return buf, NULL if buffer is too small
+ */
+char *inet_ntoa_r(struct in_addr addr, char *buf, int buflen);
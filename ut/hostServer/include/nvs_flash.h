@@ -0,0 +1,14 @@
+/**
+ * @file nvs_flash.h
+ *
+ * @brief host web server build: nothing of nvs_flash is used by the host build
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#include "esp_err.h"
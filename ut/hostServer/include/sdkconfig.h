@@ -0,0 +1,19 @@
+/**
+ * @file sdkconfig.h
+ *
+ * @brief host web server build: sdkconfig values used by the web server
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+#define CONFIG_HTTPD_WS_SUPPORT 1
+#define CONFIG_HTTPD_MAX_REQ_HDR_LEN 1024
+#define CONFIG_HTTPD_MAX_URI_LEN 512
+
+// host socket numbers are not limited to lwip range, table of sockets is sized for the host
+#define CONFIG_LWIP_MAX_SOCKETS 256
@@ -1,2 +1,42 @@
 create_test (ut-template                  main/middleware/template/templateTests.c
                                           ../main/middleware/template/template.c)
+
+create_test (ut-lruCache                  main/middleware/utils/lruCache/lruCacheTests.c
+                                          ../main/middleware/utils/lruCache/lruCache.c)
+
+create_test (ut-webArchive                main/middleware/utils/webArchive/webArchiveTests.c
+                                          ../main/middleware/utils/webArchive/webArchive.c)
+
+create_test (ut-jsonStream                main/middleware/utils/jsonStream/jsonStreamTests.c
+                                          ../main/middleware/utils/jsonStream/jsonStream.c)
+
+create_test (ut-captiveDns                main/middleware/utils/captiveDns/captiveDnsTests.c
+                                          ../main/middleware/utils/captiveDns/captiveDns.c)
+
+create_test (ut-requestMetrics            main/middleware/utils/requestMetrics/requestMetricsTests.c
+                                          ../main/middleware/utils/requestMetrics/requestMetrics.c)
+
+create_test (ut-gesture                   main/middleware/utils/gesture/gestureTests.c
+                                          ../main/middleware/utils/gesture/gesture.c)
+
+create_test (ut-noiseFloor                main/middleware/utils/noiseFloor/noiseFloorTests.c
+                                          ../main/middleware/utils/noiseFloor/noiseFloor.c)
+
+create_test (ut-piController             main/middleware/utils/piController/piControllerTests.c
+                                          ../main/middleware/utils/piController/piController.c)
+
+create_test (ut-filterLoad               main/middleware/utils/filterLoad/filterLoadTests.c
+                                          ../main/middleware/utils/filterLoad/filterLoad.c)
+
+create_test (ut-pwmSweep                main/middleware/utils/pwmSweep/pwmSweepTests.c
+                                          ../main/middleware/utils/pwmSweep/pwmSweep.c)
+
+create_test (ut-dspFilter               main/middleware/utils/dspFilter/dspFilterTests.c)
+
+# compressed output is verified by decompressing it with host zlib
+find_package(ZLIB)
+if(ZLIB_FOUND)
+    create_test (ut-deflate               main/middleware/utils/deflate/deflateTests.c
+                                          ../main/middleware/utils/deflate/deflate.c)
+    target_link_libraries(ut-deflate ZLIB::ZLIB)
+endif()
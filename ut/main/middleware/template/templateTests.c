@@ -1,5 +1,6 @@
 #include "fff.h"
 #include "minunit.h"
+#include "utRunner.h"
 
 // UUT
 #include "middleware/template/template.h"
@@ -7,18 +8,12 @@
 
 #include <stdint.h>
 
-DEFINE_FFF_GLOBALS;
-
 void test_setup()
 {
     FFF_RESET_HISTORY();
     FakeTemplateDriverReset();
 }
 
-void test_teardown()
-{
-}
-
 MU_TEST(TemplateFunctionDummyTest)
 {
     mu_assert(1 == Template(0));
@@ -26,14 +21,9 @@ MU_TEST(TemplateFunctionDummyTest)
 
 MU_TEST_SUITE(TemplateTest)
 {
-    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
 
     MU_RUN_TEST(TemplateFunctionDummyTest);
 }
 
-int main(int argc, char *argv[])
-{
-    MU_RUN_SUITE(TemplateTest);
-    MU_REPORT();
-    return minunit_fail;
-}
+UT_RUNNER_SUITE(TemplateTest);
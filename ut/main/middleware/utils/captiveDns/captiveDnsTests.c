@@ -0,0 +1,87 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/captiveDns/captiveDns.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static const uint8_t sIp[4] = { 192, 168, 4, 1 };
+static uint8_t sResponse[CAPTIVE_DNS_MAX_PACKET_LEN];
+static uint32_t sResponseLen;
+
+// id 0x1234, recursion desired, one question: connectivitycheck.gstatic.com
+#define QUERY_HEADER 0x12, 0x34, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+#define QUERY_NAME 17, 'c', 'o', 'n', 'n', 'e', 'c', 't', 'i', 'v', 'i', 't', 'y', 'c', 'h', 'e', 'c', 'k', \
+                   7, 'g', 's', 't', 'a', 't', 'i', 'c', 3, 'c', 'o', 'm', 0
+
+void test_setup()
+{
+    memset(sResponse, 0, sizeof(sResponse));
+    sResponseLen = 0;
+}
+
+MU_TEST(CaptiveDnsAQueryTest)
+{
+    const uint8_t query[] = { QUERY_HEADER, QUERY_NAME, 0x00, 0x01, 0x00, 0x01 };
+    const uint8_t answer[] = { 0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, CAPTIVE_DNS_TTL_S, 0x00, 0x04, 192, 168, 4, 1 };
+
+    mu_assert(CaptiveDnsBuildResponse(query, sizeof(query), sIp, sResponse, sizeof(sResponse), &sResponseLen));
+    mu_assert_int_eq(sizeof(query) + sizeof(answer), sResponseLen);
+
+    // id, response + authoritative + recursion flags, one question, one answer
+    mu_assert_int_eq(0x12, sResponse[0]);
+    mu_assert_int_eq(0x34, sResponse[1]);
+    mu_assert_int_eq(0x85, sResponse[2]);
+    mu_assert_int_eq(0x80, sResponse[3]);
+    mu_assert_int_eq(1, sResponse[5]);
+    mu_assert_int_eq(1, sResponse[7]);
+    mu_assert(memcmp(&sResponse[12], &query[12], sizeof(query) - 12) == 0);
+    mu_assert(memcmp(&sResponse[sizeof(query)], answer, sizeof(answer)) == 0);
+}
+
+MU_TEST(CaptiveDnsAaaaQueryTest)
+{
+    const uint8_t query[] = { QUERY_HEADER, QUERY_NAME, 0x00, 0x1C, 0x00, 0x01 };
+
+    mu_assert(CaptiveDnsBuildResponse(query, sizeof(query), sIp, sResponse, sizeof(sResponse), &sResponseLen));
+    mu_assert_int_eq(sizeof(query), sResponseLen);
+    mu_assert_int_eq(0, sResponse[7]);
+}
+
+MU_TEST(CaptiveDnsNotImplementedTest)
+{
+    // inverse query opcode
+    const uint8_t query[] = { 0x12, 0x34, 0x08, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, QUERY_NAME, 0x00, 0x01, 0x00, 0x01 };
+
+    mu_assert(CaptiveDnsBuildResponse(query, sizeof(query), sIp, sResponse, sizeof(sResponse), &sResponseLen));
+    mu_assert_int_eq(12, sResponseLen);
+    mu_assert_int_eq(4, sResponse[3] & 0x0F);
+}
+
+MU_TEST(CaptiveDnsMalformedTest)
+{
+    const uint8_t response[] = { 0x12, 0x34, 0x81, 0x80, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, QUERY_NAME, 0x00, 0x01, 0x00, 0x01 };
+    const uint8_t truncatedName[] = { QUERY_HEADER, 17, 'c', 'o', 'n' };
+    const uint8_t noType[] = { QUERY_HEADER, QUERY_NAME, 0x00 };
+    const uint8_t pointer[] = { QUERY_HEADER, 0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01 };
+
+    mu_assert(CaptiveDnsBuildResponse(response, sizeof(response), sIp, sResponse, sizeof(sResponse), &sResponseLen) == false);
+    mu_assert(CaptiveDnsBuildResponse(truncatedName, sizeof(truncatedName), sIp, sResponse, sizeof(sResponse), &sResponseLen) == false);
+    mu_assert(CaptiveDnsBuildResponse(noType, sizeof(noType), sIp, sResponse, sizeof(sResponse), &sResponseLen) == false);
+    mu_assert(CaptiveDnsBuildResponse(pointer, sizeof(pointer), sIp, sResponse, sizeof(sResponse), &sResponseLen) == false);
+    mu_assert(CaptiveDnsBuildResponse(response, 4, sIp, sResponse, sizeof(sResponse), &sResponseLen) == false);
+}
+
+MU_TEST_SUITE(CaptiveDnsTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(CaptiveDnsAQueryTest);
+    MU_RUN_TEST(CaptiveDnsAaaaQueryTest);
+    MU_RUN_TEST(CaptiveDnsNotImplementedTest);
+    MU_RUN_TEST(CaptiveDnsMalformedTest);
+}
+
+UT_RUNNER_SUITE(CaptiveDnsTest);
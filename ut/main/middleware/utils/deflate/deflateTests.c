@@ -0,0 +1,77 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/deflate/deflate.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#define BUF_SIZE (4096U)
+
+static uint8_t sCompressed[BUF_SIZE];
+static uint8_t sDecompressed[BUF_SIZE];
+
+/* compressed with the UUT, decompressed with zlib */
+static void RoundTrip(const uint8_t *data, uint32_t len, uint32_t *compressedLen)
+{
+    uLongf decompressedLen = sizeof(sDecompressed);
+
+    mu_assert(DeflateCompress(data, len, sCompressed, sizeof(sCompressed), compressedLen));
+    mu_assert_int_eq(Z_OK, uncompress(sDecompressed, &decompressedLen, sCompressed, *compressedLen));
+    mu_assert_int_eq(len, decompressedLen);
+    mu_assert(memcmp(data, sDecompressed, len) == 0);
+}
+
+MU_TEST(DeflateSchedulerJsonTest)
+{
+    char json[2048] = "{\"MessageName\":\"deviceSchedule\",\"DeviceId\":\"iCON-0123\",\"ecoModes\":[";
+    for (uint32_t day = 0; day < 7; ++day) {
+        char entry[160];
+        snprintf(entry, sizeof(entry), "%s{\"day\":%u,\"on\":true,\"startHour\":%u,\"startMinute\":0,\"stopHour\":%u,\"stopMinute\":30,\"fan\":%u}",
+                 (day == 0) ? "" : ",", day, 6 + day, 18 + (day % 3), 1 + (day % 4));
+        strcat(json, entry);
+    }
+    strcat(json, "]}");
+
+    uint32_t compressedLen = 0;
+    RoundTrip((const uint8_t *)json, strlen(json), &compressedLen);
+
+    printf("\nscheduler json %u B -> %u B\n", (uint32_t)strlen(json), compressedLen);
+    mu_assert(compressedLen < (strlen(json) / 2));
+}
+
+MU_TEST(DeflateEdgeCasesTest)
+{
+    uint8_t data[BUF_SIZE / 2];
+    uint32_t compressedLen = 0;
+
+    RoundTrip((const uint8_t *)"", 0, &compressedLen);
+    RoundTrip((const uint8_t *)"a", 1, &compressedLen);
+    RoundTrip((const uint8_t *)"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 76, &compressedLen);
+
+    // all byte values, long runs longer than maximal match
+    for (uint32_t idx = 0; idx < sizeof(data); ++idx) {
+        data[idx] = (idx < 1024U) ? (uint8_t)(idx * 7U) : 0x55U;
+    }
+    RoundTrip(data, sizeof(data), &compressedLen);
+}
+
+MU_TEST(DeflateOutputTooSmallTest)
+{
+    const char *text = "{\"fan\":3,\"fan\":3,\"fan\":3}";
+    uint32_t compressedLen = 0;
+
+    mu_assert(DeflateCompress((const uint8_t *)text, strlen(text), sCompressed, 8, &compressedLen) == false);
+}
+
+MU_TEST_SUITE(DeflateTest)
+{
+    MU_RUN_TEST(DeflateSchedulerJsonTest);
+    MU_RUN_TEST(DeflateEdgeCasesTest);
+    MU_RUN_TEST(DeflateOutputTooSmallTest);
+}
+
+UT_RUNNER_SUITE(DeflateTest);
@@ -0,0 +1,133 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/dspFilter/dspFilter.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+DSP_BOXCAR_DEFINE(sBoxcar, 4);
+DSP_MEDIAN_DEFINE(sMedian, 5);
+
+void test_setup()
+{
+    DspBoxcarReset(&sBoxcar);
+    DspMedianReset(&sMedian);
+}
+
+MU_TEST(DspBoxcarTest)
+{
+    // mean of the samples so far until the window is full
+    mu_assert_int_eq(100, DspBoxcarFilter(&sBoxcar, 100));
+    mu_assert_int_eq(150, DspBoxcarFilter(&sBoxcar, 200));
+    mu_assert_int_eq(200, DspBoxcarFilter(&sBoxcar, 300));
+    mu_assert_int_eq(250, DspBoxcarFilter(&sBoxcar, 400));
+    mu_assert_int_eq(350, DspBoxcarFilter(&sBoxcar, 500));
+
+    // no overflow of the sum with full scale samples
+    for (uint8_t idx = 0; idx < 4; ++idx) {
+        DspBoxcarFilter(&sBoxcar, UINT32_MAX);
+    }
+    mu_assert(DspBoxcarFilter(&sBoxcar, UINT32_MAX) == UINT32_MAX);
+}
+
+MU_TEST(DspEmaTest)
+{
+    dspEma_t ema = DSP_EMA_INIT(2);
+
+    // the first sample seeds the filter, then a quarter of the step per sample
+    mu_assert_int_eq(1000, DspEmaFilter(&ema, 1000));
+    mu_assert_int_eq(1250, DspEmaFilter(&ema, 2000));
+    mu_assert_int_eq(1438, DspEmaFilter(&ema, 2000));
+
+    for (uint8_t idx = 0; idx < 100; ++idx) {
+        DspEmaFilter(&ema, -500);
+    }
+    mu_assert_int_eq(-500, DspEmaFilter(&ema, -500));
+
+    DspEmaReset(&ema);
+    mu_assert_int_eq(7, DspEmaFilter(&ema, 7));
+}
+
+MU_TEST(DspMedianTest)
+{
+    // spikes are dropped, the median follows the window
+    mu_assert_int_eq(10, DspMedianFilter(&sMedian, 10));
+    mu_assert_int_eq(1000, DspMedianFilter(&sMedian, 1000));
+    mu_assert_int_eq(12, DspMedianFilter(&sMedian, 12));
+    mu_assert_int_eq(12, DspMedianFilter(&sMedian, 11));
+    mu_assert_int_eq(12, DspMedianFilter(&sMedian, 13));
+    mu_assert_int_eq(12, DspMedianFilter(&sMedian, -1000));
+    mu_assert_int_eq(12, DspMedianFilter(&sMedian, 12));
+
+    // duplicates leave the sorted window one by one
+    for (uint8_t idx = 0; idx < 5; ++idx) {
+        DspMedianFilter(&sMedian, 5);
+    }
+    mu_assert_int_eq(5, DspMedianFilter(&sMedian, 6));
+    mu_assert_int_eq(5, DspMedianFilter(&sMedian, 6));
+    mu_assert_int_eq(6, DspMedianFilter(&sMedian, 6));
+}
+
+MU_TEST(DspBiquadTest)
+{
+    dspBiquadCoef_t coef = {};
+    dspBiquadCoef_t coef14 = {};
+    dspBiquadQ14_t biquad14 = {};
+    dspBiquadQ30_t biquad30 = {};
+
+    mu_assert(DspBiquadDesignLowPass(&coef, 600.0f, 1000.0f) == false);
+    mu_assert(DspBiquadDesignLowPass(&coef, 10.0f, 1000.0f));
+    mu_assert(DspBiquadDesignLowPass(&coef14, 100.0f, 1000.0f));
+    mu_assert(DspBiquadQ14Init(&biquad14, &coef14));
+    mu_assert(DspBiquadQ30Init(&biquad30, &coef));
+
+    // unity gain at DC
+    int16_t out14 = 0;
+    int32_t out30 = 0;
+    for (uint16_t idx = 0; idx < 1000; ++idx) {
+        out14 = DspBiquadQ14Filter(&biquad14, 16384);
+        out30 = DspBiquadQ30Filter(&biquad30, 1 << 28);
+    }
+    mu_assert(abs(out14 - 16384) < 64);
+    mu_assert(llabs((int64_t)out30 - (1 << 28)) < (1 << 16));
+
+    // the tone at the Nyquist frequency is stopped
+    int32_t peak = 0;
+    for (uint16_t idx = 0; idx < 1000; ++idx) {
+        out30 = DspBiquadQ30Filter(&biquad30, (idx & 1) ? (1 << 28) : -(1 << 28));
+        if ((idx > 500) && (abs(out30) > peak)) {
+            peak = abs(out30);
+        }
+    }
+    mu_assert(peak < (1 << 18));
+
+    dspBiquadCoef_t wide = { .b0 = 2.5f };
+    mu_assert(DspBiquadQ14Init(&biquad14, &wide) == false);
+}
+
+MU_TEST(DspHysteresisTest)
+{
+    dspHysteresis_t hysteresis = DSP_HYSTERESIS_INIT(100, 200);
+
+    mu_assert(DspHysteresisUpdate(&hysteresis, 150) == false);
+    mu_assert(DspHysteresisUpdate(&hysteresis, 200));
+    mu_assert(DspHysteresisUpdate(&hysteresis, 101));
+    mu_assert(DspHysteresisUpdate(&hysteresis, 100) == false);
+    mu_assert(DspHysteresisUpdate(&hysteresis, 199) == false);
+}
+
+MU_TEST_SUITE(DspFilterTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(DspBoxcarTest);
+    MU_RUN_TEST(DspEmaTest);
+    MU_RUN_TEST(DspMedianTest);
+    MU_RUN_TEST(DspBiquadTest);
+    MU_RUN_TEST(DspHysteresisTest);
+}
+
+UT_RUNNER_SUITE(DspFilterTest);
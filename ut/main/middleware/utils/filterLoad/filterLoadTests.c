@@ -0,0 +1,90 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/filterLoad/filterLoad.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define CLEAN_RATIO (30.0f)
+#define CLOGGED_CHANGE (0.4f)
+
+static const float sLevelSpeed[] = {18.0f, 34.0f, 50.0f, 64.0f, 78.0f};
+
+static filterLoad_t sLoad;
+
+// fan operating points of the level changes, +-1 duty bit noise
+static void AddSamples(float ratio, uint16_t count)
+{
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        float speed = sLevelSpeed[(idx / 8) % 5];
+        float noise = (idx & 1) ? 1.0f : -1.0f;
+
+        FilterLoadAddSample(&sLoad, speed, ratio * speed + noise);
+    }
+}
+
+void test_setup()
+{
+    FilterLoadInit(&sLoad);
+}
+
+MU_TEST(FilterLoadLearnTest)
+{
+    float ratio = 0.0f;
+    float change = 0.0f;
+
+    mu_assert(FilterLoadGetRatio(&sLoad, &ratio) == false);
+
+    AddSamples(CLEAN_RATIO, FILTER_LOAD_LEARN_SAMPLES - 1);
+    mu_assert(FilterLoadGetRatio(&sLoad, &ratio) == true);
+    mu_assert(fabsf(ratio - CLEAN_RATIO) < 0.05f);
+    mu_assert(FilterLoadGetDutyChange(&sLoad, &change) == false);
+
+    AddSamples(CLEAN_RATIO, 1);
+    mu_assert(fabsf(sLoad.cleanRatio - CLEAN_RATIO) < 0.05f);
+    mu_assert(FilterLoadGetDutyChange(&sLoad, &change) == true);
+    mu_assert(fabsf(change) < 0.01f);
+
+    // stopped fan is not an operating point
+    FilterLoadAddSample(&sLoad, 0.0f, 500.0f);
+    mu_assert_int_eq(FILTER_LOAD_LEARN_SAMPLES, sLoad.samples);
+}
+
+MU_TEST(FilterLoadTrackTest)
+{
+    uint8_t percent = 0;
+
+    AddSamples(CLEAN_RATIO, FILTER_LOAD_LEARN_SAMPLES);
+    mu_assert(FilterLoadGetPercent(&sLoad, CLOGGED_CHANGE, &percent) == true);
+    mu_assert_int_eq(0, percent);
+
+    // filter loads over its life, the fit follows
+    for (uint16_t step = 1; step <= 10; ++step) {
+        AddSamples(CLEAN_RATIO * (1.0f + CLOGGED_CHANGE * step / 20.0f), 200);
+    }
+
+    FilterLoadGetPercent(&sLoad, CLOGGED_CHANGE, &percent);
+    mu_assert(percent >= 49);
+    mu_assert(percent <= 51);
+
+    AddSamples(CLEAN_RATIO * 1.6f, 400);
+    FilterLoadGetPercent(&sLoad, CLOGGED_CHANGE, &percent);
+    mu_assert_int_eq(100, percent);
+
+    // fan unloading with the filter load
+    FilterLoadGetPercent(&sLoad, -CLOGGED_CHANGE, &percent);
+    mu_assert_int_eq(0, percent);
+}
+
+MU_TEST_SUITE(FilterLoadTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(FilterLoadLearnTest);
+    MU_RUN_TEST(FilterLoadTrackTest);
+}
+
+UT_RUNNER_SUITE(FilterLoadTest);
@@ -0,0 +1,211 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/gesture/gesture.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define MAX_EVENTS (16U)
+
+enum {
+    INPUT_POWER = 0,
+    INPUT_FAN_INC,
+    INPUT_FAN_DEC,
+};
+
+enum {
+    ID_POWER_PRESS = 0,
+    ID_POWER_TAP,
+    ID_POWER_LONG,
+    ID_POWER_DOUBLE,
+    ID_FAN_INC_REPEAT,
+    ID_FAN_CHORD,
+};
+
+typedef struct {
+    int64_t time;
+    uint8_t input;
+    bool isPressed;
+} traceEntry_t;
+
+static const gestureRule_t sRules[] = {
+    {.id = ID_POWER_PRESS,      .type = GESTURE_TYPE_PRESS,         .mask = GESTURE_INPUT(INPUT_POWER)},
+    {.id = ID_POWER_TAP,        .type = GESTURE_TYPE_RELEASE,       .mask = GESTURE_INPUT(INPUT_POWER), .minMs = 50, .maxMs = 500},
+    {.id = ID_POWER_LONG,       .type = GESTURE_TYPE_HOLD,          .mask = GESTURE_INPUT(INPUT_POWER), .minMs = 2000},
+    {.id = ID_POWER_DOUBLE,     .type = GESTURE_TYPE_DOUBLE_TAP,    .mask = GESTURE_INPUT(INPUT_POWER), .maxMs = 300},
+    {.id = ID_FAN_INC_REPEAT,   .type = GESTURE_TYPE_REPEAT,        .mask = GESTURE_INPUT(INPUT_FAN_INC), .minMs = 500, .periodMs = 200},
+    {.id = ID_FAN_CHORD,        .type = GESTURE_TYPE_HOLD,          .mask = GESTURE_INPUT(INPUT_FAN_INC) | GESTURE_INPUT(INPUT_FAN_DEC), .minMs = 1000},
+};
+
+static gesture_t sGesture;
+static gestureEvent_t sEvents[MAX_EVENTS];
+static uint8_t sEventsCount;
+
+static void RecordEvent(const gestureEvent_t *event, void *ctx)
+{
+    (void)ctx;
+
+    if (sEventsCount < MAX_EVENTS) {
+        sEvents[sEventsCount++] = *event;
+    }
+}
+
+static void RunTrace(const traceEntry_t *trace, uint8_t count)
+{
+    for (uint8_t idx = 0; idx < count; ++idx) {
+        GestureInputEvent(&sGesture, trace[idx].input, trace[idx].isPressed, trace[idx].time);
+    }
+}
+
+void test_setup()
+{
+    sEventsCount = 0;
+    GestureInit(&sGesture, sRules, sizeof(sRules) / sizeof(sRules[0]), RecordEvent, NULL);
+}
+
+MU_TEST(GesturePressAndTapTest)
+{
+    const traceEntry_t trace[] = {
+        {1000, INPUT_POWER, true},
+        {1100, INPUT_POWER, false},
+        {2000, INPUT_POWER, true},
+        {2020, INPUT_POWER, false},       // too short for a tap
+    };
+
+    RunTrace(trace, 4);
+
+    mu_assert_int_eq(3, sEventsCount);
+    mu_assert_int_eq(ID_POWER_PRESS, sEvents[0].rule->id);
+    mu_assert_int_eq(ID_POWER_TAP, sEvents[1].rule->id);
+    mu_assert_int_eq(100, sEvents[1].heldMs);
+    mu_assert_int_eq(1100, sEvents[1].timeMs);
+    mu_assert_int_eq(ID_POWER_PRESS, sEvents[2].rule->id);
+}
+
+MU_TEST(GestureHoldTest)
+{
+    GestureInputEvent(&sGesture, INPUT_POWER, true, 1000);
+    mu_assert_int_eq(3000, GestureGetNextDeadline(&sGesture));
+
+    GestureTick(&sGesture, 2999);
+    mu_assert_int_eq(1, sEventsCount);
+
+    // late tick reports the threshold time
+    GestureTick(&sGesture, 3050);
+    mu_assert_int_eq(2, sEventsCount);
+    mu_assert_int_eq(ID_POWER_LONG, sEvents[1].rule->id);
+    mu_assert_int_eq(3000, sEvents[1].timeMs);
+    mu_assert_int_eq(GESTURE_NO_DEADLINE, GestureGetNextDeadline(&sGesture));
+
+    // released after the hold, not a tap
+    GestureInputEvent(&sGesture, INPUT_POWER, false, 3500);
+    mu_assert_int_eq(2, sEventsCount);
+}
+
+MU_TEST(GestureHoldBeforeReleaseTest)
+{
+    // the task missed the threshold, the hold is reported before the release
+    GestureInputEvent(&sGesture, INPUT_POWER, true, 0);
+    GestureInputEvent(&sGesture, INPUT_POWER, false, 2500);
+
+    mu_assert_int_eq(2, sEventsCount);
+    mu_assert_int_eq(ID_POWER_LONG, sEvents[1].rule->id);
+}
+
+MU_TEST(GestureDoubleTapTest)
+{
+    const traceEntry_t trace[] = {
+        {1000, INPUT_POWER, true},
+        {1100, INPUT_POWER, false},
+        {1300, INPUT_POWER, true},
+        {1400, INPUT_POWER, false},       // double tap
+        {1500, INPUT_POWER, true},
+        {1600, INPUT_POWER, false},       // third tap starts a new pair
+        {2500, INPUT_POWER, true},
+        {2600, INPUT_POWER, false},       // too late for a pair
+    };
+
+    RunTrace(trace, 8);
+
+    uint8_t doubleTaps = 0;
+    for (uint8_t idx = 0; idx < sEventsCount; ++idx) {
+        if (sEvents[idx].rule->id == ID_POWER_DOUBLE) {
+            doubleTaps += 1;
+            mu_assert_int_eq(1400, sEvents[idx].timeMs);
+        }
+    }
+
+    mu_assert_int_eq(1, doubleTaps);
+}
+
+MU_TEST(GestureRepeatTest)
+{
+    GestureInputEvent(&sGesture, INPUT_FAN_INC, true, 0);
+
+    for (int64_t time = 0; time <= 1000; time += 10) {
+        GestureTick(&sGesture, time);
+    }
+
+    // 500, 700, 900
+    mu_assert_int_eq(3, sEventsCount);
+    mu_assert_int_eq(0, sEvents[0].repeat);
+    mu_assert_int_eq(900, sEvents[2].timeMs);
+    mu_assert_int_eq(2, sEvents[2].repeat);
+    mu_assert_int_eq(1100, GestureGetNextDeadline(&sGesture));
+
+    // late tick fires once
+    GestureTick(&sGesture, 1750);
+    mu_assert_int_eq(4, sEventsCount);
+    mu_assert_int_eq(1900, GestureGetNextDeadline(&sGesture));
+}
+
+MU_TEST(GestureChordTest)
+{
+    const traceEntry_t trace[] = {
+        {0, INPUT_FAN_INC, true},
+        {40, INPUT_FAN_DEC, true},
+        {1100, INPUT_FAN_DEC, false},
+        {1200, INPUT_FAN_INC, false},
+    };
+
+    RunTrace(trace, 2);
+
+    // single input repeat is cancelled by the chord
+    mu_assert_int_eq(1040, GestureGetNextDeadline(&sGesture));
+
+    GestureTick(&sGesture, 1040);
+    mu_assert_int_eq(1, sEventsCount);
+    mu_assert_int_eq(ID_FAN_CHORD, sEvents[0].rule->id);
+    mu_assert_int_eq(1000, sEvents[0].heldMs);
+
+    RunTrace(&trace[2], 2);
+    mu_assert_int_eq(1, sEventsCount);
+}
+
+MU_TEST(GestureSetInputsTest)
+{
+    GestureSetInputs(&sGesture, GESTURE_INPUT(INPUT_FAN_INC) | GESTURE_INPUT(INPUT_FAN_DEC), 0);
+    GestureSetInputs(&sGesture, 0, 1500);
+
+    mu_assert_int_eq(1, sEventsCount);
+    mu_assert_int_eq(ID_FAN_CHORD, sEvents[0].rule->id);
+
+    mu_assert(GestureInit(&sGesture, sRules, GESTURE_MAX_RULES + 1, RecordEvent, NULL) == false);
+}
+
+MU_TEST_SUITE(GestureTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(GesturePressAndTapTest);
+    MU_RUN_TEST(GestureHoldTest);
+    MU_RUN_TEST(GestureHoldBeforeReleaseTest);
+    MU_RUN_TEST(GestureDoubleTapTest);
+    MU_RUN_TEST(GestureRepeatTest);
+    MU_RUN_TEST(GestureChordTest);
+    MU_RUN_TEST(GestureSetInputsTest);
+}
+
+UT_RUNNER_SUITE(GestureTest);
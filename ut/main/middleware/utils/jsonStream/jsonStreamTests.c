@@ -0,0 +1,123 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/jsonStream/jsonStream.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// values are collected as "key=type:value;" to compare the whole parse result at once
+static char sResult[512];
+static uint32_t sResultLen;
+static bool sIsValueStarted;
+static jsonStream_t sStream;
+
+static bool Callback(void *ctx, const char *key, jsonStreamType_t type, const char *data, uint32_t len, bool isEnd)
+{
+    (void)ctx;
+
+    if (sIsValueStarted == false) {
+        sResultLen += snprintf(&sResult[sResultLen], sizeof(sResult) - sResultLen, "%s=%d:", key, type);
+        sIsValueStarted = true;
+    }
+
+    memcpy(&sResult[sResultLen], data, len);
+    sResultLen += len;
+
+    if (isEnd) {
+        sResult[sResultLen++] = ';';
+        sIsValueStarted = false;
+    }
+    sResult[sResultLen] = '\0';
+
+    return true;
+}
+
+static void Reset(void)
+{
+    sResultLen = 0;
+    sResult[0] = '\0';
+    sIsValueStarted = false;
+    JsonStreamInit(&sStream, Callback, NULL);
+}
+
+void test_setup()
+{
+    Reset();
+}
+
+MU_TEST(JsonStreamSplitAtEveryPositionTest)
+{
+    const char *json = " {\"SSID\": \"my \\\"net\\\"\", \"radius\":\"10.0.0.1\" ,\"nested\":{\"a\":[1,\"}\"]},"
+                       "\"n\":-12.5e3, \"t\":true,\"f\":false,\"z\":null, \"u\":\"\\u00e9\\n\"} ";
+    const char *expected = "SSID=0:my \"net\";radius=0:10.0.0.1;n=1:-12.5e3;t=2:true;f=3:false;z=4:null;u=0:\xc3\xa9\n;";
+    const uint32_t len = strlen(json);
+
+    for (uint32_t split = 0; split <= len; ++split) {
+        Reset();
+        mu_assert(JsonStreamParse(&sStream, json, split));
+        mu_assert(JsonStreamParse(&sStream, &json[split], len - split));
+        mu_assert(JsonStreamIsComplete(&sStream));
+        mu_assert_string_eq(expected, sResult);
+    }
+}
+
+MU_TEST(JsonStreamLongStringInChunksTest)
+{
+    char json[300];
+    char value[200];
+
+    memset(value, 'x', sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+    snprintf(json, sizeof(json), "{\"pem\":\"%s\"}", value);
+
+    // fed byte by byte like a slow socket
+    for (uint32_t idx = 0; idx < strlen(json); ++idx) {
+        mu_assert(JsonStreamParse(&sStream, &json[idx], 1));
+    }
+
+    mu_assert(JsonStreamIsComplete(&sStream));
+    mu_assert_int_eq(strlen("pem=0:") + strlen(value) + 1, sResultLen);
+}
+
+MU_TEST(JsonStreamIncompleteTest)
+{
+    mu_assert(JsonStreamParse(&sStream, "{\"a\":\"b\"", 8));
+    mu_assert(JsonStreamIsComplete(&sStream) == false);
+
+    Reset();
+    mu_assert(JsonStreamParse(&sStream, "{}", 2));
+    mu_assert(JsonStreamIsComplete(&sStream));
+}
+
+MU_TEST(JsonStreamSyntaxErrorTest)
+{
+    const char *invalid[] = {
+        "[1]",
+        "{\"a\" 1}",
+        "{\"a\":1,}",
+        "{\"a\":tru}",
+        "{\"a\":\"\\x\"}",
+        "{\"a\":1}}",
+        "{\"keyLongerThanTheKeyBufferOfTheParser\":1}",
+    };
+
+    for (uint32_t idx = 0; idx < (sizeof(invalid) / sizeof(invalid[0])); ++idx) {
+        Reset();
+        mu_assert(JsonStreamParse(&sStream, invalid[idx], strlen(invalid[idx])) == false);
+    }
+}
+
+MU_TEST_SUITE(JsonStreamTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(JsonStreamSplitAtEveryPositionTest);
+    MU_RUN_TEST(JsonStreamLongStringInChunksTest);
+    MU_RUN_TEST(JsonStreamIncompleteTest);
+    MU_RUN_TEST(JsonStreamSyntaxErrorTest);
+}
+
+UT_RUNNER_SUITE(JsonStreamTest);
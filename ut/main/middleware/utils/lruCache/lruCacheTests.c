@@ -0,0 +1,144 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/lruCache/lruCache.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define ENTRIES_COUNT (4U)
+#define BUDGET (1000U)
+
+static lruCacheEntry_t sEntries[ENTRIES_COUNT];
+static lruCache_t sCache;
+
+void test_setup()
+{
+    LruCacheInit(&sCache, sEntries, ENTRIES_COUNT, BUDGET);
+}
+
+void test_teardown()
+{
+    LruCacheDeinit(&sCache);
+}
+
+MU_TEST(LruCachePutGetTest)
+{
+    uint8_t *buf = LruCachePut(&sCache, "/index.html", 10);
+    mu_assert_not_null(buf);
+    memcpy(buf, "0123456789", 10);
+
+    uint32_t size = 0;
+    const uint8_t *data = LruCacheGet(&sCache, "/index.html", &size);
+    mu_assert_not_null(data);
+    mu_assert_int_eq(10, size);
+    mu_assert_mem_eq("0123456789", data, 10);
+
+    mu_assert_null(LruCacheGet(&sCache, "/app.js", &size));
+    mu_assert_int_eq(1, sCache.hits);
+    mu_assert_int_eq(1, sCache.misses);
+    mu_assert_int_eq(50, LruCacheGetHitRatePercent(&sCache));
+}
+
+MU_TEST(LruCacheBudgetEvictsLeastRecentlyUsedTest)
+{
+    mu_assert_not_null(LruCachePut(&sCache, "a", 400));
+    mu_assert_not_null(LruCachePut(&sCache, "b", 400));
+
+    // "a" becomes most recently used
+    mu_assert_not_null(LruCacheGet(&sCache, "a", NULL));
+
+    mu_assert_not_null(LruCachePut(&sCache, "c", 400));
+
+    mu_assert_not_null(LruCacheGet(&sCache, "a", NULL));
+    mu_assert_null(LruCacheGet(&sCache, "b", NULL));
+    mu_assert_not_null(LruCacheGet(&sCache, "c", NULL));
+    mu_assert_int_eq(800, sCache.usedBytes);
+}
+
+MU_TEST(LruCacheEntriesCountEvictsTest)
+{
+    char key[8];
+    for (uint32_t idx = 0; idx <= ENTRIES_COUNT; ++idx) {
+        snprintf(key, sizeof(key), "%u", idx);
+        mu_assert_not_null(LruCachePut(&sCache, key, 10));
+    }
+
+    mu_assert_null(LruCacheGet(&sCache, "0", NULL));
+    mu_assert_not_null(LruCacheGet(&sCache, "4", NULL));
+    mu_assert_int_eq(ENTRIES_COUNT * 10, sCache.usedBytes);
+}
+
+MU_TEST(LruCacheRejectTest)
+{
+    mu_assert_null(LruCachePut(&sCache, "big", BUDGET + 1));
+    mu_assert_null(LruCachePut(&sCache, "/this/key/is/much/longer/than/the/cache/key/limit/of/sixty/four/chars.js", 10));
+    mu_assert_int_eq(0, sCache.usedBytes);
+}
+
+MU_TEST(LruCacheReplaceAndClearTest)
+{
+    mu_assert_not_null(LruCachePut(&sCache, "a", 100));
+    mu_assert_not_null(LruCachePut(&sCache, "a", 200));
+    mu_assert_int_eq(200, sCache.usedBytes);
+
+    LruCacheRemove(&sCache, "a");
+    mu_assert_int_eq(0, sCache.usedBytes);
+
+    mu_assert_not_null(LruCachePut(&sCache, "a", 100));
+    mu_assert_not_null(LruCachePut(&sCache, "b", 100));
+    LruCacheClear(&sCache);
+    mu_assert_int_eq(0, sCache.usedBytes);
+    mu_assert_null(LruCacheGet(&sCache, "a", NULL));
+}
+
+// Page load trace of the web UI: hot small files are requested by every client
+MU_TEST(LruCacheWebTraceHitRateTest)
+{
+    const char *trace[] = { "/index.html", "/js/app.js", "/css/app.css", "/favicon.ico", "/img/fan.svg", "/img/logo.svg" };
+    const uint32_t sizes[] = { 100, 300, 200, 50, 150, 150 };
+    const uint32_t clients = 20;
+
+    for (uint32_t client = 0; client < clients; ++client) {
+        for (uint32_t idx = 0; idx < (sizeof(trace) / sizeof(trace[0])); ++idx) {
+            if (LruCacheGet(&sCache, trace[idx], NULL) == NULL) {
+                LruCachePut(&sCache, trace[idx], sizes[idx]);
+            }
+        }
+    }
+
+    printf("\nweb trace hit rate %u%%\n", LruCacheGetHitRatePercent(&sCache));
+
+    // six files cycled through four entries thrash the cache, budget still holds
+    mu_assert(sCache.usedBytes <= BUDGET);
+
+    LruCacheClear(&sCache);
+    sCache.hits = 0;
+    sCache.misses = 0;
+
+    for (uint32_t client = 0; client < clients; ++client) {
+        for (uint32_t idx = 0; idx < ENTRIES_COUNT; ++idx) {
+            if (LruCacheGet(&sCache, trace[idx], NULL) == NULL) {
+                LruCachePut(&sCache, trace[idx], sizes[idx]);
+            }
+        }
+    }
+
+    printf("hot set hit rate %u%%\n", LruCacheGetHitRatePercent(&sCache));
+    mu_assert_int_eq(95, LruCacheGetHitRatePercent(&sCache));
+}
+
+MU_TEST_SUITE(LruCacheTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(LruCachePutGetTest);
+    MU_RUN_TEST(LruCacheBudgetEvictsLeastRecentlyUsedTest);
+    MU_RUN_TEST(LruCacheEntriesCountEvictsTest);
+    MU_RUN_TEST(LruCacheRejectTest);
+    MU_RUN_TEST(LruCacheReplaceAndClearTest);
+    MU_RUN_TEST(LruCacheWebTraceHitRateTest);
+}
+
+UT_RUNNER_SUITE(LruCacheTest);
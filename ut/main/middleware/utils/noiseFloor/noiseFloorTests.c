@@ -0,0 +1,91 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/noiseFloor/noiseFloor.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+static noiseFloor_t sNoise;
+
+void test_setup()
+{
+    NoiseFloorInit(&sNoise);
+}
+
+MU_TEST(NoiseFloorMeanTest)
+{
+    // alternating +-4 noise around the baseline
+    for (uint8_t idx = 0; idx < 64; ++idx) {
+        NoiseFloorAddSample(&sNoise, (idx & 1) ? 4 : -4);
+    }
+
+    mu_assert_int_eq(4, NoiseFloorGetMean(&sNoise));
+    mu_assert_int_eq(4, NoiseFloorGetPeak(&sNoise));
+    mu_assert_int_eq(0, NoiseFloorGetOffset(&sNoise));
+    mu_assert_int_eq(12, NoiseFloorGetThreshold(&sNoise, 3));
+    mu_assert_int_eq(64, sNoise.samples);
+}
+
+MU_TEST(NoiseFloorPeakDecayTest)
+{
+    NoiseFloorAddSample(&sNoise, -100);
+    mu_assert_int_eq(100, NoiseFloorGetPeak(&sNoise));
+
+    for (uint8_t idx = 0; idx < 22; ++idx) {
+        NoiseFloorAddSample(&sNoise, 0);
+    }
+
+    // about half after 22 samples, 1/32 per sample
+    mu_assert(NoiseFloorGetPeak(&sNoise) > 45);
+    mu_assert(NoiseFloorGetPeak(&sNoise) < 55);
+
+    for (uint16_t idx = 0; idx < 400; ++idx) {
+        NoiseFloorAddSample(&sNoise, 0);
+    }
+
+    mu_assert_int_eq(0, NoiseFloorGetMean(&sNoise));
+    mu_assert(NoiseFloorGetPeak(&sNoise) <= 1);
+}
+
+MU_TEST(NoiseFloorOffsetTest)
+{
+    // baseline drifted by 20 counts
+    for (uint8_t idx = 0; idx < 64; ++idx) {
+        NoiseFloorAddSample(&sNoise, 20);
+    }
+
+    mu_assert_int_eq(20, NoiseFloorGetOffset(&sNoise));
+
+    for (uint8_t idx = 0; idx < 64; ++idx) {
+        NoiseFloorAddSample(&sNoise, -20);
+    }
+
+    mu_assert_int_eq(-20, NoiseFloorGetOffset(&sNoise));
+}
+
+MU_TEST(NoiseFloorScaleTest)
+{
+    NoiseFloorAddSample(&sNoise, 40);
+
+    NoiseFloorScale(&sNoise, true);
+    mu_assert_int_eq(20, NoiseFloorGetPeak(&sNoise));
+    mu_assert_int_eq(20, NoiseFloorGetMean(&sNoise));
+
+    NoiseFloorScale(&sNoise, false);
+    mu_assert_int_eq(40, NoiseFloorGetPeak(&sNoise));
+    mu_assert_int_eq(40, NoiseFloorGetOffset(&sNoise));
+}
+
+MU_TEST_SUITE(NoiseFloorTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(NoiseFloorMeanTest);
+    MU_RUN_TEST(NoiseFloorPeakDecayTest);
+    MU_RUN_TEST(NoiseFloorOffsetTest);
+    MU_RUN_TEST(NoiseFloorScaleTest);
+}
+
+UT_RUNNER_SUITE(NoiseFloorTest);
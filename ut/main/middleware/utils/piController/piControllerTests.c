@@ -0,0 +1,154 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/piController/piController.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DUTY_MAX (0x0fff)
+#define STEPS_TO_SETTLE (40U)
+
+// fan simulation model: speed lags the duty (first order, 2 s), tacho counts per 1 s sample,
+// the speed per duty drops with the filter load
+#define FAN_MODEL_RPS_AT_FULL_DUTY (100.0f)
+#define FAN_MODEL_TIME_CONSTANT_S (2.0f)
+#define FAN_MODEL_STEP_S (1.0f)
+
+typedef struct {
+    float rps;
+    float load;                     // 0 - clean filter, 1 - blocked
+} fanModel_t;
+
+static const piControllerConfig_t sConfig = {
+    .kpQ8 = 8 * 256,
+    .kiQ8 = 4 * 256,
+    .outMin = 0,
+    .outMax = DUTY_MAX,
+    .slewMax = 64,
+};
+
+static piController_t sPi;
+static fanModel_t sFan;
+
+static int16_t FanModelStep(fanModel_t *fan, int32_t duty)
+{
+    float steady = FAN_MODEL_RPS_AT_FULL_DUTY * (1.0f - fan->load) * (float)duty / DUTY_MAX;
+
+    fan->rps += (steady - fan->rps) * (FAN_MODEL_STEP_S / FAN_MODEL_TIME_CONSTANT_S);
+
+    return (int16_t)(fan->rps + 0.5f);
+}
+
+static int16_t RunLoop(int16_t target, uint16_t steps)
+{
+    int16_t tacho = 0;
+
+    for (uint16_t idx = 0; idx < steps; ++idx) {
+        tacho = FanModelStep(&sFan, PiControllerGetOutput(&sPi));
+        PiControllerUpdate(&sPi, target, tacho);
+    }
+
+    return tacho;
+}
+
+void test_setup()
+{
+    sFan.rps = 0;
+    sFan.load = 0;
+}
+
+MU_TEST(PiControllerSettleTest)
+{
+    // feed forward of a clean filter
+    PiControllerInit(&sPi, &sConfig, 2000);
+
+    int16_t tacho = RunLoop(60, STEPS_TO_SETTLE);
+
+    mu_assert_int_eq(60, tacho);
+    mu_assert(abs(PiControllerGetOutput(&sPi) - 2457) < 64);
+}
+
+MU_TEST(PiControllerFilterLoadTest)
+{
+    PiControllerInit(&sPi, &sConfig, 1600);
+    RunLoop(40, STEPS_TO_SETTLE);
+    int32_t cleanDuty = PiControllerGetOutput(&sPi);
+
+    // filter loads slowly, the speed holds
+    for (uint16_t idx = 0; idx < 300; ++idx) {
+        sFan.load = 0.3f * idx / 300;
+        int16_t tacho = RunLoop(40, 1);
+        mu_assert(abs(tacho - 40) <= 1);
+    }
+
+    mu_assert_int_eq(40, RunLoop(40, STEPS_TO_SETTLE));
+    mu_assert(PiControllerGetOutput(&sPi) > (cleanDuty * 13 / 10));
+}
+
+MU_TEST(PiControllerSlewTest)
+{
+    PiControllerInit(&sPi, &sConfig, 0);
+
+    int32_t last = 0;
+    for (uint16_t idx = 0; idx < STEPS_TO_SETTLE; ++idx) {
+        RunLoop(80, 1);
+        mu_assert(abs(PiControllerGetOutput(&sPi) - last) <= 64);
+        last = PiControllerGetOutput(&sPi);
+    }
+}
+
+MU_TEST(PiControllerAntiWindupTest)
+{
+    PiControllerInit(&sPi, &sConfig, 3000);
+
+    // unreachable speed, output stays at the limit
+    RunLoop(150, 120);
+    mu_assert_int_eq(DUTY_MAX, PiControllerGetOutput(&sPi));
+    mu_assert(PiControllerIsLimited(&sPi));
+
+    // reachable again, no long stay at the limit and small overshoot
+    RunLoop(70, 1);
+    mu_assert(PiControllerGetOutput(&sPi) < DUTY_MAX);
+
+    int16_t maxTacho = 0;
+    for (uint16_t idx = 0; idx < STEPS_TO_SETTLE; ++idx) {
+        int16_t tacho = RunLoop(70, 1);
+        maxTacho = (tacho > maxTacho) ? tacho : maxTacho;
+    }
+
+    mu_assert(maxTacho <= 100);
+    mu_assert_int_eq(70, RunLoop(70, STEPS_TO_SETTLE));
+}
+
+MU_TEST(PiControllerConfigTest)
+{
+    piControllerConfig_t config = sConfig;
+
+    config.outMin = DUTY_MAX;
+    config.outMax = 0;
+    mu_assert(PiControllerInit(&sPi, &config, 0) == false);
+
+    mu_assert(PiControllerInit(&sPi, &sConfig, 5000) == true);
+    mu_assert_int_eq(DUTY_MAX, PiControllerGetOutput(&sPi));
+
+    // narrowed limits apply at the next update
+    PiControllerSetLimits(&sPi, 0, 3000);
+    PiControllerUpdate(&sPi, 0, 0);
+    mu_assert_int_eq(DUTY_MAX - 64, PiControllerGetOutput(&sPi));
+}
+
+MU_TEST_SUITE(PiControllerTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(PiControllerSettleTest);
+    MU_RUN_TEST(PiControllerFilterLoadTest);
+    MU_RUN_TEST(PiControllerSlewTest);
+    MU_RUN_TEST(PiControllerAntiWindupTest);
+    MU_RUN_TEST(PiControllerConfigTest);
+}
+
+UT_RUNNER_SUITE(PiControllerTest);
@@ -0,0 +1,123 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/pwmSweep/pwmSweep.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+static const pwmSweepSetting_t sSettings[] = {
+    {5000U, 12U},
+    {16000U, 12U},
+    {25000U, 11U},
+    {25000U, 10U},
+};
+
+#define SETTINGS_COUNT (sizeof(sSettings) / sizeof(pwmSweepSetting_t))
+
+static pwmSweep_t sSweep;
+
+void test_setup()
+{
+    PwmSweepInit(&sSweep, sSettings, SETTINGS_COUNT);
+}
+
+// speed around the mean +- ripple / 2
+static void Measure(uint32_t meanMilliSpeed, uint32_t rippleMilliSpeed, bool isValid)
+{
+    for (uint8_t idx = 0; idx < 40; ++idx) {
+        uint32_t speed = (idx & 1) ? (meanMilliSpeed + rippleMilliSpeed / 2) : (meanMilliSpeed - rippleMilliSpeed / 2);
+        PwmSweepAddSample(&sSweep, speed);
+    }
+
+    PwmSweepNext(&sSweep, isValid);
+}
+
+MU_TEST(PwmSweepOrderTest)
+{
+    pwmSweepSetting_t setting = {};
+
+    for (uint8_t idx = 0; idx < SETTINGS_COUNT; ++idx) {
+        mu_assert(PwmSweepGetSetting(&sSweep, &setting));
+        mu_assert_int_eq(sSettings[idx].freqHz, setting.freqHz);
+        mu_assert_int_eq(sSettings[idx].resolutionBits, setting.resolutionBits);
+        Measure(50000U, 1000U, true);
+    }
+
+    mu_assert(PwmSweepGetSetting(&sSweep, &setting) == false);
+    mu_assert(PwmSweepNext(&sSweep, true) == false);
+    mu_assert_int_eq(20, sSweep.results[0].ripplePerMille);
+    mu_assert_int_eq(50000, sSweep.results[0].meanMilliSpeed);
+}
+
+MU_TEST(PwmSweepSteadiestTest)
+{
+    pwmSweepSetting_t setting = {};
+
+    Measure(50000U, 2000U, true);
+    Measure(50000U, 500U, true);
+    Measure(50000U, 1500U, true);
+    Measure(50000U, 2500U, true);
+
+    mu_assert(PwmSweepGetBest(&sSweep, &setting));
+    mu_assert_int_eq(16000, setting.freqHz);
+    mu_assert_int_eq(12, setting.resolutionBits);
+}
+
+MU_TEST(PwmSweepTieTest)
+{
+    pwmSweepSetting_t setting = {};
+
+    // ripple within the tie margin, the highest frequency and then the finer resolution win
+    Measure(50000U, 600U, true);
+    Measure(50000U, 500U, true);
+    Measure(50000U, 600U, true);
+    Measure(50000U, 600U, true);
+
+    mu_assert(PwmSweepGetBest(&sSweep, &setting));
+    mu_assert_int_eq(25000, setting.freqHz);
+    mu_assert_int_eq(11, setting.resolutionBits);
+}
+
+MU_TEST(PwmSweepSpeedOffTest)
+{
+    pwmSweepSetting_t setting = {};
+
+    // the steady settings run the fan off the reference speed or could not be set
+    Measure(50000U, 2000U, true);
+    Measure(40000U, 100U, true);
+    Measure(50000U, 100U, false);
+    Measure(0U, 0U, true);
+
+    mu_assert(PwmSweepGetBest(&sSweep, &setting));
+    mu_assert_int_eq(5000, setting.freqHz);
+    mu_assert_int_eq(12, setting.resolutionBits);
+}
+
+MU_TEST(PwmSweepNoReferenceTest)
+{
+    pwmSweepSetting_t setting = {};
+
+    Measure(0U, 0U, true);
+    Measure(50000U, 100U, true);
+    Measure(50000U, 100U, true);
+    Measure(50000U, 100U, true);
+
+    mu_assert(PwmSweepGetBest(&sSweep, &setting) == false);
+    mu_assert(PwmSweepInit(&sSweep, sSettings, 0) == false);
+    mu_assert(PwmSweepInit(&sSweep, sSettings, PWM_SWEEP_MAX_SETTINGS + 1) == false);
+}
+
+MU_TEST_SUITE(PwmSweepTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(PwmSweepOrderTest);
+    MU_RUN_TEST(PwmSweepSteadiestTest);
+    MU_RUN_TEST(PwmSweepTieTest);
+    MU_RUN_TEST(PwmSweepSpeedOffTest);
+    MU_RUN_TEST(PwmSweepNoReferenceTest);
+}
+
+UT_RUNNER_SUITE(PwmSweepTest);
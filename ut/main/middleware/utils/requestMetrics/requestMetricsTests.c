@@ -0,0 +1,87 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/requestMetrics/requestMetrics.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+static requestMetrics_t sMetrics;
+
+void test_setup()
+{
+    RequestMetricsInit(&sMetrics, "/deviceInfo");
+}
+
+MU_TEST(RequestMetricsBucketTest)
+{
+    mu_assert_int_eq(0, RequestMetricsGetBucket(0));
+    mu_assert_int_eq(0, RequestMetricsGetBucket(999));
+    mu_assert_int_eq(1, RequestMetricsGetBucket(1000));
+    mu_assert_int_eq(2, RequestMetricsGetBucket(3999));
+    mu_assert_int_eq(3, RequestMetricsGetBucket(4000));
+    mu_assert_int_eq(REQUEST_METRICS_BUCKETS_COUNT - 1, RequestMetricsGetBucket(UINT32_MAX));
+}
+
+MU_TEST(RequestMetricsRecordTest)
+{
+    RequestMetricsRecord(&sMetrics, 500, false);
+    RequestMetricsRecord(&sMetrics, 1500, false);
+    RequestMetricsRecord(&sMetrics, 10000, true);
+    RequestMetricsAddBytes(&sMetrics, 300);
+    RequestMetricsAddBytes(&sMetrics, 200);
+
+    mu_assert_int_eq(3, sMetrics.count);
+    mu_assert_int_eq(1, sMetrics.errors);
+    mu_assert_int_eq(500, sMetrics.bytesSent);
+    mu_assert_int_eq(4000, RequestMetricsGetMeanUs(&sMetrics));
+    mu_assert_int_eq(10000, sMetrics.latencyMaxUs);
+    mu_assert_int_eq(1, sMetrics.buckets[0]);
+    mu_assert_int_eq(1, sMetrics.buckets[1]);
+    mu_assert_int_eq(1, sMetrics.buckets[4]);
+}
+
+MU_TEST(RequestMetricsPercentileTest)
+{
+    mu_assert_int_eq(0, RequestMetricsGetPercentileUs(&sMetrics, 95));
+
+    for (uint32_t idx = 0; idx < 95; ++idx) {
+        RequestMetricsRecord(&sMetrics, 1200, false);
+    }
+    for (uint32_t idx = 0; idx < 5; ++idx) {
+        RequestMetricsRecord(&sMetrics, 5000000, false);
+    }
+
+    mu_assert_int_eq(2000, RequestMetricsGetPercentileUs(&sMetrics, 50));
+    mu_assert_int_eq(2000, RequestMetricsGetPercentileUs(&sMetrics, 95));
+    mu_assert_int_eq(5000000, RequestMetricsGetPercentileUs(&sMetrics, 96));
+}
+
+MU_TEST(RequestMetricsFormatTest)
+{
+    char buf[96];
+    size_t len = 0;
+
+    RequestMetricsRecord(&sMetrics, 1500, false);
+    RequestMetricsAddBytes(&sMetrics, 321);
+
+    mu_assert(RequestMetricsFormat(&sMetrics, buf, sizeof(buf), &len));
+    mu_assert_string_eq("/deviceInfo 1 0 321 1500 1500 1500 0,1,0,0,0,0,0,0,0,0\n", buf);
+    mu_assert_int_eq(strlen(buf), len);
+
+    mu_assert(RequestMetricsFormat(&sMetrics, buf, 20, &len) == false);
+    mu_assert_int_eq(0, len);
+}
+
+MU_TEST_SUITE(RequestMetricsTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, NULL);
+
+    MU_RUN_TEST(RequestMetricsBucketTest);
+    MU_RUN_TEST(RequestMetricsRecordTest);
+    MU_RUN_TEST(RequestMetricsPercentileTest);
+    MU_RUN_TEST(RequestMetricsFormatTest);
+}
+
+UT_RUNNER_SUITE(RequestMetricsTest);
@@ -0,0 +1,185 @@
+#include "minunit.h"
+#include "utRunner.h"
+
+// UUT
+#include "utils/webArchive/webArchive.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define FILES_COUNT (4U)
+#define ARCHIVE_MAX_SIZE (1024U)
+
+static const char *sNames[FILES_COUNT] = { "/css/app.css", "/favicon.ico", "/index.html", "/index.html.gz" };
+static const char *sContents[FILES_COUNT] = { "body{}", "ico", "<html></html>", "gz" };
+
+static uint8_t sArchiveData[ARCHIVE_MAX_SIZE];
+static uint8_t sBundleData[ARCHIVE_MAX_SIZE];
+static uint32_t sArchiveSize;
+static webArchive_t sArchive;
+static webArchive_t sBundle;
+
+static uint32_t Crc32(const uint8_t *data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for (uint32_t idx = 0; idx < size; ++idx) {
+        crc ^= data[idx];
+        for (uint8_t bit = 0; bit < 8U; ++bit) {
+            crc = (crc & 1U) ? ((crc >> 1) ^ 0xEDB88320U) : (crc >> 1);
+        }
+    }
+
+    return ~crc;
+}
+
+// same layout as packWebAssets.py
+static void PackArchive(void)
+{
+    webArchiveHeader_t header = {
+        .magic = WEB_ARCHIVE_MAGIC,
+        .version = WEB_ARCHIVE_VERSION,
+        .entriesCount = FILES_COUNT,
+    };
+
+    uint32_t offset = sizeof(webArchiveHeader_t) + (FILES_COUNT * sizeof(webArchiveEntry_t));
+
+    for (uint32_t idx = 0; idx < FILES_COUNT; ++idx) {
+        webArchiveEntry_t entry = {};
+        strcpy(entry.name, sNames[idx]);
+        entry.offset = offset;
+        entry.size = strlen(sContents[idx]);
+        entry.hash = Crc32((const uint8_t *)sContents[idx], entry.size);
+
+        memcpy(&sArchiveData[sizeof(webArchiveHeader_t) + (idx * sizeof(webArchiveEntry_t))], &entry, sizeof(entry));
+        memcpy(&sArchiveData[offset], sContents[idx], entry.size);
+        offset += (entry.size + 3U) & ~3U;
+    }
+
+    header.size = offset;
+    header.crc = Crc32(&sArchiveData[sizeof(webArchiveHeader_t)], offset - sizeof(webArchiveHeader_t));
+    memcpy(sArchiveData, &header, sizeof(header));
+
+    sArchiveSize = offset;
+}
+
+static webArchiveEntry_t *GetEntry(uint32_t idx)
+{
+    return (webArchiveEntry_t *)&sArchiveData[sizeof(webArchiveHeader_t) + (idx * sizeof(webArchiveEntry_t))];
+}
+
+void test_setup()
+{
+    memset(sArchiveData, 0, sizeof(sArchiveData));
+    PackArchive();
+}
+
+void test_teardown()
+{
+    WebArchiveClose(&sArchive);
+    WebArchiveClose(&sBundle);
+}
+
+MU_TEST(WebArchiveFindTest)
+{
+    webArchiveFile_t file = {};
+
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), true));
+    mu_assert_int_eq(FILES_COUNT, sArchive.entriesCount);
+
+    for (uint32_t idx = 0; idx < FILES_COUNT; ++idx) {
+        mu_assert(WebArchiveFind(&sArchive, sNames[idx], &file));
+        mu_assert_int_eq(strlen(sContents[idx]), file.size);
+        mu_assert_mem_eq(sContents[idx], file.data, file.size);
+        mu_assert_int_eq(Crc32((const uint8_t *)sContents[idx], file.size), file.hash);
+    }
+
+    mu_assert(WebArchiveFind(&sArchive, "/app.js", &file) == false);
+    mu_assert(WebArchiveFind(&sArchive, "/index.htm", &file) == false);
+    mu_assert(WebArchiveFind(&sArchive, "/zzz", &file) == false);
+    mu_assert(WebArchiveFind(&sArchive, "", &file) == false);
+}
+
+MU_TEST(WebArchiveHeaderTest)
+{
+    webArchiveHeader_t header;
+    memcpy(&header, sArchiveData, sizeof(header));
+
+    mu_assert(WebArchiveCheckHeader(&header, sArchiveSize));
+    mu_assert(WebArchiveCheckHeader(&header, sArchiveSize - 1U) == false);
+
+    header.magic = 0xFFFFFFFFU;
+    mu_assert(WebArchiveCheckHeader(&header, sArchiveSize) == false);
+
+    // erased flash
+    memset(sArchiveData, 0xFF, sizeof(sArchiveData));
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), false) == false);
+}
+
+MU_TEST(WebArchiveCrcTest)
+{
+    sArchiveData[sArchiveSize - 1U] ^= 0x01U;
+
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), true) == false);
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), false));
+}
+
+MU_TEST(WebArchiveInvalidTableTest)
+{
+    // unsorted names break binary search
+    webArchiveEntry_t first = *GetEntry(0);
+    *GetEntry(0) = *GetEntry(1);
+    *GetEntry(1) = first;
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), false) == false);
+    mu_assert_null(sArchive.entries);
+
+    PackArchive();
+    GetEntry(2)->size = ARCHIVE_MAX_SIZE;
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), false) == false);
+
+    PackArchive();
+    memset(GetEntry(3)->name, 'a', WEB_ARCHIVE_NAME_MAX_LEN);
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), false) == false);
+}
+
+MU_TEST(WebArchiveBundleTest)
+{
+    webArchiveHeader_t header;
+
+    mu_assert(WebArchiveOpen(&sArchive, sArchiveData, sizeof(sArchiveData), true));
+    mu_assert_int_eq(0, sArchive.baseCrc);
+
+    // base crc is outside of the crc of the bundle
+    memcpy(sBundleData, sArchiveData, sizeof(sBundleData));
+    memcpy(&header, sBundleData, sizeof(header));
+    header.baseCrc = sArchive.crc;
+    memcpy(sBundleData, &header, sizeof(header));
+
+    mu_assert(WebArchiveOpen(&sBundle, sBundleData, sizeof(sBundleData), true));
+    mu_assert(WebArchiveIsBundleOf(&sBundle, &sArchive));
+
+    // base archive was flashed with other files
+    header.baseCrc = sArchive.crc ^ 0x01U;
+    memcpy(sBundleData, &header, sizeof(header));
+    mu_assert(WebArchiveOpen(&sBundle, sBundleData, sizeof(sBundleData), true));
+    mu_assert(WebArchiveIsBundleOf(&sBundle, &sArchive) == false);
+
+    // a base archive is not a bundle
+    mu_assert(WebArchiveIsBundleOf(&sArchive, &sArchive) == false);
+
+    WebArchiveClose(&sArchive);
+    mu_assert(WebArchiveIsBundleOf(&sBundle, &sArchive) == false);
+}
+
+MU_TEST_SUITE(WebArchiveTest)
+{
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(WebArchiveFindTest);
+    MU_RUN_TEST(WebArchiveHeaderTest);
+    MU_RUN_TEST(WebArchiveCrcTest);
+    MU_RUN_TEST(WebArchiveInvalidTableTest);
+    MU_RUN_TEST(WebArchiveBundleTest);
+}
+
+UT_RUNNER_SUITE(WebArchiveTest);
@@ -0,0 +1,21 @@
+/**
+ * @file utRunner.c
+ *
+ * @brief shared runner of the unit tests, owns main and the fff globals
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+
+#include "fff.h"
+#include "utRunner.h"
+
+DEFINE_FFF_GLOBALS;
+
+int main(void)
+{
+    return UtRunnerRunSuite();
+}
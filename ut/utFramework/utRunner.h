@@ -0,0 +1,36 @@
+/**
+ * @file utRunner.h
+ *
+ * @brief shared runner of the unit tests, create_test links utRunner.c with its main
+ *        to every test; a test file defines its suite and ends with UT_RUNNER_SUITE(suite);
+ *
+ * @author matfio
+ * @date 2026.10.18
+ * @version v1.0
+ *
+ * @copyright 2021 Fideltronik R&D - all rights reserved.
+ */
+#pragma once
+
+/*****************************************************************************
+                       PUBLIC DEFINES / MACROS / ENUMS
+*****************************************************************************/
+
+// minunit counters are static in the test file, so the suite is run and reported there
+#define UT_RUNNER_SUITE(suite_name)                                                                \
+    int UtRunnerRunSuite(void)                                                                     \
+    {                                                                                              \
+        MU_RUN_SUITE(suite_name);                                                                  \
+        MU_REPORT();                                                                               \
+        return minunit_fail;                                                                       \
+    }                                                                                              \
+    extern int UtRunnerRunSuite(void)
+
+/*****************************************************************************
+                         PUBLIC INTERFACE DECLARATION
+*****************************************************************************/
+
+/** @brief Run suite of the test, defined by UT_RUNNER_SUITE in the test file
+ *  @return number of failed tests
+ */
+int UtRunnerRunSuite(void);